@@ -9,11 +9,15 @@
 using namespace std::chrono_literals;
 using namespace nearobject;
 
-NearObjectSession::NearObjectSession(uint32_t sessionId, NearObjectCapabilities capabilities, const std::vector<std::shared_ptr<NearObject>>& nearObjects, std::weak_ptr<NearObjectSessionEventCallbacks> eventCallbacks) :
+NearObjectSession::NearObjectSession(uint32_t sessionId, NearObjectCapabilities capabilities, const std::vector<std::shared_ptr<NearObject>>& nearObjects, std::weak_ptr<NearObjectSessionEventCallbacks> eventCallbacks, notstd::thread_pool& threadPool) :
     m_sessionId(sessionId),
     m_capabilities(capabilities),
     m_eventCallbacks(std::move(eventCallbacks)),
-    m_nearObjects(nearObjects)
+    m_nearObjects(nearObjects),
+    m_strand(threadPool),
+    m_nearObjectPropertiesChangedQueue([this](notstd::inline_task task) {
+        m_strand.post_detached(std::move(task));
+    })
 {
 }
 
@@ -37,17 +41,15 @@ NearObjectSession::GetCapabilities() const noexcept
 void
 NearObjectSession::InvokeEventCallback(std::function<void(NearObjectSessionEventCallbacks& callbacks)> executor)
 {
-    auto dispatcher = m_taskQueue.get_dispatcher();
-
-    auto const task = [this, executor = std::move(executor)]() {
+    // The completion of event callbacks isn't tracked, so avoid the overhead
+    // of creating a future for each one.
+    m_strand.post_detached([this, executor = std::move(executor)]() {
         const auto eventCallbacks = m_eventCallbacks.lock();
         if (!eventCallbacks) {
             return;
         }
         executor(*eventCallbacks);
-    };
-
-    dispatcher->post(std::move(task));
+    });
 }
 
 void
@@ -130,8 +132,14 @@ NearObjectSession::EndSession()
 void
 NearObjectSession::NearObjectPropertiesChanged(const std::shared_ptr<NearObject> nearObjectChanged)
 {
-    InvokeEventCallback([this, nearObjectChanged](auto& eventCallbacks) {
-        eventCallbacks.OnNearObjectPropertiesChanged(this, { nearObjectChanged });
+    // Replace any pending event for the same near object, since the callbacks
+    // only need to know the latest state of each one.
+    m_nearObjectPropertiesChangedQueue.post(nearObjectChanged, [this, nearObjectChanged] {
+        const auto eventCallbacks = m_eventCallbacks.lock();
+        if (!eventCallbacks) {
+            return;
+        }
+        eventCallbacks->OnNearObjectPropertiesChanged(this, { nearObjectChanged });
     });
 }
 
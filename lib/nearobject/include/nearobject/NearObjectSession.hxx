@@ -12,7 +12,9 @@
 #include <nearobject/NearObject.hxx>
 #include <nearobject/NearObjectCapabilities.hxx>
 
-#include <notstd/task_queue.hxx>
+#include <notstd/coalescing_queue.hxx>
+#include <notstd/strand.hxx>
+#include <notstd/thread_pool.hxx>
 
 namespace nearobject
 {
@@ -39,8 +41,9 @@ public:
      * @param capabilities The capabilities supported by this session.
      * @param nearObjects The initial near objects involved in this session.
      * @param eventCallbacks The callbacks used to signal events from this session.
+     * @param threadPool The thread pool to run event callbacks on.
      */
-    NearObjectSession(uint32_t sessionId, NearObjectCapabilities capabilities, const std::vector<std::shared_ptr<NearObject>>& nearObjects, std::weak_ptr<NearObjectSessionEventCallbacks> eventCallbacks);
+    NearObjectSession(uint32_t sessionId, NearObjectCapabilities capabilities, const std::vector<std::shared_ptr<NearObject>>& nearObjects, std::weak_ptr<NearObjectSessionEventCallbacks> eventCallbacks, notstd::thread_pool& threadPool = notstd::thread_pool::get_default());
 
     /**
      * @brief Destroy the NearObjectSession object
@@ -195,7 +198,14 @@ private:
     mutable std::mutex m_nearObjectsGate;
     std::vector<std::shared_ptr<NearObject>> m_nearObjects;
 
-    notstd::task_queue m_taskQueue;
+    // Event callbacks are run serially on a strand of a shared thread pool,
+    // so sessions don't each require a dedicated thread.
+    notstd::strand m_strand;
+
+    // Property change events are coalesced per near object, so a slow
+    // consumer only receives the latest change of each one rather than an
+    // ever-growing backlog.
+    notstd::coalescing_queue<std::shared_ptr<NearObject>> m_nearObjectPropertiesChangedQueue;
 };
 
 } // namespace nearobject
@@ -0,0 +1,117 @@
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+#include <notstd/histogram.hxx>
+
+using namespace notstd;
+
+namespace
+{
+/**
+ * @brief Increments an atomic which is only modified by a single thread,
+ * avoiding the cost of an atomic read-modify-write operation.
+ *
+ * @param value The atomic to increment.
+ * @param amount The amount to increment it by.
+ */
+void
+add_single_writer(std::atomic<std::uint64_t>& value, std::uint64_t amount) noexcept
+{
+    value.store(value.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+}
+} // namespace
+
+double
+histogram::snapshot::mean() const noexcept
+{
+    return (count == 0) ? 0.0 : static_cast<double>(sum) / static_cast<double>(count);
+}
+
+std::uint64_t
+histogram::snapshot::value_at_percentile(double percentile) const noexcept
+{
+    if (count == 0) {
+        return 0;
+    }
+
+    // The rank of the value at the percentile, counting from one.
+    const auto fraction = std::clamp(percentile, 0.0, 100.0) / 100.0;
+    const auto rank = std::max<std::uint64_t>(1, static_cast<std::uint64_t>(std::ceil(fraction * static_cast<double>(count))));
+
+    std::uint64_t count_cumulative = 0;
+    for (std::size_t index = 0; index < counts.size(); index++) {
+        count_cumulative += counts[index];
+        if (count_cumulative >= rank) {
+            return std::min(bucket_upper_bound(index), max);
+        }
+    }
+
+    return max;
+}
+
+void
+histogram::record(std::uint64_t value) noexcept
+{
+    add_single_writer(m_counts[bucket_index(value)], 1);
+    add_single_writer(m_count, 1);
+    add_single_writer(m_sum, value);
+    if (value > m_max.load(std::memory_order_relaxed)) {
+        m_max.store(value, std::memory_order_relaxed);
+    }
+}
+
+histogram::snapshot
+histogram::get_snapshot() const noexcept
+{
+    snapshot result{};
+    for (std::size_t index = 0; index < m_counts.size(); index++) {
+        result.counts[index] = m_counts[index].load(std::memory_order_relaxed);
+    }
+    result.count = m_count.load(std::memory_order_relaxed);
+    result.sum = m_sum.load(std::memory_order_relaxed);
+    result.max = m_max.load(std::memory_order_relaxed);
+
+    return result;
+}
+
+/* static */
+std::size_t
+histogram::bucket_index(std::uint64_t value) noexcept
+{
+    if (value < sub_bucket_count) {
+        return static_cast<std::size_t>(value);
+    }
+
+    // The bits below the leading one, beyond the first sub_bucket_bits of
+    // them, are discarded.
+    const auto shift = static_cast<std::size_t>(std::bit_width(value)) - 1 - sub_bucket_bits;
+    const auto sub_bucket = static_cast<std::size_t>(value >> shift) & (sub_bucket_count - 1);
+    return ((shift + 1) * sub_bucket_count) + sub_bucket;
+}
+
+/* static */
+std::uint64_t
+histogram::bucket_lower_bound(std::size_t index) noexcept
+{
+    if (index < sub_bucket_count) {
+        return index;
+    }
+
+    const auto shift = (index / sub_bucket_count) - 1;
+    const auto sub_bucket = index % sub_bucket_count;
+    return static_cast<std::uint64_t>(sub_bucket_count + sub_bucket) << shift;
+}
+
+/* static */
+std::uint64_t
+histogram::bucket_upper_bound(std::size_t index) noexcept
+{
+    if (index < sub_bucket_count) {
+        return index;
+    }
+
+    const auto shift = (index / sub_bucket_count) - 1;
+    return bucket_lower_bound(index) + ((std::uint64_t{ 1 } << shift) - 1);
+}
@@ -0,0 +1,247 @@
+
+#ifndef NOTSTD_COALESCING_QUEUE_HXX
+#define NOTSTD_COALESCING_QUEUE_HXX
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+
+#include <notstd/inline_task.hxx>
+
+namespace notstd
+{
+/**
+ * @brief A queue of keyed tasks where a newer task replaces any pending task
+ * with the same key (latest-wins).
+ *
+ * This is intended for high-rate notifications of changing state, where only
+ * the latest state is of interest to the consumer. Pending tasks are run on an
+ * executor (eg. a strand or task_queue dispatcher), which receives a single
+ * task that drains the queue whenever it becomes non-empty. A task keeps the
+ * position in the queue of the first pending task it replaced, so frequently
+ * updated keys don't starve the others, and memory is bounded by the number of
+ * distinct keys rather than the rate of posting.
+ *
+ * Since pending tasks are run by a single drain task, they may run ahead of
+ * tasks posted directly to the executor after them.
+ *
+ * @tparam KeyT The type of key used to identify tasks to coalesce.
+ * @tparam HashT The hash function for the key type.
+ * @tparam KeyEqualT The equality function for the key type.
+ */
+template <typename KeyT, typename HashT = std::hash<KeyT>, typename KeyEqualT = std::equal_to<KeyT>>
+class coalescing_queue
+{
+public:
+    using key_type = KeyT;
+
+    /**
+     * @brief The function used to schedule the task which drains the queue.
+     */
+    using executor_type = std::function<void(inline_task)>;
+
+    /**
+     * @brief The capacity of a queue that accepts any number of distinct keys.
+     */
+    static constexpr std::size_t capacity_unbounded = std::numeric_limits<std::size_t>::max();
+
+    /**
+     * @brief Construct a new coalescing_queue object.
+     *
+     * @param executor The function used to schedule the task which drains the
+     * queue. This must run the task it is given exactly once, and may throw if
+     * it can't accept the task.
+     * @param capacity The maximum number of distinct keys that may be pending.
+     * Tasks with a new key posted while the queue is full are dropped.
+     */
+    explicit coalescing_queue(executor_type executor, std::size_t capacity = capacity_unbounded) :
+        m_state(std::make_shared<shared_state>(std::move(executor), capacity))
+    {}
+
+    /**
+     * @brief Destroy the coalescing_queue object. Pending tasks are dropped
+     * without being run. A drain task still scheduled on the executor does
+     * nothing when it runs.
+     */
+    ~coalescing_queue()
+    {
+        std::unordered_map<KeyT, inline_task, HashT, KeyEqualT> tasks{};
+        {
+            std::scoped_lock tasks_lock{ m_state->tasks_gate };
+            m_state->closed = true;
+            m_state->dropped.fetch_add(m_state->tasks.size(), std::memory_order_relaxed);
+            std::swap(tasks, m_state->tasks);
+            m_state->keys.clear();
+        }
+    }
+
+    coalescing_queue(const coalescing_queue&) = delete;
+    coalescing_queue(coalescing_queue&&) = delete;
+    coalescing_queue&
+    operator=(const coalescing_queue&) = delete;
+    coalescing_queue&
+    operator=(coalescing_queue&&) = delete;
+
+    /**
+     * @brief Posts a task, replacing any pending task with the same key.
+     *
+     * @param key The key identifying the task.
+     * @param task The task to run.
+     * @return true If the task is pending.
+     * @return false If the task was dropped because the queue is full.
+     */
+    bool
+    post(KeyT key, inline_task task)
+    {
+        auto& state = *m_state;
+        bool schedule = false;
+        // Destroyed once the lock has been released.
+        inline_task task_replaced{};
+
+        {
+            std::scoped_lock tasks_lock{ state.tasks_gate };
+            auto it = state.tasks.find(key);
+            if (it != std::end(state.tasks)) {
+                task_replaced = std::exchange(it->second, std::move(task));
+                state.coalesced.fetch_add(1, std::memory_order_relaxed);
+                return true;
+            }
+
+            if (state.tasks.size() >= state.capacity) {
+                state.dropped.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+
+            state.keys.push_back(key);
+            state.tasks.emplace(std::move(key), std::move(task));
+            schedule = !std::exchange(state.scheduled, true);
+        }
+
+        // Only one drain task is scheduled at a time. If the executor rejects
+        // it, allow the next post to try again.
+        if (schedule) {
+            try {
+                state.executor([state_weak = std::weak_ptr<shared_state>(m_state)] {
+                    if (auto state_shared = state_weak.lock()) {
+                        drain(*state_shared);
+                    }
+                });
+            } catch (...) {
+                std::scoped_lock tasks_lock{ state.tasks_gate };
+                state.scheduled = false;
+                throw;
+            }
+        }
+
+        return true;
+    }
+
+    /**
+     * @brief Get the number of pending tasks.
+     *
+     * @return std::size_t
+     */
+    std::size_t
+    size() const
+    {
+        std::scoped_lock tasks_lock{ m_state->tasks_gate };
+        return m_state->tasks.size();
+    }
+
+    /**
+     * @brief Get the number of tasks that were replaced by a newer task with
+     * the same key before they ran.
+     *
+     * @return std::uint64_t
+     */
+    std::uint64_t
+    coalesced() const noexcept
+    {
+        return m_state->coalesced.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Get the number of tasks that were dropped without running,
+     * either because the queue was full or because it was destroyed.
+     *
+     * @return std::uint64_t
+     */
+    std::uint64_t
+    dropped() const noexcept
+    {
+        return m_state->dropped.load(std::memory_order_relaxed);
+    }
+
+private:
+    /**
+     * @brief The state of the queue, shared with the drain task so the queue
+     * may be destroyed while a drain task is still scheduled.
+     */
+    struct shared_state
+    {
+        shared_state(executor_type executor_drain, std::size_t capacity_keys) :
+            executor(std::move(executor_drain)),
+            capacity(capacity_keys)
+        {}
+
+        const executor_type executor;
+        const std::size_t capacity;
+
+        std::mutex tasks_gate;
+        // Access to the below variables must be synchronized with tasks_gate.
+        std::unordered_map<KeyT, inline_task, HashT, KeyEqualT> tasks;
+        // The keys of the pending tasks, in the order they were first posted.
+        std::deque<KeyT> keys;
+        bool scheduled{ false };
+        bool closed{ false };
+
+        std::atomic<std::uint64_t> coalesced{ 0 };
+        std::atomic<std::uint64_t> dropped{ 0 };
+    };
+
+    /**
+     * @brief Runs pending tasks until the queue is empty.
+     *
+     * Tasks are removed one at a time, so a task posted while another runs
+     * still replaces a pending task with the same key.
+     *
+     * @param state The state of the queue.
+     */
+    static void
+    drain(shared_state& state)
+    {
+        for (;;) {
+            inline_task task{};
+            {
+                std::scoped_lock tasks_lock{ state.tasks_gate };
+                if (state.closed || state.keys.empty()) {
+                    state.scheduled = false;
+                    return;
+                }
+
+                auto node = state.tasks.extract(state.keys.front());
+                state.keys.pop_front();
+                task = std::move(node.mapped());
+            }
+
+            try {
+                task();
+            } catch (...) {
+            }
+        }
+    }
+
+private:
+    std::shared_ptr<shared_state> m_state;
+};
+
+} // namespace notstd
+
+#endif // NOTSTD_COALESCING_QUEUE_HXX
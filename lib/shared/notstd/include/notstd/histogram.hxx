@@ -0,0 +1,116 @@
+
+#ifndef NOTSTD_HISTOGRAM_HXX
+#define NOTSTD_HISTOGRAM_HXX
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace notstd
+{
+/**
+ * @brief A histogram of unsigned values with log-linear buckets.
+ *
+ * Values below sub_bucket_count each have their own bucket. Above that, each
+ * power of two is divided into sub_bucket_count equally sized buckets, so the
+ * relative error of a value reported from the histogram is at most
+ * 1 / sub_bucket_count, while covering the full range of 64-bit values with a
+ * fixed number of buckets.
+ *
+ * Recording is lock-free and wait-free, but only a single thread may record
+ * values at a time. Snapshots may be taken from any thread concurrently with
+ * recording, and are consistent per bucket, but not across buckets.
+ */
+class histogram
+{
+public:
+    static constexpr std::size_t sub_bucket_bits = 3;
+    static constexpr std::size_t sub_bucket_count = std::size_t{ 1 } << sub_bucket_bits;
+    static constexpr std::size_t bucket_count = (64 - sub_bucket_bits + 1) * sub_bucket_count;
+
+    /**
+     * @brief A point-in-time copy of the contents of a histogram.
+     */
+    struct snapshot
+    {
+        std::array<std::uint64_t, bucket_count> counts{};
+        std::uint64_t count{ 0 };
+        std::uint64_t sum{ 0 };
+        std::uint64_t max{ 0 };
+
+        /**
+         * @brief Get the mean of the recorded values.
+         *
+         * @return double The mean, or zero if no values were recorded.
+         */
+        double
+        mean() const noexcept;
+
+        /**
+         * @brief Get an upper bound of the specified percentile of the
+         * recorded values.
+         *
+         * @param percentile The percentile, between 0 and 100.
+         * @return std::uint64_t The upper bound of the bucket holding the
+         * percentile, capped at the maximum recorded value, or zero if no
+         * values were recorded.
+         */
+        std::uint64_t
+        value_at_percentile(double percentile) const noexcept;
+    };
+
+    /**
+     * @brief Records a value. This must not be called concurrently from
+     * multiple threads.
+     *
+     * @param value The value to record.
+     */
+    void
+    record(std::uint64_t value) noexcept;
+
+    /**
+     * @brief Get a copy of the contents of the histogram.
+     *
+     * @return snapshot
+     */
+    snapshot
+    get_snapshot() const noexcept;
+
+    /**
+     * @brief Get the index of the bucket holding a value.
+     *
+     * @param value The value.
+     * @return std::size_t
+     */
+    static std::size_t
+    bucket_index(std::uint64_t value) noexcept;
+
+    /**
+     * @brief Get the smallest value held by a bucket.
+     *
+     * @param index The index of the bucket.
+     * @return std::uint64_t
+     */
+    static std::uint64_t
+    bucket_lower_bound(std::size_t index) noexcept;
+
+    /**
+     * @brief Get the largest value held by a bucket.
+     *
+     * @param index The index of the bucket.
+     * @return std::uint64_t
+     */
+    static std::uint64_t
+    bucket_upper_bound(std::size_t index) noexcept;
+
+private:
+    std::array<std::atomic<std::uint64_t>, bucket_count> m_counts{};
+    std::atomic<std::uint64_t> m_count{ 0 };
+    std::atomic<std::uint64_t> m_sum{ 0 };
+    std::atomic<std::uint64_t> m_max{ 0 };
+};
+
+} // namespace notstd
+
+#endif // NOTSTD_HISTOGRAM_HXX
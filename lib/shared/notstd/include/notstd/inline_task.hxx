@@ -0,0 +1,201 @@
+
+#ifndef NOTSTD_INLINE_TASK_HXX
+#define NOTSTD_INLINE_TASK_HXX
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace notstd
+{
+/**
+ * @brief A move-only, type-erased callable taking no arguments and returning
+ * nothing, with small-buffer optimization.
+ *
+ * Unlike std::function, this accepts move-only callables, and callables up to
+ * inline_capacity bytes in size (eg. a lambda capturing a few pointers and a
+ * std::function) are stored inline, so constructing, moving, and invoking
+ * them does not allocate. Larger callables are allocated on the heap.
+ */
+class inline_task
+{
+public:
+    /**
+     * @brief The maximum size of a callable that is stored inline.
+     */
+    static constexpr std::size_t inline_capacity = 48;
+
+    /**
+     * @brief Construct a new empty inline_task object.
+     */
+    inline_task() noexcept = default;
+
+    /**
+     * @brief Construct a new inline_task object holding the specified callable.
+     *
+     * @tparam CallableT The type of the callable.
+     * @param callable The callable to hold.
+     */
+    template <typename CallableT>
+    requires(!std::is_same_v<std::remove_cvref_t<CallableT>, inline_task> && std::is_invocable_r_v<void, std::decay_t<CallableT>&>)
+    // NOLINTNEXTLINE(bugprone-forwarding-reference-overload)
+    inline_task(CallableT&& callable) :
+        m_operations(&operations_for<std::decay_t<CallableT>>)
+    {
+        using callable_type = std::decay_t<CallableT>;
+        if constexpr (is_stored_inline<callable_type>) {
+            std::construct_at(reinterpret_cast<callable_type*>(&m_storage), std::forward<CallableT>(callable));
+        } else {
+            std::construct_at(reinterpret_cast<callable_type**>(&m_storage), new callable_type(std::forward<CallableT>(callable)));
+        }
+    }
+
+    inline_task(inline_task&& other) noexcept :
+        m_operations(std::exchange(other.m_operations, nullptr))
+    {
+        if (m_operations != nullptr) {
+            m_operations->move(&m_storage, &other.m_storage);
+        }
+    }
+
+    inline_task&
+    operator=(inline_task&& other) noexcept
+    {
+        if (this != &other) {
+            reset();
+            m_operations = std::exchange(other.m_operations, nullptr);
+            if (m_operations != nullptr) {
+                m_operations->move(&m_storage, &other.m_storage);
+            }
+        }
+
+        return *this;
+    }
+
+    inline_task(const inline_task&) = delete;
+    inline_task&
+    operator=(const inline_task&) = delete;
+
+    ~inline_task()
+    {
+        reset();
+    }
+
+    /**
+     * @brief Determines if this object holds a callable.
+     *
+     * @return true
+     * @return false
+     */
+    explicit
+    operator bool() const noexcept
+    {
+        return m_operations != nullptr;
+    }
+
+    /**
+     * @brief Determines if the held callable is stored inline, without any
+     * heap allocation.
+     *
+     * @return true
+     * @return false
+     */
+    bool
+    is_inline() const noexcept
+    {
+        return m_operations != nullptr && m_operations->is_inline;
+    }
+
+    /**
+     * @brief Invoke the held callable. This object must hold a callable.
+     */
+    void
+    operator()()
+    {
+        m_operations->invoke(&m_storage);
+    }
+
+    /**
+     * @brief Destroy the held callable, if any.
+     */
+    void
+    reset() noexcept
+    {
+        if (m_operations != nullptr) {
+            std::exchange(m_operations, nullptr)->destroy(&m_storage);
+        }
+    }
+
+private:
+    /**
+     * @brief Determines if a callable type is stored inline.
+     *
+     * @tparam CallableT The type of the callable.
+     */
+    template <typename CallableT>
+    static constexpr bool is_stored_inline = (sizeof(CallableT) <= inline_capacity) && (alignof(CallableT) <= alignof(std::max_align_t)) && std::is_nothrow_move_constructible_v<CallableT>;
+
+    /**
+     * @brief The type-specific operations on the held callable.
+     */
+    struct operations
+    {
+        void (*invoke)(void* storage);
+        void (*move)(void* storage, void* storage_other) noexcept;
+        void (*destroy)(void* storage) noexcept;
+        bool is_inline;
+    };
+
+    /**
+     * @brief Get the callable held in the specified storage.
+     *
+     * @tparam CallableT The type of the callable.
+     * @param storage The storage holding the callable.
+     * @return CallableT*
+     */
+    template <typename CallableT>
+    static CallableT*
+    get(void* storage) noexcept
+    {
+        if constexpr (is_stored_inline<CallableT>) {
+            return std::launder(static_cast<CallableT*>(storage));
+        } else {
+            return *std::launder(static_cast<CallableT**>(storage));
+        }
+    }
+
+    template <typename CallableT>
+    static constexpr operations operations_for{
+        .invoke = [](void* storage) {
+            std::invoke(*get<CallableT>(storage));
+        },
+        .move = [](void* storage, void* storage_other) noexcept {
+            if constexpr (is_stored_inline<CallableT>) {
+                auto* callable_other = get<CallableT>(storage_other);
+                std::construct_at(static_cast<CallableT*>(storage), std::move(*callable_other));
+                std::destroy_at(callable_other);
+            } else {
+                std::construct_at(static_cast<CallableT**>(storage), get<CallableT>(storage_other));
+            }
+        },
+        .destroy = [](void* storage) noexcept {
+            if constexpr (is_stored_inline<CallableT>) {
+                std::destroy_at(get<CallableT>(storage));
+            } else {
+                delete get<CallableT>(storage);
+            }
+        },
+        .is_inline = is_stored_inline<CallableT>,
+    };
+
+private:
+    alignas(std::max_align_t) std::byte m_storage[inline_capacity]{};
+    const operations* m_operations{ nullptr };
+};
+
+} // namespace notstd
+
+#endif // NOTSTD_INLINE_TASK_HXX
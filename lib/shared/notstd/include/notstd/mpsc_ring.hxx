@@ -0,0 +1,189 @@
+
+#ifndef NOTSTD_MPSC_RING_HXX
+#define NOTSTD_MPSC_RING_HXX
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+namespace notstd
+{
+/**
+ * @brief A bounded, lock-free, multi-producer single-consumer (MPSC) queue.
+ *
+ * The queue is a ring of slots, each tagged with a sequence number which
+ * encodes whether the slot is free for the producer claiming a position, or
+ * holds a value for the consumer at that position. Producers claim a position
+ * with a single atomic compare-exchange, so posting never takes a lock, and
+ * the consumer never contends with producers except on the slot it reads.
+ *
+ * This is based on the bounded MPMC queue design by Dmitry Vyukov, specialized
+ * for a single consumer.
+ *
+ * @tparam T The type of value held in the queue.
+ */
+template <typename T>
+class mpsc_ring
+{
+    static_assert(std::is_nothrow_move_constructible_v<T>, "mpsc_ring values must be nothrow move constructible");
+
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+
+    /**
+     * @brief Construct a new mpsc_ring object.
+     *
+     * @param capacity The maximum number of values the queue can hold. This is
+     * rounded up to the next power of two.
+     */
+    explicit mpsc_ring(size_type capacity) :
+        m_mask(std::bit_ceil(std::max<size_type>(capacity, 2)) - 1),
+        m_slots(std::make_unique<slot[]>(m_mask + 1))
+    {
+        for (size_type position = 0; position <= m_mask; position++) {
+            m_slots[position].sequence.store(position, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief Destroy the mpsc_ring object, destroying any values still held.
+     */
+    ~mpsc_ring()
+    {
+        while (try_pop()) {
+        }
+    }
+
+    mpsc_ring(const mpsc_ring&) = delete;
+    mpsc_ring(mpsc_ring&&) = delete;
+    mpsc_ring&
+    operator=(const mpsc_ring&) = delete;
+    mpsc_ring&
+    operator=(mpsc_ring&&) = delete;
+
+    /**
+     * @brief Get the maximum number of values the queue can hold.
+     *
+     * @return size_type
+     */
+    size_type
+    capacity() const noexcept
+    {
+        return m_mask + 1;
+    }
+
+    /**
+     * @brief Attempt to push a value onto the back of the queue. This may be
+     * called from any thread.
+     *
+     * @param value The value to push. This is only moved from if the push succeeds.
+     * @return true If the value was pushed.
+     * @return false If the queue was full.
+     */
+    bool
+    try_push(T& value) noexcept
+    {
+        auto position = m_tail.load(std::memory_order_relaxed);
+        for (;;) {
+            auto& cell = m_slots[position & m_mask];
+            const auto sequence = cell.sequence.load(std::memory_order_acquire);
+            const auto difference = static_cast<std::ptrdiff_t>(sequence - position);
+            if (difference == 0) {
+                // The slot is free; attempt to claim the position.
+                if (m_tail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    std::construct_at(cell.value(), std::move(value));
+                    cell.sequence.store(position + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (difference < 0) {
+                // The slot still holds the value from the previous lap, so the queue is full.
+                return false;
+            } else {
+                // Another producer claimed the position; try the next one.
+                position = m_tail.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /**
+     * @brief Attempt to pop the value at the front of the queue. This must
+     * only be called from the (single) consumer thread.
+     *
+     * If a producer has claimed the front position but not yet finished
+     * writing its value, this waits for it to finish, so an empty result
+     * means that no value was pushed prior to the call.
+     *
+     * @return std::optional<T> The value at the front of the queue, if any.
+     */
+    std::optional<T>
+    try_pop() noexcept
+    {
+        const auto position = m_head;
+        auto& cell = m_slots[position & m_mask];
+        for (;;) {
+            const auto sequence = cell.sequence.load(std::memory_order_acquire);
+            if (sequence == position + 1) {
+                break;
+            }
+            if (m_tail.load(std::memory_order_acquire) == position) {
+                return std::nullopt;
+            }
+            std::this_thread::yield();
+        }
+
+        std::optional<T> value{ std::move(*cell.value()) };
+        std::destroy_at(cell.value());
+        cell.sequence.store(position + m_mask + 1, std::memory_order_release);
+        m_head = position + 1;
+        return value;
+    }
+
+    /**
+     * @brief Determines if the queue is empty. This must only be called from
+     * the (single) consumer thread.
+     *
+     * @return true
+     * @return false
+     */
+    bool
+    empty() const noexcept
+    {
+        return m_tail.load(std::memory_order_acquire) == m_head;
+    }
+
+private:
+    /**
+     * @brief A single entry in the ring.
+     */
+    struct slot
+    {
+        std::atomic<size_type> sequence{ 0 };
+        alignas(T) std::byte storage[sizeof(T)];
+
+        T*
+        value() noexcept
+        {
+            return std::launder(reinterpret_cast<T*>(&storage));
+        }
+    };
+
+    // Producers and the consumer write to different cache lines.
+    static constexpr std::size_t cache_line_size = 64;
+
+    const size_type m_mask;
+    std::unique_ptr<slot[]> m_slots;
+    alignas(cache_line_size) std::atomic<size_type> m_tail{ 0 };
+    alignas(cache_line_size) size_type m_head{ 0 };
+};
+
+} // namespace notstd
+
+#endif // NOTSTD_MPSC_RING_HXX
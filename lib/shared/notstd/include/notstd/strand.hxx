@@ -0,0 +1,137 @@
+
+#ifndef NOTSTD_STRAND_HXX
+#define NOTSTD_STRAND_HXX
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <vector>
+
+#include <notstd/inline_task.hxx>
+#include <notstd/thread_pool.hxx>
+
+namespace notstd
+{
+/**
+ * @brief Runs tasks serially, in first-in-first-out (FIFO) order, on a shared
+ * thread pool.
+ *
+ * A strand provides the same ordering guarantees as a task_queue without
+ * dedicating a thread to it: at most one of its tasks runs at any time, but
+ * successive tasks may run on different worker threads of the pool. This
+ * allows many independent serial queues (eg. one per session) to share a
+ * small, fixed number of threads.
+ *
+ * A strand must not be destroyed from one of its own tasks.
+ */
+class strand
+{
+public:
+    /**
+     * @brief The action to apply to pending tasks when stopping.
+     */
+    enum class pending_task_action {
+        run,
+        cancel,
+    };
+
+    /**
+     * @brief Construct a new strand object.
+     *
+     * @param pool The pool to run tasks on. This must outlive the strand.
+     */
+    explicit strand(thread_pool& pool = thread_pool::get_default());
+
+    /**
+     * @brief Runs all pending tasks, and waits for them to complete.
+     */
+    ~strand();
+
+    strand(const strand&) = delete;
+    strand(strand&&) = delete;
+    strand&
+    operator=(const strand&) = delete;
+    strand&
+    operator=(strand&&) = delete;
+
+    /**
+     * @brief Posts a task onto the strand.
+     *
+     * @param runnable The runnable task to be posted onto the strand.
+     * @return std::future<void> A future which completes when the task has run.
+     */
+    std::future<void>
+    post(std::function<void()> runnable);
+
+    /**
+     * @brief Posts a task onto the strand without tracking its completion.
+     * Any exception thrown by the task is discarded.
+     *
+     * @param runnable The runnable task to be posted onto the strand.
+     */
+    void
+    post_detached(inline_task runnable);
+
+    /**
+     * @brief Halts operation of the strand. Posting a task after this
+     * throws.
+     *
+     * @param pending_task_action The desired action to take for pending
+     * tasks. They will be run by default ('run'), or will be canceled
+     * ('cancel').
+     */
+    void
+    stop(pending_task_action pending_task_action = pending_task_action::run) noexcept;
+
+    /**
+     * @brief Stops the strand and waits for completion of all pending tasks.
+     */
+    void
+    stop_and_wait_for_task_completion();
+
+    /**
+     * @brief Determines if the calling thread is currently running a task of
+     * this strand.
+     *
+     * @return true
+     * @return false
+     */
+    bool
+    running_in_this_thread() const noexcept;
+
+private:
+    /**
+     * @brief Runs the pending tasks of the strand on a pool thread.
+     */
+    void
+    process_tasks();
+
+    /**
+     * @brief Helper to track state of the strand.
+     */
+    enum class state {
+        running,
+        stopping,
+        canceling,
+    };
+
+private:
+    thread_pool& m_pool;
+
+    std::mutex m_tasks_gate;
+    // Access to the below variables must be synchronized with m_tasks_gate.
+    std::vector<inline_task> m_tasks;
+    bool m_scheduled{ false };
+    std::condition_variable m_idle;
+    // Modifications to the state must be synchronized with m_tasks_gate.
+    std::atomic<state> m_state{ state::running };
+
+    // Only accessed while running the pending tasks.
+    std::vector<inline_task> m_tasks_running;
+};
+
+} // namespace notstd
+
+#endif // NOTSTD_STRAND_HXX
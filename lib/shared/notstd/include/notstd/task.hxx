@@ -0,0 +1,612 @@
+
+#ifndef NOTSTD_TASK_HXX
+#define NOTSTD_TASK_HXX
+
+#include <atomic>
+#include <concepts>
+#include <coroutine>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+#include <notstd/task_queue.hxx>
+#include <notstd/thread_pool.hxx>
+
+namespace notstd
+{
+template <typename T = void>
+class task;
+
+namespace detail
+{
+/**
+ * @brief State common to the promises of all task types.
+ */
+class task_promise_base
+{
+public:
+    /**
+     * @brief Awaitable run when the coroutine completes, which transfers
+     * control to the coroutine awaiting the task, if any.
+     */
+    struct final_awaiter
+    {
+        bool
+        await_ready() const noexcept
+        {
+            return false;
+        }
+
+        template <typename PromiseT>
+        std::coroutine_handle<>
+        await_suspend(std::coroutine_handle<PromiseT> coroutine) noexcept
+        {
+            return coroutine.promise().m_continuation;
+        }
+
+        void
+        await_resume() const noexcept
+        {}
+    };
+
+    /**
+     * @brief Tasks are lazy; they don't start until they're awaited.
+     */
+    std::suspend_always
+    initial_suspend() const noexcept
+    {
+        return {};
+    }
+
+    final_awaiter
+    final_suspend() const noexcept
+    {
+        return {};
+    }
+
+    void
+    unhandled_exception() noexcept
+    {
+        m_exception = std::current_exception();
+    }
+
+    /**
+     * @brief Set the coroutine to resume once the task completes.
+     *
+     * @param continuation The handle of the coroutine to resume.
+     */
+    void
+    set_continuation(std::coroutine_handle<> continuation) noexcept
+    {
+        m_continuation = continuation;
+    }
+
+protected:
+    /**
+     * @brief Rethrows the exception which escaped the coroutine, if any.
+     */
+    void
+    rethrow_if_exception() const
+    {
+        if (m_exception) {
+            std::rethrow_exception(m_exception);
+        }
+    }
+
+private:
+    std::coroutine_handle<> m_continuation{ std::noop_coroutine() };
+    std::exception_ptr m_exception{};
+};
+
+/**
+ * @brief The promise of a task producing a value of type T.
+ *
+ * @tparam T The type of value produced.
+ */
+template <typename T>
+class task_promise :
+    public task_promise_base
+{
+public:
+    task<T>
+    get_return_object() noexcept;
+
+    template <typename ValueT>
+    requires std::convertible_to<ValueT&&, T>
+    void
+    return_value(ValueT&& value) noexcept(std::is_nothrow_constructible_v<T, ValueT&&>)
+    {
+        m_value.emplace(std::forward<ValueT>(value));
+    }
+
+    /**
+     * @brief Get the result of the coroutine, rethrowing any exception which
+     * escaped it.
+     *
+     * @return T
+     */
+    T
+    result()
+    {
+        rethrow_if_exception();
+        return std::move(*m_value);
+    }
+
+private:
+    std::optional<T> m_value{};
+};
+
+/**
+ * @brief The promise of a task producing no value.
+ */
+template <>
+class task_promise<void> :
+    public task_promise_base
+{
+public:
+    task<void>
+    get_return_object() noexcept;
+
+    void
+    return_void() const noexcept
+    {}
+
+    void
+    result() const
+    {
+        rethrow_if_exception();
+    }
+};
+
+/**
+ * @brief A coroutine which starts immediately and destroys itself once it
+ * completes, used to run a task without an awaiting coroutine.
+ */
+struct detached_coroutine
+{
+    struct promise_type
+    {
+        detached_coroutine
+        get_return_object() const noexcept
+        {
+            return {};
+        }
+
+        std::suspend_never
+        initial_suspend() const noexcept
+        {
+            return {};
+        }
+
+        std::suspend_never
+        final_suspend() const noexcept
+        {
+            return {};
+        }
+
+        void
+        return_void() const noexcept
+        {}
+
+        void
+        unhandled_exception() const noexcept
+        {
+            std::terminate();
+        }
+    };
+};
+} // namespace detail
+
+/**
+ * @brief A lazily started coroutine producing a value of type T.
+ *
+ * The coroutine doesn't start until the task is awaited with co_await, and the
+ * awaiting coroutine is resumed on whichever thread the task completes on.
+ * Use task_queue::dispatcher::schedule() within the coroutine to switch it to
+ * a task_queue, and spawn() to start a task from outside of a coroutine.
+ *
+ * @tparam T The type of value produced, or void.
+ */
+template <typename T>
+class task
+{
+    static_assert(!std::is_reference_v<T>, "tasks producing references are not supported");
+
+    /**
+     * @brief Allow the promise to access the private constructor.
+     */
+    friend class detail::task_promise<T>;
+
+public:
+    using promise_type = detail::task_promise<T>;
+    using value_type = T;
+
+    task(task&& other) noexcept :
+        m_coroutine(std::exchange(other.m_coroutine, nullptr))
+    {}
+
+    task&
+    operator=(task&& other) noexcept
+    {
+        if (this != &other) {
+            destroy();
+            m_coroutine = std::exchange(other.m_coroutine, nullptr);
+        }
+
+        return *this;
+    }
+
+    task(const task&) = delete;
+    task&
+    operator=(const task&) = delete;
+
+    /**
+     * @brief Destroy the task object, along with the coroutine if it hasn't
+     * completed.
+     */
+    ~task()
+    {
+        destroy();
+    }
+
+    /**
+     * @brief Starts the coroutine and suspends the awaiting coroutine until
+     * it completes. A task may only be awaited once.
+     *
+     * @return auto An awaitable producing the result of the coroutine, or
+     * rethrowing the exception which escaped it.
+     */
+    auto
+    operator co_await() && noexcept
+    {
+        struct awaiter
+        {
+            bool
+            await_ready() const noexcept
+            {
+                return false;
+            }
+
+            std::coroutine_handle<>
+            await_suspend(std::coroutine_handle<> awaiting) noexcept
+            {
+                coroutine.promise().set_continuation(awaiting);
+                return coroutine;
+            }
+
+            T
+            await_resume()
+            {
+                return coroutine.promise().result();
+            }
+
+            std::coroutine_handle<promise_type> coroutine;
+        };
+
+        return awaiter{ m_coroutine };
+    }
+
+private:
+    explicit task(std::coroutine_handle<promise_type> coroutine) noexcept :
+        m_coroutine(coroutine)
+    {}
+
+    void
+    destroy() noexcept
+    {
+        if (m_coroutine) {
+            m_coroutine.destroy();
+            m_coroutine = nullptr;
+        }
+    }
+
+private:
+    std::coroutine_handle<promise_type> m_coroutine{};
+};
+
+template <typename T>
+task<T>
+detail::task_promise<T>::get_return_object() noexcept
+{
+    return task<T>{ std::coroutine_handle<task_promise<T>>::from_promise(*this) };
+}
+
+inline task<void>
+detail::task_promise<void>::get_return_object() noexcept
+{
+    return task<void>{ std::coroutine_handle<task_promise<void>>::from_promise(*this) };
+}
+
+namespace detail
+{
+/**
+ * @brief Awaitable which resumes a detached coroutine on a task queue, like
+ * task_queue::dispatcher::schedule(). Unlike schedule(), the task resuming the
+ * coroutine owns it; if the task is dropped instead of run, the coroutine is
+ * destroyed rather than leaked.
+ */
+class detached_schedule_operation
+{
+    /**
+     * @brief Whether the task resuming the coroutine was dropped while it was
+     * being posted. This is shared between the task and the awaitable, since
+     * the task may run and complete the coroutine before posting returns.
+     */
+    enum class post_state {
+        posting,
+        posted,
+        dropped,
+    };
+
+    /**
+     * @brief The task which resumes the coroutine, or destroys it if the task
+     * is destroyed without being run.
+     */
+    class resumer
+    {
+    public:
+        resumer(std::coroutine_handle<> coroutine, std::shared_ptr<std::atomic<post_state>> state) noexcept :
+            m_coroutine(coroutine),
+            m_state(std::move(state))
+        {}
+
+        resumer(resumer&& other) noexcept :
+            m_coroutine(std::exchange(other.m_coroutine, nullptr)),
+            m_state(std::move(other.m_state))
+        {}
+
+        resumer(const resumer&) = delete;
+        resumer&
+        operator=(const resumer&) = delete;
+        resumer&
+        operator=(resumer&&) = delete;
+
+        /**
+         * @brief Destroy the coroutine if this was dropped after posting
+         * completed. If posting is still in progress, the awaitable handles
+         * the drop instead.
+         */
+        ~resumer()
+        {
+            if (!m_coroutine) {
+                return;
+            }
+
+            auto state = post_state::posting;
+            if (!m_state->compare_exchange_strong(state, post_state::dropped)) {
+                m_coroutine.destroy();
+            }
+        }
+
+        void
+        operator()()
+        {
+            std::exchange(m_coroutine, nullptr).resume();
+        }
+
+    private:
+        std::coroutine_handle<> m_coroutine;
+        std::shared_ptr<std::atomic<post_state>> m_state;
+    };
+
+public:
+    explicit detached_schedule_operation(task_queue::dispatcher& dispatcher) noexcept :
+        m_dispatcher(dispatcher)
+    {}
+
+    bool
+    await_ready() const noexcept
+    {
+        return false;
+    }
+
+    /**
+     * @brief Posts a task which resumes the awaiting coroutine. If posting
+     * throws, the coroutine is resumed immediately and the exception is
+     * raised from the co_await expression. If the task is dropped, the
+     * coroutine is destroyed.
+     *
+     * @param awaiting The handle of the awaiting coroutine.
+     * @return true If the coroutine remains suspended.
+     * @return false If the coroutine should be resumed immediately.
+     */
+    bool
+    await_suspend(std::coroutine_handle<> awaiting)
+    {
+        auto state = std::make_shared<std::atomic<post_state>>(post_state::posting);
+        try {
+            m_dispatcher.post_detached(resumer{ awaiting, state });
+        } catch (...) {
+            m_exception = std::current_exception();
+            return false;
+        }
+
+        // The task may already have resumed the coroutine, so neither this
+        // object nor the coroutine may be accessed unless the task was
+        // dropped while posting.
+        auto state_expected = post_state::posting;
+        if (!state->compare_exchange_strong(state_expected, post_state::posted)) {
+            awaiting.destroy();
+        }
+
+        return true;
+    }
+
+    void
+    await_resume() const
+    {
+        if (m_exception) {
+            std::rethrow_exception(m_exception);
+        }
+    }
+
+private:
+    task_queue::dispatcher& m_dispatcher;
+    std::exception_ptr m_exception{};
+};
+
+/**
+ * @brief Runs a task on a task queue, reporting its result in a promise. If
+ * the queue drops the task which starts it, the coroutine is destroyed, and
+ * with it the promise, so its future reports std::future_errc::broken_promise.
+ */
+template <typename T>
+detached_coroutine
+run_spawned(task_queue::dispatcher& dispatcher, task<T> work, std::promise<T> result)
+{
+    try {
+        co_await detached_schedule_operation{ dispatcher };
+        if constexpr (std::is_void_v<T>) {
+            co_await std::move(work);
+            result.set_value();
+        } else {
+            result.set_value(co_await std::move(work));
+        }
+    } catch (...) {
+        result.set_exception(std::current_exception());
+    }
+}
+} // namespace detail
+
+/**
+ * @brief Starts a task on the worker thread of a task queue.
+ *
+ * @tparam T The type of value produced by the task.
+ * @param dispatcher The dispatcher of the queue to start the task on.
+ * @param work The task to start.
+ * @return std::future<T> A future which receives the result of the task, or
+ * the exception which escaped it. If the queue has stopped, the future
+ * receives the exception thrown when posting to it. If the queue drops the
+ * task before starting it, eg. because it was stopped with
+ * pending_task_action::cancel, the future receives a std::future_error with
+ * std::future_errc::broken_promise.
+ */
+template <typename T>
+std::future<T>
+spawn(task_queue::dispatcher& dispatcher, task<T> work)
+{
+    std::promise<T> result{};
+    auto future = result.get_future();
+    detail::run_spawned(dispatcher, std::move(work), std::move(result));
+    return future;
+}
+
+/**
+ * @brief Awaitable which runs a blocking function on a thread pool, then
+ * resumes the awaiting coroutine on the task queue it was running on.
+ *
+ * @tparam FnT The type of function to run.
+ */
+template <typename FnT>
+class blocking_operation
+{
+public:
+    using result_type = std::invoke_result_t<FnT&>;
+
+    blocking_operation(FnT fn, thread_pool& pool) :
+        m_fn(std::move(fn)),
+        m_pool(pool)
+    {}
+
+    bool
+    await_ready() const noexcept
+    {
+        return false;
+    }
+
+    void
+    await_suspend(std::coroutine_handle<> awaiting)
+    {
+        m_resume_on = task_queue::current_dispatcher();
+        m_pool.post([this, awaiting] {
+            try {
+                if constexpr (std::is_void_v<result_type>) {
+                    std::invoke(m_fn);
+                } else {
+                    m_result.emplace(std::invoke(m_fn));
+                }
+            } catch (...) {
+                m_exception = std::current_exception();
+            }
+
+            resume(awaiting);
+        });
+    }
+
+    result_type
+    await_resume()
+    {
+        if (m_exception) {
+            std::rethrow_exception(m_exception);
+        }
+        if constexpr (!std::is_void_v<result_type>) {
+            return std::move(*m_result);
+        }
+    }
+
+private:
+    /**
+     * @brief Resumes the awaiting coroutine on the task queue it was
+     * suspended on. If that queue has stopped, or the coroutine wasn't
+     * running on a queue, it is resumed on the calling thread instead.
+     *
+     * @param awaiting The handle of the awaiting coroutine.
+     */
+    void
+    resume(std::coroutine_handle<> awaiting) noexcept
+    {
+        // The coroutine may destroy this object as soon as it resumes, so
+        // release the dispatcher first.
+        auto resume_on = std::move(m_resume_on);
+        if (resume_on) {
+            try {
+                resume_on->post_detached([awaiting] {
+                    awaiting.resume();
+                });
+                return;
+            } catch (...) {
+            }
+        }
+
+        awaiting.resume();
+    }
+
+private:
+    FnT m_fn;
+    thread_pool& m_pool;
+    std::shared_ptr<task_queue::dispatcher> m_resume_on{};
+    std::optional<std::conditional_t<std::is_void_v<result_type>, std::monostate, result_type>> m_result{};
+    std::exception_ptr m_exception{};
+};
+
+/**
+ * @brief Get an awaitable which runs a blocking function on a thread pool,
+ * so the awaiting coroutine doesn't block the thread it's running on. Once
+ * the function returns, the coroutine is resumed on the task queue it was
+ * running on, if any, otherwise on the thread pool.
+ *
+ * The pool should not be one which runs strands or other short tasks, since
+ * the function occupies a worker for as long as it blocks. Use
+ * thread_pool::get_blocking() unless a dedicated pool is needed.
+ *
+ * @tparam FnT The type of function to run.
+ * @param fn The function to run. The result of the co_await expression is the
+ * value it returns, or the exception it throws.
+ * @param pool The thread pool to run the function on.
+ * @return blocking_operation<FnT>
+ */
+template <typename FnT>
+blocking_operation<FnT>
+run_blocking(FnT fn, thread_pool& pool)
+{
+    return blocking_operation<FnT>(std::move(fn), pool);
+}
+
+} // namespace notstd
+
+#endif // NOTSTD_TASK_HXX
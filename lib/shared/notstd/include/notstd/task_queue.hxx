@@ -2,31 +2,200 @@
 #ifndef TASK_QUEUE_HXX
 #define TASK_QUEUE_HXX
 
+#include <array>
+#include <atomic>
+#include <chrono>
 #include <condition_variable>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
 #include <functional>
 #include <future>
+#include <limits>
 #include <memory>
 #include <mutex>
+#include <notstd/histogram.hxx>
+#include <notstd/inline_task.hxx>
 #include <notstd/memory.hxx>
+#include <notstd/mpsc_ring.hxx>
+#include <notstd/timer_wheel.hxx>
 #include <queue>
 #include <stdexcept>
 #include <thread>
+#include <vector>
 #include <version>
 
 namespace notstd
 {
 /**
  * @brief A thread-safe, serialized task queue supporting cancelation.
+ *
+ * Tasks are posted to one of several priority lanes. Tasks in the same lane
+ * run in first-in-first-out (FIFO) order, and the worker thread always runs
+ * the tasks of a higher priority lane before those of a lower priority one.
  */
 class task_queue
 {
 public:
+    using clock = timer_wheel::clock;
+    using timer_id = timer_wheel::timer_id;
+
+    /**
+     * @brief The priority lane a task is posted to, from highest to lowest
+     * priority.
+     */
+    enum class task_priority {
+        /**
+         * @brief Tasks that control the operation of the queue's owner, such
+         * as error and teardown notifications.
+         */
+        control,
+        /**
+         * @brief Tasks that report or change state. This is the default.
+         */
+        state,
+        /**
+         * @brief Tasks that deliver high volume data, such as measurements.
+         */
+        data,
+    };
+
+    /**
+     * @brief The number of priority lanes.
+     */
+    static constexpr std::size_t task_priority_count = 3;
+
+    /**
+     * @brief The deadline of a task that should run regardless of how long it
+     * waits in the queue.
+     */
+    static constexpr clock::time_point no_deadline = clock::time_point::max();
+
+    /**
+     * @brief The capacity of a queue that accepts any number of pending tasks.
+     */
+    static constexpr std::size_t capacity_unbounded = std::numeric_limits<std::size_t>::max();
+
+    /**
+     * @brief The action taken when a task is posted to a bounded queue that
+     * is full.
+     */
+    enum class overflow_policy {
+        /**
+         * @brief Wait until the worker thread frees space for the task. Tasks
+         * posted from the worker thread itself are accepted regardless, since
+         * waiting would deadlock.
+         */
+        block,
+        /**
+         * @brief Reject the task. post() and post_detached() throw a
+         * full_exception, and try_post_detached() returns post_status::full.
+         */
+        fail,
+        /**
+         * @brief Drop the oldest pending task of the lowest priority lane, no
+         * higher than that of the task, to make space for it. If there's no
+         * such task, the task being posted is dropped instead.
+         */
+        drop_oldest,
+        /**
+         * @brief Drop the task being posted.
+         */
+        drop_newest,
+    };
+
+    /**
+     * @brief The result of posting a task.
+     */
+    enum class post_status {
+        /**
+         * @brief The task was queued.
+         */
+        posted,
+        /**
+         * @brief The task was dropped because the queue is full.
+         */
+        dropped,
+        /**
+         * @brief The task was rejected because the queue is full.
+         */
+        full,
+        /**
+         * @brief The task was rejected because the queue is stopping.
+         */
+        stopped,
+    };
+
+    /**
+     * @brief The watermark crossed by the number of pending tasks.
+     */
+    enum class watermark {
+        high,
+        low,
+    };
+
+    /**
+     * @brief Function invoked when the number of pending tasks reaches the
+     * high watermark, or subsequently falls to the low watermark.
+     */
+    using watermark_callback = std::function<void(watermark)>;
+
+    /**
+     * @brief Whether statistics are collected. They are only collected when
+     * notstd is built with NOTSTD_TASK_QUEUE_STATS defined, so that queues
+     * pay nothing for them otherwise.
+     */
+#ifdef NOTSTD_TASK_QUEUE_STATS
+    static constexpr bool stats_enabled = true;
+#else
+    static constexpr bool stats_enabled = false;
+#endif
+
+    /**
+     * @brief A snapshot of the statistics of the tasks posted to the priority
+     * lanes of a queue. Tasks run by timers are not included.
+     */
+    struct statistics
+    {
+        /**
+         * @brief The number of pending tasks.
+         */
+        std::size_t depth{ 0 };
+        /**
+         * @brief The largest number of pending tasks there has been.
+         */
+        std::size_t depth_high_water{ 0 };
+        /**
+         * @brief The number of tasks that were posted.
+         */
+        std::uint64_t tasks_posted{ 0 };
+        /**
+         * @brief The number of tasks that were run.
+         */
+        std::uint64_t tasks_run{ 0 };
+        /**
+         * @brief The number of tasks that were removed without being run,
+         * because their deadline passed, they were dropped by the overflow
+         * policy, or the queue was stopped with pending_task_action::cancel.
+         */
+        std::uint64_t tasks_canceled{ 0 };
+        /**
+         * @brief The time tasks waited between being posted and starting to
+         * run, in nanoseconds.
+         */
+        histogram::snapshot wait_time{};
+        /**
+         * @brief The time tasks took to run, in nanoseconds.
+         */
+        histogram::snapshot run_time{};
+    };
+
     /**
      * @brief Class which handles the details of dispatching tasks to a
      * task_queue.
      * 
      * This default implementation submits tasks to the attached queue in
-     * first-in-first-out (FIFO) order.
+     * first-in-first-out (FIFO) order within each priority lane.
      */
     class dispatcher
     {
@@ -36,18 +205,162 @@ public:
         friend class task_queue;
 
     public:
+        /**
+         * @brief Awaitable which suspends the awaiting coroutine and resumes
+         * it from a task on the queue.
+         */
+        class schedule_operation
+        {
+            /**
+             * @brief Allow the dispatcher to access the private constructor.
+             */
+            friend class dispatcher;
+
+        public:
+            bool
+            await_ready() const noexcept
+            {
+                return false;
+            }
+
+            /**
+             * @brief Posts a task which resumes the awaiting coroutine. If the
+             * queue has stopped, the exception thrown by posting is raised
+             * from the co_await expression instead.
+             *
+             * @param awaiting The handle of the awaiting coroutine.
+             */
+            void
+            await_suspend(std::coroutine_handle<> awaiting);
+
+            void
+            await_resume() const noexcept
+            {}
+
+        private:
+            schedule_operation(dispatcher& dispatcher, task_priority priority) noexcept;
+
+        private:
+            dispatcher& m_dispatcher;
+            const task_priority m_priority;
+        };
+
+        /**
+         * @brief Get an awaitable which resumes the awaiting coroutine on the
+         * worker thread of the queue, eg. 'co_await dispatcher->schedule();'.
+         *
+         * The same guarantees as post_detached() apply to the task resuming
+         * the coroutine. If that task is dropped because the queue is being
+         * destroyed, the coroutine is never resumed.
+         *
+         * @param priority The priority lane to resume the coroutine from.
+         * @return schedule_operation
+         */
+        schedule_operation
+        schedule(task_priority priority = task_priority::state) noexcept;
+
         /**
          * @brief Posts a task onto the queue.
          *
          * If the queue is being destroyed and this function is called there is
          * NO guarantee that the requested task will be ran. However, if this
          * function returns before the queue has been requested to be destroyed
-         * then the requested task will run.
-         *        
+         * then the requested task will run, unless it has a deadline.
+         *
+         * A task whose deadline has passed by the time the worker thread gets
+         * to it is dropped without being run, and its future reports a
+         * std::future_errc::broken_promise error. The same applies to a task
+         * dropped by the overflow policy of a bounded queue.
+         *
          * @param runnable The runnable task to be posted onto the queue.
+         * @param priority The priority lane to post the task to.
+         * @param deadline The time after which the task is stale and should be
+         * dropped instead of run.
          */
         std::future<void>
-        post(std::function<void()> runnable);
+        post(std::function<void()> runnable, task_priority priority = task_priority::state, clock::time_point deadline = no_deadline);
+
+        /**
+         * @brief Posts a task onto the queue without tracking its completion.
+         *
+         * Unlike post(), this doesn't wrap the task in a std::packaged_task or
+         * create a std::future. Callables that fit within
+         * inline_task::inline_capacity, including move-only ones, are stored
+         * without any heap allocation. Any exception thrown by the task is
+         * discarded.
+         *
+         * The same guarantees as post() apply regarding whether the task will
+         * run if the queue is being destroyed or its deadline has passed.
+         *
+         * @param runnable The runnable task to be posted onto the queue.
+         * @param priority The priority lane to post the task to.
+         * @param deadline The time after which the task is stale and should be
+         * dropped instead of run.
+         */
+        void
+        post_detached(inline_task runnable, task_priority priority = task_priority::state, clock::time_point deadline = no_deadline);
+
+        /**
+         * @brief Posts a task onto the queue without tracking its completion,
+         * reporting whether it was queued instead of throwing.
+         *
+         * This behaves like post_detached(), except that the task being
+         * rejected, either because the queue is stopping or by the overflow
+         * policy of a bounded queue, is reported by the returned status. An
+         * overflow_policy::block queue still waits for space.
+         *
+         * @param runnable The runnable task to be posted onto the queue.
+         * @param priority The priority lane to post the task to.
+         * @param deadline The time after which the task is stale and should be
+         * dropped instead of run.
+         * @return post_status
+         */
+        post_status
+        try_post_detached(inline_task runnable, task_priority priority = task_priority::state, clock::time_point deadline = no_deadline);
+
+        /**
+         * @brief Posts a task onto the queue once the specified delay has
+         * elapsed. Any exception thrown by the task is discarded.
+         *
+         * Timers are serviced by the worker thread of the queue, and expire
+         * with a resolution of timer_wheel::tick_duration. Timers that haven't
+         * expired when the queue stops are discarded.
+         *
+         * @param delay The time to wait before running the task.
+         * @param runnable The runnable task to be posted onto the queue.
+         * @return timer_id The identifier of the timer, which can be used to
+         * cancel it.
+         */
+        timer_id
+        post_after(clock::duration delay, inline_task runnable);
+
+        /**
+         * @brief Posts a task onto the queue each time the specified period
+         * elapses, starting one period from now, until the timer is canceled
+         * or the queue stops. Any exception thrown by the task is discarded.
+         *
+         * @param period The time between successive runs of the task. This
+         * must be positive.
+         * @param runnable The runnable task to be posted onto the queue.
+         * @return timer_id The identifier of the timer, which can be used to
+         * cancel it.
+         */
+        timer_id
+        post_every(clock::duration period, inline_task runnable);
+
+        /**
+         * @brief Cancels a timer created with post_after() or post_every().
+         *
+         * Once this returns, the task of the timer will not be run again,
+         * unless it is called from a task of the queue while the timer's task
+         * has already expired and is waiting to be run.
+         *
+         * @param id The identifier of the timer to cancel.
+         * @return true If the timer was canceled.
+         * @return false If the timer already expired or was canceled.
+         */
+        bool
+        cancel(timer_id id) noexcept;
 
     protected:
         /**
@@ -68,12 +381,71 @@ public:
     struct creation_exception : public std::exception
     {};
 
+    /**
+     * @brief Signifies that a task was rejected because the queue is full.
+     */
+    struct full_exception : public std::exception
+    {};
+
+    /**
+     * @brief The data structure used to hold pending tasks.
+     */
+    enum class queue_backend {
+        /**
+         * @brief An unbounded queue synchronized with a mutex, with the worker
+         * thread woken using a condition variable.
+         */
+        locked,
+        /**
+         * @brief A bounded, lock-free ring per priority lane, with the worker
+         * thread woken using an atomic wait (futex). Posting never takes a
+         * lock. If the ring is full, posting waits until the worker frees a
+         * slot, except when posting from a task running on the queue itself,
+         * in which case the task is held in an overflow queue until the ring
+         * has been drained.
+         */
+        lock_free,
+    };
+
+    /**
+     * @brief The default number of pending tasks the lock-free backend can hold.
+     */
+    static constexpr std::size_t lock_free_capacity_default = 1024;
+
     /**
      * @brief Constructs the task queue and starts the worker thread. 
      * Throws a creation_exception if the thread couldn't be started.
      */
     task_queue();
 
+    /**
+     * @brief Constructs the task queue with the specified backend and starts
+     * the worker thread. Throws a creation_exception if the thread couldn't be
+     * started.
+     *
+     * @param backend The data structure to hold pending tasks in.
+     * @param capacity The number of pending tasks each lane of the lock-free
+     * backend can hold. This is ignored by the locked backend.
+     */
+    explicit task_queue(queue_backend backend, std::size_t capacity = lock_free_capacity_default);
+
+    /**
+     * @brief Constructs a bounded task queue with the locked backend and
+     * starts the worker thread. Throws a creation_exception if the thread
+     * couldn't be started.
+     *
+     * The number of pending tasks across all priority lanes, including those
+     * the worker thread has taken but not yet run, is limited to the
+     * specified capacity. Tasks posted once it has been reached are handled
+     * according to the overflow policy.
+     *
+     * @param capacity The maximum number of pending tasks. This must be
+     * positive.
+     * @param policy The action taken when a task is posted while the queue is
+     * full.
+     */
+    task_queue(std::size_t capacity, overflow_policy policy);
+
     /**
      * @brief Destroy the Task Queue object.
      */
@@ -122,13 +494,169 @@ public:
     std::shared_ptr<dispatcher>
     get_dispatcher() const noexcept;
 
+    /**
+     * @brief Get the dispatcher of the queue whose worker thread is calling
+     * this function.
+     *
+     * @return std::shared_ptr<dispatcher> The dispatcher, or nullptr if not
+     * called from a task running on a queue.
+     */
+    static std::shared_ptr<dispatcher>
+    current_dispatcher() noexcept;
+
+    /**
+     * @brief Get the number of tasks waiting to be run in a priority lane.
+     * This is a snapshot which may be stale by the time it is returned.
+     *
+     * @param priority The priority lane.
+     * @return std::size_t
+     */
+    std::size_t
+    queue_depth(task_priority priority) const noexcept;
+
+    /**
+     * @brief Get the number of tasks in a priority lane that were dropped
+     * without being run because their deadline had passed.
+     *
+     * @param priority The priority lane.
+     * @return std::size_t
+     */
+    std::size_t
+    tasks_expired(task_priority priority) const noexcept;
+
+    /**
+     * @brief Get the number of tasks in a priority lane that were dropped
+     * by the overflow policy of a bounded queue.
+     *
+     * @param priority The priority lane.
+     * @return std::size_t
+     */
+    std::size_t
+    tasks_dropped(task_priority priority) const noexcept;
+
+    /**
+     * @brief Set the watermarks of the number of pending tasks across all
+     * priority lanes, allowing producers to be throttled at their source.
+     *
+     * The callback is invoked with watermark::high when the number of pending
+     * tasks reaches the high watermark, and with watermark::low when it
+     * subsequently falls to the low watermark. Invocations alternate, and are
+     * serialized, but may happen on either the posting thread or the worker
+     * thread, so the callback must not block.
+     *
+     * @param high The high watermark. This must be positive.
+     * @param low The low watermark. This must be less than the high watermark.
+     * @param callback The function to invoke when a watermark is crossed.
+     */
+    void
+    set_watermarks(std::size_t high, std::size_t low, watermark_callback callback);
+
+    /**
+     * @brief Get a snapshot of the statistics of the queue. Collecting them
+     * doesn't take any locks, so counters may be updated while the snapshot
+     * is taken.
+     *
+     * @return statistics The statistics, which are all zero unless
+     * stats_enabled is true.
+     */
+    statistics
+    stats() const noexcept;
+
 private:
+    /**
+     * @brief Constructs the task queue and starts the worker thread.
+     *
+     * @param backend The data structure to hold pending tasks in.
+     * @param ring_capacity The number of pending tasks each lane of the
+     * lock-free backend can hold.
+     * @param capacity The maximum number of pending tasks of the locked
+     * backend.
+     * @param policy The action taken when a task is posted while the queue is
+     * full.
+     */
+    task_queue(queue_backend backend, std::size_t ring_capacity, std::size_t capacity, overflow_policy policy);
+
+    /**
+     * @brief A task waiting in one of the priority lanes.
+     */
+    struct queued_task
+    {
+        inline_task task;
+        clock::time_point deadline{ no_deadline };
+#ifdef NOTSTD_TASK_QUEUE_STATS
+        clock::time_point posted{};
+#endif
+    };
+
+    /**
+     * @brief Runs a task popped from a priority lane, or drops it if its
+     * deadline has passed. This must only be called from the worker thread.
+     *
+     * @param task The task to run.
+     * @param lane The index of the lane the task was popped from.
+     */
+    void
+    run_queued_task(queued_task& task, std::size_t lane) noexcept;
+
     /**
      * @brief Handler function run by the queue processing thread.
      */
     void
     process_queue();
 
+    /**
+     * @brief Handler function run by the queue processing thread for the
+     * locked backend.
+     */
+    void
+    process_queue_locked();
+
+    /**
+     * @brief Handler function run by the queue processing thread for the
+     * lock-free backend.
+     */
+    void
+    process_queue_lock_free();
+
+    /**
+     * @brief Pushes a task onto the back of a lane's lock-free ring, waking
+     * the worker thread if it is waiting.
+     *
+     * @param task The task to push.
+     * @param lane The index of the lane to push the task to.
+     * @return post_status
+     */
+    post_status
+    post_lock_free(queued_task task, std::size_t lane);
+
+    /**
+     * @brief Determines if the lanes of the lock-free backend are all empty.
+     * This must only be called from the worker thread.
+     *
+     * @return true
+     * @return false
+     */
+    bool
+    is_lock_free_empty() const noexcept;
+
+    /**
+     * @brief Wakes the worker thread of the lock-free backend if it is
+     * waiting.
+     */
+    void
+    wake_lock_free_worker() noexcept;
+
+    /**
+     * @brief Collects and runs the tasks of all expired timers. This must
+     * only be called from the worker thread.
+     *
+     * @param expired A container to hold the expired tasks while they run.
+     * @return std::optional<clock::time_point> The next time the timers must
+     * be serviced, if any timers are scheduled.
+     */
+    std::optional<clock::time_point>
+    run_expired_timers(std::vector<inline_task>& expired);
+
     /**
      * @brief Indicates whether the queue processing thread should exit.
      * 
@@ -159,10 +687,84 @@ private:
      * onto the back of the queue.
      * 
      * @param runnable
+     * @param priority
+     * @param deadline
      * @return std::future<void> 
      */
     std::future<void>
-    post(std::function<void()> runnable);
+    post(std::function<void()> runnable, task_priority priority, clock::time_point deadline);
+
+    /**
+     * @brief The dispatcher calls this function to post a task onto the back
+     * of the queue without tracking its completion.
+     * 
+     * @param runnable 
+     * @param priority
+     * @param deadline
+     */
+    void
+    post_detached(inline_task runnable, task_priority priority, clock::time_point deadline);
+
+    /**
+     * @brief The dispatcher calls this function to post a task onto the back
+     * of the queue, reporting whether it was queued.
+     *
+     * @param runnable
+     * @param priority
+     * @param deadline
+     * @return post_status
+     */
+    post_status
+    try_post_detached(inline_task runnable, task_priority priority, clock::time_point deadline);
+
+    /**
+     * @brief Pushes a task onto the back of a lane of the locked backend,
+     * applying the overflow policy if the queue is bounded.
+     *
+     * @param task The task to push.
+     * @param lane The index of the lane to push the task to.
+     * @return post_status
+     */
+    post_status
+    post_locked(queued_task task, std::size_t lane);
+
+    /**
+     * @brief Get the number of pending tasks across all priority lanes.
+     *
+     * @return std::size_t
+     */
+    std::size_t
+    pending_count() const noexcept;
+
+    /**
+     * @brief Invokes the watermark callback if the number of pending tasks
+     * has crossed a watermark since it was last invoked. Any exception thrown
+     * by the callback is discarded.
+     */
+    void
+    update_watermark() noexcept;
+
+    /**
+     * @brief The dispatcher calls this function to schedule a task to be run
+     * once or periodically.
+     *
+     * @param delay The time to wait before running the task.
+     * @param period The time between successive runs, or zero to run once.
+     * @param runnable
+     * @return timer_id
+     */
+    timer_id
+    post_timer(clock::duration delay, clock::duration period, inline_task runnable);
+
+    /**
+     * @brief The dispatcher calls this function to cancel a timer.
+     *
+     * @param id
+     * @return true
+     * @return false
+     */
+    bool
+    cancel_timer(timer_id id) noexcept;
 
     /**
      * @brief Helper to track state of the queue.
@@ -177,12 +779,61 @@ private:
 private:
     std::thread m_thread;
     std::shared_ptr<dispatcher> m_dispatcher;
+    const queue_backend m_backend;
 
     std::mutex m_runnables_changed_gate;
     // Access to the below variables must be synchronized with m_runnables_changed_gate.
-    std::queue<std::packaged_task<void()>> m_runnables;
+    std::array<std::vector<queued_task>, task_priority_count> m_runnables;
+    // The number of tasks at the front of each lane that were dropped by the
+    // overflow_policy::drop_oldest policy. The worker skips them.
+    std::array<std::size_t, task_priority_count> m_runnables_head{};
     std::condition_variable m_runnables_changed;
-    state m_state{ state::stopped };
+    // Modifications to the state must be synchronized with m_runnables_changed_gate.
+    std::atomic<state> m_state{ state::stopped };
+    timer_wheel m_timers{};
+
+    // Incremented when a task is posted, and decremented by the worker thread
+    // when it is popped.
+    std::array<std::atomic<std::size_t>, task_priority_count> m_runnables_depth{};
+    // Only modified by the worker thread.
+    std::array<std::atomic<std::size_t>, task_priority_count> m_runnables_expired{};
+    std::array<std::atomic<std::size_t>, task_priority_count> m_runnables_dropped{};
+
+    // Used by bounded queues only, which use the locked backend.
+    const std::size_t m_capacity{ capacity_unbounded };
+    const overflow_policy m_overflow_policy{ overflow_policy::block };
+    // Notified by the worker thread when it frees space while producers wait.
+    std::condition_variable m_runnables_space;
+    std::atomic<std::size_t> m_producers_waiting{ 0 };
+
+    // Recursive since the watermark callback may post to the queue itself.
+    std::recursive_mutex m_watermark_gate;
+    // Access to the below variables must be synchronized with m_watermark_gate.
+    watermark_callback m_watermark_callback;
+    // Modifications to the below variables must be synchronized with
+    // m_watermark_gate. They are read without it to avoid taking the lock
+    // unless a watermark may have been crossed.
+    std::atomic<std::size_t> m_watermark_high{ capacity_unbounded };
+    std::atomic<std::size_t> m_watermark_low{ 0 };
+    std::atomic<bool> m_watermark_reached{ false };
+
+#ifdef NOTSTD_TASK_QUEUE_STATS
+    std::atomic<std::size_t> m_stats_depth_high_water{ 0 };
+    std::atomic<std::uint64_t> m_stats_tasks_posted{ 0 };
+    std::atomic<std::uint64_t> m_stats_tasks_canceled{ 0 };
+    // Only recorded by the worker thread.
+    histogram m_stats_wait_time;
+    histogram m_stats_run_time;
+#endif
+
+    // Used by the lock-free backend only.
+    std::array<std::unique_ptr<mpsc_ring<queued_task>>, task_priority_count> m_runnables_rings;
+    // Only accessed from the worker thread.
+    std::array<std::queue<queued_task>, task_priority_count> m_runnables_overflow;
+    std::atomic<uint32_t> m_runnables_signal{ 0 };
+    std::atomic<bool> m_worker_waiting{ false };
+    // Set while the worker waits for a timer to expire, on m_runnables_changed.
+    std::atomic<bool> m_worker_waiting_timed{ false };
 };
 
 } // namespace notstd
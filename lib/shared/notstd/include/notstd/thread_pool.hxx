@@ -0,0 +1,153 @@
+
+#ifndef NOTSTD_THREAD_POOL_HXX
+#define NOTSTD_THREAD_POOL_HXX
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <notstd/inline_task.hxx>
+
+namespace notstd
+{
+/**
+ * @brief A fixed-size pool of worker threads which share work by stealing.
+ *
+ * Each worker has its own queue of tasks. Tasks posted from a worker thread
+ * are pushed onto that worker's queue, and tasks posted from other threads are
+ * distributed across the workers' queues in round-robin order. A worker whose
+ * queue is empty steals tasks from the other workers before going to sleep, so
+ * no worker sits idle while work is pending. Tasks are not ordered with
+ * respect to each other; use a strand to run a sequence of tasks serially.
+ */
+class thread_pool
+{
+public:
+    /**
+     * @brief Signifies that the worker threads could not be started.
+     */
+    struct creation_exception : public std::exception
+    {};
+
+    /**
+     * @brief Constructs the pool and starts the worker threads. Throws a
+     * creation_exception if the threads couldn't be started.
+     *
+     * @param num_threads The number of worker threads. If zero, one thread per
+     * hardware thread is used.
+     */
+    explicit thread_pool(std::size_t num_threads = 0);
+
+    /**
+     * @brief Runs all pending tasks, then stops the worker threads.
+     */
+    ~thread_pool();
+
+    thread_pool(const thread_pool&) = delete;
+    thread_pool(thread_pool&&) = delete;
+    thread_pool&
+    operator=(const thread_pool&) = delete;
+    thread_pool&
+    operator=(thread_pool&&) = delete;
+
+    /**
+     * @brief Get the process-wide pool, sized to the number of hardware
+     * threads. This is created on first use.
+     *
+     * @return thread_pool&
+     */
+    static thread_pool&
+    get_default();
+
+    /**
+     * @brief Get the process-wide pool for functions which block, such as
+     * device I/O. This is separate from the default pool so that blocked
+     * functions never occupy the workers running strands. It has at least
+     * blocking_pool_size_minimum threads, and is created on first use.
+     *
+     * @return thread_pool&
+     */
+    static thread_pool&
+    get_blocking();
+
+    /**
+     * @brief The minimum number of worker threads of the blocking pool.
+     */
+    static constexpr std::size_t blocking_pool_size_minimum = 4;
+
+    /**
+     * @brief Get the number of worker threads.
+     *
+     * @return std::size_t
+     */
+    std::size_t
+    size() const noexcept;
+
+    /**
+     * @brief Determines if the calling thread is one of the worker threads of
+     * this pool.
+     *
+     * @return true
+     * @return false
+     */
+    bool
+    running_in_this_thread() const noexcept;
+
+    /**
+     * @brief Posts a task to be run on one of the worker threads. Any
+     * exception thrown by the task is discarded.
+     *
+     * @param task The task to run.
+     */
+    void
+    post(inline_task task);
+
+private:
+    /**
+     * @brief The queue of tasks owned by a single worker thread.
+     */
+    struct worker
+    {
+        std::mutex tasks_gate;
+        // Access to the below variables must be synchronized with tasks_gate.
+        std::deque<inline_task> tasks;
+    };
+
+    /**
+     * @brief Handler function run by each worker thread.
+     *
+     * @param index The index of the worker.
+     */
+    void
+    process_tasks(std::size_t index);
+
+    /**
+     * @brief Pops the next task to run, first from the specified worker's own
+     * queue, then from the queues of the other workers.
+     *
+     * @param index The index of the worker.
+     * @param task The task that was popped, if any.
+     * @return true If a task was popped.
+     * @return false If all queues were empty.
+     */
+    bool
+    try_pop(std::size_t index, inline_task& task);
+
+private:
+    std::vector<std::unique_ptr<worker>> m_workers;
+    std::vector<std::thread> m_threads;
+    std::atomic<std::size_t> m_worker_next{ 0 };
+    std::atomic<std::size_t> m_tasks_pending{ 0 };
+    std::atomic<std::size_t> m_workers_waiting{ 0 };
+    std::atomic<uint32_t> m_tasks_signal{ 0 };
+    std::atomic<bool> m_stopping{ false };
+};
+
+} // namespace notstd
+
+#endif // NOTSTD_THREAD_POOL_HXX
@@ -0,0 +1,258 @@
+
+#ifndef NOTSTD_TIMER_WHEEL_HXX
+#define NOTSTD_TIMER_WHEEL_HXX
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include <notstd/inline_task.hxx>
+
+namespace notstd
+{
+/**
+ * @brief A hierarchical timer wheel, holding tasks to be run at a later time.
+ *
+ * Time is divided into ticks of tick_duration. The wheel has num_levels levels
+ * of slots_per_level slots each; a slot in level 0 holds the timers expiring
+ * in a single tick, and a slot in each higher level spans all the slots of the
+ * level below it. A timer is placed in the lowest level whose range covers its
+ * expiry, and is moved ("cascaded") down a level each time the wheel reaches
+ * the slot holding it. Each slot is an intrusive list, so scheduling and
+ * canceling a timer are O(1), and advancing the wheel only touches slots that
+ * hold timers.
+ *
+ * This class is not thread-safe; callers must synchronize access to it.
+ */
+class timer_wheel
+{
+public:
+    using clock = std::chrono::steady_clock;
+    using tick_duration = std::chrono::milliseconds;
+
+    /**
+     * @brief Identifies a scheduled timer. Identifiers include a generation
+     * count, so an identifier of an expired or canceled timer does not refer
+     * to a timer scheduled later in its place.
+     */
+    using timer_id = std::uint64_t;
+
+    /**
+     * @brief An identifier which never refers to a timer.
+     */
+    static constexpr timer_id invalid_timer_id = 0;
+
+    static constexpr std::size_t slot_bits = 8;
+    static constexpr std::size_t slots_per_level = std::size_t{ 1 } << slot_bits;
+    static constexpr std::size_t num_levels = 4;
+
+    /**
+     * @brief Construct a new timer_wheel object.
+     *
+     * @param start The time corresponding to the first tick of the wheel.
+     */
+    explicit timer_wheel(clock::time_point start = clock::now());
+
+    /**
+     * @brief Schedules a task to be run once the specified time has passed.
+     *
+     * @param expiry The time after which the task should run.
+     * @param task The task to run.
+     * @return timer_id The identifier of the new timer.
+     */
+    timer_id
+    schedule(clock::time_point expiry, inline_task task);
+
+    /**
+     * @brief Schedules a task to be run repeatedly, each time the specified
+     * period elapses. If the wheel isn't advanced for longer than the period,
+     * the missed runs are skipped.
+     *
+     * @param expiry The time after which the task should first run.
+     * @param period The time between successive runs. This is rounded up to
+     * a whole number of ticks.
+     * @param task The task to run.
+     * @return timer_id The identifier of the new timer.
+     */
+    timer_id
+    schedule_periodic(clock::time_point expiry, clock::duration period, inline_task task);
+
+    /**
+     * @brief Cancels a scheduled timer.
+     *
+     * @param id The identifier of the timer to cancel.
+     * @return true If the timer was canceled before it expired.
+     * @return false If the timer already expired or was canceled.
+     */
+    bool
+    cancel(timer_id id) noexcept;
+
+    /**
+     * @brief Get the number of scheduled timers.
+     *
+     * @return std::size_t
+     */
+    std::size_t
+    size() const noexcept;
+
+    /**
+     * @brief Determines if there are no scheduled timers.
+     *
+     * @return true
+     * @return false
+     */
+    bool
+    empty() const noexcept;
+
+    /**
+     * @brief Get the next time the wheel must be advanced. This is no later
+     * than the earliest expiry of the scheduled timers, but may be earlier
+     * when a timer needs to be cascaded to a lower level first.
+     *
+     * @return std::optional<clock::time_point> The time, or std::nullopt if
+     * there are no scheduled timers.
+     */
+    std::optional<clock::time_point>
+    next_expiry() const noexcept;
+
+    /**
+     * @brief Advances the wheel to the specified time, collecting the tasks
+     * of all timers that expired, in order of expiry. Periodic timers are
+     * rescheduled, and a task sharing their callable is collected each time
+     * they expire.
+     *
+     * @param now The current time.
+     * @param expired The container to append the expired tasks to.
+     */
+    void
+    advance(clock::time_point now, std::vector<inline_task>& expired);
+
+private:
+    /**
+     * @brief Index denoting the absence of a timer in the intrusive lists.
+     */
+    static constexpr std::uint32_t npos = std::numeric_limits<std::uint32_t>::max();
+
+    /**
+     * @brief A scheduled timer.
+     */
+    struct timer
+    {
+        inline_task task;
+        // Held for periodic timers only, since the callable is shared by the
+        // task collected each time the timer expires.
+        std::shared_ptr<inline_task> task_periodic;
+        std::uint64_t expiry{ 0 };
+        std::uint64_t period{ 0 };
+        std::uint32_t generation{ 1 };
+        std::uint32_t slot{ npos };
+        std::uint32_t previous{ npos };
+        std::uint32_t next{ npos };
+    };
+
+    /**
+     * @brief The list of timers in a single slot.
+     */
+    struct slot
+    {
+        std::uint32_t head{ npos };
+        std::uint32_t tail{ npos };
+    };
+
+    /**
+     * @brief Bitmap of the slots in a level which hold timers.
+     */
+    using slot_bitmap = std::array<std::uint64_t, slots_per_level / 64>;
+
+    /**
+     * @brief Allocates a timer, and links it into the wheel.
+     *
+     * @param expiry The tick at which the timer expires.
+     * @param task The task to run, for a timer that runs once.
+     * @param task_periodic The task to run, for a periodic timer.
+     * @param period The period of a periodic timer in ticks, or zero.
+     * @return timer_id
+     */
+    timer_id
+    allocate(std::uint64_t expiry, inline_task task, std::shared_ptr<inline_task> task_periodic, std::uint64_t period);
+
+    /**
+     * @brief Releases a timer which is no longer linked into the wheel.
+     *
+     * @param index The index of the timer.
+     */
+    void
+    release(std::uint32_t index) noexcept;
+
+    /**
+     * @brief Links a timer into the slot corresponding to its expiry.
+     *
+     * @param index The index of the timer.
+     */
+    void
+    link(std::uint32_t index) noexcept;
+
+    /**
+     * @brief Unlinks a timer from the slot holding it.
+     *
+     * @param index The index of the timer.
+     */
+    void
+    unlink(std::uint32_t index) noexcept;
+
+    /**
+     * @brief Unlinks all timers from a slot.
+     *
+     * @param slot_index The global index of the slot.
+     * @return std::uint32_t The index of the first timer in the slot.
+     */
+    std::uint32_t
+    detach(std::uint32_t slot_index) noexcept;
+
+    /**
+     * @brief Collects the task of an expired timer, and either releases or
+     * reschedules it.
+     *
+     * @param index The index of the timer.
+     * @param target The tick the wheel is being advanced to.
+     * @param expired The container to append the expired task to.
+     */
+    void
+    expire(std::uint32_t index, std::uint64_t target, std::vector<inline_task>& expired);
+
+    /**
+     * @brief Get the next tick at which a timer either expires or must be
+     * cascaded to a lower level.
+     *
+     * @return std::optional<std::uint64_t>
+     */
+    std::optional<std::uint64_t>
+    next_tick() const noexcept;
+
+    /**
+     * @brief Converts a time to a tick, rounding up.
+     *
+     * @param time The time to convert.
+     * @return std::uint64_t
+     */
+    std::uint64_t
+    to_tick(clock::time_point time) const noexcept;
+
+private:
+    const clock::time_point m_start;
+    std::uint64_t m_now{ 0 };
+    std::size_t m_size{ 0 };
+    std::vector<timer> m_timers;
+    std::vector<std::uint32_t> m_timers_free;
+    std::array<slot, num_levels * slots_per_level> m_slots{};
+    std::array<slot_bitmap, num_levels> m_slots_occupied{};
+};
+
+} // namespace notstd
+
+#endif // NOTSTD_TIMER_WHEEL_HXX
@@ -0,0 +1,146 @@
+
+#include <stdexcept>
+#include <utility>
+
+#include <notstd/strand.hxx>
+
+using namespace notstd;
+
+namespace
+{
+/**
+ * @brief The strand whose tasks are running on the current thread, if any.
+ */
+thread_local const strand* current_strand = nullptr;
+} // namespace
+
+strand::strand(thread_pool& pool) :
+    m_pool(pool)
+{}
+
+strand::~strand()
+{
+    try {
+        stop_and_wait_for_task_completion();
+    } catch (...) {
+    }
+}
+
+std::future<void>
+strand::post(std::function<void()> runnable)
+{
+    auto task = std::packaged_task<void()>(std::move(runnable));
+    auto future = task.get_future();
+    post_detached(std::move(task));
+    return future;
+}
+
+void
+strand::post_detached(inline_task runnable)
+{
+    bool schedule = false;
+
+    {
+        std::scoped_lock tasks_lock{ m_tasks_gate };
+        if (m_state != state::running) {
+            throw std::runtime_error("attempt to post to strand in stopping state, this is a bug!");
+        }
+
+        m_tasks.push_back(std::move(runnable));
+        schedule = !std::exchange(m_scheduled, true);
+    }
+
+    // Only one instance of process_tasks() is scheduled on the pool at a time,
+    // which guarantees that tasks run serially.
+    if (schedule) {
+        m_pool.post([this] {
+            process_tasks();
+        });
+    }
+}
+
+void
+strand::stop(pending_task_action pending_action) noexcept
+{
+    std::scoped_lock tasks_lock{ m_tasks_gate };
+
+    switch (pending_action) {
+    case pending_task_action::cancel:
+        m_state = state::canceling;
+        // If the tasks are being run, they'll be canceled once the current
+        // one completes.
+        if (!m_scheduled) {
+            m_tasks.clear();
+        }
+        break;
+    default:
+        // Don't downgrade a pending cancelation.
+        if (m_state != state::canceling) {
+            m_state = state::stopping;
+        }
+        break;
+    }
+}
+
+void
+strand::stop_and_wait_for_task_completion()
+{
+    stop();
+
+    // Waiting from one of the strand's own tasks would deadlock.
+    if (running_in_this_thread()) {
+        return;
+    }
+
+    std::unique_lock tasks_lock{ m_tasks_gate };
+    m_idle.wait(tasks_lock, [&] {
+        return !m_scheduled;
+    });
+}
+
+bool
+strand::running_in_this_thread() const noexcept
+{
+    return current_strand == this;
+}
+
+void
+strand::process_tasks()
+{
+    // Swap all pending tasks out in one batch. This allows clients to continue
+    // posting while the batch runs without acquiring the lock once per task.
+    {
+        std::scoped_lock tasks_lock{ m_tasks_gate };
+        std::swap(m_tasks_running, m_tasks);
+    }
+
+    current_strand = this;
+    for (auto& task : m_tasks_running) {
+        if (m_state == state::canceling) {
+            break;
+        }
+        try {
+            task();
+        } catch (...) {
+        }
+    }
+    m_tasks_running.clear();
+    current_strand = nullptr;
+
+    std::scoped_lock tasks_lock{ m_tasks_gate };
+    if (m_state == state::canceling) {
+        m_tasks.clear();
+    } else if (!m_tasks.empty()) {
+        // More tasks were posted while this batch ran. Reschedule rather than
+        // looping so that a busy strand doesn't monopolize the worker thread.
+        m_pool.post([this] {
+            process_tasks();
+        });
+        return;
+    }
+
+    // Notify while holding the lock, since the strand may be destroyed as
+    // soon as a waiter observes that it is idle.
+    m_scheduled = false;
+    m_idle.notify_all();
+}
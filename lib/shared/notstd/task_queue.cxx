@@ -1,15 +1,108 @@
 
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <cassert>
+#include <chrono>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
 #include <version>
 
 #include <notstd/task_queue.hxx>
 
 using namespace notstd;
 
+namespace
+{
+/**
+ * @brief The task queue whose worker is running on the current thread, if any.
+ */
+thread_local const task_queue* current_task_queue = nullptr;
+
+/**
+ * @brief The number of tasks the lock-free worker runs between servicing
+ * timers while the queue is busy, so that a steady stream of tasks doesn't
+ * delay expired timers indefinitely.
+ */
+constexpr std::size_t timer_poll_interval = 64;
+
+/**
+ * @brief Runs a task, discarding any exception it throws so that it does not
+ * terminate the worker thread. Tasks posted with a future capture exceptions
+ * in the future, so this only affects detached tasks.
+ *
+ * @param task The task to run.
+ */
+void
+run_task(inline_task& task) noexcept
+{
+    try {
+        task();
+    } catch (...) {
+    }
+}
+} // namespace
+
 std::future<void>
-task_queue::dispatcher::post(std::function<void()> runnable)
+task_queue::dispatcher::post(std::function<void()> runnable, task_priority priority, clock::time_point deadline)
+{
+    return m_task_queue.post(std::move(runnable), priority, deadline);
+}
+
+void
+task_queue::dispatcher::post_detached(inline_task runnable, task_priority priority, clock::time_point deadline)
+{
+    m_task_queue.post_detached(std::move(runnable), priority, deadline);
+}
+
+task_queue::post_status
+task_queue::dispatcher::try_post_detached(inline_task runnable, task_priority priority, clock::time_point deadline)
+{
+    return m_task_queue.try_post_detached(std::move(runnable), priority, deadline);
+}
+
+task_queue::timer_id
+task_queue::dispatcher::post_after(clock::duration delay, inline_task runnable)
+{
+    return m_task_queue.post_timer(delay, clock::duration::zero(), std::move(runnable));
+}
+
+task_queue::timer_id
+task_queue::dispatcher::post_every(clock::duration period, inline_task runnable)
+{
+    if (period <= clock::duration::zero()) {
+        throw std::invalid_argument("timer period must be positive");
+    }
+
+    return m_task_queue.post_timer(period, period, std::move(runnable));
+}
+
+bool
+task_queue::dispatcher::cancel(timer_id id) noexcept
+{
+    return m_task_queue.cancel_timer(id);
+}
+
+task_queue::dispatcher::schedule_operation
+task_queue::dispatcher::schedule(task_priority priority) noexcept
 {
-    return m_task_queue.post(std::move(runnable));
+    return schedule_operation(*this, priority);
+}
+
+task_queue::dispatcher::schedule_operation::schedule_operation(dispatcher& dispatcher, task_priority priority) noexcept :
+    m_dispatcher(dispatcher),
+    m_priority(priority)
+{}
+
+void
+task_queue::dispatcher::schedule_operation::await_suspend(std::coroutine_handle<> awaiting)
+{
+    m_dispatcher.post_detached([awaiting] {
+        awaiting.resume();
+    },
+        m_priority);
 }
 
 task_queue::dispatcher::dispatcher(task_queue &task_queue) :
@@ -17,8 +110,33 @@ task_queue::dispatcher::dispatcher(task_queue &task_queue) :
 {}
 
 task_queue::task_queue() :
-    m_dispatcher(std::make_shared<notstd::enable_make_protected<dispatcher>>(*this))
+    task_queue(queue_backend::locked)
+{}
+
+task_queue::task_queue(queue_backend backend, std::size_t capacity) :
+    task_queue(backend, capacity, capacity_unbounded, overflow_policy::block)
+{}
+
+task_queue::task_queue(std::size_t capacity, overflow_policy policy) :
+    task_queue(queue_backend::locked, lock_free_capacity_default, capacity, policy)
+{}
+
+task_queue::task_queue(queue_backend backend, std::size_t ring_capacity, std::size_t capacity, overflow_policy policy) :
+    m_dispatcher(std::make_shared<notstd::enable_make_protected<dispatcher>>(*this)),
+    m_backend(backend),
+    m_capacity(capacity),
+    m_overflow_policy(policy)
 {
+    if (m_capacity == 0) {
+        throw std::invalid_argument("task queue capacity must be positive");
+    }
+
+    if (m_backend == queue_backend::lock_free) {
+        for (auto& ring : m_runnables_rings) {
+            ring = std::make_unique<mpsc_ring<queued_task>>(ring_capacity);
+        }
+    }
+
     try {
         m_thread = std::thread(&task_queue::process_queue, this);
         m_state = state::running;
@@ -45,6 +163,104 @@ task_queue::get_dispatcher() const noexcept
     return m_dispatcher;
 }
 
+/* static */
+std::shared_ptr<task_queue::dispatcher>
+task_queue::current_dispatcher() noexcept
+{
+    return (current_task_queue != nullptr) ? current_task_queue->m_dispatcher : nullptr;
+}
+
+std::size_t
+task_queue::queue_depth(task_priority priority) const noexcept
+{
+    return m_runnables_depth[static_cast<std::size_t>(priority)].load(std::memory_order_relaxed);
+}
+
+std::size_t
+task_queue::tasks_expired(task_priority priority) const noexcept
+{
+    return m_runnables_expired[static_cast<std::size_t>(priority)].load(std::memory_order_relaxed);
+}
+
+std::size_t
+task_queue::tasks_dropped(task_priority priority) const noexcept
+{
+    return m_runnables_dropped[static_cast<std::size_t>(priority)].load(std::memory_order_relaxed);
+}
+
+void
+task_queue::set_watermarks(std::size_t high, std::size_t low, watermark_callback callback)
+{
+    if (high == 0 || high == capacity_unbounded || low >= high) {
+        throw std::invalid_argument("watermarks must satisfy 0 <= low < high");
+    }
+
+    std::scoped_lock watermark_lock{ m_watermark_gate };
+    m_watermark_callback = std::move(callback);
+    m_watermark_low = low;
+    m_watermark_high = high;
+    m_watermark_reached = false;
+    update_watermark();
+}
+
+std::size_t
+task_queue::pending_count() const noexcept
+{
+    std::size_t pending = 0;
+    for (const auto& depth : m_runnables_depth) {
+        pending += depth.load();
+    }
+
+    return pending;
+}
+
+task_queue::statistics
+task_queue::stats() const noexcept
+{
+    statistics result{};
+
+#ifdef NOTSTD_TASK_QUEUE_STATS
+    result.depth = pending_count();
+    result.depth_high_water = m_stats_depth_high_water.load(std::memory_order_relaxed);
+    result.tasks_posted = m_stats_tasks_posted.load(std::memory_order_relaxed);
+    result.tasks_canceled = m_stats_tasks_canceled.load(std::memory_order_relaxed);
+    result.wait_time = m_stats_wait_time.get_snapshot();
+    result.run_time = m_stats_run_time.get_snapshot();
+    result.tasks_run = result.run_time.count;
+#endif
+
+    return result;
+}
+
+void
+task_queue::update_watermark() noexcept
+{
+    try {
+        std::scoped_lock watermark_lock{ m_watermark_gate };
+        const auto pending = pending_count();
+        watermark crossed = watermark::high;
+        if (!m_watermark_reached && pending >= m_watermark_high) {
+            m_watermark_reached = true;
+            crossed = watermark::high;
+        } else if (m_watermark_reached && pending <= m_watermark_low) {
+            m_watermark_reached = false;
+            crossed = watermark::low;
+        } else {
+            return;
+        }
+
+        // Invoke a copy, in case the callback replaces itself. The lock is
+        // held so that invocations are serialized, and so alternate.
+        const auto callback = m_watermark_callback;
+        if (callback) {
+            callback(crossed);
+        }
+    } catch (...) {
+        // As with detached tasks, exceptions thrown by the callback are
+        // discarded.
+    }
+}
+
 void
 task_queue::stop(pending_task_action pending_action) noexcept
 {
@@ -56,12 +272,27 @@ task_queue::stop(pending_task_action pending_action) noexcept
             m_state = state::canceling;
             break;
         default:
-            m_state = state::stopping;
+            // Don't downgrade a pending cancelation, eg. when the queue is
+            // destroyed after being explicitly canceled.
+            if (m_state != state::canceling) {
+                m_state = state::stopping;
+            }
             break;
         }
+
+        // Bump the signal while holding the lock so that a lock-free worker
+        // waiting for a timer on m_runnables_changed observes it.
+        if (m_backend == queue_backend::lock_free) {
+            m_runnables_signal.fetch_add(1);
+        }
     }
 
     m_runnables_changed.notify_all();
+    m_runnables_space.notify_all();
+
+    if (m_backend == queue_backend::lock_free) {
+        m_runnables_signal.notify_all();
+    }
 }
 
 void
@@ -87,7 +318,16 @@ task_queue::should_queue_exit() const noexcept
     // Exit if abort is requested, or if stopping and the queue has been drained.
     switch (m_state) {
     case state::stopping:
-        should_exit = m_runnables.empty();
+        // The locked worker may hold part of a batch of tasks which it
+        // yielded to a higher priority lane, so check the depths instead,
+        // which also count those.
+        if (m_backend == queue_backend::lock_free) {
+            should_exit = is_lock_free_empty();
+        } else {
+            should_exit = std::ranges::all_of(m_runnables_depth, [](const auto& depth) {
+                return depth.load(std::memory_order_relaxed) == 0;
+            });
+        }
         break;
     case state::canceling:
         should_exit = true;
@@ -121,24 +361,96 @@ task_queue::is_stop_pending() const noexcept
 void
 task_queue::process_queue()
 {
+    current_task_queue = this;
+
+    if (m_backend == queue_backend::lock_free) {
+        process_queue_lock_free();
+    } else {
+        process_queue_locked();
+    }
+
+#ifdef NOTSTD_TASK_QUEUE_STATS
+    // Tasks still pending when the queue is canceled are never run.
+    if (m_state == state::canceling) {
+        m_stats_tasks_canceled.fetch_add(pending_count(), std::memory_order_relaxed);
+    }
+#endif
+}
+
+void
+task_queue::process_queue_locked()
+{
+    // Tasks are swapped out of each lane in batches. Retain the capacity of
+    // the vectors so posting doesn't allocate once the queue has warmed up.
+    std::array<std::vector<queued_task>, task_priority_count> batches{};
+    std::array<std::size_t, task_priority_count> batch_positions{};
+    std::vector<inline_task> timers_expired{};
+
+    const auto is_task_pending = [&] {
+        for (std::size_t lane = 0; lane < task_priority_count; lane++) {
+            if (!batches[lane].empty() || !m_runnables[lane].empty()) {
+                return true;
+            }
+        }
+        return false;
+    };
+
+    const auto is_higher_priority_task_pending = [&](std::size_t lane) {
+        for (std::size_t lane_higher = 0; lane_higher < lane; lane_higher++) {
+            if (m_runnables_depth[lane_higher].load(std::memory_order_relaxed) != 0) {
+                return true;
+            }
+        }
+        return false;
+    };
+
     for (;;) {
         std::unique_lock runnables_changed_lock{ m_runnables_changed_gate };
 
-        // Wait for non-empty queue or if exit requested.
-        m_runnables_changed.wait(runnables_changed_lock, [&]() {
-            return !m_runnables.empty() || should_queue_exit();
-        });
+        // Wait for non-empty queue, an expired timer, or if exit requested.
+        // While timers are scheduled, wake up when the next one is due.
+        for (;;) {
+            if (is_task_pending() || should_queue_exit()) {
+                break;
+            }
+            if (!m_timers.empty()) {
+                m_timers.advance(clock::now(), timers_expired);
+                if (!timers_expired.empty()) {
+                    break;
+                }
+            }
+
+            const auto timers_next = m_timers.next_expiry();
+            if (timers_next.has_value()) {
+                m_runnables_changed.wait_until(runnables_changed_lock, *timers_next);
+            } else {
+                m_runnables_changed.wait(runnables_changed_lock);
+            }
+        }
 
         // Check exit condition in case requested while waiting.
         if (should_queue_exit()) {
             break;
         }
 
-        // The queue is non-empty, remove all tasks from the queue while holding
-        // the lock to run them later.
-        assert(m_runnables.size() > 0);
-        auto tasks = std::move(m_runnables);
-        m_runnables = {};
+        // Service the timers even if tasks were posted, so a busy queue
+        // doesn't delay them.
+        if (!m_timers.empty() && timers_expired.empty()) {
+            m_timers.advance(clock::now(), timers_expired);
+        }
+
+        // Remove all tasks from the lanes while holding the lock to run them
+        // later. A lane still holding part of a batch, because it yielded to a
+        // higher priority lane, leaves new tasks queued until the batch is
+        // done, which preserves the FIFO order of the lane. Tasks dropped from
+        // the front of a lane are skipped.
+        assert(is_task_pending() || timers_expired.size() > 0);
+        for (std::size_t lane = 0; lane < task_priority_count; lane++) {
+            if (batches[lane].empty()) {
+                std::swap(batches[lane], m_runnables[lane]);
+                batch_positions[lane] = std::exchange(m_runnables_head[lane], 0);
+            }
+        }
 
         // Now that all pending tasks have been popped from the queue, release
         // the lock. This allows clients to continue pushing onto the queue
@@ -151,37 +463,423 @@ task_queue::process_queue()
         // Notify waiters since the queue has been modified (now empty).
         m_runnables_changed.notify_all();
 
-        // Run all the pending tasks.
-        while (!tasks.empty()) {
-            auto taskToRun = std::move(tasks.front());
-            tasks.pop();
-            if (taskToRun.valid()) {
-                taskToRun();
+        // Run the tasks of expired timers, then the pending tasks from the
+        // highest priority lane to the lowest. As soon as a task is posted to
+        // a higher priority lane than the one running, go back for it.
+        for (auto& task : timers_expired) {
+            run_task(task);
+        }
+        timers_expired.clear();
+
+        for (std::size_t lane = 0; lane < task_priority_count; lane++) {
+            auto& batch = batches[lane];
+            auto& batch_position = batch_positions[lane];
+            while (batch_position < batch.size()) {
+                run_queued_task(batch[batch_position++], lane);
+                if (is_higher_priority_task_pending(lane)) {
+                    break;
+                }
             }
+
+            if (batch_position < batch.size()) {
+                break;
+            }
+            batch.clear();
+            batch_position = 0;
         }
     } // for (;;)
 }
 
+void
+task_queue::process_queue_lock_free()
+{
+    std::vector<inline_task> timers_expired{};
+    std::size_t tasks_run = 0;
+
+    for (;;) {
+        if (m_state == state::canceling) {
+            break;
+        }
+
+        // Pop the next task from the highest priority lane holding one. Tasks
+        // posted from this thread while a ring was full are held in the
+        // overflow queue of the lane, and are run once the ring has been
+        // drained.
+        std::optional<queued_task> task{};
+        std::size_t lane = 0;
+        for (; lane < task_priority_count; lane++) {
+            task = m_runnables_rings[lane]->try_pop();
+            if (!task.has_value() && !m_runnables_overflow[lane].empty()) {
+                task = std::move(m_runnables_overflow[lane].front());
+                m_runnables_overflow[lane].pop();
+            }
+            if (task.has_value()) {
+                break;
+            }
+        }
+
+        if (task.has_value()) {
+            run_queued_task(*task, lane);
+            if (++tasks_run % timer_poll_interval == 0) {
+                run_expired_timers(timers_expired);
+            }
+            continue;
+        }
+
+        // The queue is empty. Advertise that the worker is about to wait, and
+        // re-check the exit condition and the ring to avoid missing a task
+        // posted in the meantime. The fence pairs with the one in
+        // post_lock_free() so that at least one side observes the other.
+        m_worker_waiting.store(true, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const auto signal = m_runnables_signal.load(std::memory_order_acquire);
+        if (should_queue_exit()) {
+            break;
+        }
+
+        // Run the tasks of any expired timers. Scheduling a timer which
+        // expires before the others bumps the signal, so one scheduled after
+        // the signal was loaded above ends the wait below early.
+        const auto timers_next = run_expired_timers(timers_expired);
+        if (is_lock_free_empty()) {
+            if (timers_next.has_value()) {
+                // Atomic waits can't time out, so wait for the next timer on
+                // the condition variable instead. Producers check
+                // m_worker_waiting_timed to notify it.
+                m_worker_waiting_timed.store(true);
+                {
+                    std::unique_lock runnables_changed_lock{ m_runnables_changed_gate };
+                    m_runnables_changed.wait_until(runnables_changed_lock, *timers_next, [&] {
+                        return m_runnables_signal.load() != signal;
+                    });
+                }
+                m_worker_waiting_timed.store(false);
+            } else {
+                m_runnables_signal.wait(signal, std::memory_order_acquire);
+            }
+        }
+        m_worker_waiting.store(false, std::memory_order_relaxed);
+    } // for (;;)
+}
+
+task_queue::post_status
+task_queue::post_lock_free(queued_task task, std::size_t lane)
+{
+    auto& ring = *m_runnables_rings[lane];
+    auto& overflow = m_runnables_overflow[lane];
+
+    // Count the task before it is visible to the worker, so the depth never
+    // drops below zero.
+    m_runnables_depth[lane].fetch_add(1, std::memory_order_relaxed);
+
+    if (current_task_queue == this) {
+        // Posting from a task running on this queue. Waiting for the ring to
+        // drain would deadlock, so hold the task until it has been drained
+        // instead, along with any tasks posted after it to preserve ordering.
+        if (!overflow.empty() || !ring.try_push(task)) {
+            overflow.push(std::move(task));
+        }
+        return post_status::posted;
+    }
+
+    while (!ring.try_push(task)) {
+        if (is_stop_pending()) {
+            m_runnables_depth[lane].fetch_sub(1, std::memory_order_relaxed);
+            return post_status::stopped;
+        }
+        std::this_thread::yield();
+    }
+
+    wake_lock_free_worker();
+    return post_status::posted;
+}
+
+bool
+task_queue::is_lock_free_empty() const noexcept
+{
+    for (std::size_t lane = 0; lane < task_priority_count; lane++) {
+        if (!m_runnables_rings[lane]->empty() || !m_runnables_overflow[lane].empty()) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void
+task_queue::run_queued_task(queued_task& task, std::size_t lane) noexcept
+{
+    if (m_capacity == capacity_unbounded) {
+        m_runnables_depth[lane].fetch_sub(1, std::memory_order_relaxed);
+    } else {
+        // The sequentially consistent decrement pairs with the increment of
+        // m_producers_waiting in post_locked(), so either the producer sees
+        // the space freed here, or this sees the producer waiting for it.
+        m_runnables_depth[lane].fetch_sub(1);
+        if (m_producers_waiting.load() != 0) {
+            {
+                std::scoped_lock runnables_changed_lock{ m_runnables_changed_gate };
+            }
+            m_runnables_space.notify_one();
+        }
+    }
+
+    if (m_watermark_reached.load(std::memory_order_relaxed) && pending_count() <= m_watermark_low.load(std::memory_order_relaxed)) {
+        update_watermark();
+    }
+
+    // Drop stale tasks. Only read the clock for tasks with a deadline, so
+    // tasks without one pay nothing for the check.
+    if (task.deadline != no_deadline && clock::now() > task.deadline) {
+        m_runnables_expired[lane].fetch_add(1, std::memory_order_relaxed);
+#ifdef NOTSTD_TASK_QUEUE_STATS
+        m_stats_tasks_canceled.fetch_add(1, std::memory_order_relaxed);
+#endif
+        task.task.reset();
+        return;
+    }
+
+#ifdef NOTSTD_TASK_QUEUE_STATS
+    const auto started = clock::now();
+    m_stats_wait_time.record(static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(started - task.posted).count()));
+#endif
+
+    if (task.task) {
+        run_task(task.task);
+    }
+
+#ifdef NOTSTD_TASK_QUEUE_STATS
+    m_stats_run_time.record(static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - started).count()));
+#endif
+}
+
+void
+task_queue::wake_lock_free_worker() noexcept
+{
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (!m_worker_waiting.load(std::memory_order_relaxed)) {
+        return;
+    }
+
+    m_runnables_signal.fetch_add(1);
+    m_runnables_signal.notify_one();
+
+    // A worker waiting for a timer checks the signal while holding the lock,
+    // so acquiring it ensures the worker either observes the new signal or is
+    // waiting to be notified.
+    if (m_worker_waiting_timed.load()) {
+        {
+            std::scoped_lock runnables_changed_lock{ m_runnables_changed_gate };
+        }
+        m_runnables_changed.notify_one();
+    }
+}
+
+std::optional<task_queue::clock::time_point>
+task_queue::run_expired_timers(std::vector<inline_task>& expired)
+{
+    std::optional<clock::time_point> timers_next{};
+
+    {
+        std::scoped_lock runnables_changed_lock{ m_runnables_changed_gate };
+        if (m_timers.empty()) {
+            return std::nullopt;
+        }
+
+        m_timers.advance(clock::now(), expired);
+        timers_next = m_timers.next_expiry();
+    }
+
+    for (auto& task : expired) {
+        if (m_state == state::canceling) {
+            break;
+        }
+        run_task(task);
+    }
+    expired.clear();
+
+    return timers_next;
+}
+
 std::future<void>
-task_queue::post(std::function<void()> runnable)
+task_queue::post(std::function<void()> runnable, task_priority priority, clock::time_point deadline)
 {
     auto task = std::packaged_task<void()>(std::move(runnable));
     auto future = task.get_future();
+    post_detached(std::move(task), priority, deadline);
+    return future;
+}
+
+void
+task_queue::post_detached(inline_task runnable, task_priority priority, clock::time_point deadline)
+{
+    switch (try_post_detached(std::move(runnable), priority, deadline)) {
+    case post_status::stopped:
+        throw std::runtime_error("attempt to post to queue in stopping state, this is a bug!");
+    case post_status::full:
+        throw full_exception();
+    default:
+        break;
+    }
+}
+
+task_queue::post_status
+task_queue::try_post_detached(inline_task runnable, task_priority priority, clock::time_point deadline)
+{
+    const auto lane = static_cast<std::size_t>(priority);
+
+    queued_task task{ std::move(runnable), deadline };
+#ifdef NOTSTD_TASK_QUEUE_STATS
+    task.posted = clock::now();
+#endif
+
+    post_status status = post_status::posted;
+    if (m_backend == queue_backend::lock_free) {
+        status = is_stop_pending() ? post_status::stopped : post_lock_free(std::move(task), lane);
+    } else {
+        status = post_locked(std::move(task), lane);
+    }
+
+#ifdef NOTSTD_TASK_QUEUE_STATS
+    if (status == post_status::posted) {
+        m_stats_tasks_posted.fetch_add(1, std::memory_order_relaxed);
+        const auto depth = pending_count();
+        auto depth_high_water = m_stats_depth_high_water.load(std::memory_order_relaxed);
+        while (depth > depth_high_water && !m_stats_depth_high_water.compare_exchange_weak(depth_high_water, depth, std::memory_order_relaxed)) {}
+    } else if (status == post_status::dropped) {
+        m_stats_tasks_posted.fetch_add(1, std::memory_order_relaxed);
+    }
+#endif
+
+    // Only count the pending tasks when a high watermark has been set.
+    if (status == post_status::posted && !m_watermark_reached.load(std::memory_order_relaxed)) {
+        const auto watermark_high = m_watermark_high.load(std::memory_order_relaxed);
+        if (watermark_high != capacity_unbounded && pending_count() >= watermark_high) {
+            update_watermark();
+        }
+    }
+
+    return status;
+}
+
+task_queue::post_status
+task_queue::post_locked(queued_task task, std::size_t lane)
+{
+    // A task displaced by the overflow policy is destroyed once the lock has
+    // been released, since its destructor may run arbitrary code.
+    inline_task task_dropped{};
+    bool is_oldest_dropped = false;
     bool was_empty = false;
 
+    {
+        std::unique_lock runnables_changed_lock{ m_runnables_changed_gate };
+        if (is_stop_pending()) {
+            return post_status::stopped;
+        }
+
+        if (m_capacity != capacity_unbounded && pending_count() >= m_capacity) {
+            switch (m_overflow_policy) {
+            case overflow_policy::block:
+                // Waiting for space on the worker thread would deadlock, so
+                // accept the task regardless.
+                if (current_task_queue == this) {
+                    break;
+                }
+
+                m_producers_waiting.fetch_add(1);
+                m_runnables_space.wait(runnables_changed_lock, [&] {
+                    return is_stop_pending() || pending_count() < m_capacity;
+                });
+                m_producers_waiting.fetch_sub(1);
+                if (is_stop_pending()) {
+                    return post_status::stopped;
+                }
+                break;
+            case overflow_policy::fail:
+                return post_status::full;
+            case overflow_policy::drop_oldest:
+                // Drop the task at the front of the lowest priority lane no
+                // higher than that of the new task. The worker skips it, so
+                // nothing needs to be moved.
+                for (auto lane_dropped = task_priority_count; lane_dropped-- > lane;) {
+                    auto& runnables = m_runnables[lane_dropped];
+                    auto& head = m_runnables_head[lane_dropped];
+                    if (head < runnables.size()) {
+                        task_dropped = std::move(runnables[head++].task);
+                        m_runnables_depth[lane_dropped].fetch_sub(1);
+                        m_runnables_dropped[lane_dropped].fetch_add(1, std::memory_order_relaxed);
+#ifdef NOTSTD_TASK_QUEUE_STATS
+                        m_stats_tasks_canceled.fetch_add(1, std::memory_order_relaxed);
+#endif
+                        is_oldest_dropped = true;
+                        break;
+                    }
+                }
+                if (is_oldest_dropped) {
+                    break;
+                }
+                [[fallthrough]];
+            case overflow_policy::drop_newest:
+                m_runnables_dropped[lane].fetch_add(1, std::memory_order_relaxed);
+#ifdef NOTSTD_TASK_QUEUE_STATS
+                m_stats_tasks_canceled.fetch_add(1, std::memory_order_relaxed);
+#endif
+                task_dropped = std::move(task.task);
+                return post_status::dropped;
+            }
+        }
+
+        was_empty = m_runnables[lane].empty();
+        m_runnables[lane].push_back(std::move(task));
+        m_runnables_depth[lane].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    if (was_empty) {
+        m_runnables_changed.notify_all();
+    }
+
+    return post_status::posted;
+}
+
+task_queue::timer_id
+task_queue::post_timer(clock::duration delay, clock::duration period, inline_task runnable)
+{
+    timer_id id = timer_wheel::invalid_timer_id;
+    bool is_next = false;
+
     {
         std::lock_guard runnables_changed_lock{ m_runnables_changed_gate };
         if (is_stop_pending()) {
             throw std::runtime_error("attempt to post to queue in stopping state, this is a bug!");
         }
 
-        was_empty = m_runnables.empty();
-        m_runnables.push(std::move(task));
+        const auto expiry = clock::now() + delay;
+        const auto timers_next = m_timers.next_expiry();
+        id = (period > clock::duration::zero())
+            ? m_timers.schedule_periodic(expiry, period, std::move(runnable))
+            : m_timers.schedule(expiry, std::move(runnable));
+
+        // The worker only needs to be woken if it would otherwise wait past
+        // the expiry of the new timer.
+        is_next = !timers_next.has_value() || m_timers.next_expiry() < timers_next;
+        if (is_next && m_backend == queue_backend::lock_free) {
+            m_runnables_signal.fetch_add(1);
+        }
     }
 
-    if (was_empty) {
+    if (is_next) {
         m_runnables_changed.notify_all();
+        if (m_backend == queue_backend::lock_free) {
+            m_runnables_signal.notify_one();
+        }
     }
 
-    return future;
+    return id;
+}
+
+bool
+task_queue::cancel_timer(timer_id id) noexcept
+{
+    std::lock_guard runnables_changed_lock{ m_runnables_changed_gate };
+    return m_timers.cancel(id);
 }
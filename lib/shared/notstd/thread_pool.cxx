@@ -0,0 +1,182 @@
+
+#include <algorithm>
+#include <utility>
+
+#include <notstd/thread_pool.hxx>
+
+using namespace notstd;
+
+namespace
+{
+/**
+ * @brief The pool and index of the worker running on the current thread, if any.
+ */
+thread_local const thread_pool* current_thread_pool = nullptr;
+thread_local std::size_t current_worker_index = 0;
+} // namespace
+
+thread_pool::thread_pool(std::size_t num_threads)
+{
+    if (num_threads == 0) {
+        num_threads = std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+    }
+
+    m_workers.reserve(num_threads);
+    for (std::size_t index = 0; index < num_threads; index++) {
+        m_workers.push_back(std::make_unique<worker>());
+    }
+
+    try {
+        m_threads.reserve(num_threads);
+        for (std::size_t index = 0; index < num_threads; index++) {
+            m_threads.emplace_back(&thread_pool::process_tasks, this, index);
+        }
+    } catch (...) {
+        m_stopping = true;
+        m_tasks_signal.fetch_add(1);
+        m_tasks_signal.notify_all();
+        for (auto& thread : m_threads) {
+            thread.join();
+        }
+        throw thread_pool::creation_exception();
+    }
+}
+
+thread_pool::~thread_pool()
+{
+    m_stopping = true;
+    m_tasks_signal.fetch_add(1);
+    m_tasks_signal.notify_all();
+
+    for (auto& thread : m_threads) {
+        if (thread.joinable()) {
+            try {
+                thread.join();
+            } catch (...) {
+            }
+        }
+    }
+}
+
+/* static */
+thread_pool&
+thread_pool::get_default()
+{
+    static thread_pool pool{};
+    return pool;
+}
+
+/* static */
+thread_pool&
+thread_pool::get_blocking()
+{
+    static thread_pool pool{ std::max<std::size_t>(std::thread::hardware_concurrency(), blocking_pool_size_minimum) };
+    return pool;
+}
+
+std::size_t
+thread_pool::size() const noexcept
+{
+    return m_workers.size();
+}
+
+bool
+thread_pool::running_in_this_thread() const noexcept
+{
+    return current_thread_pool == this;
+}
+
+void
+thread_pool::post(inline_task task)
+{
+    // Keep tasks posted from a worker on that worker for locality; spread the
+    // others across all workers.
+    const auto index = running_in_this_thread()
+        ? current_worker_index
+        : (m_worker_next.fetch_add(1, std::memory_order_relaxed) % m_workers.size());
+
+    // Count the task as pending before it is visible to workers, so the count
+    // never drops below zero.
+    m_tasks_pending.fetch_add(1);
+    {
+        auto& target = *m_workers[index];
+        std::scoped_lock tasks_lock{ target.tasks_gate };
+        target.tasks.push_back(std::move(task));
+    }
+
+    // Only wake a worker if one is waiting. This pairs with the sequence in
+    // process_tasks() such that either the waiting worker observes the
+    // pending task, or this observes the waiting worker.
+    if (m_workers_waiting.load() > 0) {
+        m_tasks_signal.fetch_add(1);
+        m_tasks_signal.notify_one();
+    }
+}
+
+bool
+thread_pool::try_pop(std::size_t index, inline_task& task)
+{
+    // Take the oldest task from this worker's own queue.
+    {
+        auto& own = *m_workers[index];
+        std::scoped_lock tasks_lock{ own.tasks_gate };
+        if (!own.tasks.empty()) {
+            task = std::move(own.tasks.front());
+            own.tasks.pop_front();
+            return true;
+        }
+    }
+
+    // Steal the newest task from another worker, leaving the oldest tasks to
+    // their owner.
+    for (std::size_t offset = 1; offset < m_workers.size(); offset++) {
+        auto& victim = *m_workers[(index + offset) % m_workers.size()];
+        std::unique_lock tasks_lock{ victim.tasks_gate, std::try_to_lock };
+        if (tasks_lock.owns_lock() && !victim.tasks.empty()) {
+            task = std::move(victim.tasks.back());
+            victim.tasks.pop_back();
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void
+thread_pool::process_tasks(std::size_t index)
+{
+    current_thread_pool = this;
+    current_worker_index = index;
+
+    inline_task task{};
+    for (;;) {
+        if (m_tasks_pending.load() > 0 && try_pop(index, task)) {
+            m_tasks_pending.fetch_sub(1);
+            try {
+                task();
+            } catch (...) {
+            }
+            task.reset();
+            continue;
+        }
+
+        // Either no tasks are pending, or they are being taken by other
+        // workers. Advertise that this worker is about to wait, then re-check
+        // for pending tasks to avoid missing one posted in the meantime.
+        m_workers_waiting.fetch_add(1);
+        const auto signal = m_tasks_signal.load();
+        const auto tasks_pending = m_tasks_pending.load();
+        if (tasks_pending == 0) {
+            if (m_stopping) {
+                m_workers_waiting.fetch_sub(1);
+                break;
+            }
+            m_tasks_signal.wait(signal);
+        } else {
+            // A task is pending, but may be in a queue that was locked while
+            // trying to steal from it.
+            std::this_thread::yield();
+        }
+        m_workers_waiting.fetch_sub(1);
+    }
+}
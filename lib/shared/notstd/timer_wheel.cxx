@@ -0,0 +1,346 @@
+
+#include <algorithm>
+#include <bit>
+#include <utility>
+
+#include <notstd/timer_wheel.hxx>
+
+using namespace notstd;
+
+namespace
+{
+/**
+ * @brief Finds the first occupied slot in a level, searching from the
+ * specified slot and wrapping around.
+ *
+ * @param bitmap The bitmap of occupied slots in the level.
+ * @param start The slot to start searching from.
+ * @return std::optional<std::size_t> The distance from the start slot to the
+ * first occupied slot, if any.
+ */
+template <typename BitmapT>
+std::optional<std::size_t>
+find_occupied_slot(const BitmapT& bitmap, std::size_t start) noexcept
+{
+    static constexpr std::size_t word_bits = 64;
+    static constexpr std::size_t num_slots = std::tuple_size_v<BitmapT> * word_bits;
+
+    const auto word = start / word_bits;
+    const auto bit = start % word_bits;
+    const auto distance = [&](std::size_t word_index, std::uint64_t bits) {
+        const auto slot = (word_index * word_bits) + static_cast<std::size_t>(std::countr_zero(bits));
+        return (slot + num_slots - start) % num_slots;
+    };
+
+    // The remainder of the starting word, the other words, then the beginning
+    // of the starting word.
+    if (const auto bits = bitmap[word] & (~std::uint64_t{ 0 } << bit); bits != 0) {
+        return distance(word, bits);
+    }
+    for (std::size_t offset = 1; offset < bitmap.size(); offset++) {
+        const auto word_index = (word + offset) % bitmap.size();
+        if (bitmap[word_index] != 0) {
+            return distance(word_index, bitmap[word_index]);
+        }
+    }
+    if (const auto bits = bitmap[word] & ((std::uint64_t{ 1 } << bit) - 1); bits != 0) {
+        return distance(word, bits);
+    }
+
+    return std::nullopt;
+}
+} // namespace
+
+timer_wheel::timer_wheel(clock::time_point start) :
+    m_start(start)
+{}
+
+timer_wheel::timer_id
+timer_wheel::schedule(clock::time_point expiry, inline_task task)
+{
+    return allocate(to_tick(expiry), std::move(task), nullptr, 0);
+}
+
+timer_wheel::timer_id
+timer_wheel::schedule_periodic(clock::time_point expiry, clock::duration period, inline_task task)
+{
+    auto period_ticks = std::chrono::ceil<tick_duration>(period).count();
+    period_ticks = std::max<decltype(period_ticks)>(period_ticks, 1);
+
+    return allocate(to_tick(expiry), {}, std::make_shared<inline_task>(std::move(task)), static_cast<std::uint64_t>(period_ticks));
+}
+
+bool
+timer_wheel::cancel(timer_id id) noexcept
+{
+    const auto index = static_cast<std::uint32_t>(id);
+    const auto generation = static_cast<std::uint32_t>(id >> 32U);
+    if (index >= m_timers.size()) {
+        return false;
+    }
+
+    // Timers which aren't linked into a slot have either expired or been
+    // canceled.
+    const auto& entry = m_timers[index];
+    if (entry.generation != generation || entry.slot == npos) {
+        return false;
+    }
+
+    unlink(index);
+    release(index);
+    return true;
+}
+
+std::size_t
+timer_wheel::size() const noexcept
+{
+    return m_size;
+}
+
+bool
+timer_wheel::empty() const noexcept
+{
+    return m_size == 0;
+}
+
+std::optional<timer_wheel::clock::time_point>
+timer_wheel::next_expiry() const noexcept
+{
+    const auto tick = next_tick();
+    if (!tick.has_value()) {
+        return std::nullopt;
+    }
+
+    return m_start + tick_duration(static_cast<tick_duration::rep>(*tick));
+}
+
+void
+timer_wheel::advance(clock::time_point now, std::vector<inline_task>& expired)
+{
+    if (now <= m_start) {
+        return;
+    }
+
+    const auto target = static_cast<std::uint64_t>(std::chrono::floor<tick_duration>(now - m_start).count());
+    if (target <= m_now) {
+        return;
+    }
+
+    // Jump directly between the ticks at which something must be done, rather
+    // than visiting every tick in between.
+    for (auto tick = next_tick(); tick.has_value() && *tick <= target; tick = next_tick()) {
+        m_now = *tick;
+
+        // Cascade the timers of each higher level whose slot has been reached,
+        // starting with the highest so they can cascade all the way down.
+        for (std::size_t level = num_levels - 1; level > 0; level--) {
+            const auto shift = slot_bits * level;
+            if ((m_now & ((std::uint64_t{ 1 } << shift) - 1)) != 0) {
+                continue;
+            }
+
+            const auto bucket = (level * slots_per_level) + ((m_now >> shift) & (slots_per_level - 1));
+            for (auto index = detach(static_cast<std::uint32_t>(bucket)); index != npos;) {
+                const auto next = std::exchange(m_timers[index].next, npos);
+                if (m_timers[index].expiry <= m_now) {
+                    expire(index, target, expired);
+                } else {
+                    link(index);
+                }
+                index = next;
+            }
+        }
+
+        // Expire the timers in the current slot of the lowest level.
+        for (auto index = detach(static_cast<std::uint32_t>(m_now & (slots_per_level - 1))); index != npos;) {
+            const auto next = std::exchange(m_timers[index].next, npos);
+            if (m_timers[index].expiry <= m_now) {
+                expire(index, target, expired);
+            } else {
+                link(index);
+            }
+            index = next;
+        }
+    }
+
+    m_now = target;
+}
+
+timer_wheel::timer_id
+timer_wheel::allocate(std::uint64_t expiry, inline_task task, std::shared_ptr<inline_task> task_periodic, std::uint64_t period)
+{
+    std::uint32_t index = 0;
+    if (!m_timers_free.empty()) {
+        index = m_timers_free.back();
+        m_timers_free.pop_back();
+    } else {
+        index = static_cast<std::uint32_t>(m_timers.size());
+        m_timers.emplace_back();
+    }
+
+    auto& entry = m_timers[index];
+    entry.task = std::move(task);
+    entry.task_periodic = std::move(task_periodic);
+    entry.expiry = expiry;
+    entry.period = period;
+    m_size++;
+    link(index);
+
+    return (static_cast<timer_id>(entry.generation) << 32U) | index;
+}
+
+void
+timer_wheel::release(std::uint32_t index) noexcept
+{
+    auto& entry = m_timers[index];
+    entry.task.reset();
+    entry.task_periodic.reset();
+    entry.slot = npos;
+    // Skip generation zero so that no identifier equals invalid_timer_id.
+    if (++entry.generation == 0) {
+        entry.generation = 1;
+    }
+
+    m_timers_free.push_back(index);
+    m_size--;
+}
+
+void
+timer_wheel::link(std::uint32_t index) noexcept
+{
+    static constexpr std::uint64_t range_max = (std::uint64_t{ 1 } << (slot_bits * num_levels)) - 1;
+
+    auto& entry = m_timers[index];
+
+    // Timers which are already due are placed in the next slot. Those beyond
+    // the range of the wheel are placed in the furthest slot, and cascaded
+    // back into the highest level once it has been reached.
+    auto expiry = std::max(entry.expiry, m_now + 1);
+    const auto delta = std::min(expiry - m_now, range_max);
+    expiry = m_now + delta;
+
+    std::size_t level = 0;
+    while (level < num_levels - 1 && delta >= (std::uint64_t{ 1 } << (slot_bits * (level + 1)))) {
+        level++;
+    }
+
+    const auto slot_in_level = (expiry >> (slot_bits * level)) & (slots_per_level - 1);
+    const auto slot_index = static_cast<std::uint32_t>((level * slots_per_level) + slot_in_level);
+    auto& bucket = m_slots[slot_index];
+
+    entry.slot = slot_index;
+    entry.previous = bucket.tail;
+    entry.next = npos;
+    if (bucket.tail != npos) {
+        m_timers[bucket.tail].next = index;
+    } else {
+        bucket.head = index;
+        m_slots_occupied[level][slot_in_level / 64] |= (std::uint64_t{ 1 } << (slot_in_level % 64));
+    }
+    bucket.tail = index;
+}
+
+void
+timer_wheel::unlink(std::uint32_t index) noexcept
+{
+    auto& entry = m_timers[index];
+    auto& bucket = m_slots[entry.slot];
+
+    if (entry.previous != npos) {
+        m_timers[entry.previous].next = entry.next;
+    } else {
+        bucket.head = entry.next;
+    }
+    if (entry.next != npos) {
+        m_timers[entry.next].previous = entry.previous;
+    } else {
+        bucket.tail = entry.previous;
+    }
+
+    if (bucket.head == npos) {
+        const auto level = entry.slot / slots_per_level;
+        const auto slot_in_level = entry.slot % slots_per_level;
+        m_slots_occupied[level][slot_in_level / 64] &= ~(std::uint64_t{ 1 } << (slot_in_level % 64));
+    }
+
+    entry.slot = npos;
+    entry.previous = npos;
+    entry.next = npos;
+}
+
+std::uint32_t
+timer_wheel::detach(std::uint32_t slot_index) noexcept
+{
+    auto& bucket = m_slots[slot_index];
+    const auto head = std::exchange(bucket.head, npos);
+    bucket.tail = npos;
+
+    const auto level = slot_index / slots_per_level;
+    const auto slot_in_level = slot_index % slots_per_level;
+    m_slots_occupied[level][slot_in_level / 64] &= ~(std::uint64_t{ 1 } << (slot_in_level % 64));
+
+    for (auto index = head; index != npos; index = m_timers[index].next) {
+        m_timers[index].slot = npos;
+    }
+
+    return head;
+}
+
+void
+timer_wheel::expire(std::uint32_t index, std::uint64_t target, std::vector<inline_task>& expired)
+{
+    auto& entry = m_timers[index];
+    if (entry.period == 0) {
+        expired.push_back(std::move(entry.task));
+        release(index);
+        return;
+    }
+
+    expired.emplace_back([task = entry.task_periodic] {
+        (*task)();
+    });
+
+    // Skip any runs that were missed because the wheel wasn't advanced in
+    // time, so the task is collected at most once per advance.
+    const auto periods_missed = (target - entry.expiry) / entry.period;
+    entry.expiry += (periods_missed + 1) * entry.period;
+    link(index);
+}
+
+std::optional<std::uint64_t>
+timer_wheel::next_tick() const noexcept
+{
+    if (m_size == 0) {
+        return std::nullopt;
+    }
+
+    // Each occupied slot at the given level holds timers for the tick range
+    // following the current one, so the distance to the first occupied slot
+    // after the current one determines when it is reached.
+    std::optional<std::uint64_t> tick_next{};
+    for (std::size_t level = 0; level < num_levels; level++) {
+        const auto shift = slot_bits * level;
+        const auto base = m_now >> shift;
+        const auto distance = find_occupied_slot(m_slots_occupied[level], (base + 1) & (slots_per_level - 1));
+        if (!distance.has_value()) {
+            continue;
+        }
+
+        const auto tick = (base + 1 + *distance) << shift;
+        if (!tick_next.has_value() || tick < *tick_next) {
+            tick_next = tick;
+        }
+    }
+
+    return tick_next;
+}
+
+std::uint64_t
+timer_wheel::to_tick(clock::time_point time) const noexcept
+{
+    if (time <= m_start) {
+        return 0;
+    }
+
+    return static_cast<std::uint64_t>(std::chrono::ceil<tick_duration>(time - m_start).count());
+}
@@ -1,9 +1,12 @@
 
 #include <algorithm>
 #include <bit>
+#include <functional>
+#include <future>
 #include <iterator>
 #include <optional>
 #include <utility>
+#include <vector>
 
 #include <tlv/TlvBer.hxx>
 
@@ -11,26 +14,176 @@
 
 using namespace encoding;
 
-TlvBer::TlvBer(TlvBer::Class tlvClass, TlvBer::Type tlvType, uint32_t tagNumber, const std::vector<uint8_t>& tag, const std::vector<uint8_t>& value) :
+namespace
+{
+/**
+ * @brief Tag container which discards the tag octets. The tag octets are
+ * copied directly from the parsed buffer instead.
+ */
+struct TagOctetsDiscard
+{
+    void
+    push_back(uint8_t /* octet */) noexcept
+    {}
+};
+
+/**
+ * @brief Find a TLV by following a path of tags through the TLVs nested
+ * within the specified TLV.
+ *
+ * @param tlv The TLV to start from.
+ * @param path The tags to follow.
+ * @return const TlvBer* The TLV at the end of the path, or nullptr if there is none.
+ */
+const TlvBer*
+FindPath(const TlvBer& tlv, std::span<const uint32_t> path)
+{
+    const TlvBer* current = &tlv;
+    for (const auto tag : path) {
+        current = current->Find(tag);
+        if (current == nullptr) {
+            break;
+        }
+    }
+
+    return current;
+}
+} // namespace
+
+TlvBer::TlvBer(const allocator_type& allocator) :
+    m_value(allocator),
+    m_valuesConstructed(allocator),
+    m_index(allocator)
+{}
+
+TlvBer::TlvBer(TlvBer::Class tlvClass, TlvBer::Type tlvType, uint32_t tagNumber, std::span<const uint8_t> tag, std::span<const uint8_t> value, const allocator_type& allocator) :
     m_class(tlvClass),
     m_type(tlvType),
     m_tagNumber(tagNumber),
     m_tag(tag),
-    m_value(value)
+    m_value(value, allocator),
+    m_valuesConstructed(allocator),
+    m_index(allocator)
 {
-    ::Tlv::Tag = m_tag;
-    ::Tlv::Value = m_value;
+    UpdateViews();
 }
 
-TlvBer::TlvBer(TlvBer::Class tlvClass, TlvBer::Type tlvType, uint32_t tagNumber, const std::vector<uint8_t>& tag, std::vector<TlvBer>& values) :
+TlvBer::TlvBer(TlvBer::Class tlvClass, TlvBer::Type tlvType, uint32_t tagNumber, std::span<const uint8_t> tag, std::pmr::vector<TlvBer>& values, const allocator_type& allocator) :
     m_class(tlvClass),
     m_type(tlvType),
     m_tagNumber(tagNumber),
     m_tag(tag),
-    m_valuesConstructed(std::move(values))
+    m_value(allocator),
+    m_valuesConstructed(std::move(values), allocator),
+    m_index(allocator)
+{
+    UpdateViews();
+    BuildIndex();
+}
+
+TlvBer::TlvBer(const TlvBer& other) :
+    TlvBer(other, allocator_type{})
+{}
+
+TlvBer::TlvBer(const TlvBer& other, const allocator_type& allocator) :
+    m_class(other.m_class),
+    m_type(other.m_type),
+    m_tagNumber(other.m_tagNumber),
+    m_tag(other.m_tag),
+    m_value(other.m_value, allocator),
+    m_valuesConstructed(other.m_valuesConstructed, allocator),
+    m_index(other.m_index, allocator)
+{
+    UpdateViews();
+}
+
+TlvBer::TlvBer(TlvBer&& other) noexcept :
+    m_class(other.m_class),
+    m_type(other.m_type),
+    m_tagNumber(other.m_tagNumber),
+    m_tag(other.m_tag),
+    m_value(std::move(other.m_value)),
+    m_valuesConstructed(std::move(other.m_valuesConstructed)),
+    m_index(std::move(other.m_index))
+{
+    UpdateViews();
+    other.UpdateViews();
+    other.m_index.clear();
+}
+
+TlvBer::TlvBer(TlvBer&& other, const allocator_type& allocator) :
+    m_class(other.m_class),
+    m_type(other.m_type),
+    m_tagNumber(other.m_tagNumber),
+    m_tag(other.m_tag),
+    m_value(std::move(other.m_value), allocator),
+    m_valuesConstructed(std::move(other.m_valuesConstructed), allocator),
+    m_index(std::move(other.m_index), allocator)
+{
+    UpdateViews();
+    other.UpdateViews();
+    other.m_index.clear();
+}
+
+TlvBer&
+TlvBer::operator=(const TlvBer& other)
+{
+    if (this != &other) {
+        m_class = other.m_class;
+        m_type = other.m_type;
+        m_tagNumber = other.m_tagNumber;
+        m_tag = other.m_tag;
+        m_value = other.m_value;
+        m_valuesConstructed = other.m_valuesConstructed;
+        m_index = other.m_index;
+        UpdateViews();
+    }
+
+    return *this;
+}
+
+TlvBer&
+TlvBer::operator=(TlvBer&& other)
+{
+    if (this != &other) {
+        m_class = other.m_class;
+        m_type = other.m_type;
+        m_tagNumber = other.m_tagNumber;
+        m_tag = other.m_tag;
+        m_value = std::move(other.m_value);
+        m_valuesConstructed = std::move(other.m_valuesConstructed);
+        m_index = std::move(other.m_index);
+        UpdateViews();
+        other.UpdateViews();
+        other.m_index.clear();
+    }
+
+    return *this;
+}
+
+TlvBer::allocator_type
+TlvBer::get_allocator() const noexcept
+{
+    return m_valuesConstructed.get_allocator();
+}
+
+void
+TlvBer::UpdateViews() noexcept
 {
     ::Tlv::Tag = m_tag;
-    ::Tlv::Value = std::span<const uint8_t>{};
+    ::Tlv::Value = m_value;
+
+    m_valueSize = 0;
+    if (IsPrimitive()) {
+        m_valueSize = m_value.size();
+    } else {
+        for (const auto& tlv : m_valuesConstructed) {
+            m_valueSize += tlv.EncodedSize();
+        }
+    }
+
+    m_length.clear();
+    WriteLengthEncoding(m_valueSize, std::back_inserter(m_length));
 }
 
 /* static */
@@ -93,18 +246,91 @@ TlvBer::GetTag() const noexcept
     return m_tag;
 }
 
-const std::vector<uint8_t>&
+std::span<const uint8_t>
 TlvBer::GetValue() const noexcept
 {
     return m_value;
 }
 
-const std::vector<TlvBer>&
+const std::pmr::vector<TlvBer>&
 TlvBer::GetValues() const noexcept
 {
     return m_valuesConstructed;
 }
 
+uint32_t
+TlvBer::GetTagValue() const noexcept
+{
+    return GetTagValue(m_tag);
+}
+
+void
+TlvBer::BuildIndex()
+{
+    m_index.clear();
+    if (m_valuesConstructed.size() < IndexThreshold) {
+        return;
+    }
+
+    m_index.reserve(m_valuesConstructed.size());
+    for (std::size_t position = 0; position < m_valuesConstructed.size(); position++) {
+        m_index.push_back({ m_valuesConstructed[position].GetTagValue(), static_cast<uint32_t>(position) });
+    }
+    std::ranges::sort(m_index);
+}
+
+std::span<const TlvBer::IndexEntry>
+TlvBer::GetIndexEntries(uint32_t tag) const
+{
+    const auto [first, last] = std::ranges::equal_range(m_index, tag, std::less<>{}, &IndexEntry::Tag);
+    return { first, last };
+}
+
+const TlvBer*
+TlvBer::Find(uint32_t tag) const
+{
+    if (m_valuesConstructed.size() < IndexThreshold) {
+        const auto value = std::ranges::find_if(m_valuesConstructed, [&](const auto& tlv) {
+            return tlv.GetTagValue() == tag;
+        });
+        return (value != std::cend(m_valuesConstructed)) ? &(*value) : nullptr;
+    }
+
+    const auto indexEntries = GetIndexEntries(tag);
+    return indexEntries.empty() ? nullptr : &m_valuesConstructed[indexEntries.front().Position];
+}
+
+const TlvBer*
+TlvBer::Find(std::initializer_list<uint32_t> path) const
+{
+    const std::span<const uint32_t> tags{ std::begin(path), std::size(path) };
+    const TlvBer* tlv = FindPath(*this, tags);
+    if (tlv == nullptr && !tags.empty() && tags.front() == GetTagValue()) {
+        tlv = FindPath(*this, tags.subspan(1));
+    }
+
+    return tlv;
+}
+
+std::vector<const TlvBer*>
+TlvBer::FindAll(uint32_t tag) const
+{
+    std::vector<const TlvBer*> values{};
+    if (m_valuesConstructed.size() < IndexThreshold) {
+        for (const auto& value : m_valuesConstructed) {
+            if (value.GetTagValue() == tag) {
+                values.push_back(&value);
+            }
+        }
+    } else {
+        for (const auto& indexEntry : GetIndexEntries(tag)) {
+            values.push_back(&m_valuesConstructed[indexEntry.Position]);
+        }
+    }
+
+    return values;
+}
+
 bool
 TlvBer::IsConstructed() const noexcept
 {
@@ -118,40 +344,103 @@ TlvBer::IsPrimitive() const noexcept
 }
 
 std::vector<uint8_t>
-// Static-analysis flags false positive as ToBytes() is called no another instance, thus is not actually recursive.
+TlvBer::ToBytes(EncodingRules encodingRules) const
+{
+    std::vector<uint8_t> bytes(EncodedSize());
+    Encode(bytes, encodingRules);
+    return bytes;
+}
+
+std::size_t
+TlvBer::EncodedSize() const noexcept
+{
+    return m_tag.size() + m_length.size() + m_valueSize;
+}
+
+std::size_t
+TlvBer::Encode(std::span<uint8_t> output, EncodingRules encodingRules) const
+{
+    const auto encodedSize = EncodedSize();
+    if (output.size() < encodedSize) {
+        throw std::length_error("output buffer too small to hold TlvBer encoding");
+    }
+
+    if (encodingRules == EncodingRules::Distinguished) {
+        EncodeDistinguished(output.first(encodedSize));
+    } else {
+        Encode(std::begin(output));
+    }
+
+    return encodedSize;
+}
+
+bool
+TlvBer::IsSet() const noexcept
+{
+    return m_class == TlvBer::Class::Universal && IsConstructed() && m_tagNumber == TagNumberSet;
+}
+
+void
 // NOLINTNEXTLINE(misc-no-recursion)
-TlvBer::ToBytes() const
+TlvBer::EncodeDistinguished(std::span<uint8_t> output) const
 {
-    std::vector<uint8_t> value;
+    auto outputIt = std::copy(std::cbegin(m_tag), std::cend(m_tag), std::begin(output));
+    outputIt = std::copy(std::cbegin(m_length), std::cend(m_length), outputIt);
 
     if (IsPrimitive()) {
-        value = m_value;
-    } else {
-        for (const auto& tlv : m_valuesConstructed) {
-            auto data = tlv.ToBytes();
-            value.insert(std::cend(value), std::make_move_iterator(std::begin(data)), std::make_move_iterator(std::end(data)));
-        }
+        std::copy(std::cbegin(m_value), std::cend(m_value), outputIt);
+        return;
     }
 
-    const auto lengthEncoding = TlvBer::GetLengthEncoding(value.size());
+    // Encode the nested TLVs in place, then sort the encodings of SET members
+    // (X.690 11.6). The encodings are compared as octet strings, with shorter
+    // encodings padded with trailing zero octets, and then by size.
+    auto valueOutput = output.subspan(static_cast<std::size_t>(std::distance(std::begin(output), outputIt)));
+    std::vector<std::span<uint8_t>> encodings{};
+    encodings.reserve(m_valuesConstructed.size());
+    for (const auto& tlv : m_valuesConstructed) {
+        auto encoding = valueOutput.first(tlv.EncodedSize());
+        tlv.EncodeDistinguished(encoding);
+        encodings.push_back(encoding);
+        valueOutput = valueOutput.subspan(encoding.size());
+    }
 
-    // Build the byte array.
-    std::vector<uint8_t> accumulate;
-    accumulate.insert(std::cend(accumulate), std::cbegin(m_tag), std::cend(m_tag));
-    accumulate.insert(std::cend(accumulate), std::cbegin(lengthEncoding), std::cend(lengthEncoding));
-    accumulate.insert(std::cend(accumulate), std::cbegin(value), std::cend(value));
-    return accumulate;
+    if (!IsSet()) {
+        return;
+    }
+
+    std::vector<std::vector<uint8_t>> encodingsSorted{};
+    encodingsSorted.reserve(encodings.size());
+    for (const auto& encoding : encodings) {
+        encodingsSorted.emplace_back(std::cbegin(encoding), std::cend(encoding));
+    }
+    std::ranges::sort(encodingsSorted, [](const auto& lhs, const auto& rhs) {
+        const auto size = std::max(lhs.size(), rhs.size());
+        for (std::size_t i = 0; i < size; i++) {
+            const uint8_t octetLhs = (i < lhs.size()) ? lhs[i] : 0;
+            const uint8_t octetRhs = (i < rhs.size()) ? rhs[i] : 0;
+            if (octetLhs != octetRhs) {
+                return octetLhs < octetRhs;
+            }
+        }
+        return lhs.size() < rhs.size();
+    });
+
+    auto valueIt = outputIt;
+    for (const auto& encoding : encodingsSorted) {
+        valueIt = std::ranges::copy(encoding, valueIt).out;
+    }
 }
 
 Tlv::ParseResult
-TlvBer::ParseConstructedValue(std::vector<TlvBer>& valueOutput, std::size_t length, std::span<uint8_t> dataInput, std::size_t& bytesParsedOverall)
+TlvBer::ParseConstructedValue(std::pmr::vector<TlvBer>& valueOutput, std::size_t length, std::span<const uint8_t> dataInput, std::size_t& bytesParsedOverall)
 {
     bytesParsedOverall = 0;
     std::size_t bytesParsed = 0;
-    std::span<uint8_t> subspan = dataInput;
+    std::span<const uint8_t> subspan = dataInput;
 
     while (bytesParsedOverall < length) {
-        TlvBer subtlv{};
+        TlvBer subtlv{ valueOutput.get_allocator() };
         auto parseResult = Parse(subtlv, subspan, bytesParsed);
         if (parseResult != Tlv::ParseResult::Succeeded) {
             return parseResult;
@@ -170,19 +459,21 @@ TlvBer::ParseConstructedValue(std::vector<TlvBer>& valueOutput, std::size_t leng
 }
 
 Tlv::ParseResult
-TlvBer::Parse(TlvBer& tlvOutput, std::span<uint8_t> dataInput, std::size_t& bytesParsedOverall)
+TlvBer::Parse(TlvBer& tlvOutput, std::span<const uint8_t> dataInput, std::size_t& bytesParsedOverall)
 {
     // Parse tag.
+    const auto allocator = tlvOutput.get_allocator();
     auto tlvClass = TlvBer::Class::Invalid;
     auto tlvType = TlvBer::Type::Primitive;
     uint32_t tagNumber = 0;
-    std::vector<uint8_t> tag;
+    TagOctetsDiscard tagOctets{};
     std::size_t offset = 0;
     std::size_t bytesParsed = 0;
-    auto parseResult = ParseTag(tlvClass, tlvType, tagNumber, tag, dataInput, bytesParsed);
+    auto parseResult = ParseTag(tlvClass, tlvType, tagNumber, tagOctets, dataInput, bytesParsed);
     if (parseResult != Tlv::ParseResult::Succeeded) {
         return parseResult;
     }
+    const auto tag = dataInput.first(bytesParsed);
 
     // Parse length.
     offset += bytesParsed;
@@ -197,19 +488,18 @@ TlvBer::Parse(TlvBer& tlvOutput, std::span<uint8_t> dataInput, std::size_t& byte
     offset += bytesParsed;
     subspan = dataInput.subspan(offset);
     if (tlvType == Type::Constructed) {
-        std::vector<TlvBer> values;
+        std::pmr::vector<TlvBer> values{ allocator };
         parseResult = ParseConstructedValue(values, length, subspan, bytesParsed);
         if (parseResult != Tlv::ParseResult::Succeeded) {
             return parseResult;
         }
-        tlvOutput = TlvBer(tlvClass, tlvType, tagNumber, tag, values);
+        tlvOutput = TlvBer(tlvClass, tlvType, tagNumber, tag, values, allocator);
     } else {
-        std::vector<uint8_t> value;
-        parseResult = ParsePrimitiveValue(value, length, subspan, bytesParsed);
-        if (parseResult != Tlv::ParseResult::Succeeded) {
-            return parseResult;
+        if (subspan.size() < length) {
+            return Tlv::ParseResult::Failed;
         }
-        tlvOutput = TlvBer(tlvClass, tlvType, tagNumber, tag, value);
+        bytesParsed = length;
+        tlvOutput = TlvBer(tlvClass, tlvType, tagNumber, tag, subspan.first(length), allocator);
     }
 
     offset += bytesParsed;
@@ -218,51 +508,164 @@ TlvBer::Parse(TlvBer& tlvOutput, std::span<uint8_t> dataInput, std::size_t& byte
     return ParseResult::Succeeded;
 }
 
+/* static */
+Tlv::ParseResult
+TlvBer::ParseSequence(std::span<const uint8_t> dataInput, const ParseSequenceCallback& onTlvParsed, std::size_t concurrency, const allocator_type& allocator)
+{
+    std::vector<std::span<const uint8_t>> encodings{};
+    const auto scanResult = ScanSequence(dataInput, encodings);
+
+    // Decode and report each tlv in turn, so only one is held at a time.
+    concurrency = std::min(concurrency, encodings.size());
+    if (concurrency <= 1) {
+        return ParseSequenceTlvs(encodings, onTlvParsed, allocator) ? scanResult : Tlv::ParseResult::Failed;
+    }
+
+    // Decode contiguous runs of tlvs in parallel, reporting each run once it
+    // and all runs preceding it have been decoded.
+    const auto runSize = (encodings.size() + concurrency - 1) / concurrency;
+    const auto numRuns = (encodings.size() + runSize - 1) / runSize;
+    std::vector<std::vector<TlvBer>> runs(numRuns);
+    std::vector<std::future<bool>> runResults{};
+    runResults.reserve(numRuns);
+
+    for (std::size_t i = 0; i < numRuns; i++) {
+        const auto runEncodings = std::span{ encodings }.subspan(i * runSize, std::min(runSize, encodings.size() - i * runSize));
+        runResults.push_back(std::async(std::launch::async, [runEncodings, &run = runs[i], &allocator] {
+            run.reserve(runEncodings.size());
+            return ParseSequenceTlvs(runEncodings, [&](TlvBer& tlv) {
+                run.push_back(std::move(tlv));
+            }, allocator);
+        }));
+    }
+
+    for (std::size_t i = 0; i < numRuns; i++) {
+        const bool runSucceeded = runResults[i].get();
+        for (auto& tlv : runs[i]) {
+            onTlvParsed(tlv);
+        }
+        runs[i].clear();
+        if (!runSucceeded) {
+            return Tlv::ParseResult::Failed;
+        }
+    }
+
+    return scanResult;
+}
+
+/* static */
+Tlv::ParseResult
+TlvBer::ScanSequence(std::span<const uint8_t> dataInput, std::vector<std::span<const uint8_t>>& encodings)
+{
+    while (!dataInput.empty()) {
+        std::size_t encodingSize = 0;
+
+        // Fast path for a single octet tag and short-form length, which
+        // describes the vast majority of tlvs in practice.
+        if (dataInput.size() >= 2 && (dataInput[0] & BitmaskTagFirstByte) != TagValueLongField && (dataInput[1] & BitmaskLengthForm) == LengthFormShort) {
+            encodingSize = 2 + dataInput[1];
+        } else {
+            auto tlvClass = TlvBer::Class::Invalid;
+            auto tlvType = TlvBer::Type::Primitive;
+            uint32_t tagNumber = 0;
+            TagOctetsDiscard tagOctets{};
+            std::size_t tagSize = 0;
+            auto parseResult = ParseTag(tlvClass, tlvType, tagNumber, tagOctets, dataInput, tagSize);
+            if (parseResult != Tlv::ParseResult::Succeeded) {
+                return parseResult;
+            }
+
+            std::size_t length = 0;
+            std::size_t lengthSize = 0;
+            auto subspan = dataInput.subspan(tagSize);
+            parseResult = ParseLength(length, subspan, lengthSize);
+            if (parseResult != Tlv::ParseResult::Succeeded) {
+                return parseResult;
+            }
+
+            encodingSize = tagSize + lengthSize + length;
+        }
+
+        if (encodingSize > dataInput.size()) {
+            return Tlv::ParseResult::Failed;
+        }
+
+        encodings.push_back(dataInput.first(encodingSize));
+        dataInput = dataInput.subspan(encodingSize);
+    }
+
+    return Tlv::ParseResult::Succeeded;
+}
+
+/* static */
+bool
+TlvBer::ParseSequenceTlvs(std::span<const std::span<const uint8_t>> encodings, const ParseSequenceCallback& onTlvParsed, const allocator_type& allocator)
+{
+    for (const auto encoding : encodings) {
+        TlvBer tlv{ allocator };
+        std::size_t bytesParsed = 0;
+        if (Parse(tlv, encoding, bytesParsed) != Tlv::ParseResult::Succeeded || bytesParsed != encoding.size()) {
+            return false;
+        }
+        onTlvParsed(tlv);
+    }
+
+    return true;
+}
+
 void
 TlvBer::Builder::WriteLength(uint64_t length)
 {
-    const auto lengthEncoding = TlvBer::GetLengthEncoding(length);
-    m_data.insert(std::cend(m_data), std::cbegin(lengthEncoding), std::cend(lengthEncoding));
+    TlvBer::WriteLengthEncoding(length, std::back_inserter(m_data));
+}
+
+TlvBer::Builder::Builder(const allocator_type& allocator) :
+    m_data(allocator),
+    m_valuesConstructed(allocator)
+{}
+
+TlvBer::Builder::allocator_type
+TlvBer::Builder::get_allocator() const noexcept
+{
+    return m_data.get_allocator();
 }
 
 TlvBer::Builder&
 TlvBer::Builder::SetTag(uint8_t tag)
 {
-    TlvBer::ParseTag(m_class, m_type, m_tagNumber, m_tag, tag);
-    return *this;
+    const std::array<uint8_t, 1> tagArray{ tag };
+    return SetTag(tagArray);
 }
 
+std::span<const uint8_t>
+TlvBer::GetLengthEncoding() const noexcept
+{
+    return m_length;
+}
+
+/* static */
 std::vector<uint8_t>
 TlvBer::GetLengthEncoding(std::size_t length)
+{
+    std::vector<uint8_t> encoding(GetLengthEncodingSize(length));
+    WriteLengthEncoding(length, std::begin(encoding));
+    return encoding;
+}
+
+/* static */
+std::size_t
+TlvBer::GetLengthEncodingSize(std::size_t length) noexcept
 {
     // Short-form, values 0-127.
     if (length <= LengthFormShortMax) {
-        return { static_cast<uint8_t>(length) };
-    }
-
-    // Long-form, values 128+.
-    std::size_t numBytes = 0;
-    std::vector<uint8_t> encoding;
-
-    // Successively encode length value with big endian byte ordering.
-    while (length > 0) {
-        encoding.push_back(length & 0xFFU);
-        length >>= 8U;
-        numBytes++;
+        return 1;
     }
 
-    // Encode the long-format indicator and number of trailing bytes.
-    encoding.push_back((numBytes & BitmaskLengthNumOctets) | LengthFormLong);
-
-    // Ensure returned encoding is big-endian, accounting for host endianness.
-    if constexpr (std::endian::native == std::endian::big) {
-        return encoding;
-    } else {
-        return {
-            std::make_move_iterator(std::rbegin(encoding)),
-            std::make_move_iterator(std::rend(encoding))
-        };
-    }
+    // Long-form, values 128+; one octet for the long-format indicator and
+    // number of trailing bytes, followed by the minimum number of octets
+    // needed to hold the value.
+    const auto numBits = static_cast<std::size_t>(std::bit_width(length));
+    return 1 + ((numBits + 7U) / 8U);
 }
 
 void
@@ -300,7 +703,7 @@ TlvBer::Builder::SetAsCopyOfTlv(const TlvBer& tlv)
     m_type = tlv.m_type;
     m_tagNumber = tlv.m_tagNumber;
     m_tag = tlv.m_tag;
-    m_data = tlv.m_value;
+    m_data.assign(std::cbegin(tlv.m_value), std::cend(tlv.m_value));
     m_valuesConstructed = tlv.m_valuesConstructed;
     return *this;
 }
@@ -308,7 +711,13 @@ TlvBer::Builder::SetAsCopyOfTlv(const TlvBer& tlv)
 TlvBer::Builder&
 TlvBer::Builder::Reset()
 {
-    *this = {};
+    // Clear, rather than replace, the storage to retain the allocator.
+    m_class = TlvBer::Class::Invalid;
+    m_type = TlvBer::Type::Primitive;
+    m_tagNumber = 0;
+    m_tag.clear();
+    m_data.clear();
+    m_valuesConstructed.clear();
     return *this;
 }
 
@@ -317,9 +726,9 @@ TlvBer::Builder::Build()
 {
     ValidateTag();
     if (m_type == TlvBer::Type::Primitive) {
-        return TlvBer{ m_class, m_type, m_tagNumber, m_tag, m_data };
+        return TlvBer{ m_class, m_type, m_tagNumber, m_tag, m_data, get_allocator() };
     }
-    return TlvBer{ m_class, m_type, m_tagNumber, m_tag, m_valuesConstructed };
+    return TlvBer{ m_class, m_type, m_tagNumber, m_tag, m_valuesConstructed, get_allocator() };
 }
 
 void
@@ -0,0 +1,224 @@
+
+#include <algorithm>
+#include <iterator>
+#include <utility>
+
+#include <tlv/TlvBerDecoder.hxx>
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers)
+
+using namespace encoding;
+
+namespace
+{
+/**
+ * @brief The maximum number of octets in a tag supported by TlvBer::ParseTag.
+ */
+constexpr std::size_t MaxNumOctetsInTag = 3;
+} // namespace
+
+TlvBerDecoder::TlvBerDecoder(TlvDecodedCallback onTlvDecoded) :
+    m_onTlvDecoded(std::move(onTlvDecoded))
+{}
+
+TlvBerDecoder::Result
+TlvBerDecoder::Push(std::span<const uint8_t> data)
+{
+    if (m_state == State::Failed) {
+        return Result::Failed;
+    }
+
+    while (!data.empty()) {
+        std::size_t bytesConsumed = 1;
+        bool succeeded = true;
+
+        switch (m_state) {
+        case State::Tag:
+            succeeded = ConsumeTagOctet(data.front());
+            break;
+        case State::Length:
+            succeeded = ConsumeLengthOctet(data.front());
+            break;
+        case State::Value:
+            bytesConsumed = ConsumeValueOctets(data);
+            break;
+        case State::Failed:
+            return Result::Failed;
+        }
+
+        if (!succeeded) {
+            m_state = State::Failed;
+            return Result::Failed;
+        }
+
+        data = data.subspan(bytesConsumed);
+    }
+
+    return BytesRequired() == 0 ? Result::Succeeded : Result::NeedMoreData;
+}
+
+std::size_t
+TlvBerDecoder::BytesRequired() const noexcept
+{
+    // The extent of the outermost TLV is known, so the exact count is too.
+    if (!m_frames.empty()) {
+        return m_frames.front().EndOffset - m_offset;
+    }
+
+    switch (m_state) {
+    case State::Tag:
+        return m_headerOctetsCount == 0 ? 0 : 1;
+    case State::Length: {
+        if (m_headerOctetsCount == 0) {
+            return 1;
+        }
+        const auto numFollowingOctets = static_cast<std::size_t>(m_headerOctets[0] & TlvBer::BitmaskLengthNumOctets);
+        return 1 + numFollowingOctets - m_headerOctetsCount;
+    }
+    case State::Value:
+        return m_length - m_value.size();
+    case State::Failed:
+    default:
+        return 0;
+    }
+}
+
+void
+TlvBerDecoder::Reset() noexcept
+{
+    m_state = State::Tag;
+    m_offset = 0;
+    m_headerOctetsCount = 0;
+    m_tag.clear();
+    m_value.clear();
+    m_frames.clear();
+}
+
+bool
+TlvBerDecoder::ConsumeTagOctet(uint8_t octet)
+{
+    m_offset++;
+    m_headerOctets[m_headerOctetsCount++] = octet;
+
+    // Determine whether more tag octets follow. See ISO/IEC 7816-4, 2005-01-15
+    // section 5.2.2.1 'BER-TLV tag fields'.
+    bool tagComplete = false;
+    if (m_headerOctetsCount == 1) {
+        tagComplete = ((octet & TlvBer::BitmaskTagFirstByte) != TlvBer::TagValueLongField);
+    } else if (m_headerOctetsCount < MaxNumOctetsInTag) {
+        tagComplete = ((octet & TlvBer::BitmaskTagLastByte) != TlvBer::TagValueLastByte);
+    } else {
+        tagComplete = true;
+    }
+
+    if (!tagComplete) {
+        return true;
+    }
+
+    const std::span<const uint8_t> tagOctets{ std::data(m_headerOctets), m_headerOctetsCount };
+    std::size_t bytesParsed = 0;
+    m_tag.clear();
+    const auto parseResult = TlvBer::ParseTag(m_class, m_type, m_tagNumber, m_tag, tagOctets, bytesParsed);
+    if (parseResult != Tlv::ParseResult::Succeeded || bytesParsed != m_headerOctetsCount) {
+        return false;
+    }
+
+    m_headerOctetsCount = 0;
+    m_state = State::Length;
+    return true;
+}
+
+bool
+TlvBerDecoder::ConsumeLengthOctet(uint8_t octet)
+{
+    m_offset++;
+    m_headerOctets[m_headerOctetsCount++] = octet;
+
+    std::size_t numFollowingOctets = 0;
+    if ((m_headerOctets[0] & TlvBer::BitmaskLengthForm) == TlvBer::LengthFormLong) {
+        numFollowingOctets = m_headerOctets[0] & TlvBer::BitmaskLengthNumOctets;
+        if (numFollowingOctets >= TlvBer::MaxNumOctetsInLengthEncoding) {
+            return false;
+        }
+    }
+
+    if (m_headerOctetsCount < 1 + numFollowingOctets) {
+        return true;
+    }
+
+    const std::span<const uint8_t> lengthOctets{ std::data(m_headerOctets), m_headerOctetsCount };
+    std::size_t bytesParsed = 0;
+    const auto parseResult = TlvBer::ParseLength(m_length, lengthOctets, bytesParsed);
+    if (parseResult != Tlv::ParseResult::Succeeded) {
+        return false;
+    }
+
+    m_headerOctetsCount = 0;
+    return OnHeaderDecoded();
+}
+
+std::size_t
+TlvBerDecoder::ConsumeValueOctets(std::span<const uint8_t> data)
+{
+    const auto bytesConsumed = std::min(data.size(), m_length - m_value.size());
+    m_value.insert(std::cend(m_value), std::cbegin(data), std::next(std::cbegin(data), static_cast<std::ptrdiff_t>(bytesConsumed)));
+    m_offset += bytesConsumed;
+
+    if (m_value.size() == m_length) {
+        OnTlvDecoded(TlvBer{ m_class, m_type, m_tagNumber, m_tag, m_value });
+        m_value.clear();
+    }
+
+    return bytesConsumed;
+}
+
+bool
+TlvBerDecoder::OnHeaderDecoded()
+{
+    const auto endOffset = m_offset + m_length;
+
+    // A nested TLV must not extend beyond its enclosing TLV.
+    if (!m_frames.empty() && endOffset > m_frames.back().EndOffset) {
+        return false;
+    }
+
+    if (m_length == 0) {
+        if (m_type == TlvBer::Type::Constructed) {
+            std::pmr::vector<TlvBer> values{};
+            OnTlvDecoded(TlvBer{ m_class, m_type, m_tagNumber, m_tag, values });
+        } else {
+            OnTlvDecoded(TlvBer{ m_class, m_type, m_tagNumber, m_tag, std::span<const uint8_t>{} });
+        }
+    } else if (m_type == TlvBer::Type::Constructed) {
+        m_frames.push_back({ m_class, m_type, m_tagNumber, m_tag, endOffset, {} });
+        m_tag.clear();
+        m_state = State::Tag;
+    } else {
+        m_state = State::Value;
+    }
+
+    return true;
+}
+
+void
+TlvBerDecoder::OnTlvDecoded(TlvBer tlv)
+{
+    m_state = State::Tag;
+
+    // Add the TLV to its enclosing constructed TLV, completing that one too
+    // if this was its last nested TLV, and so on.
+    while (!m_frames.empty()) {
+        auto& frame = m_frames.back();
+        frame.Values.push_back(std::move(tlv));
+        if (m_offset < frame.EndOffset) {
+            return;
+        }
+
+        tlv = TlvBer{ frame.Class, frame.Type, frame.TagNumber, frame.Tag, frame.Values };
+        m_frames.pop_back();
+    }
+
+    m_onTlvDecoded(tlv);
+}
+
+// NOLINTEND(cppcoreguidelines-avoid-magic-numbers)
@@ -0,0 +1,251 @@
+
+#include <algorithm>
+
+#include <tlv/TlvBerView.hxx>
+
+using namespace encoding;
+
+namespace
+{
+/**
+ * @brief Tag container which discards the tag octets. Views refer to the tag
+ * octets in the parsed buffer directly, so they never need to be copied.
+ */
+struct TagOctetsDiscard
+{
+    void
+    push_back(uint8_t /* octet */) noexcept
+    {}
+};
+} // namespace
+
+bool
+TlvBerView::IsConstructed() const noexcept
+{
+    return m_type == TlvBer::Type::Constructed;
+}
+
+bool
+TlvBerView::IsPrimitive() const noexcept
+{
+    return m_type == TlvBer::Type::Primitive;
+}
+
+TlvBer::Type
+TlvBerView::GetType() const noexcept
+{
+    return m_type;
+}
+
+TlvBer::Class
+TlvBerView::GetClass() const noexcept
+{
+    return m_class;
+}
+
+uint32_t
+TlvBerView::GetTagNumber() const noexcept
+{
+    return m_tagNumber;
+}
+
+std::span<const uint8_t>
+TlvBerView::GetTag() const noexcept
+{
+    return Tag;
+}
+
+std::span<const uint8_t>
+TlvBerView::GetValue() const noexcept
+{
+    return Value;
+}
+
+TlvBerView::Values
+TlvBerView::GetValues() const noexcept
+{
+    return IsConstructed() ? Values{ Value } : Values{};
+}
+
+std::span<const uint8_t>
+TlvBerView::GetEncoding() const noexcept
+{
+    return m_encoding;
+}
+
+TlvBer
+TlvBerView::ToTlvBer(const TlvBer::allocator_type& allocator) const
+{
+    TlvBer tlv{ allocator };
+    std::size_t bytesParsed = 0;
+    TlvBer::Parse(tlv, m_encoding, bytesParsed);
+    return tlv;
+}
+
+bool
+TlvBerView::operator==(const TlvBerView& other) const noexcept
+{
+    return std::ranges::equal(m_encoding, other.m_encoding);
+}
+
+/* static */
+Tlv::ParseResult
+TlvBerView::ParseHeader(TlvBerView& tlvOutput, std::span<const uint8_t> dataInput, std::size_t& bytesParsedOverall)
+{
+    // Parse tag.
+    auto tlvClass = TlvBer::Class::Invalid;
+    auto tlvType = TlvBer::Type::Primitive;
+    uint32_t tagNumber = 0;
+    TagOctetsDiscard tag{};
+    std::size_t bytesParsed = 0;
+    auto parseResult = TlvBer::ParseTag(tlvClass, tlvType, tagNumber, tag, dataInput, bytesParsed);
+    if (parseResult != Tlv::ParseResult::Succeeded) {
+        return parseResult;
+    }
+
+    // Parse length.
+    const std::size_t tagLength = bytesParsed;
+    std::size_t length = 0;
+    auto subspan = dataInput.subspan(tagLength);
+    parseResult = TlvBer::ParseLength(length, subspan, bytesParsed);
+    if (parseResult != Tlv::ParseResult::Succeeded) {
+        return parseResult;
+    }
+
+    // Locate value.
+    const std::size_t offset = tagLength + bytesParsed;
+    if (dataInput.size() - offset < length) {
+        return Tlv::ParseResult::Failed;
+    }
+
+    tlvOutput.m_class = tlvClass;
+    tlvOutput.m_type = tlvType;
+    tlvOutput.m_tagNumber = tagNumber;
+    tlvOutput.m_encoding = dataInput.first(offset + length);
+    tlvOutput.Tag = dataInput.first(tagLength);
+    tlvOutput.Value = dataInput.subspan(offset, length);
+    bytesParsedOverall = offset + length;
+
+    return Tlv::ParseResult::Succeeded;
+}
+
+/* static */
+Tlv::ParseResult
+// Recursion depth is bounded by the input size since each nesting level consumes at least two octets.
+// NOLINTNEXTLINE(misc-no-recursion)
+TlvBerView::ValidateConstructedValue(std::span<const uint8_t> dataInput)
+{
+    std::size_t bytesParsed = 0;
+    while (!dataInput.empty()) {
+        TlvBerView subtlv{};
+        auto parseResult = Parse(subtlv, dataInput, bytesParsed);
+        if (parseResult != Tlv::ParseResult::Succeeded) {
+            return parseResult;
+        }
+
+        dataInput = dataInput.subspan(bytesParsed);
+    }
+
+    return Tlv::ParseResult::Succeeded;
+}
+
+/* static */
+Tlv::ParseResult
+// NOLINTNEXTLINE(misc-no-recursion)
+TlvBerView::Parse(TlvBerView& tlvOutput, std::span<const uint8_t> dataInput, std::size_t& bytesParsedOverall)
+{
+    TlvBerView tlv{};
+    std::size_t bytesParsed = 0;
+    auto parseResult = ParseHeader(tlv, dataInput, bytesParsed);
+    if (parseResult != Tlv::ParseResult::Succeeded) {
+        return parseResult;
+    }
+
+    if (tlv.IsConstructed()) {
+        parseResult = ValidateConstructedValue(tlv.Value);
+        if (parseResult != Tlv::ParseResult::Succeeded) {
+            return parseResult;
+        }
+    }
+
+    tlvOutput = tlv;
+    bytesParsedOverall = bytesParsed;
+
+    return Tlv::ParseResult::Succeeded;
+}
+
+TlvBerView::Values::Values(std::span<const uint8_t> data) noexcept :
+    m_data(data)
+{}
+
+TlvBerView::Iterator
+TlvBerView::Values::begin() const noexcept
+{
+    return Iterator{ m_data };
+}
+
+TlvBerView::Iterator
+TlvBerView::Values::end() const noexcept
+{
+    return Iterator{ m_data.last(0) };
+}
+
+bool
+TlvBerView::Values::empty() const noexcept
+{
+    return m_data.empty();
+}
+
+TlvBerView::Iterator::Iterator(std::span<const uint8_t> remaining) noexcept :
+    m_remaining(remaining)
+{
+    Decode();
+}
+
+void
+TlvBerView::Iterator::Decode() noexcept
+{
+    if (m_remaining.empty()) {
+        m_current = {};
+        return;
+    }
+
+    // The enclosing view was fully validated when it was parsed, so decoding
+    // the header is sufficient here and cannot fail.
+    std::size_t bytesParsed = 0;
+    ParseHeader(m_current, m_remaining, bytesParsed);
+}
+
+TlvBerView::Iterator::reference
+TlvBerView::Iterator::operator*() const noexcept
+{
+    return m_current;
+}
+
+TlvBerView::Iterator::pointer
+TlvBerView::Iterator::operator->() const noexcept
+{
+    return &m_current;
+}
+
+TlvBerView::Iterator&
+TlvBerView::Iterator::operator++() noexcept
+{
+    m_remaining = m_remaining.subspan(m_current.m_encoding.size());
+    Decode();
+    return *this;
+}
+
+TlvBerView::Iterator
+TlvBerView::Iterator::operator++(int) noexcept
+{
+    auto iterator = *this;
+    ++(*this);
+    return iterator;
+}
+
+bool
+TlvBerView::Iterator::operator==(const Iterator& other) const noexcept
+{
+    return m_remaining.data() == other.m_remaining.data() && m_remaining.size() == other.m_remaining.size();
+}
@@ -1,7 +1,6 @@
 
-#include <limits>
-
 #include <tlv/TlvSimple.hxx>
+#include <tlv/TlvSimpleView.hxx>
 
 using namespace encoding;
 
@@ -17,41 +16,31 @@ TlvSimple::TlvSimple(uint8_t tag, std::vector<uint8_t> value) :
 Tlv::ParseResult
 TlvSimple::Parse(TlvSimple **tlvOutput, const std::span<uint8_t> &data)
 {
-    Tlv::ParseResult parseResult = Tlv::ParseResult::Failed;
     if (!tlvOutput) {
-        return parseResult;
+        return Tlv::ParseResult::Failed;
     }
     *tlvOutput = nullptr;
 
-    uint8_t tag{};
-    uint16_t length = 0;
-    std::vector<uint8_t> value;
-
-    const auto datasize = data.size();
-    if (datasize < TlvSimple::OneByteLengthMinimumSize) {
-        return parseResult;
-    }
-    tag = data[0];
-    length = (uint8_t)data[1];
-    if (length == TlvSimple::ThreeByteLengthIndicatorValue) {
-        if (datasize < TlvSimple::ThreeByteLengthMinimumSize) {
-            return parseResult;
-        }
-        length = (uint8_t)data[2];
-        length <<= (std::size_t)std::numeric_limits<uint8_t>::digits;
-        length |= (uint8_t)data[3];
-        if (datasize != TlvSimple::ThreeByteLengthMinimumSize + length) {
-            return parseResult;
-        }
-    } else if (datasize != TlvSimple::OneByteLengthMinimumSize + length) {
-        return parseResult;
+    std::unique_ptr<TlvSimple> tlvSimple;
+    auto parseResult = Parse(tlvSimple, data);
+    if (parseResult == Tlv::ParseResult::Succeeded) {
+        *tlvOutput = tlvSimple.release();
     }
-    auto tmpspan = data.last(length);
-    value.assign(std::cbegin(tmpspan), std::cend(tmpspan));
 
-    parseResult = Tlv::ParseResult::Succeeded;
-    auto tlvSimple = std::make_unique<TlvSimple>(tag, std::move(value));
-    *tlvOutput = tlvSimple.release();
+    return parseResult;
+}
+
+/* static */
+Tlv::ParseResult
+TlvSimple::Parse(std::unique_ptr<TlvSimple> &tlvOutput, std::span<const uint8_t> data)
+{
+    TlvSimpleView tlvView{};
+    std::size_t bytesParsed = 0;
+    auto parseResult = TlvSimpleView::Parse(tlvView, data, bytesParsed);
+    if (parseResult != Tlv::ParseResult::Succeeded || bytesParsed != data.size()) {
+        return Tlv::ParseResult::Failed;
+    }
 
+    tlvOutput = tlvView.ToTlvSimple();
     return parseResult;
 }
@@ -0,0 +1,163 @@
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+#include <tlv/TlvSimpleView.hxx>
+
+using namespace encoding;
+
+uint8_t
+TlvSimpleView::GetTag() const noexcept
+{
+    return Tag.empty() ? 0 : Tag[0];
+}
+
+std::span<const uint8_t>
+TlvSimpleView::GetValue() const noexcept
+{
+    return Value;
+}
+
+std::span<const uint8_t>
+TlvSimpleView::GetEncoding() const noexcept
+{
+    return m_encoding;
+}
+
+std::unique_ptr<TlvSimple>
+TlvSimpleView::ToTlvSimple() const
+{
+    return std::make_unique<TlvSimple>(GetTag(), std::vector<uint8_t>(std::cbegin(Value), std::cend(Value)));
+}
+
+bool
+TlvSimpleView::operator==(const TlvSimpleView& other) const noexcept
+{
+    return std::ranges::equal(m_encoding, other.m_encoding);
+}
+
+/* static */
+Tlv::ParseResult
+TlvSimpleView::Parse(TlvSimpleView& tlvOutput, std::span<const uint8_t> dataInput, std::size_t& bytesParsed) noexcept
+{
+    if (dataInput.size() < TlvSimple::OneByteLengthMinimumSize) {
+        return Tlv::ParseResult::Failed;
+    }
+
+    std::size_t offset = TlvSimple::OneByteLengthMinimumSize;
+    std::size_t length = dataInput[1];
+    if (length == TlvSimple::ThreeByteLengthIndicatorValue) {
+        if (dataInput.size() < TlvSimple::ThreeByteLengthMinimumSize) {
+            return Tlv::ParseResult::Failed;
+        }
+        offset = TlvSimple::ThreeByteLengthMinimumSize;
+        length = (static_cast<std::size_t>(dataInput[2]) << static_cast<std::size_t>(std::numeric_limits<uint8_t>::digits)) | dataInput[3];
+    }
+
+    if (dataInput.size() - offset < length) {
+        return Tlv::ParseResult::Failed;
+    }
+
+    tlvOutput.m_encoding = dataInput.first(offset + length);
+    tlvOutput.Tag = dataInput.first(1);
+    tlvOutput.Value = dataInput.subspan(offset, length);
+    bytesParsed = offset + length;
+
+    return Tlv::ParseResult::Succeeded;
+}
+
+/* static */
+TlvSimpleView::Values
+TlvSimpleView::ParseAll(std::span<const uint8_t> dataInput, std::size_t& bytesParsed) noexcept
+{
+    bytesParsed = 0;
+    auto remaining = dataInput;
+    while (!remaining.empty()) {
+        TlvSimpleView tlv{};
+        std::size_t tlvBytesParsed = 0;
+        if (Parse(tlv, remaining, tlvBytesParsed) != Tlv::ParseResult::Succeeded) {
+            break;
+        }
+
+        bytesParsed += tlvBytesParsed;
+        remaining = remaining.subspan(tlvBytesParsed);
+    }
+
+    return Values{ dataInput.first(bytesParsed) };
+}
+
+TlvSimpleView::Values::Values(std::span<const uint8_t> data) noexcept :
+    m_data(data)
+{}
+
+TlvSimpleView::Iterator
+TlvSimpleView::Values::begin() const noexcept
+{
+    return Iterator{ m_data };
+}
+
+TlvSimpleView::Iterator
+TlvSimpleView::Values::end() const noexcept
+{
+    return Iterator{ m_data.last(0) };
+}
+
+bool
+TlvSimpleView::Values::empty() const noexcept
+{
+    return m_data.empty();
+}
+
+TlvSimpleView::Iterator::Iterator(std::span<const uint8_t> remaining) noexcept :
+    m_remaining(remaining)
+{
+    Decode();
+}
+
+void
+TlvSimpleView::Iterator::Decode() noexcept
+{
+    if (m_remaining.empty()) {
+        m_current = {};
+        return;
+    }
+
+    // The range was fully validated when it was parsed, so this cannot fail.
+    std::size_t bytesParsed = 0;
+    Parse(m_current, m_remaining, bytesParsed);
+}
+
+TlvSimpleView::Iterator::reference
+TlvSimpleView::Iterator::operator*() const noexcept
+{
+    return m_current;
+}
+
+TlvSimpleView::Iterator::pointer
+TlvSimpleView::Iterator::operator->() const noexcept
+{
+    return &m_current;
+}
+
+TlvSimpleView::Iterator&
+TlvSimpleView::Iterator::operator++() noexcept
+{
+    m_remaining = m_remaining.subspan(m_current.m_encoding.size());
+    Decode();
+    return *this;
+}
+
+TlvSimpleView::Iterator
+TlvSimpleView::Iterator::operator++(int) noexcept
+{
+    auto iterator = *this;
+    ++(*this);
+    return iterator;
+}
+
+bool
+TlvSimpleView::Iterator::operator==(const Iterator& other) const noexcept
+{
+    return m_remaining.data() == other.m_remaining.data() && m_remaining.size() == other.m_remaining.size();
+}
@@ -0,0 +1,416 @@
+
+#ifndef TLV_SMALL_BUFFER_HXX
+#define TLV_SMALL_BUFFER_HXX
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <span>
+#include <stdexcept>
+#include <utility>
+
+namespace encoding
+{
+/**
+ * @brief Octet buffer with a fixed capacity, stored entirely inline.
+ *
+ * This is intended for short, bounded data such as BER-TLV tags, for which
+ * dynamic allocation is pure overhead.
+ *
+ * @tparam Capacity The maximum number of octets the buffer can hold.
+ */
+template <std::size_t Capacity>
+class InlineBuffer
+{
+    static_assert(Capacity <= UINT8_MAX, "InlineBuffer is intended for short data only");
+
+public:
+    using value_type = uint8_t;
+    using size_type = std::size_t;
+    using iterator = uint8_t*;
+    using const_iterator = const uint8_t*;
+
+    InlineBuffer() = default;
+
+    /**
+     * @brief Construct a new InlineBuffer object with a copy of the specified data.
+     *
+     * @param data The data to copy.
+     * @throws std::length_error if the data exceeds the capacity.
+     */
+    explicit InlineBuffer(std::span<const uint8_t> data)
+    {
+        assign(data);
+    }
+
+    /**
+     * @brief Replace the contents of the buffer with a copy of the specified data.
+     *
+     * @param data The data to copy.
+     * @throws std::length_error if the data exceeds the capacity.
+     */
+    void
+    assign(std::span<const uint8_t> data)
+    {
+        if (data.size() > Capacity) {
+            throw std::length_error("data exceeds InlineBuffer capacity");
+        }
+
+        std::ranges::copy(data, std::begin(m_data));
+        m_size = static_cast<uint8_t>(data.size());
+    }
+
+    /**
+     * @brief Append an octet to the buffer.
+     *
+     * @param octet The octet to append.
+     * @throws std::length_error if the buffer is full.
+     */
+    void
+    push_back(uint8_t octet)
+    {
+        if (m_size == Capacity) {
+            throw std::length_error("InlineBuffer capacity exceeded");
+        }
+
+        m_data[m_size++] = octet;
+    }
+
+    void
+    clear() noexcept
+    {
+        m_size = 0;
+    }
+
+    static constexpr std::size_t
+    capacity() noexcept
+    {
+        return Capacity;
+    }
+
+    std::size_t
+    size() const noexcept
+    {
+        return m_size;
+    }
+
+    bool
+    empty() const noexcept
+    {
+        return m_size == 0;
+    }
+
+    uint8_t*
+    data() noexcept
+    {
+        return std::data(m_data);
+    }
+
+    const uint8_t*
+    data() const noexcept
+    {
+        return std::data(m_data);
+    }
+
+    uint8_t*
+    begin() noexcept
+    {
+        return data();
+    }
+
+    const uint8_t*
+    begin() const noexcept
+    {
+        return data();
+    }
+
+    uint8_t*
+    end() noexcept
+    {
+        return data() + m_size;
+    }
+
+    const uint8_t*
+    end() const noexcept
+    {
+        return data() + m_size;
+    }
+
+    uint8_t
+    operator[](std::size_t index) const noexcept
+    {
+        return m_data[index];
+    }
+
+    bool
+    operator==(const InlineBuffer& other) const noexcept
+    {
+        return std::ranges::equal(*this, other);
+    }
+
+private:
+    std::array<uint8_t, Capacity> m_data{};
+    uint8_t m_size{ 0 };
+};
+
+/**
+ * @brief Octet buffer which stores short data inline, and only allocates
+ * dynamically, from a polymorphic allocator, when the data exceeds the
+ * inline capacity.
+ *
+ * @tparam InlineCapacity The maximum number of octets stored inline.
+ */
+template <std::size_t InlineCapacity>
+class SmallBuffer
+{
+public:
+    using value_type = uint8_t;
+    using size_type = std::size_t;
+    using iterator = uint8_t*;
+    using const_iterator = const uint8_t*;
+    using allocator_type = std::pmr::polymorphic_allocator<>;
+
+    SmallBuffer() = default;
+
+    /**
+     * @brief Construct a new empty SmallBuffer object.
+     *
+     * @param allocator The allocator to use for data exceeding the inline capacity.
+     */
+    explicit SmallBuffer(const allocator_type& allocator) noexcept :
+        m_allocator(allocator)
+    {}
+
+    /**
+     * @brief Construct a new SmallBuffer object with a copy of the specified data.
+     *
+     * @param data The data to copy.
+     * @param allocator The allocator to use for data exceeding the inline capacity.
+     */
+    explicit SmallBuffer(std::span<const uint8_t> data, const allocator_type& allocator = {}) :
+        m_allocator(allocator)
+    {
+        assign(data);
+    }
+
+    /**
+     * @brief Copy constructor. As with standard allocator-aware containers,
+     * the copy uses the default memory resource.
+     *
+     * @param other
+     */
+    SmallBuffer(const SmallBuffer& other) :
+        SmallBuffer(other, allocator_type{})
+    {}
+
+    SmallBuffer(const SmallBuffer& other, const allocator_type& allocator) :
+        SmallBuffer(std::span<const uint8_t>{ other }, allocator)
+    {}
+
+    SmallBuffer(SmallBuffer&& other) noexcept :
+        m_allocator(other.m_allocator)
+    {
+        TakeFrom(other);
+    }
+
+    SmallBuffer(SmallBuffer&& other, const allocator_type& allocator) :
+        m_allocator(allocator)
+    {
+        if (m_allocator == other.m_allocator) {
+            TakeFrom(other);
+        } else {
+            assign(other);
+            other.clear();
+        }
+    }
+
+    SmallBuffer&
+    operator=(const SmallBuffer& other)
+    {
+        if (this != &other) {
+            assign(other);
+        }
+
+        return *this;
+    }
+
+    SmallBuffer&
+    operator=(SmallBuffer&& other)
+    {
+        if (this == &other) {
+            return *this;
+        }
+
+        if (m_allocator == other.m_allocator) {
+            Deallocate();
+            TakeFrom(other);
+        } else {
+            assign(other);
+            other.clear();
+        }
+
+        return *this;
+    }
+
+    ~SmallBuffer()
+    {
+        Deallocate();
+    }
+
+    /**
+     * @brief Replace the contents of the buffer with a copy of the specified data.
+     *
+     * @param data The data to copy.
+     */
+    void
+    assign(std::span<const uint8_t> data)
+    {
+        if (data.size() > m_capacity) {
+            auto* allocation = static_cast<uint8_t*>(m_allocator.allocate_bytes(data.size(), alignof(uint8_t)));
+            Deallocate();
+            m_allocated = allocation;
+            m_capacity = data.size();
+        }
+
+        std::ranges::copy(data, this->data());
+        m_size = data.size();
+    }
+
+    void
+    clear() noexcept
+    {
+        m_size = 0;
+    }
+
+    std::size_t
+    capacity() const noexcept
+    {
+        return m_capacity;
+    }
+
+    /**
+     * @brief Determines whether the data is stored inline.
+     *
+     * @return true
+     * @return false
+     */
+    bool
+    is_inline() const noexcept
+    {
+        return m_allocated == nullptr;
+    }
+
+    std::size_t
+    size() const noexcept
+    {
+        return m_size;
+    }
+
+    bool
+    empty() const noexcept
+    {
+        return m_size == 0;
+    }
+
+    uint8_t*
+    data() noexcept
+    {
+        return is_inline() ? std::data(m_inline) : m_allocated;
+    }
+
+    const uint8_t*
+    data() const noexcept
+    {
+        return is_inline() ? std::data(m_inline) : m_allocated;
+    }
+
+    uint8_t*
+    begin() noexcept
+    {
+        return data();
+    }
+
+    const uint8_t*
+    begin() const noexcept
+    {
+        return data();
+    }
+
+    uint8_t*
+    end() noexcept
+    {
+        return data() + m_size;
+    }
+
+    const uint8_t*
+    end() const noexcept
+    {
+        return data() + m_size;
+    }
+
+    uint8_t
+    operator[](std::size_t index) const noexcept
+    {
+        return data()[index];
+    }
+
+    bool
+    operator==(const SmallBuffer& other) const noexcept
+    {
+        return std::ranges::equal(*this, other);
+    }
+
+    allocator_type
+    get_allocator() const noexcept
+    {
+        return m_allocator;
+    }
+
+private:
+    /**
+     * @brief Release any dynamically allocated storage, reverting to the
+     * inline storage.
+     */
+    void
+    Deallocate() noexcept
+    {
+        if (m_allocated != nullptr) {
+            m_allocator.deallocate_bytes(m_allocated, m_capacity, alignof(uint8_t));
+            m_allocated = nullptr;
+            m_capacity = InlineCapacity;
+        }
+    }
+
+    /**
+     * @brief Take ownership of the contents of another buffer that uses an
+     * equal allocator. This buffer must not hold any dynamically allocated
+     * storage.
+     *
+     * @param other
+     */
+    void
+    TakeFrom(SmallBuffer& other) noexcept
+    {
+        if (other.is_inline()) {
+            std::copy_n(std::data(other.m_inline), other.m_size, std::data(m_inline));
+        } else {
+            m_allocated = std::exchange(other.m_allocated, nullptr);
+            m_capacity = std::exchange(other.m_capacity, InlineCapacity);
+        }
+
+        m_size = std::exchange(other.m_size, 0);
+    }
+
+private:
+    allocator_type m_allocator{};
+    uint8_t* m_allocated{ nullptr };
+    std::size_t m_size{ 0 };
+    std::size_t m_capacity{ InlineCapacity };
+    std::array<uint8_t, InlineCapacity> m_inline{};
+};
+
+} // namespace encoding
+
+#endif // TLV_SMALL_BUFFER_HXX
@@ -2,11 +2,18 @@
 #ifndef TLV_BER_HXX
 #define TLV_BER_HXX
 
+#include <tlv/SmallBuffer.hxx>
 #include <tlv/Tlv.hxx>
 
+#include <algorithm>
 #include <array>
+#include <compare>
 #include <cstddef>
 #include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory_resource>
 #include <span>
 #include <stdexcept>
 #include <type_traits>
@@ -62,6 +69,45 @@ public:
 
     static constexpr uint8_t MaxNumOctetsInLengthEncoding = 5;
 
+    /**
+     * @brief The number of octets reserved inline for each tag. Valid tags
+     * have at most three octets, so tags never allocate.
+     */
+    static constexpr std::size_t TagStorageCapacity = 4;
+
+    /**
+     * @brief The maximum size of a primitive value that is stored inline,
+     * without allocating. Most values of interest (eg. integers, flags,
+     * addresses, and identifiers) fit within this.
+     */
+    static constexpr std::size_t ValueInlineCapacity = 16;
+
+    /**
+     * @brief The number of octets reserved inline for the length encoding,
+     * which is large enough to hold the long-form encoding of any length.
+     */
+    static constexpr std::size_t LengthStorageCapacity = 1 + sizeof(std::size_t);
+
+    /**
+     * @brief The universal tag number of the SET and SET OF types.
+     */
+    static constexpr uint32_t TagNumberSet = 17;
+
+    /**
+     * @brief Storage for the octets of a tag.
+     */
+    using TagStorage = InlineBuffer<TagStorageCapacity>;
+
+    /**
+     * @brief Storage for the octets of a length encoding.
+     */
+    using LengthStorage = InlineBuffer<LengthStorageCapacity>;
+
+    /**
+     * @brief Storage for the octets of a primitive value.
+     */
+    using ValueStorage = SmallBuffer<ValueInlineCapacity>;
+
     /**
      * @brief The class of the TLV.
      */
@@ -81,6 +127,21 @@ public:
         Constructed,
     };
 
+    /**
+     * @brief The rules used to encode a TLV.
+     *
+     * Basic encodes nested TLVs in the order they were added. Distinguished
+     * additionally sorts the nested TLVs of universal SET types by their
+     * encodings, as required by the Distinguished Encoding Rules (DER) of
+     * ITU-T X.690, section 11.6. Lengths are always encoded in their minimal
+     * (definite) form, so equal TLVs encode to identical octets under DER
+     * regardless of the order their members were added.
+     */
+    enum class EncodingRules {
+        Basic,
+        Distinguished,
+    };
+
     /**
      * @brief Determines if the specified tag denotes a constructed TlvBer.
      * 
@@ -121,11 +182,82 @@ public:
     static std::vector<uint8_t>
     GetLengthEncoding(std::size_t length);
 
+    /**
+     * @brief Get the encoding of the length of this TLV's value.
+     *
+     * The encoding is computed once upon construction, so this does not
+     * allocate.
+     *
+     * @return std::span<const uint8_t>
+     */
+    std::span<const uint8_t>
+    GetLengthEncoding() const noexcept;
+
+    /**
+     * @brief Get the number of octets required to encode the length value.
+     * 
+     * @param length The length value to get the encoding size for.
+     * @return std::size_t 
+     */
+    static std::size_t
+    GetLengthEncodingSize(std::size_t length) noexcept;
+
+    /**
+     * @brief Write the encoding of the length value to an output iterator.
+     * 
+     * See ISO/IEC 7816-4, 2005-01-15 section 5.2.2.2 'BER-TLV length fields',
+     * Table 8.
+     * 
+     * @tparam OutputIt 
+     * @param length The length value to write the encoding for.
+     * @param output The output iterator to write the encoding to.
+     * @return OutputIt The output iterator, positioned after the encoding.
+     */
+    template <std::output_iterator<uint8_t> OutputIt>
+    static OutputIt
+    WriteLengthEncoding(std::size_t length, OutputIt output)
+    {
+        // Short-form, values 0-127.
+        if (length <= LengthFormShortMax) {
+            *output++ = static_cast<uint8_t>(length);
+            return output;
+        }
+
+        // Long-form, values 128+. Encode the long-format indicator and number
+        // of trailing bytes, followed by the length value in big-endian byte
+        // ordering.
+        const auto numBytes = GetLengthEncodingSize(length) - 1;
+        *output++ = static_cast<uint8_t>((numBytes & BitmaskLengthNumOctets) | LengthFormLong);
+        for (auto i = numBytes; i > 0; i--) {
+            *output++ = static_cast<uint8_t>((length >> ((i - 1) * 8U)) & 0xFFU);
+        }
+
+        return output;
+    }
+
+    /**
+     * @brief The allocator used for all storage owned by a TlvBer, including
+     * that of nested TlvBers.
+     * 
+     * This allows a complete tree to be allocated from a single memory
+     * resource, such as a std::pmr::monotonic_buffer_resource, and released at
+     * once. Nested TlvBers always use the allocator of their parent.
+     */
+    using allocator_type = std::pmr::polymorphic_allocator<>;
+
     /**
      * @brief Construct a new TlvBer object with no tag and no value.
      */
     TlvBer() = default;
 
+    /**
+     * @brief Construct a new TlvBer object with no tag and no value, using the
+     * specified allocator.
+     * 
+     * @param allocator 
+     */
+    explicit TlvBer(const allocator_type& allocator);
+
     /**
      * @brief Construct a new TlvBer with given tag and value.
      * 
@@ -134,16 +266,66 @@ public:
      * @param tagNumber 
      * @param tag
      * @param value 
+     * @param allocator 
      */
-    TlvBer(TlvBer::Class tlvClass, TlvBer::Type tlvType, uint32_t tagNumber, const std::vector<uint8_t>& tag, const std::vector<uint8_t>& value);
+    TlvBer(TlvBer::Class tlvClass, TlvBer::Type tlvType, uint32_t tagNumber, std::span<const uint8_t> tag, std::span<const uint8_t> value, const allocator_type& allocator = {});
 
     /**
      * @brief Construct a new constructed TlvBer object.
      * 
      * @param tag The tag to use.
-     * @param values The constructed values.
+     * @param values The constructed values. These are moved into the new object.
+     * @param allocator 
      */
-    TlvBer(TlvBer::Class tlvClass, TlvBer::Type tlvType, uint32_t tagNumber, const std::vector<uint8_t>& tag, std::vector<TlvBer>& value);
+    TlvBer(TlvBer::Class tlvClass, TlvBer::Type tlvType, uint32_t tagNumber, std::span<const uint8_t> tag, std::pmr::vector<TlvBer>& values, const allocator_type& allocator = {});
+
+    /**
+     * @brief Copy constructor. As with standard allocator-aware containers,
+     * the copy uses the default memory resource.
+     * 
+     * @param other 
+     */
+    TlvBer(const TlvBer& other);
+
+    /**
+     * @brief Allocator-extended copy constructor.
+     * 
+     * @param other 
+     * @param allocator 
+     */
+    TlvBer(const TlvBer& other, const allocator_type& allocator);
+
+    /**
+     * @brief Move constructor. The new object takes ownership of the storage,
+     * and allocator, of the moved-from object.
+     * 
+     * @param other 
+     */
+    TlvBer(TlvBer&& other) noexcept;
+
+    /**
+     * @brief Allocator-extended move constructor.
+     * 
+     * @param other 
+     * @param allocator 
+     */
+    TlvBer(TlvBer&& other, const allocator_type& allocator);
+
+    TlvBer&
+    operator=(const TlvBer& other);
+
+    TlvBer&
+    operator=(TlvBer&& other);
+
+    ~TlvBer() = default;
+
+    /**
+     * @brief Get the allocator used by this object.
+     * 
+     * @return allocator_type 
+     */
+    allocator_type
+    get_allocator() const noexcept;
 
     /**
      * @brief Returns whether this TLV contains a constructed value.
@@ -198,26 +380,102 @@ public:
     /**
      * @brief Get the primitive value buffer. Returns empty if this object is Constructed
      * 
-     * @return std::vector<uint8_t> 
+     * @return std::span<const uint8_t> 
      */
-    const std::vector<uint8_t>&
+    std::span<const uint8_t>
     GetValue() const noexcept;
 
     /**
      * @brief Get the Values object. Returns empty if this object is Primitive
      * 
-     * @return const std::vector<TlvBer> 
+     * @return const std::pmr::vector<TlvBer>& 
      */
-    const std::vector<TlvBer>&
+    const std::pmr::vector<TlvBer>&
     GetValues() const noexcept;
 
+    /**
+     * @brief Get the tag of the TLV, as an integer.
+     * 
+     * The tag octets are interpreted as a big-endian integer, eg. the tag
+     * { 0xBF, 0x78 } is 0xBF78. This is the form of tag accepted by Find() and
+     * FindAll().
+     * 
+     * @return uint32_t 
+     */
+    uint32_t
+    GetTagValue() const noexcept;
+
+    /**
+     * @brief Get the integer value of the specified tag octets, interpreted
+     * as a big-endian integer.
+     * 
+     * @param tag The tag octets.
+     * @return uint32_t 
+     */
+    static constexpr uint32_t
+    GetTagValue(std::span<const uint8_t> tag) noexcept
+    {
+        uint32_t value = 0;
+        for (const auto octet : tag) {
+            value = (value << 8U) | octet;
+        }
+
+        return value;
+    }
+
+    /**
+     * @brief Find the first nested TLV with the specified tag. Always returns
+     * nullptr if this object is Primitive.
+     * 
+     * Constructed TLVs with many nested TLVs build an index of them when they
+     * are created, so lookups need not scan every nested TLV. Lookups do not
+     * modify the object, so they may be made concurrently.
+     * 
+     * @param tag The tag to find, in the form returned by GetTagValue().
+     * @return const TlvBer* The nested TLV, or nullptr if there is none.
+     */
+    const TlvBer*
+    Find(uint32_t tag) const;
+
+    /**
+     * @brief Find a TLV by following a path of tags through nested TLVs.
+     * 
+     * The first tag is that of a TLV nested directly within this object, the
+     * second is that of a TLV nested within that one, and so on. For example,
+     * for a UWB_SESSION_DATA object (0xBF78), Find({ 0xA3, 0x8B }) finds the
+     * 0x8B parameter within its UWB_CONFIG_DATA object (0xA3). At each level,
+     * the first TLV with a matching tag is followed.
+     *
+     * The path may also begin with the tag of this object, so
+     * Find({ 0xBF78, 0xA3, 0x8B }) finds the same parameter. This form is only
+     * tried if the path cannot be followed from the nested TLVs.
+     * 
+     * @param path The tags to follow, in the form returned by GetTagValue().
+     * @return const TlvBer* The TLV at the end of the path, or nullptr if there is none.
+     */
+    const TlvBer*
+    Find(std::initializer_list<uint32_t> path) const;
+
+    /**
+     * @brief Find all nested TLVs with the specified tag, in order.
+     * 
+     * @param tag The tag to find, in the form returned by GetTagValue().
+     * @return std::vector<const TlvBer*> 
+     */
+    std::vector<const TlvBer*>
+    FindAll(uint32_t tag) const;
+
     /**
      * @brief Parses the tag portion of a BER-TLV from the specified buffer.
      * 
      * Writes to tlvClass, tlvType, tagNumber, tag, and bytesParsed if a proper
      * tag was parsed.
      * 
+     * The tag octets are appended to the tag output using push_back(), so any
+     * container supporting this may be used to receive them.
+     * 
      * @tparam Iterable 
+     * @tparam TagContainerT 
      * @param tlvClass 
      * @param tlvType 
      * @param tagNumber 
@@ -226,9 +484,12 @@ public:
      * @param bytesParsed 
      * @return Tlv::ParseResult 
      */
-    template <typename Iterable>
+    template <typename Iterable, typename TagContainerT>
+    // clang-format off
+    requires requires(TagContainerT& tagContainer, uint8_t octet) { tagContainer.push_back(octet); }
     static Tlv::ParseResult
-    ParseTag(TlvBer::Class& tlvClass, TlvBer::Type& tlvType, uint32_t& tagNumber, std::vector<uint8_t>& tag, Iterable& data, std::size_t& bytesParsed)
+    ParseTag(TlvBer::Class& tlvClass, TlvBer::Type& tlvType, uint32_t& tagNumber, TagContainerT& tag, Iterable& data, std::size_t& bytesParsed)
+    // clang-format on
     {
         auto dataIt = std::cbegin(data);
         auto dataEnd = std::cend(data);
@@ -244,6 +505,7 @@ public:
         if ((*dataIt & BitmaskTagFirstByte) != TagValueLongField) {
             tag.push_back(*dataIt);
             tagNumber = *dataIt & BitmaskTagShort;
+            bytesParsed = 1;
             return Tlv::ParseResult::Succeeded;
         }
 
@@ -351,21 +613,22 @@ public:
      * Writes to valueOutput if a proper value was parsed.
      * 
      * @tparam Iterable 
+     * @tparam ValueContainerT 
      * @param valueOutput 
      * @param length 
      * @param data 
      * @param bytesParsed The number of bytes parsed.
      * @return Tlv::ParseResult 
      */
-    template <typename Iterable>
+    template <typename Iterable, typename ValueContainerT>
     static Tlv::ParseResult
-    ParsePrimitiveValue(std::vector<uint8_t>& valueOutput, std::size_t length, Iterable& data, std::size_t& bytesParsed)
+    ParsePrimitiveValue(ValueContainerT& valueOutput, std::size_t length, Iterable& data, std::size_t& bytesParsed)
     {
         if (std::size(data) < length) {
             return Tlv::ParseResult::Failed;
         }
 
-        valueOutput = { std::cbegin(data), std::cbegin(data) + static_cast<long>(length) };
+        valueOutput.assign(std::cbegin(data), std::cbegin(data) + static_cast<long>(length));
         bytesParsed = length;
 
         return Tlv::ParseResult::Succeeded;
@@ -383,18 +646,52 @@ public:
      * @return Tlv::ParseResult 
      */
     static Tlv::ParseResult
-    ParseConstructedValue(std::vector<TlvBer>& valueOutput, size_t length, std::span<uint8_t> dataInput, size_t& bytesParsedOverall);
+    ParseConstructedValue(std::pmr::vector<TlvBer>& valueOutput, size_t length, std::span<const uint8_t> dataInput, size_t& bytesParsedOverall);
 
     /**
      * @brief Decode a Tlv from a blob of BER-TLV data.
      * 
+     * The decoded Tlv, including all nested Tlvs, is allocated using the
+     * allocator of tlvOutput.
+     * 
      * @param tlvOutput The decoded Tlv, if parsing was successful (ParseResult::Succeeded).
      * @param dataInput The data to parse a Tlv from.
      * @param bytesParsedOverall 
      * @return Tlv::ParseResult The result of the parsing operation.
      */
     static Tlv::ParseResult
-    Parse(TlvBer& tlvOutput, std::span<uint8_t> dataInput, size_t& bytesParsedOverall);
+    Parse(TlvBer& tlvOutput, std::span<const uint8_t> dataInput, size_t& bytesParsedOverall);
+
+    /**
+     * @brief Callback invoked with each Tlv decoded by ParseSequence().
+     */
+    using ParseSequenceCallback = std::function<void(TlvBer&)>;
+
+    /**
+     * @brief Decode a sequence of concatenated top-level Tlvs from a blob of
+     * BER-TLV data, such as a capture of out-of-band messages.
+     * 
+     * The boundaries of all top-level Tlvs are first located from their tag
+     * and length encodings alone, without decoding their values. The Tlvs are
+     * then decoded, optionally in parallel across multiple threads, each
+     * decoding a contiguous run of Tlvs.
+     * 
+     * The callback is always invoked on the calling thread, once per Tlv, in
+     * the order in which the Tlvs appear in the data. If the data contains an
+     * invalid or truncated Tlv, the callback is invoked for each Tlv preceding
+     * it, and parsing fails.
+     * 
+     * When decoding in parallel, the allocator is used concurrently from
+     * multiple threads, so its memory resource must be thread-safe.
+     * 
+     * @param dataInput The data to parse Tlvs from.
+     * @param onTlvParsed The callback to invoke with each decoded Tlv.
+     * @param concurrency The maximum number of threads to decode Tlvs with.
+     * @param allocator The allocator to use for the decoded Tlvs.
+     * @return Tlv::ParseResult The result of the parsing operation.
+     */
+    static Tlv::ParseResult
+    ParseSequence(std::span<const uint8_t> dataInput, const ParseSequenceCallback& onTlvParsed, std::size_t concurrency = 1, const allocator_type& allocator = {});
 
     /**
      * @brief Decode a Tlv from a blob of BER-TLV data.
@@ -423,10 +720,65 @@ public:
     /**
      * @brief Encode this TlvBer into binary and return a vector of bytes.
      * 
+     * @param encodingRules The rules to encode with.
      * @return std::vector<uint8_t> 
      */
     std::vector<uint8_t>
-    ToBytes() const;
+    ToBytes(EncodingRules encodingRules = EncodingRules::Basic) const;
+
+    /**
+     * @brief Get the number of octets required to encode this TlvBer,
+     * including its tag, length, and value. This is the same for all encoding
+     * rules.
+     * 
+     * The size is computed once upon construction, so this is a constant-time
+     * operation. This allows callers to size (and re-use) buffers prior to
+     * calling Encode().
+     * 
+     * @return std::size_t 
+     */
+    std::size_t
+    EncodedSize() const noexcept;
+
+    /**
+     * @brief Encode this TlvBer into binary, writing it to an output iterator.
+     * 
+     * The sizes of all nested values are known up front, so the complete
+     * tree is written in a single pass without any intermediate buffers.
+     * 
+     * @tparam OutputIt 
+     * @param output The output iterator to write the encoding to.
+     * @return OutputIt The output iterator, positioned after the encoding.
+     */
+    template <std::output_iterator<uint8_t> OutputIt>
+    // NOLINTNEXTLINE(misc-no-recursion)
+    OutputIt
+    Encode(OutputIt output) const
+    {
+        output = std::copy(std::cbegin(m_tag), std::cend(m_tag), output);
+        output = std::copy(std::cbegin(m_length), std::cend(m_length), output);
+
+        if (IsPrimitive()) {
+            return std::copy(std::cbegin(m_value), std::cend(m_value), output);
+        }
+
+        for (const auto& tlv : m_valuesConstructed) {
+            output = tlv.Encode(output);
+        }
+
+        return output;
+    }
+
+    /**
+     * @brief Encode this TlvBer into binary, writing it to the specified buffer.
+     * 
+     * @param output The buffer to write the encoding to. This must be at least
+     * EncodedSize() octets in size.
+     * @return std::size_t The number of octets written.
+     * @throws std::length_error if the buffer is too small to hold the encoding.
+     */
+    std::size_t
+    Encode(std::span<uint8_t> output, EncodingRules encodingRules = EncodingRules::Basic) const;
 
     /**
      * @brief Helper class to iteratively build a TlvBer. This allows separating
@@ -446,6 +798,32 @@ public:
      */
     class Builder
     {
+    public:
+        using allocator_type = TlvBer::allocator_type;
+
+        /**
+         * @brief Construct a new Builder object using the default memory
+         * resource.
+         */
+        Builder() = default;
+
+        /**
+         * @brief Construct a new Builder object. All intermediate storage, as
+         * well as the built TlvBer, are allocated using the specified
+         * allocator.
+         * 
+         * @param allocator 
+         */
+        explicit Builder(const allocator_type& allocator);
+
+        /**
+         * @brief Get the allocator used by this builder.
+         * 
+         * @return allocator_type 
+         */
+        allocator_type
+        get_allocator() const noexcept;
+
     private:
         /**
          * @brief Write a fixed-length array of data to the tlv storage buffer.
@@ -509,6 +887,7 @@ public:
         SetTag(Iterable& tag)
         {
             std::size_t bytesParsed = 0;
+            m_tag.clear();
             ParseTag(m_class, m_type, m_tagNumber, m_tag, tag, bytesParsed);
             return *this;
         }
@@ -599,22 +978,112 @@ public:
         TlvBer::Class m_class{ TlvBer::Class::Invalid };
         TlvBer::Type m_type{ TlvBer::Type::Primitive };
         uint32_t m_tagNumber{ 0 };
-        std::vector<uint8_t> m_tag;
-        std::vector<uint8_t> m_data;
-        std::vector<TlvBer> m_valuesConstructed;
+        TagStorage m_tag;
+        std::pmr::vector<uint8_t> m_data;
+        std::pmr::vector<TlvBer> m_valuesConstructed;
     };
 
 public:
     bool
     operator==(const TlvBer&) const;
 
+private:
+    /**
+     * @brief Locate the encodings of a sequence of concatenated top-level
+     * Tlvs from their tag and length encodings, without decoding their values.
+     * 
+     * @param dataInput The data to scan.
+     * @param encodings The output vector to append the encoding of each Tlv to.
+     * @return Tlv::ParseResult Failed if the data ends with an invalid or
+     * truncated Tlv, in which case the encodings preceding it are still output.
+     */
+    static Tlv::ParseResult
+    ScanSequence(std::span<const uint8_t> dataInput, std::vector<std::span<const uint8_t>>& encodings);
+
+    /**
+     * @brief Decode each of the specified Tlv encodings in turn, stopping at
+     * the first invalid one.
+     * 
+     * @param encodings The encodings of the Tlvs to decode.
+     * @param onTlvParsed The callback to invoke with each decoded Tlv.
+     * @param allocator The allocator to use for the decoded Tlvs.
+     * @return true If all Tlvs were decoded.
+     * @return false Otherwise.
+     */
+    static bool
+    ParseSequenceTlvs(std::span<const std::span<const uint8_t>> encodings, const ParseSequenceCallback& onTlvParsed, const allocator_type& allocator);
+
+    /**
+     * @brief Determines if the nested TLVs of this TlvBer must be sorted when
+     * encoding with the Distinguished Encoding Rules.
+     *
+     * @return true
+     * @return false
+     */
+    bool
+    IsSet() const noexcept;
+
+    /**
+     * @brief Encode this TlvBer using the Distinguished Encoding Rules.
+     *
+     * @param output The buffer to write the encoding to. This must be exactly
+     * EncodedSize() octets in size.
+     */
+    void
+    EncodeDistinguished(std::span<uint8_t> output) const;
+
+    /**
+     * @brief Point the public Tlv tag and value views at the storage owned by
+     * this object, and update the cached value size and length encoding.
+     */
+    void
+    UpdateViews() noexcept;
+
+    /**
+     * @brief An entry in the index of nested TLVs, ordered by tag, then by
+     * position.
+     */
+    struct IndexEntry
+    {
+        uint32_t Tag;
+        uint32_t Position;
+
+        auto
+        operator<=>(const IndexEntry&) const = default;
+    };
+
+    /**
+     * @brief The minimum number of nested TLVs for which lookups are backed by
+     * an index. Scanning fewer than this is cheaper than building an index.
+     */
+    static constexpr std::size_t IndexThreshold = 8;
+
+    /**
+     * @brief Build the index of nested TLVs, if there are enough of them to
+     * warrant one.
+     */
+    void
+    BuildIndex();
+
+    /**
+     * @brief Get the index entries of all nested TLVs with the specified tag.
+     * 
+     * @param tag 
+     * @return std::span<const IndexEntry> 
+     */
+    std::span<const IndexEntry>
+    GetIndexEntries(uint32_t tag) const;
+
 private:
     TlvBer::Class m_class{ TlvBer::Class::Invalid };
     TlvBer::Type m_type{ TlvBer::Type::Primitive };
     uint32_t m_tagNumber{ 0 };
-    std::vector<uint8_t> m_tag;
-    std::vector<uint8_t> m_value;
-    std::vector<TlvBer> m_valuesConstructed;
+    TagStorage m_tag;
+    ValueStorage m_value;
+    std::pmr::vector<TlvBer> m_valuesConstructed;
+    std::size_t m_valueSize{ 0 };
+    LengthStorage m_length;
+    std::pmr::vector<IndexEntry> m_index;
 };
 
 } // namespace encoding
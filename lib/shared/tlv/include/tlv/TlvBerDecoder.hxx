@@ -0,0 +1,186 @@
+
+#ifndef TLV_BER_DECODER_HXX
+#define TLV_BER_DECODER_HXX
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory_resource>
+#include <span>
+#include <vector>
+
+#include <tlv/TlvBer.hxx>
+
+namespace encoding
+{
+/**
+ * @brief Incremental (push-mode) decoder for a stream of BER-TLV data.
+ *
+ * Data may be provided in arbitrarily sized chunks as it becomes available,
+ * for example, as fragments of an out-of-band message are received. Each chunk
+ * is consumed exactly once; the decoder retains only the partially decoded
+ * state, so no previously supplied data is re-scanned. The stream may contain
+ * any number of back-to-back top-level TLVs, each of which is reported through
+ * the callback once it has been completely decoded.
+ */
+class TlvBerDecoder
+{
+public:
+    /**
+     * @brief Describes the result of pushing data to the decoder.
+     */
+    enum class Result {
+        /**
+         * @brief All data was consumed and every TLV in it was completely
+         * decoded; the decoder is positioned at a TLV boundary.
+         */
+        Succeeded,
+
+        /**
+         * @brief All data was consumed, but the last TLV is incomplete. See
+         * BytesRequired() for the number of bytes still needed.
+         */
+        NeedMoreData,
+
+        /**
+         * @brief The data is not valid BER-TLV. The decoder must be Reset()
+         * before it can be used again.
+         */
+        Failed,
+    };
+
+    /**
+     * @brief Callback invoked for each completely decoded top-level TLV.
+     */
+    using TlvDecodedCallback = std::function<void(TlvBer&)>;
+
+    /**
+     * @brief Construct a new TlvBerDecoder object.
+     *
+     * @param onTlvDecoded The callback to invoke with each decoded top-level TLV.
+     */
+    explicit TlvBerDecoder(TlvDecodedCallback onTlvDecoded);
+
+    /**
+     * @brief Push the next chunk of the stream to the decoder.
+     *
+     * @param data The next chunk of BER-TLV data.
+     * @return Result
+     */
+    Result
+    Push(std::span<const uint8_t> data);
+
+    /**
+     * @brief The minimum number of bytes that must be pushed before the
+     * pending TLV can be completed.
+     *
+     * This is exact once the length of the outermost pending TLV has been
+     * decoded. Prior to that, it is the number of bytes needed to complete its
+     * tag or length. This is zero if no TLV is pending.
+     *
+     * @return std::size_t
+     */
+    std::size_t
+    BytesRequired() const noexcept;
+
+    /**
+     * @brief Discard any partially decoded state, including failures.
+     */
+    void
+    Reset() noexcept;
+
+private:
+    /**
+     * @brief The portion of a TLV currently being decoded.
+     */
+    enum class State {
+        Tag,
+        Length,
+        Value,
+        Failed,
+    };
+
+    /**
+     * @brief A constructed TLV whose nested TLVs are being decoded.
+     */
+    struct ConstructedFrame
+    {
+        TlvBer::Class Class;
+        TlvBer::Type Type;
+        uint32_t TagNumber;
+        TlvBer::TagStorage Tag;
+        std::size_t EndOffset;
+        std::pmr::vector<TlvBer> Values;
+    };
+
+    /**
+     * @brief Consume one tag octet.
+     *
+     * @param octet
+     * @return true If the octet was consumed successfully.
+     * @return false If the tag is invalid.
+     */
+    bool
+    ConsumeTagOctet(uint8_t octet);
+
+    /**
+     * @brief Consume one length octet.
+     *
+     * @param octet
+     * @return true If the octet was consumed successfully.
+     * @return false If the length is invalid.
+     */
+    bool
+    ConsumeLengthOctet(uint8_t octet);
+
+    /**
+     * @brief Consume as many value octets as are needed from the front of the
+     * specified data.
+     *
+     * @param data
+     * @return std::size_t The number of octets consumed.
+     */
+    std::size_t
+    ConsumeValueOctets(std::span<const uint8_t> data);
+
+    /**
+     * @brief Process a TLV whose header has been fully decoded.
+     *
+     * @return true If the header was valid in the current context.
+     * @return false Otherwise.
+     */
+    bool
+    OnHeaderDecoded();
+
+    /**
+     * @brief Process a completely decoded TLV, completing any enclosing
+     * constructed TLVs which it finishes.
+     *
+     * @param tlv
+     */
+    void
+    OnTlvDecoded(TlvBer tlv);
+
+private:
+    TlvDecodedCallback m_onTlvDecoded;
+    State m_state{ State::Tag };
+    std::size_t m_offset{ 0 };
+
+    // State of the TLV currently being decoded.
+    std::array<uint8_t, TlvBer::MaxNumOctetsInLengthEncoding> m_headerOctets{};
+    std::size_t m_headerOctetsCount{ 0 };
+    TlvBer::Class m_class{ TlvBer::Class::Invalid };
+    TlvBer::Type m_type{ TlvBer::Type::Primitive };
+    uint32_t m_tagNumber{ 0 };
+    TlvBer::TagStorage m_tag;
+    std::size_t m_length{ 0 };
+    std::vector<uint8_t> m_value;
+
+    // Enclosing constructed TLVs, outermost first.
+    std::vector<ConstructedFrame> m_frames;
+};
+
+} // namespace encoding
+
+#endif // TLV_BER_DECODER_HXX
@@ -0,0 +1,675 @@
+
+#ifndef TLV_BER_SCHEMA_HXX
+#define TLV_BER_SCHEMA_HXX
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory_resource>
+#include <optional>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+#include <tlv/TlvBer.hxx>
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers)
+
+namespace encoding
+{
+/**
+ * @brief Compile-time schemas describing how an object is encoded as a
+ * constructed BER-TLV, with each of its fields encoded as a nested TLV.
+ *
+ * A schema is a table of fields, each of which binds a tag, an accessor for
+ * the field within the object, and a codec for the field value. Encoders and
+ * decoders are generated from the table, so objects need not hand-write them.
+ * For example:
+ *
+ * using PointSchema = TlvBerSchema<Point, 0xA1,
+ *     TlvBerField<0x80, TlvBerMember<&Point::X>, TlvBerIntegerCodec<uint16_t>>,
+ *     TlvBerField<0x81, TlvBerMember<&Point::Y>, TlvBerIntegerCodec<uint16_t>>>;
+ *
+ * A codec describes how a value is encoded, and must provide:
+ *
+ *  - value_type: The type of value encoded.
+ *  - Size(value): The number of octets in the encoding of a value.
+ *  - Encode(value, output): Write the encoding of a value to an output iterator.
+ *  - Decode(tlv, value): Decode a value from a TlvBer or TlvBerView,
+ *    returning false if the tlv does not hold a valid encoding.
+ *
+ * A codec of values encoded as a constructed TLV may also provide
+ * EncodeTlvs(value, values), which appends the nested TLVs of a value. This
+ * allows ToTlvBer() to build the TLVs directly instead of parsing them from
+ * an encoding.
+ *
+ * An accessor describes where a value is held within an object, and must
+ * provide:
+ *
+ *  - object_type: The type of object the value is held in.
+ *  - value_type: The type of value held.
+ *  - Get(object): Get a pointer to the value, or nullptr if the object does
+ *    not hold a value, in which case the field is omitted from the encoding.
+ *  - Emplace(object): Get a reference to a (possibly newly created) value in
+ *    the object, to decode into.
+ */
+template <typename CodecT>
+concept TlvBerValueCodec = requires(const typename CodecT::value_type& value, typename CodecT::value_type& valueOut, const TlvBer& tlv, uint8_t* output) {
+    { CodecT::Size(value) } -> std::convertible_to<std::size_t>;
+    { CodecT::Encode(value, output) } -> std::same_as<uint8_t*>;
+    { CodecT::Decode(tlv, valueOut) } -> std::same_as<bool>;
+};
+
+template <typename CodecT>
+concept TlvBerConstructedValueCodec = TlvBerValueCodec<CodecT> && requires(const typename CodecT::value_type& value, std::pmr::vector<TlvBer>& values) {
+    CodecT::EncodeTlvs(value, values);
+};
+
+template <typename AccessorT>
+concept TlvBerValueAccessor = requires(const typename AccessorT::object_type& object, typename AccessorT::object_type& objectOut) {
+    { AccessorT::Get(object) } -> std::same_as<const typename AccessorT::value_type*>;
+    { AccessorT::Emplace(objectOut) } -> std::same_as<typename AccessorT::value_type&>;
+};
+
+namespace detail
+{
+/**
+ * @brief Get the number of octets in a tag, given its integer value.
+ *
+ * @param tag The tag value, in the form returned by TlvBer::GetTagValue().
+ * @return std::size_t
+ */
+constexpr std::size_t
+GetTagSize(uint32_t tag) noexcept
+{
+    std::size_t size = 1;
+    while (size < sizeof tag && (tag >> (size * 8U)) != 0) {
+        size++;
+    }
+
+    return size;
+}
+
+/**
+ * @brief Write the octets of a tag, given its integer value.
+ *
+ * @tparam Tag The tag value, in the form returned by TlvBer::GetTagValue().
+ * @tparam OutputIt
+ * @param output The output iterator to write the tag to.
+ * @return OutputIt The output iterator, positioned after the tag.
+ */
+template <uint32_t Tag, std::output_iterator<uint8_t> OutputIt>
+OutputIt
+WriteTag(OutputIt output)
+{
+    for (auto i = GetTagSize(Tag); i > 0; i--) {
+        *output++ = static_cast<uint8_t>((Tag >> ((i - 1) * 8U)) & 0xFFU);
+    }
+
+    return output;
+}
+
+/**
+ * @brief Determines if all of the specified tags are unique.
+ *
+ * @tparam Tags
+ * @return true
+ * @return false
+ */
+template <uint32_t... Tags>
+constexpr bool
+TagsAreUnique() noexcept
+{
+    std::array<uint32_t, sizeof...(Tags)> tags{ Tags... };
+    std::ranges::sort(tags);
+    return std::ranges::adjacent_find(tags) == std::cend(tags);
+}
+
+/**
+ * @brief Create a TLV with the specified tag, given its integer value.
+ *
+ * @tparam Tag The tag value, in the form returned by TlvBer::GetTagValue().
+ * @tparam ValueT The type of value, either the octets of a primitive TLV or
+ * the nested TLVs of a constructed TLV.
+ * @param value The value of the TLV. Nested TLVs are moved into the TLV.
+ * @param allocator The allocator to use for the TLV.
+ * @return TlvBer
+ * @throws TlvBer::Builder::InvalidTlvBerTagException If the tag is invalid,
+ * or its type does not match the type of value.
+ */
+template <uint32_t Tag, typename ValueT>
+TlvBer
+MakeTlv(ValueT& value, const TlvBer::allocator_type& allocator)
+{
+    constexpr auto tlvTypeOfValue = std::is_same_v<std::remove_cv_t<ValueT>, std::pmr::vector<TlvBer>> ? TlvBer::Type::Constructed : TlvBer::Type::Primitive;
+
+    std::array<uint8_t, GetTagSize(Tag)> tag{};
+    WriteTag<Tag>(std::begin(tag));
+
+    TlvBer::Class tlvClass{};
+    TlvBer::Type tlvType{};
+    uint32_t tagNumber = 0;
+    TlvBer::TagStorage tagParsed{};
+    std::size_t bytesParsed = 0;
+    const auto parseResult = TlvBer::ParseTag(tlvClass, tlvType, tagNumber, tagParsed, tag, bytesParsed);
+    if (parseResult != Tlv::ParseResult::Succeeded || bytesParsed != std::size(tag) || tlvType != tlvTypeOfValue) {
+        throw TlvBer::Builder::InvalidTlvBerTagException();
+    }
+
+    return TlvBer{ tlvClass, tlvType, tagNumber, tag, value, allocator };
+}
+} // namespace detail
+
+/**
+ * @brief Codec for values encoded as a fixed-length, big-endian, unsigned
+ * integer. This supports integral, boolean, and enumeration values.
+ *
+ * @tparam ValueT The type of value.
+ * @tparam Length The number of octets in the encoding.
+ */
+template <typename ValueT, std::size_t Length = sizeof(ValueT)>
+    requires(std::is_integral_v<ValueT> || std::is_enum_v<ValueT>) && (Length > 0) && (Length <= sizeof(uint64_t))
+struct TlvBerIntegerCodec
+{
+    using value_type = ValueT;
+
+    static constexpr std::size_t
+    Size(const ValueT& /* value */) noexcept
+    {
+        return Length;
+    }
+
+    template <std::output_iterator<uint8_t> OutputIt>
+    static OutputIt
+    Encode(const ValueT& value, OutputIt output)
+    {
+        const auto integer = ToInteger(value);
+        for (auto i = Length; i > 0; i--) {
+            *output++ = static_cast<uint8_t>((integer >> ((i - 1) * 8U)) & 0xFFU);
+        }
+
+        return output;
+    }
+
+    template <typename TlvT>
+    static bool
+    Decode(const TlvT& tlv, ValueT& value)
+    {
+        const std::span<const uint8_t> data = tlv.GetValue();
+        if (data.size() != Length) {
+            return false;
+        }
+
+        uint64_t integer = 0;
+        for (const auto octet : data) {
+            integer = (integer << 8U) | octet;
+        }
+
+        value = FromInteger(integer);
+        return true;
+    }
+
+private:
+    static constexpr uint64_t
+    ToInteger(ValueT value) noexcept
+    {
+        if constexpr (std::is_enum_v<ValueT>) {
+            return static_cast<uint64_t>(static_cast<std::underlying_type_t<ValueT>>(value));
+        } else {
+            return static_cast<uint64_t>(value);
+        }
+    }
+
+    static constexpr ValueT
+    FromInteger(uint64_t integer) noexcept
+    {
+        if constexpr (std::is_same_v<ValueT, bool>) {
+            return integer != 0;
+        } else if constexpr (std::is_enum_v<ValueT>) {
+            return static_cast<ValueT>(static_cast<std::underlying_type_t<ValueT>>(integer));
+        } else {
+            return static_cast<ValueT>(integer);
+        }
+    }
+};
+
+/**
+ * @brief Codec for values encoded as a variable-length sequence of octets.
+ */
+struct TlvBerOctetsCodec
+{
+    using value_type = std::vector<uint8_t>;
+
+    static std::size_t
+    Size(const value_type& value) noexcept
+    {
+        return value.size();
+    }
+
+    template <std::output_iterator<uint8_t> OutputIt>
+    static OutputIt
+    Encode(const value_type& value, OutputIt output)
+    {
+        return std::ranges::copy(value, output).out;
+    }
+
+    template <typename TlvT>
+    static bool
+    Decode(const TlvT& tlv, value_type& value)
+    {
+        const std::span<const uint8_t> data = tlv.GetValue();
+        value.assign(std::cbegin(data), std::cend(data));
+        return true;
+    }
+};
+
+/**
+ * @brief Codec for values encoded as a fixed-length sequence of octets.
+ *
+ * @tparam Length The number of octets in the encoding.
+ */
+template <std::size_t Length>
+struct TlvBerOctetArrayCodec
+{
+    using value_type = std::array<uint8_t, Length>;
+
+    static constexpr std::size_t
+    Size(const value_type& /* value */) noexcept
+    {
+        return Length;
+    }
+
+    template <std::output_iterator<uint8_t> OutputIt>
+    static OutputIt
+    Encode(const value_type& value, OutputIt output)
+    {
+        return std::ranges::copy(value, output).out;
+    }
+
+    template <typename TlvT>
+    static bool
+    Decode(const TlvT& tlv, value_type& value)
+    {
+        const std::span<const uint8_t> data = tlv.GetValue();
+        if (data.size() != Length) {
+            return false;
+        }
+
+        std::ranges::copy(data, std::begin(value));
+        return true;
+    }
+};
+
+/**
+ * @brief Codec for values which are themselves described by a schema, and so
+ * are encoded as a constructed TLV.
+ *
+ * @tparam SchemaT The schema of the value.
+ */
+template <typename SchemaT>
+struct TlvBerSchemaCodec
+{
+    using value_type = typename SchemaT::object_type;
+
+    static std::size_t
+    Size(const value_type& value) noexcept
+    {
+        return SchemaT::EncodedValueSize(value);
+    }
+
+    template <std::output_iterator<uint8_t> OutputIt>
+    static OutputIt
+    Encode(const value_type& value, OutputIt output)
+    {
+        return SchemaT::EncodeValue(value, output);
+    }
+
+    static void
+    EncodeTlvs(const value_type& value, std::pmr::vector<TlvBer>& values)
+    {
+        SchemaT::EncodeTlvs(value, values);
+    }
+
+    template <typename TlvT>
+    static bool
+    Decode(const TlvT& tlv, value_type& value)
+    {
+        return tlv.IsConstructed() && SchemaT::DecodeValue(tlv, value);
+    }
+};
+
+/**
+ * @brief Accessor for a value held in a data member of an object.
+ *
+ * @tparam Member The pointer to the data member.
+ */
+template <auto Member>
+struct TlvBerMember;
+
+template <typename ObjectT, typename ValueT, ValueT ObjectT::*Member>
+struct TlvBerMember<Member>
+{
+    using object_type = ObjectT;
+    using value_type = ValueT;
+
+    static const ValueT*
+    Get(const ObjectT& object) noexcept
+    {
+        return &(object.*Member);
+    }
+
+    static ValueT&
+    Emplace(ObjectT& object) noexcept
+    {
+        return object.*Member;
+    }
+};
+
+/**
+ * @brief Accessor for a value held in a std::optional data member of an
+ * object. The field is omitted from the encoding if the value is empty.
+ *
+ * @tparam Member The pointer to the data member.
+ */
+template <auto Member>
+struct TlvBerOptionalMember;
+
+template <typename ObjectT, typename ValueT, std::optional<ValueT> ObjectT::*Member>
+struct TlvBerOptionalMember<Member>
+{
+    using object_type = ObjectT;
+    using value_type = ValueT;
+
+    static const ValueT*
+    Get(const ObjectT& object) noexcept
+    {
+        const auto& value = object.*Member;
+        return value.has_value() ? &(*value) : nullptr;
+    }
+
+    static ValueT&
+    Emplace(ObjectT& object)
+    {
+        return (object.*Member).emplace();
+    }
+};
+
+/**
+ * @brief Accessor for the object itself. This allows a codec to encode
+ * values which span multiple data members of the object.
+ *
+ * @tparam ObjectT The type of object.
+ */
+template <typename ObjectT>
+struct TlvBerObject
+{
+    using object_type = ObjectT;
+    using value_type = ObjectT;
+
+    static const ObjectT*
+    Get(const ObjectT& object) noexcept
+    {
+        return &object;
+    }
+
+    static ObjectT&
+    Emplace(ObjectT& object) noexcept
+    {
+        return object;
+    }
+};
+
+/**
+ * @brief Describes a field of an object, encoded as a nested TLV.
+ *
+ * @tparam TagValue The tag of the nested TLV, in the form returned by TlvBer::GetTagValue().
+ * @tparam AccessorT The accessor for the field value within the object.
+ * @tparam CodecT The codec for the field value.
+ */
+template <uint32_t TagValue, TlvBerValueAccessor AccessorT, TlvBerValueCodec CodecT>
+    requires std::same_as<typename AccessorT::value_type, typename CodecT::value_type>
+struct TlvBerField
+{
+    using object_type = typename AccessorT::object_type;
+
+    static constexpr uint32_t Tag = TagValue;
+
+    /**
+     * @brief Get the number of octets in the encoding of this field, including
+     * its tag and length. This is zero if the field is omitted.
+     *
+     * @param object The object holding the field.
+     * @return std::size_t
+     */
+    static std::size_t
+    EncodedSize(const object_type& object) noexcept
+    {
+        const auto* value = AccessorT::Get(object);
+        if (value == nullptr) {
+            return 0;
+        }
+
+        const auto valueSize = CodecT::Size(*value);
+        return detail::GetTagSize(Tag) + TlvBer::GetLengthEncodingSize(valueSize) + valueSize;
+    }
+
+    /**
+     * @brief Encode this field, if present.
+     *
+     * @tparam OutputIt
+     * @param object The object holding the field.
+     * @param output The output iterator to write the encoding to.
+     * @return OutputIt The output iterator, positioned after the encoding.
+     */
+    template <std::output_iterator<uint8_t> OutputIt>
+    static OutputIt
+    Encode(const object_type& object, OutputIt output)
+    {
+        const auto* value = AccessorT::Get(object);
+        if (value == nullptr) {
+            return output;
+        }
+
+        output = detail::WriteTag<Tag>(output);
+        output = TlvBer::WriteLengthEncoding(CodecT::Size(*value), output);
+        return CodecT::Encode(*value, output);
+    }
+
+    /**
+     * @brief Encode this field, if present, as a nested TLV. The TLV uses the
+     * allocator of the nested TLVs it is appended to.
+     *
+     * @param object The object holding the field.
+     * @param values The nested TLVs to append the TLV of the field to.
+     */
+    static void
+    EncodeTlv(const object_type& object, std::pmr::vector<TlvBer>& values)
+    {
+        const auto* value = AccessorT::Get(object);
+        if (value == nullptr) {
+            return;
+        }
+
+        const auto allocator = values.get_allocator();
+        if constexpr (TlvBerConstructedValueCodec<CodecT>) {
+            std::pmr::vector<TlvBer> valuesNested{ allocator };
+            CodecT::EncodeTlvs(*value, valuesNested);
+            values.push_back(detail::MakeTlv<Tag>(valuesNested, allocator));
+        } else if (const auto valueSize = CodecT::Size(*value); valueSize <= TlvBer::ValueInlineCapacity) {
+            // Values of this size are stored inline, so encode them on the stack.
+            std::array<uint8_t, TlvBer::ValueInlineCapacity> encoding{};
+            CodecT::Encode(*value, std::begin(encoding));
+            const auto encodingValue = std::span<const uint8_t>{ encoding }.first(valueSize);
+            values.push_back(detail::MakeTlv<Tag>(encodingValue, allocator));
+        } else {
+            std::pmr::vector<uint8_t> encoding(valueSize, allocator);
+            CodecT::Encode(*value, std::begin(encoding));
+            const auto encodingValue = std::span<const uint8_t>{ encoding };
+            values.push_back(detail::MakeTlv<Tag>(encodingValue, allocator));
+        }
+    }
+
+    /**
+     * @brief Decode this field from its nested TLV.
+     *
+     * @tparam TlvT The type of tlv, either TlvBer or TlvBerView.
+     * @param tlv The nested TLV holding the encoded field.
+     * @param object The object to decode the field into.
+     * @return true If the field was successfully decoded.
+     * @return false If the nested TLV does not hold a valid encoding.
+     */
+    template <typename TlvT>
+    static bool
+    Decode(const TlvT& tlv, object_type& object)
+    {
+        return CodecT::Decode(tlv, AccessorT::Emplace(object));
+    }
+};
+
+/**
+ * @brief Describes how an object is encoded as a constructed TLV.
+ *
+ * @tparam ObjectT The type of object.
+ * @tparam TagValue The tag of the constructed TLV, in the form returned by TlvBer::GetTagValue().
+ * @tparam FieldTs The fields of the object (TlvBerField), in the order they are encoded.
+ */
+template <typename ObjectT, uint32_t TagValue, typename... FieldTs>
+    requires(std::same_as<ObjectT, typename FieldTs::object_type> && ...)
+struct TlvBerSchema
+{
+    static_assert(detail::TagsAreUnique<FieldTs::Tag...>(), "schema field tags must be unique");
+
+    using object_type = ObjectT;
+
+    static constexpr uint32_t Tag = TagValue;
+
+    /**
+     * @brief Get the number of octets in the encoding of the fields of an
+     * object, ie. the value of its constructed TLV.
+     *
+     * @param object
+     * @return std::size_t
+     */
+    static std::size_t
+    EncodedValueSize(const ObjectT& object) noexcept
+    {
+        return (FieldTs::EncodedSize(object) + ... + 0);
+    }
+
+    /**
+     * @brief Get the number of octets in the encoding of an object, including
+     * its tag and length.
+     *
+     * @param object
+     * @return std::size_t
+     */
+    static std::size_t
+    EncodedSize(const ObjectT& object) noexcept
+    {
+        const auto valueSize = EncodedValueSize(object);
+        return detail::GetTagSize(Tag) + TlvBer::GetLengthEncodingSize(valueSize) + valueSize;
+    }
+
+    /**
+     * @brief Encode the fields of an object, ie. the value of its constructed
+     * TLV.
+     *
+     * @tparam OutputIt
+     * @param object The object to encode.
+     * @param output The output iterator to write the encoding to.
+     * @return OutputIt The output iterator, positioned after the encoding.
+     */
+    template <std::output_iterator<uint8_t> OutputIt>
+    static OutputIt
+    EncodeValue(const ObjectT& object, OutputIt output)
+    {
+        ((output = FieldTs::Encode(object, output)), ...);
+        return output;
+    }
+
+    /**
+     * @brief Encode an object, including its tag and length.
+     *
+     * @tparam OutputIt
+     * @param object The object to encode.
+     * @param output The output iterator to write the encoding to.
+     * @return OutputIt The output iterator, positioned after the encoding.
+     */
+    template <std::output_iterator<uint8_t> OutputIt>
+    static OutputIt
+    Encode(const ObjectT& object, OutputIt output)
+    {
+        output = detail::WriteTag<Tag>(output);
+        output = TlvBer::WriteLengthEncoding(EncodedValueSize(object), output);
+        return EncodeValue(object, output);
+    }
+
+    /**
+     * @brief Encode the fields of an object as nested TLVs.
+     *
+     * @param object The object to encode.
+     * @param values The nested TLVs to append the TLVs of the fields to.
+     */
+    static void
+    EncodeTlvs(const ObjectT& object, std::pmr::vector<TlvBer>& values)
+    {
+        values.reserve(std::size(values) + sizeof...(FieldTs));
+        (FieldTs::EncodeTlv(object, values), ...);
+    }
+
+    /**
+     * @brief Encode an object as a TlvBer. The TLV and all TLVs nested within
+     * it are built directly, using only the specified allocator.
+     *
+     * @param object The object to encode.
+     * @param allocator The allocator to use for the TlvBer.
+     * @return TlvBer
+     * @throws TlvBer::Builder::InvalidTlvBerTagException If the schema has a
+     * tag which is invalid, or does not match the type of its value.
+     */
+    static TlvBer
+    ToTlvBer(const ObjectT& object, const TlvBer::allocator_type& allocator = {})
+    {
+        std::pmr::vector<TlvBer> values{ allocator };
+        EncodeTlvs(object, values);
+        return detail::MakeTlv<Tag>(values, allocator);
+    }
+
+    /**
+     * @brief Decode the fields of an object from the nested TLVs of a
+     * constructed TLV. The tag of the constructed TLV itself is not checked.
+     *
+     * Nested TLVs with tags not described by the schema are ignored. Fields
+     * without a nested TLV are left unmodified.
+     *
+     * @tparam TlvT The type of tlv, either TlvBer or TlvBerView.
+     * @param tlv The constructed TLV to decode.
+     * @param object The object to decode the fields into.
+     * @return true If all fields were successfully decoded.
+     * @return false If any nested TLV does not hold a valid encoding.
+     */
+    template <typename TlvT>
+    static bool
+    DecodeValue(const TlvT& tlv, ObjectT& object)
+    {
+        for (const auto& value : tlv.GetValues()) {
+            const auto tag = TlvBer::GetTagValue(value.GetTag());
+            bool decoded = true;
+            static_cast<void>(((tag == FieldTs::Tag && (decoded = FieldTs::Decode(value, object), true)) || ...));
+            if (!decoded) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+};
+
+} // namespace encoding
+
+// NOLINTEND(cppcoreguidelines-avoid-magic-numbers)
+
+#endif // TLV_BER_SCHEMA_HXX
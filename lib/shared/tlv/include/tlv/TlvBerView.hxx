@@ -0,0 +1,258 @@
+
+#ifndef TLV_BER_VIEW_HXX
+#define TLV_BER_VIEW_HXX
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <span>
+
+#include <tlv/Tlv.hxx>
+#include <tlv/TlvBer.hxx>
+
+namespace encoding
+{
+/**
+ * @brief Non-owning, read-only view of a Basic Encoding Rules (BER)
+ * Tag-Length-Value (TLV) structure.
+ *
+ * The tag and value of the view refer directly to the buffer it was parsed
+ * from, so parsing does not allocate or copy any data. Consequently, the
+ * buffer must outlive the view and any views derived from it. Nested TLVs of
+ * a constructed view are decoded on demand while iterating GetValues().
+ */
+class TlvBerView : public Tlv
+{
+public:
+    class Iterator;
+
+    /**
+     * @brief Range of the nested TLVs in a constructed TLV.
+     */
+    class Values
+    {
+    public:
+        Values() = default;
+
+        /**
+         * @brief Construct a new Values object over the encoded nested TLVs.
+         *
+         * @param data The (already validated) value octets of a constructed TLV.
+         */
+        explicit Values(std::span<const uint8_t> data) noexcept;
+
+        Iterator
+        begin() const noexcept;
+
+        Iterator
+        end() const noexcept;
+
+        /**
+         * @brief Determines if there are no nested TLVs.
+         *
+         * @return true
+         * @return false
+         */
+        bool
+        empty() const noexcept;
+
+    private:
+        std::span<const uint8_t> m_data;
+    };
+
+    /**
+     * @brief Construct a new empty TlvBerView.
+     */
+    TlvBerView() = default;
+
+    /**
+     * @brief Returns whether this TLV contains a constructed value.
+     *
+     * @return true
+     * @return false
+     */
+    bool
+    IsConstructed() const noexcept;
+
+    /**
+     * @brief Returns whether this TLV contains a primitive value.
+     *
+     * @return true
+     * @return false
+     */
+    bool
+    IsPrimitive() const noexcept;
+
+    /**
+     * @brief Returns the type of this TLV.
+     *
+     * @return TlvBer::Type
+     */
+    TlvBer::Type
+    GetType() const noexcept;
+
+    /**
+     * @brief Returns the class of this TLV.
+     *
+     * @return TlvBer::Class
+     */
+    TlvBer::Class
+    GetClass() const noexcept;
+
+    /**
+     * @brief Get the tagNumber of the TLV.
+     *
+     * @return uint32_t
+     */
+    uint32_t
+    GetTagNumber() const noexcept;
+
+    /**
+     * @brief Get the tag of the TLV.
+     *
+     * @return std::span<const uint8_t>
+     */
+    std::span<const uint8_t>
+    GetTag() const noexcept;
+
+    /**
+     * @brief Get the value buffer. For constructed TLVs, this is the encoding
+     * of all nested TLVs.
+     *
+     * @return std::span<const uint8_t>
+     */
+    std::span<const uint8_t>
+    GetValue() const noexcept;
+
+    /**
+     * @brief Get the nested TLVs. Returns an empty range if this object is
+     * Primitive.
+     *
+     * @return Values
+     */
+    Values
+    GetValues() const noexcept;
+
+    /**
+     * @brief Get the complete encoding of this TLV, including tag and length.
+     *
+     * @return std::span<const uint8_t>
+     */
+    std::span<const uint8_t>
+    GetEncoding() const noexcept;
+
+    /**
+     * @brief Create an owning copy of this TLV.
+     *
+     * @param allocator The allocator to use for the copy.
+     * @return TlvBer
+     */
+    TlvBer
+    ToTlvBer(const TlvBer::allocator_type& allocator = {}) const;
+
+    /**
+     * @brief Decode a Tlv view from a blob of BER-TLV data.
+     *
+     * The complete TLV, including all nested TLVs, is validated, so iterating
+     * the nested TLVs of a successfully parsed view cannot fail.
+     *
+     * @param tlvOutput The decoded Tlv view, if parsing was successful (ParseResult::Succeeded).
+     * @param dataInput The data to parse a Tlv from.
+     * @param bytesParsedOverall The number of bytes parsed.
+     * @return Tlv::ParseResult The result of the parsing operation.
+     */
+    static Tlv::ParseResult
+    Parse(TlvBerView& tlvOutput, std::span<const uint8_t> dataInput, std::size_t& bytesParsedOverall);
+
+    /**
+     * @brief Compares the encodings of two views.
+     *
+     * @param other
+     * @return true
+     * @return false
+     */
+    bool
+    operator==(const TlvBerView& other) const noexcept;
+
+private:
+    /**
+     * @brief Decode the tag and length of a Tlv, and locate its value,
+     * without validating any nested TLVs.
+     *
+     * @param tlvOutput
+     * @param dataInput
+     * @param bytesParsedOverall
+     * @return Tlv::ParseResult
+     */
+    static Tlv::ParseResult
+    ParseHeader(TlvBerView& tlvOutput, std::span<const uint8_t> dataInput, std::size_t& bytesParsedOverall);
+
+    /**
+     * @brief Validates the nested TLVs of a constructed value exactly fill
+     * the value.
+     *
+     * @param dataInput
+     * @return Tlv::ParseResult
+     */
+    static Tlv::ParseResult
+    ValidateConstructedValue(std::span<const uint8_t> dataInput);
+
+private:
+    TlvBer::Class m_class{ TlvBer::Class::Invalid };
+    TlvBer::Type m_type{ TlvBer::Type::Primitive };
+    uint32_t m_tagNumber{ 0 };
+    std::span<const uint8_t> m_encoding;
+};
+
+/**
+ * @brief Forward iterator over the nested TLVs of a constructed TlvBerView.
+ */
+class TlvBerView::Iterator
+{
+public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = TlvBerView;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const TlvBerView*;
+    using reference = const TlvBerView&;
+
+    Iterator() = default;
+
+    /**
+     * @brief Construct a new Iterator pointing to the first TLV in the
+     * specified data.
+     *
+     * @param remaining The encoded TLVs remaining to be iterated.
+     */
+    explicit Iterator(std::span<const uint8_t> remaining) noexcept;
+
+    reference
+    operator*() const noexcept;
+
+    pointer
+    operator->() const noexcept;
+
+    Iterator&
+    operator++() noexcept;
+
+    Iterator
+    operator++(int) noexcept;
+
+    bool
+    operator==(const Iterator& other) const noexcept;
+
+private:
+    /**
+     * @brief Decode the TLV at the front of the remaining data.
+     */
+    void
+    Decode() noexcept;
+
+private:
+    std::span<const uint8_t> m_remaining;
+    TlvBerView m_current;
+};
+
+} // namespace encoding
+
+#endif // TLV_BER_VIEW_HXX
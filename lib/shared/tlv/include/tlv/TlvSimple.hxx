@@ -11,9 +11,13 @@
 
 namespace encoding
 {
+class TlvSimpleView;
+
 class TlvSimple : public Tlv
 {
 private:
+    friend class TlvSimpleView;
+
     static constexpr std::size_t OneByteLengthMinimumSize = 2;
     static constexpr std::size_t ThreeByteLengthMinimumSize = 4;
 
@@ -34,6 +38,16 @@ public:
      */
     static ParseResult
     Parse(TlvSimple **tlvOutput, const std::span<uint8_t> &data);
+
+    /**
+     * @brief Decode a Tlv from a blob of SIMPLE-TLV data.
+     *
+     * @param tlvOutput The decoded Tlv, if parsing was successful (ParseResult::Succeeded).
+     * @param data The data to parse a Tlv from. This must contain exactly one Tlv.
+     * @return ParseResult The result of the parsing operation.
+     */
+    static ParseResult
+    Parse(std::unique_ptr<TlvSimple> &tlvOutput, std::span<const uint8_t> data);
 };
 
 } // namespace encoding
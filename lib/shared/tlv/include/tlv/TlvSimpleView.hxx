@@ -0,0 +1,192 @@
+
+#ifndef TLV_SIMPLE_VIEW_HXX
+#define TLV_SIMPLE_VIEW_HXX
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <span>
+
+#include <tlv/Tlv.hxx>
+#include <tlv/TlvSimple.hxx>
+
+namespace encoding
+{
+/**
+ * @brief Non-owning, read-only view of a SIMPLE-TLV structure.
+ *
+ * The tag and value of the view refer directly to the buffer it was parsed
+ * from, so parsing does not allocate or copy any data. Consequently, the
+ * buffer must outlive the view.
+ */
+class TlvSimpleView : public Tlv
+{
+public:
+    class Iterator;
+
+    /**
+     * @brief Range of consecutive SIMPLE-TLVs.
+     */
+    class Values
+    {
+    public:
+        Values() = default;
+
+        /**
+         * @brief Construct a new Values object over consecutive encoded TLVs.
+         *
+         * @param data The (already validated) encoded TLVs.
+         */
+        explicit Values(std::span<const uint8_t> data) noexcept;
+
+        Iterator
+        begin() const noexcept;
+
+        Iterator
+        end() const noexcept;
+
+        /**
+         * @brief Determines if there are no TLVs.
+         *
+         * @return true
+         * @return false
+         */
+        bool
+        empty() const noexcept;
+
+    private:
+        std::span<const uint8_t> m_data;
+    };
+
+    /**
+     * @brief Construct a new empty TlvSimpleView.
+     */
+    TlvSimpleView() = default;
+
+    /**
+     * @brief Get the tag of the TLV.
+     *
+     * @return uint8_t
+     */
+    uint8_t
+    GetTag() const noexcept;
+
+    /**
+     * @brief Get the value of the TLV.
+     *
+     * @return std::span<const uint8_t>
+     */
+    std::span<const uint8_t>
+    GetValue() const noexcept;
+
+    /**
+     * @brief Get the complete encoding of this TLV, including tag and length.
+     *
+     * @return std::span<const uint8_t>
+     */
+    std::span<const uint8_t>
+    GetEncoding() const noexcept;
+
+    /**
+     * @brief Create an owning copy of this TLV.
+     *
+     * @return std::unique_ptr<TlvSimple>
+     */
+    std::unique_ptr<TlvSimple>
+    ToTlvSimple() const;
+
+    /**
+     * @brief Decode a Tlv view from the front of a blob of SIMPLE-TLV data.
+     * Any data following the Tlv is ignored.
+     *
+     * @param tlvOutput The decoded Tlv view, if parsing was successful (ParseResult::Succeeded).
+     * @param dataInput The data to parse a Tlv from.
+     * @param bytesParsed The number of bytes parsed.
+     * @return Tlv::ParseResult The result of the parsing operation.
+     */
+    static Tlv::ParseResult
+    Parse(TlvSimpleView& tlvOutput, std::span<const uint8_t> dataInput, std::size_t& bytesParsed) noexcept;
+
+    /**
+     * @brief Decode all consecutive Tlvs from the front of a blob of
+     * SIMPLE-TLV data, such as an APDU response payload.
+     *
+     * Decoding stops at the end of the data, or at the first incomplete or
+     * invalid Tlv, in which case bytesParsed is less than the size of the
+     * data and the remaining data may be processed by other means. The Tlvs
+     * are validated up front, so iterating the returned range cannot fail.
+     *
+     * @param dataInput The data to parse Tlvs from.
+     * @param bytesParsed The number of bytes consumed by the decoded Tlvs.
+     * @return Values The decoded Tlvs.
+     */
+    static Values
+    ParseAll(std::span<const uint8_t> dataInput, std::size_t& bytesParsed) noexcept;
+
+    /**
+     * @brief Compares the encodings of two views.
+     *
+     * @param other
+     * @return true
+     * @return false
+     */
+    bool
+    operator==(const TlvSimpleView& other) const noexcept;
+
+private:
+    std::span<const uint8_t> m_encoding;
+};
+
+/**
+ * @brief Forward iterator over consecutive SIMPLE-TLVs.
+ */
+class TlvSimpleView::Iterator
+{
+public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = TlvSimpleView;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const TlvSimpleView*;
+    using reference = const TlvSimpleView&;
+
+    Iterator() = default;
+
+    /**
+     * @brief Construct a new Iterator pointing to the first TLV in the
+     * specified data.
+     *
+     * @param remaining The encoded TLVs remaining to be iterated.
+     */
+    explicit Iterator(std::span<const uint8_t> remaining) noexcept;
+
+    reference
+    operator*() const noexcept;
+
+    pointer
+    operator->() const noexcept;
+
+    Iterator&
+    operator++() noexcept;
+
+    Iterator
+    operator++(int) noexcept;
+
+    bool
+    operator==(const Iterator& other) const noexcept;
+
+private:
+    /**
+     * @brief Decode the TLV at the front of the remaining data.
+     */
+    void
+    Decode() noexcept;
+
+private:
+    std::span<const uint8_t> m_remaining;
+    TlvSimpleView m_current;
+};
+
+} // namespace encoding
+
+#endif // TLV_SIMPLE_VIEW_HXX
@@ -149,6 +149,22 @@ UwbDevice::GetDeviceInformation()
     return GetDeviceInformationImpl();
 }
 
+notstd::task<UwbCapability>
+UwbDevice::GetCapabilitiesAsync()
+{
+    co_return co_await notstd::run_blocking([this] {
+        return GetCapabilities();
+    }, notstd::thread_pool::get_blocking());
+}
+
+notstd::task<UwbDeviceInformation>
+UwbDevice::GetDeviceInformationAsync()
+{
+    co_return co_await notstd::run_blocking([this] {
+        return GetDeviceInformation();
+    }, notstd::thread_pool::get_blocking());
+}
+
 uint32_t
 UwbDevice::GetSessionCount()
 {
@@ -1,11 +1,11 @@
 
-#include <cmath>
 #include <tuple>
 
 #include <notstd/tostring.hxx>
 #include <sstream>
 #include <string>
 #include <uwb/UwbPeer.hxx>
+#include <uwb/protocols/fira/UwbQ97Conversions.hxx>
 
 using namespace uwb;
 using namespace strings::ostream_operators;
@@ -37,41 +37,13 @@ UwbPeer::UwbPeer(UwbMacAddress address) :
     m_address(std::move(address))
 {}
 
-/**
- * @brief Converts a Q9.7-formatted value to an IEEE 754 double precision floating point formatted value.
- *
- * Assuming the Arm definition of Qm.n formatting, the most significant bit is the sign, the next
- * (m-1) bits are an integer, and the next n bits is the number to be multiplied by pow(2,n)
- * The double equivalent will be the sum of those two results
- * TODO double check this conversion, write tests for it
- *
- * @param q97 a number in Q9.7 format
- * @return double
- */
-double
-ConvertQ97FormatToIEEE(uint16_t q97)
-{
-    static const double pow2 = std::pow(2, -7);
-    static const uint16_t signMask = 0b1000'0000'0000'0000U;
-    static const uint16_t unsignedIntegerMask = 0b0111'1111'1000'0000U;
-    static const uint16_t fractionMask = ~(signMask | unsignedIntegerMask);
-
-    bool sign = q97 & signMask;
-    int unsignedIntegerPart = (q97 & unsignedIntegerMask) >> 7U;
-    int fractionPart = q97 & fractionMask;
-
-    double unsignedNumber = ((double)unsignedIntegerPart) + (((double)fractionPart) * pow2);
-
-    return (sign ? -1 : 1) * unsignedNumber;
-}
-
 UwbPeer::UwbPeer(const uwb::protocol::fira::UwbRangingMeasurement& data) :
     m_address{ data.PeerMacAddress },
     m_spatialProperties{
         .Distance{ data.Distance }, // TODO is this also q97
-        .AngleAzimuth{ ConvertQ97FormatToIEEE(data.AoAAzimuth.Result) },
-        .AngleElevation{ ConvertQ97FormatToIEEE(data.AoAElevation.Result) },
-        .Elevation{ ConvertQ97FormatToIEEE(data.AoaDestinationElevation.Result) }, // TODO is this right?
+        .AngleAzimuth{ uwb::protocol::fira::ConvertQ97(data.AoAAzimuth.Result) },
+        .AngleElevation{ uwb::protocol::fira::ConvertQ97(data.AoAElevation.Result) },
+        .Elevation{ uwb::protocol::fira::ConvertQ97(data.AoaDestinationElevation.Result) }, // TODO is this right?
 
         .AngleAzimuthFom{ data.AoAAzimuth.FigureOfMerit },
         .AngleElevationFom{ data.AoAElevation.FigureOfMerit },
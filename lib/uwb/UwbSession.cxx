@@ -94,6 +94,14 @@ UwbSession::Configure(const std::vector<protocol::fira::UwbApplicationConfigurat
     }
 }
 
+notstd::task<void>
+UwbSession::ConfigureAsync(std::vector<protocol::fira::UwbApplicationConfigurationParameter> configParams)
+{
+    co_await notstd::run_blocking([this, configParams = std::move(configParams)] {
+        Configure(configParams);
+    }, notstd::thread_pool::get_blocking());
+}
+
 void
 UwbSession::StartRanging()
 {
@@ -116,6 +124,22 @@ UwbSession::StopRanging()
     }
 }
 
+notstd::task<void>
+UwbSession::StartRangingAsync()
+{
+    co_await notstd::run_blocking([this] {
+        StartRanging();
+    }, notstd::thread_pool::get_blocking());
+}
+
+notstd::task<void>
+UwbSession::StopRangingAsync()
+{
+    co_await notstd::run_blocking([this] {
+        StopRanging();
+    }, notstd::thread_pool::get_blocking());
+}
+
 void
 UwbSession::SetSessionStatus(const uwb::protocol::fira::UwbSessionStatus& status)
 {
@@ -137,6 +161,14 @@ UwbSession::GetApplicationConfigurationParameters(std::vector<::uwb::protocol::f
     return GetApplicationConfigurationParametersImpl(std::move(requestedTypes));
 }
 
+notstd::task<std::vector<::uwb::protocol::fira::UwbApplicationConfigurationParameter>>
+UwbSession::GetApplicationConfigurationParametersAsync(std::vector<::uwb::protocol::fira::UwbApplicationConfigurationParameterType> requestedTypes)
+{
+    co_return co_await notstd::run_blocking([this, requestedTypes = std::move(requestedTypes)]() mutable {
+        return GetApplicationConfigurationParameters(std::move(requestedTypes));
+    }, notstd::thread_pool::get_blocking());
+}
+
 void
 UwbSession::SetApplicationConfigurationParameters(std::vector<::uwb::protocol::fira::UwbApplicationConfigurationParameter> uwbApplicationConfigurationParameters)
 {
@@ -144,6 +176,14 @@ UwbSession::SetApplicationConfigurationParameters(std::vector<::uwb::protocol::f
     return SetApplicationConfigurationParametersImpl(std::move(uwbApplicationConfigurationParameters));
 }
 
+notstd::task<void>
+UwbSession::SetApplicationConfigurationParametersAsync(std::vector<::uwb::protocol::fira::UwbApplicationConfigurationParameter> uwbApplicationConfigurationParameters)
+{
+    co_await notstd::run_blocking([this, uwbApplicationConfigurationParameters = std::move(uwbApplicationConfigurationParameters)]() mutable {
+        SetApplicationConfigurationParameters(std::move(uwbApplicationConfigurationParameters));
+    }, notstd::thread_pool::get_blocking());
+}
+
 UwbSessionState
 UwbSession::GetSessionState()
 {
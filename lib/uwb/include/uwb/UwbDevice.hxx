@@ -6,6 +6,7 @@
 #include <shared_mutex>
 #include <unordered_map>
 
+#include <notstd/task.hxx>
 #include <uwb/UwbDeviceEventCallbacks.hxx>
 #include <uwb/UwbSession.hxx>
 #include <uwb/protocols/fira/FiraDevice.hxx>
@@ -61,6 +62,28 @@ public:
     ::uwb::protocol::fira::UwbDeviceInformation
     GetDeviceInformation();
 
+    /**
+     * @brief Get the FiRa capabilities of the device without blocking the
+     * calling thread.
+     *
+     * The request is made from notstd::thread_pool::get_blocking(), and the
+     * awaiting coroutine resumes on the notstd::task_queue it was running on,
+     * if any. The device must outlive the returned task.
+     *
+     * @return notstd::task<uwb::protocol::fira::UwbCapability>
+     */
+    notstd::task<uwb::protocol::fira::UwbCapability>
+    GetCapabilitiesAsync();
+
+    /**
+     * @brief Get the FiRa device information of the device without blocking
+     * the calling thread. This completes as described by GetCapabilitiesAsync().
+     *
+     * @return notstd::task<::uwb::protocol::fira::UwbDeviceInformation>
+     */
+    notstd::task<::uwb::protocol::fira::UwbDeviceInformation>
+    GetDeviceInformationAsync();
+
     /**
      * @brief Get the number of sessions associated with the device.
      *
@@ -10,6 +10,7 @@
 #include <type_traits>
 #include <unordered_set>
 
+#include <notstd/task.hxx>
 #include <uwb/UwbMacAddress.hxx>
 #include <uwb/UwbPeer.hxx>
 #include <uwb/UwbSessionEventCallbacks.hxx>
@@ -96,6 +97,21 @@ public:
     void
     Configure(const std::vector<protocol::fira::UwbApplicationConfigurationParameter> configParams);
 
+    /**
+     * @brief Configure the session for use without blocking the calling
+     * thread.
+     *
+     * The request is made from notstd::thread_pool::get_blocking(), and the
+     * awaiting coroutine resumes on the notstd::task_queue it was running on,
+     * if any. This allows a single queue to drive the setup of many sessions
+     * concurrently. The session must outlive the returned task.
+     *
+     * @param configParams
+     * @return notstd::task<void>
+     */
+    notstd::task<void>
+    ConfigureAsync(std::vector<protocol::fira::UwbApplicationConfigurationParameter> configParams);
+
     /**
      * @brief Set the type of mac address to be used for session participants.
      *
@@ -127,6 +143,24 @@ public:
     void
     StopRanging();
 
+    /**
+     * @brief Start ranging without blocking the calling thread. This completes
+     * as described by ConfigureAsync().
+     *
+     * @return notstd::task<void>
+     */
+    notstd::task<void>
+    StartRangingAsync();
+
+    /**
+     * @brief Stop ranging without blocking the calling thread. This completes
+     * as described by ConfigureAsync().
+     *
+     * @return notstd::task<void>
+     */
+    notstd::task<void>
+    StopRangingAsync();
+
     /**
      * @brief Set the Session Status object. NOTE, this function is NOT thread safe
      *
@@ -144,6 +178,17 @@ public:
     std::vector<::uwb::protocol::fira::UwbApplicationConfigurationParameter>
     GetApplicationConfigurationParameters(std::vector<::uwb::protocol::fira::UwbApplicationConfigurationParameterType> requestedTypes);
 
+    /**
+     * @brief Get the application configuration parameters for this session
+     * without blocking the calling thread. This completes as described by
+     * ConfigureAsync().
+     *
+     * @param requestedTypes leave this as an empty vector to request all parameters
+     * @return notstd::task<std::vector<::uwb::protocol::fira::UwbApplicationConfigurationParameter>>
+     */
+    notstd::task<std::vector<::uwb::protocol::fira::UwbApplicationConfigurationParameter>>
+    GetApplicationConfigurationParametersAsync(std::vector<::uwb::protocol::fira::UwbApplicationConfigurationParameterType> requestedTypes);
+
     /**
      * @brief Set the application configuration parameters for this session.
      *
@@ -152,6 +197,17 @@ public:
     void
     SetApplicationConfigurationParameters(std::vector<::uwb::protocol::fira::UwbApplicationConfigurationParameter> uwbApplicationConfigurationParameters);
 
+    /**
+     * @brief Set the application configuration parameters for this session
+     * without blocking the calling thread. This completes as described by
+     * ConfigureAsync().
+     *
+     * @param uwbApplicationConfigurationParameters
+     * @return notstd::task<void>
+     */
+    notstd::task<void>
+    SetApplicationConfigurationParametersAsync(std::vector<::uwb::protocol::fira::UwbApplicationConfigurationParameter> uwbApplicationConfigurationParameters);
+
     /**
      * @brief Get the current state for this session.
      *
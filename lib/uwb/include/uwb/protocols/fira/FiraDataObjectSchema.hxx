@@ -0,0 +1,485 @@
+
+#ifndef FIRA_DATA_OBJECT_SCHEMA_HXX
+#define FIRA_DATA_OBJECT_SCHEMA_HXX
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include <notstd/utility.hxx>
+#include <tlv/TlvBerSchema.hxx>
+
+#include <uwb/UwbMacAddress.hxx>
+#include <uwb/protocols/fira/FiraDevice.hxx>
+#include <uwb/protocols/fira/RangingMethod.hxx>
+#include <uwb/protocols/fira/SecureRangingInfo.hxx>
+#include <uwb/protocols/fira/StaticRangingInfo.hxx>
+#include <uwb/protocols/fira/UwbCapability.hxx>
+#include <uwb/protocols/fira/UwbConfiguration.hxx>
+#include <uwb/protocols/fira/UwbSessionData.hxx>
+
+/**
+ * @brief Schemas describing the encoding of FiRa Data Objects (DO). Encoders
+ * and decoders for the data objects are generated from these at compile-time.
+ *
+ * See FiRa Consortium Common Service Management Layer Technical Specification
+ * v1.0.0, Section 7.5.3.2, 'UWB Session Data structure', Tables 52 and 53,
+ * pages 96-109.
+ */
+namespace uwb::protocol::fira
+{
+namespace detail
+{
+/**
+ * @brief The type of value in a table of bit indexes.
+ *
+ * @tparam BitIndexes The bit index of each value, as an array of (value, bit index) pairs.
+ */
+template <const auto& BitIndexes>
+using BitIndexValueType = typename std::remove_cvref_t<decltype(BitIndexes)>::value_type::first_type;
+
+/**
+ * @brief Marks an enumeration value without a bit index in a BitIndexTable.
+ */
+inline constexpr uint8_t BitIndexNone = UINT8_MAX;
+
+/**
+ * @brief The bit index of each value of an enumeration, indexed by the
+ * underlying value of the enumeration. This is generated at compile-time from
+ * a table of (value, bit index) pairs. Values without a bit index hold
+ * BitIndexNone.
+ *
+ * @tparam BitIndexes The bit index of each value, as an array of (value, bit index) pairs.
+ */
+template <const auto& BitIndexes>
+    requires std::is_enum_v<BitIndexValueType<BitIndexes>>
+inline constexpr auto BitIndexTable = [] {
+    std::array<uint8_t, 64> table{};
+    table.fill(BitIndexNone);
+    for (const auto& [value, bitIndex] : BitIndexes) {
+        table.at(static_cast<std::size_t>(notstd::to_underlying(value))) = static_cast<uint8_t>(bitIndex);
+    }
+
+    return table;
+}();
+
+/**
+ * @brief Get the bit index of a value.
+ *
+ * Enumeration values are looked up directly in a table indexed by their
+ * underlying value. Other values, which are few, are found by a linear search.
+ *
+ * @tparam BitIndexes The bit index of each value, as an array of (value, bit index) pairs.
+ * @param value The value to get the bit index of.
+ * @return std::size_t
+ * @throws std::out_of_range If the value does not have a bit index.
+ */
+template <const auto& BitIndexes>
+std::size_t
+GetBitIndex(const BitIndexValueType<BitIndexes>& value)
+{
+    if constexpr (std::is_enum_v<BitIndexValueType<BitIndexes>>) {
+        const auto& table = BitIndexTable<BitIndexes>;
+        const auto index = static_cast<std::size_t>(notstd::to_underlying(value));
+        if (index < std::size(table) && table[index] != BitIndexNone) {
+            return table[index];
+        }
+    } else {
+        for (const auto& [entryValue, bitIndex] : BitIndexes) {
+            if (entryValue == value) {
+                return bitIndex;
+            }
+        }
+    }
+
+    throw std::out_of_range("value does not have a bit index");
+}
+
+/**
+ * @brief Encode a set of values as a bitmap, given the bit index of each value.
+ *
+ * @tparam BitIndexes The bit index of each value, as an array of (value, bit index) pairs.
+ * @param values The values to encode.
+ * @return uint64_t
+ */
+template <const auto& BitIndexes>
+uint64_t
+ToBitmap(const std::vector<BitIndexValueType<BitIndexes>>& values)
+{
+    uint64_t bitmap = 0;
+    for (const auto& value : values) {
+        bitmap |= (1ULL << GetBitIndex<BitIndexes>(value));
+    }
+
+    return bitmap;
+}
+
+/**
+ * @brief Decode a set of values from a bitmap, given the bit index of each
+ * value. The values are written in order of their bit index, reusing the
+ * storage of the output.
+ *
+ * @tparam BitIndexes The bit index of each value, as an array of (value, bit index) pairs.
+ * @param bitmap The bitmap to decode.
+ * @param values The decoded values.
+ */
+template <const auto& BitIndexes>
+void
+FromBitmap(uint64_t bitmap, std::vector<BitIndexValueType<BitIndexes>>& values)
+{
+    values.clear();
+    for (const auto& [value, bitIndex] : BitIndexes) {
+        if ((bitmap & (1ULL << bitIndex)) != 0) {
+            values.push_back(value);
+        }
+    }
+}
+} // namespace detail
+
+/**
+ * @brief Codec for a set of values encoded as a fixed-length, big-endian
+ * bitmap.
+ *
+ * @tparam Length The number of octets in the encoding.
+ * @tparam BitIndexes The bit index of each value, as an array of (value, bit index) pairs.
+ */
+template <std::size_t Length, const auto& BitIndexes>
+struct FiraBitmapCodec
+{
+    using value_type = std::vector<detail::BitIndexValueType<BitIndexes>>;
+    using BitmapCodec = encoding::TlvBerIntegerCodec<uint64_t, Length>;
+
+    static constexpr std::size_t
+    Size(const value_type& /* values */) noexcept
+    {
+        return Length;
+    }
+
+    template <std::output_iterator<uint8_t> OutputIt>
+    static OutputIt
+    Encode(const value_type& values, OutputIt output)
+    {
+        return BitmapCodec::Encode(detail::ToBitmap<BitIndexes>(values), output);
+    }
+
+    template <typename TlvT>
+    static bool
+    Decode(const TlvT& tlv, value_type& values)
+    {
+        uint64_t bitmap = 0;
+        if (!BitmapCodec::Decode(tlv, bitmap)) {
+            return false;
+        }
+
+        detail::FromBitmap<BitIndexes>(bitmap, values);
+        return true;
+    }
+};
+
+/**
+ * @brief Codec for the AOA_SUPPORT parameter of UWB_CAPABILITY, which encodes
+ * both the supported angle of arrival types and figure of merit support in a
+ * single bitmap.
+ */
+struct FiraAngleOfArrivalSupportCodec
+{
+    using value_type = UwbCapability;
+    using BitmapCodec = encoding::TlvBerIntegerCodec<uint8_t>;
+
+    static constexpr std::size_t
+    Size(const value_type& /* uwbCapability */) noexcept
+    {
+        return 1;
+    }
+
+    template <std::output_iterator<uint8_t> OutputIt>
+    static OutputIt
+    Encode(const value_type& uwbCapability, OutputIt output)
+    {
+        auto bitmap = detail::ToBitmap<UwbCapability::AngleOfArrivalBitIndexes>(uwbCapability.AngleOfArrivalTypes);
+        if (uwbCapability.AngleOfArrivalFom) {
+            bitmap |= (1ULL << UwbCapability::AngleOfArrivalFomBit);
+        }
+
+        return BitmapCodec::Encode(static_cast<uint8_t>(bitmap), output);
+    }
+
+    template <typename TlvT>
+    static bool
+    Decode(const TlvT& tlv, value_type& uwbCapability)
+    {
+        uint8_t bitmap = 0;
+        if (!BitmapCodec::Decode(tlv, bitmap)) {
+            return false;
+        }
+
+        detail::FromBitmap<UwbCapability::AngleOfArrivalBitIndexes>(bitmap, uwbCapability.AngleOfArrivalTypes);
+        uwbCapability.AngleOfArrivalFom = (bitmap & (1U << UwbCapability::AngleOfArrivalFomBit)) != 0;
+        return true;
+    }
+};
+
+/**
+ * @brief Codec for the RANGING_METHOD parameter of UWB_CONFIGURATION, which
+ * encodes a single ranging method as its index in the UWB_CAPABILITY bitmap.
+ */
+struct FiraRangingMethodCodec
+{
+    using value_type = RangingMethod;
+
+    static constexpr std::size_t
+    Size(const value_type& /* rangingMethod */) noexcept
+    {
+        return 1;
+    }
+
+    template <std::output_iterator<uint8_t> OutputIt>
+    static OutputIt
+    Encode(const value_type& rangingMethod, OutputIt output)
+    {
+        *output++ = static_cast<uint8_t>(detail::GetBitIndex<UwbCapability::RangingMethodBitIndexes>(rangingMethod));
+        return output;
+    }
+
+    template <typename TlvT>
+    static bool
+    Decode(const TlvT& tlv, value_type& rangingMethod)
+    {
+        const std::span<const uint8_t> data = tlv.GetValue();
+        if (data.size() != 1) {
+            return false;
+        }
+
+        const auto it = std::ranges::find_if(UwbCapability::RangingMethodBitIndexes, [&](const auto& entry) {
+            return entry.second == data[0];
+        });
+        if (it == std::cend(UwbCapability::RangingMethodBitIndexes)) {
+            return false;
+        }
+
+        rangingMethod = it->first;
+        return true;
+    }
+};
+
+/**
+ * @brief Codec for the RESULT_REPORT_CONFIG parameter of UWB_CONFIGURATION,
+ * which encodes a set of report configurations as a bitmap of their values.
+ */
+struct FiraResultReportConfigurationCodec
+{
+    using value_type = std::unordered_set<ResultReportConfiguration>;
+
+    static constexpr std::array<ResultReportConfiguration, 4> ResultReportConfigurations{
+        ResultReportConfiguration::TofReport,
+        ResultReportConfiguration::AoAAzimuthReport,
+        ResultReportConfiguration::AoAElevationReport,
+        ResultReportConfiguration::AoAFoMReport,
+    };
+
+    static constexpr std::size_t
+    Size(const value_type& /* resultReportConfigurations */) noexcept
+    {
+        return 1;
+    }
+
+    template <std::output_iterator<uint8_t> OutputIt>
+    static OutputIt
+    Encode(const value_type& resultReportConfigurations, OutputIt output)
+    {
+        uint8_t bitmap = 0;
+        for (const auto resultReportConfiguration : resultReportConfigurations) {
+            bitmap |= notstd::to_underlying(resultReportConfiguration);
+        }
+
+        *output++ = bitmap;
+        return output;
+    }
+
+    template <typename TlvT>
+    static bool
+    Decode(const TlvT& tlv, value_type& resultReportConfigurations)
+    {
+        const std::span<const uint8_t> data = tlv.GetValue();
+        if (data.size() != 1) {
+            return false;
+        }
+
+        resultReportConfigurations.clear();
+        for (const auto resultReportConfiguration : ResultReportConfigurations) {
+            if ((data[0] & notstd::to_underlying(resultReportConfiguration)) != 0) {
+                resultReportConfigurations.insert(resultReportConfiguration);
+            }
+        }
+
+        return true;
+    }
+};
+
+/**
+ * @brief Codec for a short (2 octet) or extended (8 octet) UWB MAC address.
+ */
+struct FiraMacAddressCodec
+{
+    using value_type = ::uwb::UwbMacAddress;
+
+    static std::size_t
+    Size(const value_type& macAddress) noexcept
+    {
+        return macAddress.GetLength();
+    }
+
+    template <std::output_iterator<uint8_t> OutputIt>
+    static OutputIt
+    Encode(const value_type& macAddress, OutputIt output)
+    {
+        return std::ranges::copy(macAddress.GetValue(), output).out;
+    }
+
+    template <typename TlvT>
+    static bool
+    Decode(const TlvT& tlv, value_type& macAddress)
+    {
+        const std::span<const uint8_t> data = tlv.GetValue();
+        switch (data.size()) {
+        case ::uwb::UwbMacAddress::ShortLength: {
+            ::uwb::UwbMacAddress::ShortType value{};
+            std::ranges::copy(data, std::begin(value));
+            macAddress = ::uwb::UwbMacAddress{ value };
+            return true;
+        }
+        case ::uwb::UwbMacAddress::ExtendedLength: {
+            ::uwb::UwbMacAddress::ExtendedType value{};
+            std::ranges::copy(data, std::begin(value));
+            macAddress = ::uwb::UwbMacAddress{ value };
+            return true;
+        }
+        default:
+            return false;
+        }
+    }
+};
+
+/**
+ * @brief Fields of the UWB_CAPABILITY data object.
+ */
+template <UwbCapability::ParameterTag Tag, typename AccessorT, typename CodecT>
+using UwbCapabilityField = encoding::TlvBerField<notstd::to_underlying(Tag), AccessorT, CodecT>;
+
+template <UwbCapability::ParameterTag Tag, auto Member, std::size_t Length = 1>
+using UwbCapabilityIntegerField = UwbCapabilityField<Tag, encoding::TlvBerMember<Member>, encoding::TlvBerIntegerCodec<typename encoding::TlvBerMember<Member>::value_type, Length>>;
+
+template <UwbCapability::ParameterTag Tag, auto Member, const auto& BitIndexes, std::size_t Length = 1>
+using UwbCapabilityBitmapField = UwbCapabilityField<Tag, encoding::TlvBerMember<Member>, FiraBitmapCodec<Length, BitIndexes>>;
+
+/**
+ * @brief Schema for the UWB_CAPABILITY data object.
+ */
+using UwbCapabilitySchema = encoding::TlvBerSchema<UwbCapability, UwbCapability::Tag,
+    UwbCapabilityIntegerField<UwbCapability::ParameterTag::FiraPhyVersionRange, &UwbCapability::FiraPhyVersionRange, 4>,
+    UwbCapabilityIntegerField<UwbCapability::ParameterTag::FiraMacVersionRange, &UwbCapability::FiraMacVersionRange, 4>,
+    UwbCapabilityBitmapField<UwbCapability::ParameterTag::DeviceRoles, &UwbCapability::DeviceRoles, UwbCapability::DeviceRoleBitIndexes>,
+    UwbCapabilityBitmapField<UwbCapability::ParameterTag::RangingMethod, &UwbCapability::RangingMethods, UwbCapability::RangingMethodBitIndexes>,
+    UwbCapabilityBitmapField<UwbCapability::ParameterTag::StsConfig, &UwbCapability::StsConfigurations, UwbCapability::StsConfigurationBitIndexes>,
+    UwbCapabilityBitmapField<UwbCapability::ParameterTag::MultiNodeMode, &UwbCapability::MultiNodeModes, UwbCapability::MultiNodeModeBitIndexes>,
+    UwbCapabilityBitmapField<UwbCapability::ParameterTag::RangingMode, &UwbCapability::RangingTimeStructs, UwbCapability::RangingModeBitIndexes>,
+    UwbCapabilityBitmapField<UwbCapability::ParameterTag::ScheduledMode, &UwbCapability::SchedulingModes, UwbCapability::SchedulingModeBitIndexes>,
+    UwbCapabilityIntegerField<UwbCapability::ParameterTag::HoppingMode, &UwbCapability::HoppingMode>,
+    UwbCapabilityIntegerField<UwbCapability::ParameterTag::BlockStriding, &UwbCapability::BlockStriding>,
+    UwbCapabilityIntegerField<UwbCapability::ParameterTag::UwbInitiationTime, &UwbCapability::UwbInitiationTime>,
+    UwbCapabilityBitmapField<UwbCapability::ParameterTag::Channels, &UwbCapability::Channels, UwbCapability::ChannelsBitIndexes>,
+    UwbCapabilityBitmapField<UwbCapability::ParameterTag::RFrameConfig, &UwbCapability::RFrameConfigurations, UwbCapability::RFrameConfigurationBitIndexes>,
+    UwbCapabilityBitmapField<UwbCapability::ParameterTag::CcConstraintLength, &UwbCapability::ConvolutionalCodeConstraintLengths, UwbCapability::ConvolutionalCodeConstraintLengthsBitIndexes>,
+    UwbCapabilityBitmapField<UwbCapability::ParameterTag::BprfParameterSets, &UwbCapability::BprfParameterSets, UwbCapability::BprfParameterSetsBitIndexes>,
+    UwbCapabilityBitmapField<UwbCapability::ParameterTag::HprfParameterSets, &UwbCapability::HprfParameterSets, UwbCapability::HprfParameterSetsBitIndexes, 5>,
+    UwbCapabilityField<UwbCapability::ParameterTag::AoaSupport, encoding::TlvBerObject<UwbCapability>, FiraAngleOfArrivalSupportCodec>,
+    UwbCapabilityIntegerField<UwbCapability::ParameterTag::ExtendedMacAddress, &UwbCapability::ExtendedMacAddress>>;
+
+/**
+ * @brief Schema for the STATIC_RANGING_INFO data object.
+ */
+using StaticRangingInfoSchema = encoding::TlvBerSchema<StaticRangingInfo, StaticRangingInfo::Tag,
+    encoding::TlvBerField<notstd::to_underlying(StaticRangingInfo::ParameterTag::VendorId), encoding::TlvBerMember<&StaticRangingInfo::VendorId>, encoding::TlvBerIntegerCodec<uint16_t>>,
+    encoding::TlvBerField<notstd::to_underlying(StaticRangingInfo::ParameterTag::StaticStsIv), encoding::TlvBerMember<&StaticRangingInfo::InitializationVector>, encoding::TlvBerOctetArrayCodec<StaticRangingInfo::InitializationVectorLength>>>;
+
+/**
+ * @brief Schema for the SECURE_RANGING_INFO data object.
+ */
+using SecureRangingInfoSchema = encoding::TlvBerSchema<SecureRangingInfo, SecureRangingInfo::Tag,
+    encoding::TlvBerField<notstd::to_underlying(SecureRangingInfo::ParameterTag::UwbSessionKeyInfo), encoding::TlvBerMember<&SecureRangingInfo::UwbSessionKeyInfo>, encoding::TlvBerOctetsCodec>,
+    encoding::TlvBerField<notstd::to_underlying(SecureRangingInfo::ParameterTag::ResponderSpecificSubSessionKeyInfo), encoding::TlvBerMember<&SecureRangingInfo::ResponderSpecificSubSessionKeyInfo>, encoding::TlvBerOctetsCodec>,
+    encoding::TlvBerField<notstd::to_underlying(SecureRangingInfo::ParameterTag::SusAdditionalParameters), encoding::TlvBerMember<&SecureRangingInfo::SusAdditionalParameters>, encoding::TlvBerOctetsCodec>>;
+
+/**
+ * @brief Fields of the UWB_CONFIGURATION data object.
+ */
+template <UwbConfiguration::ParameterTag Tag, typename CodecT>
+using UwbConfigurationField = encoding::TlvBerField<notstd::to_underlying(Tag), UwbConfiguration::ParameterAccessor<Tag, typename CodecT::value_type>, CodecT>;
+
+template <UwbConfiguration::ParameterTag Tag, typename ValueT, std::size_t Length = 1>
+using UwbConfigurationIntegerField = UwbConfigurationField<Tag, encoding::TlvBerIntegerCodec<ValueT, Length>>;
+
+/**
+ * @brief Schema for the UWB_CONFIGURATION data object. Parameters which are
+ * not set in the configuration are omitted from the encoding.
+ */
+using UwbConfigurationSchema = encoding::TlvBerSchema<UwbConfiguration, UwbConfiguration::Tag,
+    UwbConfigurationIntegerField<UwbConfiguration::ParameterTag::FiraPhyVersion, uint16_t, 2>,
+    UwbConfigurationIntegerField<UwbConfiguration::ParameterTag::FiraMacVersion, uint16_t, 2>,
+    UwbConfigurationIntegerField<UwbConfiguration::ParameterTag::DeviceRole, DeviceRole>,
+    UwbConfigurationField<UwbConfiguration::ParameterTag::RangingMethod, FiraRangingMethodCodec>,
+    UwbConfigurationIntegerField<UwbConfiguration::ParameterTag::StsConfig, StsConfiguration>,
+    UwbConfigurationIntegerField<UwbConfiguration::ParameterTag::MultiNodeMode, MultiNodeMode>,
+    UwbConfigurationIntegerField<UwbConfiguration::ParameterTag::RangingTimeStruct, RangingMode>,
+    UwbConfigurationIntegerField<UwbConfiguration::ParameterTag::ScheduledMode, SchedulingMode>,
+    UwbConfigurationIntegerField<UwbConfiguration::ParameterTag::HoppingMode, bool>,
+    UwbConfigurationIntegerField<UwbConfiguration::ParameterTag::BlockStriding, bool>,
+    UwbConfigurationIntegerField<UwbConfiguration::ParameterTag::UwbInitiationTime, uint32_t, 4>,
+    UwbConfigurationIntegerField<UwbConfiguration::ParameterTag::ChannelNumber, Channel>,
+    UwbConfigurationIntegerField<UwbConfiguration::ParameterTag::RFrameConfig, StsPacketConfiguration>,
+    UwbConfigurationIntegerField<UwbConfiguration::ParameterTag::CcConstraintLength, ConvolutionalCodeConstraintLength>,
+    UwbConfigurationIntegerField<UwbConfiguration::ParameterTag::PrfMode, PrfMode>,
+    UwbConfigurationIntegerField<UwbConfiguration::ParameterTag::Sp0PhySetNumber, uint8_t>,
+    UwbConfigurationIntegerField<UwbConfiguration::ParameterTag::Sp1PhySetNumber, uint8_t>,
+    UwbConfigurationIntegerField<UwbConfiguration::ParameterTag::Sp3PhySetNumber, uint8_t>,
+    UwbConfigurationIntegerField<UwbConfiguration::ParameterTag::PreambleCodeIndex, uint8_t>,
+    UwbConfigurationField<UwbConfiguration::ParameterTag::ResultReportConfig, FiraResultReportConfigurationCodec>,
+    UwbConfigurationIntegerField<UwbConfiguration::ParameterTag::MacAddressMode, ::uwb::UwbMacAddressType>,
+    UwbConfigurationField<UwbConfiguration::ParameterTag::ControleeShortMacAddress, FiraMacAddressCodec>,
+    UwbConfigurationField<UwbConfiguration::ParameterTag::ControllerMacAddress, FiraMacAddressCodec>,
+    UwbConfigurationIntegerField<UwbConfiguration::ParameterTag::SlotsPerRr, uint8_t>,
+    UwbConfigurationIntegerField<UwbConfiguration::ParameterTag::MaxContentionPhaseLength, uint8_t>,
+    UwbConfigurationIntegerField<UwbConfiguration::ParameterTag::SlotDuration, uint16_t, 2>,
+    UwbConfigurationIntegerField<UwbConfiguration::ParameterTag::RangingInterval, uint16_t, 2>,
+    UwbConfigurationIntegerField<UwbConfiguration::ParameterTag::KeyRotationRate, uint8_t>,
+    UwbConfigurationIntegerField<UwbConfiguration::ParameterTag::MacFcsType, ::uwb::UwbMacAddressFcsType>,
+    UwbConfigurationIntegerField<UwbConfiguration::ParameterTag::MaxRrRetry, uint16_t, 2>>;
+
+/**
+ * @brief Fields of the UWB_SESSION_DATA data object.
+ */
+template <UwbSessionData::ParameterTag Tag, typename AccessorT, typename CodecT>
+using UwbSessionDataField = encoding::TlvBerField<notstd::to_underlying(Tag), AccessorT, CodecT>;
+
+/**
+ * @brief Schema for the UWB_SESSION_DATA data object.
+ */
+using UwbSessionDataSchema = encoding::TlvBerSchema<UwbSessionData, UwbSessionData::Tag,
+    UwbSessionDataField<UwbSessionData::ParameterTag::SessionDataVersion, encoding::TlvBerMember<&UwbSessionData::sessionDataVersion>, encoding::TlvBerIntegerCodec<uint16_t>>,
+    UwbSessionDataField<UwbSessionData::ParameterTag::SessionId, encoding::TlvBerMember<&UwbSessionData::sessionId>, encoding::TlvBerIntegerCodec<uint32_t>>,
+    UwbSessionDataField<UwbSessionData::ParameterTag::SubSessionId, encoding::TlvBerMember<&UwbSessionData::subSessionId>, encoding::TlvBerIntegerCodec<uint32_t>>,
+    UwbSessionDataField<UwbSessionData::ParameterTag::ConfigurationParameters, encoding::TlvBerMember<&UwbSessionData::uwbConfiguration>, encoding::TlvBerSchemaCodec<UwbConfigurationSchema>>,
+    UwbSessionDataField<UwbSessionData::ParameterTag::StaticRangingInfo, encoding::TlvBerOptionalMember<&UwbSessionData::staticRangingInfo>, encoding::TlvBerSchemaCodec<StaticRangingInfoSchema>>,
+    UwbSessionDataField<UwbSessionData::ParameterTag::SecureRangingInfo, encoding::TlvBerOptionalMember<&UwbSessionData::secureRangingInfo>, encoding::TlvBerSchemaCodec<SecureRangingInfoSchema>>>;
+
+} // namespace uwb::protocol::fira
+
+#endif // FIRA_DATA_OBJECT_SCHEMA_HXX
@@ -310,6 +310,53 @@ ToString(const std::unordered_set<ResultReportConfiguration>& resultReportConfig
 std::optional<std::unordered_set<ResultReportConfiguration>>
 StringToResultReportConfiguration(const std::string& input);
 
+/**
+ * @brief The status codes used by UCI to report the status of commands and
+ * ranging measurements. See FiRa Consortium - UCI Generic Specification
+ * v1.1.0.
+ */
+enum class UwbStatusCode : uint8_t {
+    // Generic Status Codes
+    Ok = 0x00,
+    Rejected = 0x01,
+    Failed = 0x02,
+    SyntaxError = 0x03,
+    InvalidParameter = 0x04,
+    InvalidRange = 0x05,
+    InvalidMessageSize = 0x06,
+    UnknownGid = 0x07,
+    UnknownOid = 0x08,
+    ReadOnly = 0x09,
+    CommandRetry = 0x0A,
+    // RFU = 0x0B-0x10
+
+    // UWB Session Specific Status Codes
+    UwbSessionNotExist = 0x11,
+    UwbSessionDuplicate = 0x12,
+    UwbSessionActive = 0x13,
+    UwbSessionMaxSessionsExceeded = 0x14,
+    UwbSessionSessionNotConfigured = 0x15,
+    UwbSessionActiveSessionsOngoing = 0x16,
+    UwbSessionMulticastListFull = 0x17,
+    UwbSessionAddressNotFound = 0x18,
+    UwbSessionAddressAlreadyPresent = 0x19,
+    // RFU = 0x1A-0x1F
+
+    // UWB Ranging Session Specific Status Codes
+    RangingTxFailed = 0x20,
+    RangingRxTimeout = 0x21,
+    RangingRxPhyDecodingFailed = 0x22,
+    RangingRxPhyToaFailed = 0x23,
+    RangingRxPhyStsFailed = 0x24,
+    RangingRxMacDecodingFailed = 0x25,
+    RangingRxMacIeDecodedFailed = 0x26,
+    RangingRxMaxIeMissing = 0x27,
+    // RFU = 0x28-0x4F
+
+    // Proprietary Status Codes
+    // Vendor Specific = 0x50-0xFF
+};
+
 enum class UwbStatusSession {
     NotExist,
     Duplicate,
@@ -369,6 +416,25 @@ IsUwbStatusOk(const UwbStatus& uwbStatus) noexcept;
 bool
 IsUwbStatusRetry(const UwbStatus& uwbStatus) noexcept;
 
+/**
+ * @brief Encodes a status as a UCI status code.
+ *
+ * @param uwbStatus The status to encode.
+ * @return uint8_t
+ */
+uint8_t
+EncodeUwbStatus(const UwbStatus& uwbStatus) noexcept;
+
+/**
+ * @brief Decodes a UCI status code.
+ *
+ * @param value The status code.
+ * @return std::optional<UwbStatus> The status, or std::nullopt if the code is
+ * reserved or vendor-specific.
+ */
+std::optional<UwbStatus>
+DecodeUwbStatus(uint8_t value) noexcept;
+
 enum class UwbStatusMulticast {
     OkUpdate,
     ErrorListFull,
@@ -2,17 +2,20 @@
 #ifndef FIRA_UWB_CAPABILITY_HXX
 #define FIRA_UWB_CAPABILITY_HXX
 
+#include <array>
 #include <cstdint>
 #include <functional>
 #include <initializer_list>
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include <notstd/hash.hxx>
 
 #include <tlv/TlvBer.hxx>
+#include <tlv/TlvBerView.hxx>
 #include <uwb/protocols/fira/FiraDevice.hxx>
 #include <uwb/protocols/fira/RangingMethod.hxx>
 
@@ -183,6 +186,116 @@ struct UwbCapability
 
     static const std::initializer_list<RangingMethod> RangingMethodsDefault;
 
+    /**
+     * @brief The bit index of each value in the bitmaps of the UWB_CAPABILITY
+     * data object. See FiRa Consortium Common Service Management Layer
+     * Technical Specification v1.0.0, Section 7.5.3.2, 'UWB Controlee Info',
+     * Table 52, pages 96-99.
+     */
+    static constexpr std::array<std::pair<MultiNodeMode, std::size_t>, 3> MultiNodeModeBitIndexes{ {
+        { MultiNodeMode::Unicast, 0 },
+        { MultiNodeMode::OneToMany, 1 },
+        { MultiNodeMode::ManyToMany, 2 },
+    } };
+    static constexpr std::array<std::pair<DeviceRole, std::size_t>, 2> DeviceRoleBitIndexes{ {
+        { DeviceRole::Responder, 0 },
+        { DeviceRole::Initiator, 1 },
+    } };
+    static constexpr std::array<std::pair<StsConfiguration, std::size_t>, 3> StsConfigurationBitIndexes{ {
+        { StsConfiguration::Static, 0 },
+        { StsConfiguration::Dynamic, 1 },
+        { StsConfiguration::DynamicWithResponderSubSessionKey, 2 },
+    } };
+    static constexpr std::array<std::pair<StsPacketConfiguration, std::size_t>, 3> RFrameConfigurationBitIndexes{ {
+        { StsPacketConfiguration::SP0, 0 },
+        { StsPacketConfiguration::SP1, 1 },
+        { StsPacketConfiguration::SP3, 3 },
+    } };
+    static constexpr std::array<std::pair<AngleOfArrival, std::size_t>, 3> AngleOfArrivalBitIndexes{ {
+        { AngleOfArrival::Azimuth90, 0 },
+        { AngleOfArrival::Azimuth180, 1 },
+        { AngleOfArrival::Elevation, 2 },
+    } };
+    static constexpr std::array<std::pair<SchedulingMode, std::size_t>, 2> SchedulingModeBitIndexes{ {
+        { SchedulingMode::Contention, 0 },
+        { SchedulingMode::Time, 1 },
+    } };
+    static constexpr std::array<std::pair<RangingMode, std::size_t>, 2> RangingModeBitIndexes{ {
+        { RangingMode::Block, 0 },
+        { RangingMode::Interval, 1 },
+    } };
+    static constexpr std::array<std::pair<RangingMethod, std::size_t>, 5> RangingMethodBitIndexes{ {
+        { { RangingDirection::OneWay, MeasurementReportMode::None }, 0 },
+        { { RangingDirection::SingleSidedTwoWay, MeasurementReportMode::Deferred }, 1 },
+        { { RangingDirection::DoubleSidedTwoWay, MeasurementReportMode::Deferred }, 2 },
+        { { RangingDirection::SingleSidedTwoWay, MeasurementReportMode::NonDeferred }, 3 },
+        { { RangingDirection::DoubleSidedTwoWay, MeasurementReportMode::NonDeferred }, 4 },
+    } };
+    static constexpr std::array<std::pair<ConvolutionalCodeConstraintLength, std::size_t>, 2> ConvolutionalCodeConstraintLengthsBitIndexes{ {
+        { ConvolutionalCodeConstraintLength::K3, 0 },
+        { ConvolutionalCodeConstraintLength::K7, 1 },
+    } };
+    static constexpr std::array<std::pair<Channel, std::size_t>, 8> ChannelsBitIndexes{ {
+        { Channel::C5, 0 },
+        { Channel::C6, 1 },
+        { Channel::C8, 2 },
+        { Channel::C9, 3 },
+        { Channel::C10, 4 },
+        { Channel::C12, 5 },
+        { Channel::C13, 6 },
+        { Channel::C14, 7 },
+    } };
+    static constexpr std::array<std::pair<BprfParameter, std::size_t>, 6> BprfParameterSetsBitIndexes{ {
+        { BprfParameter::Set1, 0 },
+        { BprfParameter::Set2, 1 },
+        { BprfParameter::Set3, 2 },
+        { BprfParameter::Set4, 3 },
+        { BprfParameter::Set5, 4 },
+        { BprfParameter::Set6, 5 },
+    } };
+    static constexpr std::array<std::pair<HprfParameter, std::size_t>, 35> HprfParameterSetsBitIndexes{ {
+        { HprfParameter::Set1, 0 },
+        { HprfParameter::Set2, 1 },
+        { HprfParameter::Set3, 2 },
+        { HprfParameter::Set4, 3 },
+        { HprfParameter::Set5, 4 },
+        { HprfParameter::Set6, 5 },
+        { HprfParameter::Set7, 6 },
+        { HprfParameter::Set8, 7 },
+        { HprfParameter::Set9, 8 },
+        { HprfParameter::Set10, 9 },
+        { HprfParameter::Set11, 10 },
+        { HprfParameter::Set12, 11 },
+        { HprfParameter::Set13, 12 },
+        { HprfParameter::Set14, 13 },
+        { HprfParameter::Set15, 14 },
+        { HprfParameter::Set16, 15 },
+        { HprfParameter::Set17, 16 },
+        { HprfParameter::Set18, 17 },
+        { HprfParameter::Set19, 18 },
+        { HprfParameter::Set20, 19 },
+        { HprfParameter::Set21, 20 },
+        { HprfParameter::Set22, 21 },
+        { HprfParameter::Set23, 22 },
+        { HprfParameter::Set24, 23 },
+        { HprfParameter::Set25, 24 },
+        { HprfParameter::Set26, 25 },
+        { HprfParameter::Set27, 26 },
+        { HprfParameter::Set28, 27 },
+        { HprfParameter::Set29, 28 },
+        { HprfParameter::Set30, 29 },
+        { HprfParameter::Set31, 30 },
+        { HprfParameter::Set32, 31 },
+        { HprfParameter::Set33, 32 },
+        { HprfParameter::Set34, 33 },
+        { HprfParameter::Set35, 34 },
+    } };
+
+    /**
+     * @brief The bit index of each value in the bitmaps of the UWB_CAPABILITY
+     * data object, as maps. These hold the same values as the *BitIndexes
+     * arrays above.
+     */
     static const std::unordered_map<MultiNodeMode, std::size_t> MultiNodeModeBit;
     static const std::unordered_map<DeviceRole, std::size_t> DeviceRoleBit;
     static const std::unordered_map<StsConfiguration, std::size_t> StsConfigurationBit;
@@ -242,6 +355,16 @@ struct UwbCapability
      */
     static UwbCapability
     FromOobDataObject(const encoding::TlvBer& tlv);
+
+    /**
+     * @brief Decode a UwbCapability directly from the encoded FiRa Data Object
+     * (DO), without copying it.
+     *
+     * @param tlv
+     * @return UwbCapability
+     */
+    static UwbCapability
+    FromOobDataObject(const encoding::TlvBerView& tlv);
 };
 
 bool
@@ -4,6 +4,7 @@
 
 #include <compare>
 #include <cstdint>
+#include <exception>
 #include <functional>
 #include <memory>
 #include <optional>
@@ -12,6 +13,7 @@
 
 #include <notstd/hash.hxx>
 #include <tlv/TlvBer.hxx>
+#include <tlv/TlvBerView.hxx>
 
 #include <uwb/UwbMacAddress.hxx>
 #include <uwb/protocols/fira/FiraDevice.hxx>
@@ -30,6 +32,11 @@ struct UwbConfiguration
     class Builder;
     friend class Builder;
 
+    struct IncorrectNumberOfBytesInValueError : public std::exception
+    {};
+    struct IncorrectTlvTag : public std::exception
+    {};
+
     /**
      * @brief See FiRa Consortium Common Service Management Layer Technical
      * Specification v1.0.0, Section 7.5.3.2, 'UWB Session Data structure',
@@ -128,6 +135,49 @@ struct UwbConfiguration
         ::uwb::UwbMacAddressType,
         std::unordered_set<::uwb::protocol::fira::ResultReportConfiguration>>;
 
+    /**
+     * @brief Accessor for a single parameter value, for use with
+     * encoding::TlvBerField.
+     *
+     * @tparam Tag The tag of the parameter.
+     * @tparam ValueT The type of the parameter value.
+     */
+    template <ParameterTag Tag, typename ValueT>
+    struct ParameterAccessor
+    {
+        using object_type = UwbConfiguration;
+        using value_type = ValueT;
+
+        /**
+         * @brief Get a pointer to the parameter value, or nullptr if the
+         * parameter is not set.
+         *
+         * @param uwbConfiguration
+         * @return const ValueT*
+         */
+        static const ValueT*
+        Get(const UwbConfiguration& uwbConfiguration) noexcept
+        {
+            auto it = uwbConfiguration.m_values.find(Tag);
+            return (it != std::cend(uwbConfiguration.m_values))
+                ? std::get_if<ValueT>(&it->second)
+                : nullptr;
+        }
+
+        /**
+         * @brief Set the parameter to a default-constructed value, returning
+         * a reference to it.
+         *
+         * @param uwbConfiguration
+         * @return ValueT&
+         */
+        static ValueT&
+        Emplace(UwbConfiguration& uwbConfiguration)
+        {
+            return uwbConfiguration.m_values[Tag].template emplace<ValueT>();
+        }
+    };
+
     /**
      * @brief Creates a new UwbConfiguration builder object.
      *
@@ -163,6 +213,15 @@ struct UwbConfiguration
     static UwbConfiguration
     FromDataObject(const encoding::TlvBer& tlv);
 
+    /**
+     * @brief Attempt to create a UwbConfiguration object from a TlvBerView.
+     *
+     * @param tlv
+     * @return UwbConfiguration
+     */
+    static UwbConfiguration
+    FromDataObject(const encoding::TlvBerView& tlv);
+
     /**
      * @brief The map of parameter tags and their values from the configuration object.
      *
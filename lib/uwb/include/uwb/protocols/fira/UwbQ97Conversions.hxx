@@ -0,0 +1,62 @@
+
+#ifndef UWB_Q97_CONVERSIONS_HXX
+#define UWB_Q97_CONVERSIONS_HXX
+
+#include <cstdint>
+#include <span>
+
+namespace uwb::protocol::fira
+{
+/**
+ * @brief Converts a Q9.7-formatted value to a double.
+ *
+ * FiRa reports angles in degrees as Q9.7 values in sign-magnitude form: the
+ * most significant bit is the sign, the next 8 bits are the integer part of
+ * the magnitude, and the remaining 7 bits are its fractional part. Every
+ * Q9.7 value is exactly representable as a float or a double.
+ *
+ * @param q97 The value in Q9.7 format.
+ * @return double
+ */
+double
+ConvertQ97(uint16_t q97) noexcept;
+
+/**
+ * @brief Converts a double to the nearest Q9.7-formatted value. This is the
+ * inverse of ConvertQ97(), except that negative zero is encoded as zero.
+ *
+ * @param value The value to convert. Values whose magnitude is too large to
+ * represent are clamped to the largest magnitude.
+ * @return uint16_t
+ */
+uint16_t
+EncodeQ97(double value) noexcept;
+
+/**
+ * @brief Converts Q9.7-formatted values to floats.
+ *
+ * This produces the same values as the scalar conversion, using SIMD
+ * instructions where the target supports them.
+ *
+ * @param q97 The values in Q9.7 format.
+ * @param values The converted values. Must be at least as large as q97.
+ * @throws std::invalid_argument If values is smaller than q97.
+ */
+void
+ConvertQ97(std::span<const uint16_t> q97, std::span<float> values);
+
+/**
+ * @brief Converts Q9.7-formatted values to doubles.
+ *
+ * This produces the same values as the scalar conversion, using SIMD
+ * instructions where the target supports them.
+ *
+ * @param q97 The values in Q9.7 format.
+ * @param values The converted values. Must be at least as large as q97.
+ * @throws std::invalid_argument If values is smaller than q97.
+ */
+void
+ConvertQ97(std::span<const uint16_t> q97, std::span<double> values);
+} // namespace uwb::protocol::fira
+
+#endif // UWB_Q97_CONVERSIONS_HXX
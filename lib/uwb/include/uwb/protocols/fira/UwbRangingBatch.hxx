@@ -0,0 +1,294 @@
+
+#ifndef UWB_RANGING_BATCH_HXX
+#define UWB_RANGING_BATCH_HXX
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+#include <uwb/UwbMacAddress.hxx>
+#include <uwb/protocols/fira/FiraDevice.hxx>
+
+namespace uwb::protocol::fira
+{
+/**
+ * @brief The angle measurements reported for each peer in a ranging round.
+ */
+enum class UwbRangingAngle : std::size_t {
+    AoAAzimuth,
+    AoAElevation,
+    AoaDestinationAzimuth,
+    AoaDestinationElevation,
+};
+
+/**
+ * @brief A batch of ranging data, stored column-wise.
+ *
+ * Each field of UwbRangingData and UwbRangingMeasurement is stored in its own
+ * contiguous array, so that operations over many measurements (filtering,
+ * unit conversion, statistics) can be written as simple loops over arrays of
+ * scalars. The measurements of each ranging data are stored back-to-back;
+ * GetMeasurementOffsets() describes where each one begins. Peers are stored
+ * once each, and referred to from each measurement by index.
+ *
+ * Conversion to and from UwbRangingData is lossless.
+ */
+class UwbRangingBatch
+{
+public:
+    /**
+     * @brief The number of angle measurements reported for each peer.
+     */
+    static constexpr std::size_t NumberOfAngles = 4;
+
+    /**
+     * @brief Construct an empty batch.
+     */
+    UwbRangingBatch() = default;
+
+    /**
+     * @brief Construct a batch from existing ranging data.
+     *
+     * @param rangingData The ranging data to add to the batch.
+     */
+    explicit UwbRangingBatch(std::span<const UwbRangingData> rangingData);
+
+    /**
+     * @brief Get the bit of the figure of merit presence mask for an angle.
+     *
+     * @param angle The angle.
+     * @return uint8_t
+     */
+    static constexpr uint8_t
+    FigureOfMeritPresentMask(UwbRangingAngle angle) noexcept
+    {
+        return static_cast<uint8_t>(1U << static_cast<std::size_t>(angle));
+    }
+
+    /**
+     * @brief Reserve storage for ranging data.
+     *
+     * @param numberOfRangingData The total number of ranging data expected.
+     * @param numberOfMeasurements The total number of measurements expected.
+     */
+    void
+    Reserve(std::size_t numberOfRangingData, std::size_t numberOfMeasurements);
+
+    /**
+     * @brief Add ranging data to the end of the batch.
+     *
+     * @param rangingData The ranging data to add.
+     */
+    void
+    Append(const UwbRangingData& rangingData);
+
+    /**
+     * @brief Remove all ranging data and peers from the batch. Storage is
+     * retained for reuse.
+     */
+    void
+    Clear() noexcept;
+
+    /**
+     * @brief Get the number of ranging data in the batch.
+     *
+     * @return std::size_t
+     */
+    std::size_t
+    GetNumberOfRangingData() const noexcept;
+
+    /**
+     * @brief Get the total number of measurements in the batch.
+     *
+     * @return std::size_t
+     */
+    std::size_t
+    GetNumberOfMeasurements() const noexcept;
+
+    /**
+     * @brief Reconstruct a ranging data in the batch.
+     *
+     * @param index The index of the ranging data.
+     * @return UwbRangingData
+     */
+    UwbRangingData
+    GetRangingData(std::size_t index) const;
+
+    /**
+     * @brief Reconstruct all ranging data in the batch.
+     *
+     * @return std::vector<UwbRangingData>
+     */
+    std::vector<UwbRangingData>
+    ToRangingData() const;
+
+    /**
+     * @brief Get the sequence number of each ranging data.
+     *
+     * @return std::span<const uint32_t>
+     */
+    std::span<const uint32_t>
+    GetSequenceNumbers() const noexcept;
+
+    /**
+     * @brief Get the session id of each ranging data.
+     *
+     * @return std::span<const uint32_t>
+     */
+    std::span<const uint32_t>
+    GetSessionIds() const noexcept;
+
+    /**
+     * @brief Get the ranging interval of each ranging data.
+     *
+     * @return std::span<const uint32_t>
+     */
+    std::span<const uint32_t>
+    GetCurrentRangingIntervals() const noexcept;
+
+    /**
+     * @brief Get the measurement type of each ranging data.
+     *
+     * @return std::span<const UwbRangingMeasurementType>
+     */
+    std::span<const UwbRangingMeasurementType>
+    GetRangingMeasurementTypes() const noexcept;
+
+    /**
+     * @brief Get the index of the first measurement of each ranging data,
+     * followed by the total number of measurements. The measurements of
+     * ranging data i are in [offsets[i], offsets[i + 1]).
+     *
+     * @return std::span<const std::size_t>
+     */
+    std::span<const std::size_t>
+    GetMeasurementOffsets() const noexcept;
+
+    /**
+     * @brief Get the slot index of each measurement.
+     *
+     * @return std::span<const uint8_t>
+     */
+    std::span<const uint8_t>
+    GetSlotIndexes() const noexcept;
+
+    /**
+     * @brief Get the distance of each measurement, in centimeters.
+     *
+     * @return std::span<const uint16_t>
+     */
+    std::span<const uint16_t>
+    GetDistances() const noexcept;
+
+    /**
+     * @brief Get the status of each measurement, as a UCI status code.
+     *
+     * @return std::span<const uint8_t>
+     */
+    std::span<const uint8_t>
+    GetStatusCodes() const noexcept;
+
+    /**
+     * @brief Get the line of sight indicator of each measurement.
+     *
+     * @return std::span<const UwbLineOfSightIndicator>
+     */
+    std::span<const UwbLineOfSightIndicator>
+    GetLineOfSightIndicators() const noexcept;
+
+    /**
+     * @brief Get the index of the peer of each measurement into GetPeers().
+     *
+     * @return std::span<const uint32_t>
+     */
+    std::span<const uint32_t>
+    GetPeerIndexes() const noexcept;
+
+    /**
+     * @brief Get the distinct peers referred to by the measurements.
+     *
+     * @return std::span<const UwbMacAddress>
+     */
+    std::span<const UwbMacAddress>
+    GetPeers() const noexcept;
+
+    /**
+     * @brief Get an angle of each measurement, in Q9.7 format.
+     *
+     * @param angle The angle.
+     * @return std::span<const uint16_t>
+     */
+    std::span<const uint16_t>
+    GetAngles(UwbRangingAngle angle) const noexcept;
+
+    /**
+     * @brief Get an angle of each measurement, in degrees.
+     *
+     * @param angle The angle.
+     * @param degrees The converted angles. Must hold at least
+     * GetNumberOfMeasurements() values.
+     * @throws std::invalid_argument If degrees is too small.
+     */
+    void
+    GetAngles(UwbRangingAngle angle, std::span<float> degrees) const;
+
+    /**
+     * @brief Get an angle of each measurement, in degrees.
+     *
+     * @param angle The angle.
+     * @param degrees The converted angles. Must hold at least
+     * GetNumberOfMeasurements() values.
+     * @throws std::invalid_argument If degrees is too small.
+     */
+    void
+    GetAngles(UwbRangingAngle angle, std::span<double> degrees) const;
+
+    /**
+     * @brief Get the figure of merit of an angle of each measurement. The
+     * value is 0 where the figure of merit is absent.
+     *
+     * @param angle The angle.
+     * @return std::span<const uint8_t>
+     */
+    std::span<const uint8_t>
+    GetFiguresOfMerit(UwbRangingAngle angle) const noexcept;
+
+    /**
+     * @brief Get a mask of the figures of merit present for each
+     * measurement. See FigureOfMeritPresentMask().
+     *
+     * @return std::span<const uint8_t>
+     */
+    std::span<const uint8_t>
+    GetFigureOfMeritPresence() const noexcept;
+
+    bool
+    operator==(const UwbRangingBatch&) const noexcept = default;
+
+private:
+    // Columns with one entry per ranging data.
+    std::vector<uint32_t> m_sequenceNumbers;
+    std::vector<uint32_t> m_sessionIds;
+    std::vector<uint32_t> m_currentRangingIntervals;
+    std::vector<UwbRangingMeasurementType> m_rangingMeasurementTypes;
+    std::vector<std::size_t> m_measurementOffsets{ 0 };
+
+    // Columns with one entry per measurement.
+    std::vector<uint8_t> m_slotIndexes;
+    std::vector<uint16_t> m_distances;
+    std::vector<uint8_t> m_statusCodes;
+    std::vector<UwbLineOfSightIndicator> m_lineOfSightIndicators;
+    std::vector<uint32_t> m_peerIndexes;
+    std::array<std::vector<uint16_t>, NumberOfAngles> m_angles;
+    std::array<std::vector<uint8_t>, NumberOfAngles> m_figuresOfMerit;
+    std::vector<uint8_t> m_figureOfMeritPresence;
+
+    std::vector<UwbMacAddress> m_peers;
+    std::unordered_map<UwbMacAddress, uint32_t> m_peerIndexLookup;
+};
+} // namespace uwb::protocol::fira
+
+#endif // UWB_RANGING_BATCH_HXX
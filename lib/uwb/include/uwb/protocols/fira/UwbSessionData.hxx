@@ -3,11 +3,13 @@
 #define UWB_SESSION_DATA_HXX
 
 #include <cstdint>
+#include <exception>
 #include <memory>
 #include <optional>
 
 #include <notstd/hash.hxx>
 #include <tlv/TlvBer.hxx>
+#include <tlv/TlvBerView.hxx>
 
 #include <uwb/protocols/fira/SecureRangingInfo.hxx>
 #include <uwb/protocols/fira/StaticRangingInfo.hxx>
@@ -23,6 +25,11 @@ namespace uwb::protocol::fira
  */
 struct UwbSessionData
 {
+    struct IncorrectNumberOfBytesInValueError : public std::exception
+    {};
+    struct IncorrectTlvTag : public std::exception
+    {};
+
     /**
      * @brief See FiRa Consortium Common Service Management Layer Technical
      * Specification v1.0.0, Section 7.5.3.2, 'UWB Session Data structure',
@@ -68,6 +75,16 @@ struct UwbSessionData
     static UwbSessionData
     FromDataObject(const encoding::TlvBer& tlv);
 
+    /**
+     * @brief Attempt to create a UwbSessionData object directly from the
+     * encoded data object, without copying it.
+     *
+     * @param tlv
+     * @return UwbSessionData
+     */
+    static UwbSessionData
+    FromDataObject(const encoding::TlvBerView& tlv);
+
     uint16_t sessionDataVersion{ 0 };
     uint32_t sessionId{ 0 };
     uint32_t subSessionId{ 0 };
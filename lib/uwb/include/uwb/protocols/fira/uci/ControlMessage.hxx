@@ -2,10 +2,159 @@
 #ifndef FIRA_UCI_CONTROL_MESSAGE_HXX
 #define FIRA_UCI_CONTROL_MESSAGE_HXX
 
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <notstd/utility.hxx>
+#include <uwb/protocols/fira/uci/ControlPacket.hxx>
+#include <uwb/protocols/fira/uci/Opcodes.hxx>
+
 namespace uwb::protocol::fira::uci
 {
+/**
+ * @brief A view of a complete UCI control message, which may have been sent
+ * as multiple segmented packets. The payload refers to a buffer owned by
+ * someone else; it isn't copied.
+ */
+struct ControlMessageView
+{
+    MessageType Type{ MessageType::Command };
+    uint8_t Group{ 0 };
+    uint8_t Opcode{ 0 };
+    std::span<const uint8_t> Payload{};
+
+    /**
+     * @brief Determines whether the message has the specified type and
+     * opcode.
+     *
+     * @tparam OpcodeT The opcode enumeration of the group.
+     * @param type The message type.
+     * @param group The group identifier.
+     * @param opcode The opcode identifier.
+     * @return true If the message matches.
+     * @return false Otherwise.
+     */
+    template <typename OpcodeT>
+    requires std::is_enum_v<OpcodeT>
+    bool
+    Is(MessageType type, GroupId group, OpcodeT opcode) const noexcept
+    {
+        return (Type == type) && (Group == notstd::to_underlying(group)) && (Opcode == notstd::to_underlying(opcode));
+    }
+};
+
+/**
+ * @brief A complete UCI control message, owning its payload.
+ *
+ * See FiRa Consortium - UCI Generic Specification v1.1.0, Section 4.4.
+ */
 struct ControlMessage
 {
+    MessageType Type{ MessageType::Command };
+    uint8_t Group{ 0 };
+    uint8_t Opcode{ 0 };
+    std::vector<uint8_t> Payload{};
+
+    bool
+    operator==(const ControlMessage&) const noexcept = default;
+
+    /**
+     * @brief Create a message.
+     *
+     * @tparam OpcodeT The opcode enumeration of the group.
+     * @param type The message type.
+     * @param group The group identifier.
+     * @param opcode The opcode identifier.
+     * @param payload The payload of the message.
+     * @return ControlMessage
+     */
+    template <typename OpcodeT>
+    requires std::is_enum_v<OpcodeT>
+    static ControlMessage
+    Create(MessageType type, GroupId group, OpcodeT opcode, std::vector<uint8_t> payload = {})
+    {
+        return ControlMessage{ type, notstd::to_underlying(group), notstd::to_underlying(opcode), std::move(payload) };
+    }
+
+    /**
+     * @brief Create a message with a copy of the contents of a view.
+     *
+     * @param view The view to copy.
+     * @return ControlMessage
+     */
+    static ControlMessage
+    FromView(const ControlMessageView& view);
+
+    /**
+     * @brief Get a view of the message.
+     *
+     * @return ControlMessageView
+     */
+    ControlMessageView
+    View() const noexcept;
+
+    /**
+     * @brief Encodes the message as a sequence of control packets. Payloads
+     * larger than the maximum packet payload length are segmented, with the
+     * packet boundary flag set on all but the last packet.
+     *
+     * @param payloadLengthMaximum The largest payload to put in one packet,
+     * between 1 and ControlPacketHeader::PayloadLengthMaximum.
+     * @return std::vector<uint8_t> The packets, one after the other.
+     */
+    std::vector<uint8_t>
+    Encode(std::size_t payloadLengthMaximum = ControlPacketHeader::PayloadLengthMaximum) const;
+};
+
+/**
+ * @brief Reassembles segmented control packets into complete messages.
+ *
+ * Messages sent in a single packet are returned without copying their
+ * payload. Segmented messages are accumulated into a buffer owned by the
+ * reassembler, which is reused for subsequent messages.
+ */
+class ControlMessageReassembler
+{
+public:
+    /**
+     * @brief Adds a packet to the message being reassembled.
+     *
+     * If a packet arrives which doesn't continue the pending segmented
+     * message, the pending message is discarded and the packet starts a new
+     * one.
+     *
+     * @param packet The packet to add.
+     * @return std::optional<ControlMessageView> The complete message, if the
+     * packet completes one. The view is only valid until the next call to
+     * Push(), and for as long as the buffer holding the packet.
+     */
+    std::optional<ControlMessageView>
+    Push(const ControlPacket& packet);
+
+    /**
+     * @brief Discards the message being reassembled, if any.
+     */
+    void
+    Reset() noexcept;
+
+    /**
+     * @brief Get the number of partially reassembled messages that were
+     * discarded.
+     *
+     * @return std::size_t
+     */
+    std::size_t
+    GetNumberOfMessagesDiscarded() const noexcept;
+
+private:
+    std::optional<ControlPacketHeader> m_header{};
+    std::vector<uint8_t> m_payload{};
+    std::size_t m_numberOfMessagesDiscarded{ 0 };
 };
 
 } // namespace uwb::protocol::fira::uci
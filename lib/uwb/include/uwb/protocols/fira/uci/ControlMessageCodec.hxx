@@ -0,0 +1,421 @@
+
+#ifndef FIRA_UCI_CONTROL_MESSAGE_CODEC_HXX
+#define FIRA_UCI_CONTROL_MESSAGE_CODEC_HXX
+
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include <uwb/protocols/fira/FiraDevice.hxx>
+#include <uwb/protocols/fira/uci/ControlMessage.hxx>
+
+/**
+ * @brief Encoders and decoders for the payloads of the UCI control messages
+ * in the core, session and ranging groups.
+ *
+ * Encoders produce complete messages, ready to be passed to
+ * ControlMessage::Encode(). Decoders accept the payload of a complete
+ * (reassembled) message and return std::nullopt if it is malformed. All
+ * multi-octet fields are little-endian.
+ *
+ * See FiRa Consortium - UCI Generic Specification v1.1.0, Section 7 and
+ * Section 8.
+ */
+namespace uwb::protocol::fira::uci
+{
+/**
+ * @brief The length of a single two-way ranging measurement in a
+ * RANGE_DATA_NTF, irrespective of the mac address mode.
+ */
+constexpr std::size_t RangingMeasurementLength = 31;
+
+/**
+ * @brief The length of the fixed portion of a RANGE_DATA_NTF, preceding the
+ * ranging measurements.
+ */
+constexpr std::size_t RangeDataNotificationHeaderLength = 25;
+
+/**
+ * @brief The decoded payload of a SESSION_INIT_CMD.
+ */
+struct SessionInitCommand
+{
+    uint32_t SessionId;
+    UwbSessionType SessionType;
+
+    auto
+    operator<=>(const SessionInitCommand&) const noexcept = default;
+};
+
+/**
+ * @brief The decoded payload of a SESSION_SET_APP_CONFIG_CMD.
+ */
+struct SessionSetAppConfigCommand
+{
+    uint32_t SessionId;
+    std::vector<UwbApplicationConfigurationParameter> Parameters;
+
+    bool
+    operator==(const SessionSetAppConfigCommand&) const noexcept = default;
+};
+
+/**
+ * @brief The decoded payload of a SESSION_GET_APP_CONFIG_CMD.
+ */
+struct SessionGetAppConfigCommand
+{
+    uint32_t SessionId;
+    std::vector<UwbApplicationConfigurationParameterType> ParameterTypes;
+
+    auto
+    operator<=>(const SessionGetAppConfigCommand&) const noexcept = default;
+};
+
+/**
+ * @brief The decoded payload of a SESSION_SET_APP_CONFIG_RSP.
+ */
+struct SessionSetAppConfigResponse
+{
+    UwbStatus Status;
+    std::vector<UwbSetApplicationConfigurationParameterStatus> ParameterStatuses;
+
+    auto
+    operator<=>(const SessionSetAppConfigResponse&) const noexcept = default;
+};
+
+/**
+ * @brief The decoded payload of a SESSION_GET_APP_CONFIG_RSP.
+ */
+struct SessionGetAppConfigResponse
+{
+    UwbStatus Status;
+    std::vector<UwbApplicationConfigurationParameter> Parameters;
+
+    bool
+    operator==(const SessionGetAppConfigResponse&) const noexcept = default;
+};
+
+/**
+ * @brief The decoded payload of a SESSION_GET_COUNT_RSP or a
+ * RANGE_GET_RANGING_COUNT_RSP.
+ */
+struct CountResponse
+{
+    UwbStatus Status;
+    uint32_t Count;
+
+    auto
+    operator<=>(const CountResponse&) const noexcept = default;
+};
+
+/**
+ * @brief The decoded payload of a SESSION_GET_STATE_RSP.
+ */
+struct SessionGetStateResponse
+{
+    UwbStatus Status;
+    UwbSessionState State;
+
+    auto
+    operator<=>(const SessionGetStateResponse&) const noexcept = default;
+};
+
+/**
+ * @brief Encodes a CORE_DEVICE_RESET_CMD.
+ */
+ControlMessage
+EncodeDeviceResetCommand();
+
+/**
+ * @brief Encodes a CORE_GET_DEVICE_INFO_CMD.
+ */
+ControlMessage
+EncodeGetDeviceInfoCommand();
+
+/**
+ * @brief Encodes a SESSION_INIT_CMD.
+ */
+ControlMessage
+EncodeSessionInitCommand(const SessionInitCommand& command);
+
+/**
+ * @brief Encodes a SESSION_DEINIT_CMD.
+ */
+ControlMessage
+EncodeSessionDeinitCommand(uint32_t sessionId);
+
+/**
+ * @brief Encodes a SESSION_SET_APP_CONFIG_CMD.
+ */
+ControlMessage
+EncodeSessionSetAppConfigCommand(const SessionSetAppConfigCommand& command);
+
+/**
+ * @brief Encodes a SESSION_GET_APP_CONFIG_CMD.
+ */
+ControlMessage
+EncodeSessionGetAppConfigCommand(const SessionGetAppConfigCommand& command);
+
+/**
+ * @brief Encodes a SESSION_GET_COUNT_CMD.
+ */
+ControlMessage
+EncodeSessionGetCountCommand();
+
+/**
+ * @brief Encodes a SESSION_GET_STATE_CMD.
+ */
+ControlMessage
+EncodeSessionGetStateCommand(uint32_t sessionId);
+
+/**
+ * @brief Encodes a SESSION_UPDATE_CONTROLLER_MULTICAST_LIST_CMD. Only short
+ * controlee addresses are allowed.
+ */
+ControlMessage
+EncodeSessionUpdateControllerMulticastListCommand(const UwbSessionUpdateMulicastList& command);
+
+/**
+ * @brief Encodes a RANGE_START_CMD.
+ */
+ControlMessage
+EncodeRangeStartCommand(uint32_t sessionId);
+
+/**
+ * @brief Encodes a RANGE_STOP_CMD.
+ */
+ControlMessage
+EncodeRangeStopCommand(uint32_t sessionId);
+
+/**
+ * @brief Encodes a RANGE_GET_RANGING_COUNT_CMD.
+ */
+ControlMessage
+EncodeRangeGetRangingCountCommand(uint32_t sessionId);
+
+/**
+ * @brief Decodes the payload of a command whose only field is a session
+ * identifier, which are SESSION_DEINIT_CMD, SESSION_GET_STATE_CMD,
+ * RANGE_START_CMD, RANGE_STOP_CMD and RANGE_GET_RANGING_COUNT_CMD.
+ *
+ * @param payload The payload of the command.
+ * @return std::optional<uint32_t> The session identifier.
+ */
+std::optional<uint32_t>
+DecodeSessionIdCommand(std::span<const uint8_t> payload) noexcept;
+
+/**
+ * @brief Decodes the payload of a SESSION_INIT_CMD.
+ */
+std::optional<SessionInitCommand>
+DecodeSessionInitCommand(std::span<const uint8_t> payload) noexcept;
+
+/**
+ * @brief Decodes the payload of a SESSION_SET_APP_CONFIG_CMD.
+ */
+std::optional<SessionSetAppConfigCommand>
+DecodeSessionSetAppConfigCommand(std::span<const uint8_t> payload);
+
+/**
+ * @brief Decodes the payload of a SESSION_GET_APP_CONFIG_CMD.
+ */
+std::optional<SessionGetAppConfigCommand>
+DecodeSessionGetAppConfigCommand(std::span<const uint8_t> payload);
+
+/**
+ * @brief Decodes the payload of a SESSION_UPDATE_CONTROLLER_MULTICAST_LIST_CMD.
+ */
+std::optional<UwbSessionUpdateMulicastList>
+DecodeSessionUpdateControllerMulticastListCommand(std::span<const uint8_t> payload);
+
+/**
+ * @brief Encodes a response whose only field is a status, replying to the
+ * specified command.
+ *
+ * @param command The command being responded to.
+ * @param status The status of the command.
+ * @return ControlMessage
+ */
+ControlMessage
+EncodeStatusResponse(const ControlMessageView& command, const UwbStatus& status);
+
+/**
+ * @brief Encodes a CORE_GET_DEVICE_INFO_RSP.
+ */
+ControlMessage
+EncodeGetDeviceInfoResponse(const UwbDeviceInformation& deviceInformation);
+
+/**
+ * @brief Encodes a SESSION_SET_APP_CONFIG_RSP.
+ */
+ControlMessage
+EncodeSessionSetAppConfigResponse(const SessionSetAppConfigResponse& response);
+
+/**
+ * @brief Encodes a SESSION_GET_APP_CONFIG_RSP.
+ */
+ControlMessage
+EncodeSessionGetAppConfigResponse(const SessionGetAppConfigResponse& response);
+
+/**
+ * @brief Encodes a SESSION_GET_COUNT_RSP. The count is a single octet on the
+ * wire.
+ */
+ControlMessage
+EncodeSessionGetCountResponse(const CountResponse& response);
+
+/**
+ * @brief Encodes a SESSION_GET_STATE_RSP.
+ */
+ControlMessage
+EncodeSessionGetStateResponse(const SessionGetStateResponse& response);
+
+/**
+ * @brief Encodes a RANGE_GET_RANGING_COUNT_RSP.
+ */
+ControlMessage
+EncodeRangeGetRangingCountResponse(const CountResponse& response);
+
+/**
+ * @brief Decodes the payload of a response whose only field is a status.
+ *
+ * @param payload The payload of the response.
+ * @return std::optional<UwbStatus>
+ */
+std::optional<UwbStatus>
+DecodeStatusResponse(std::span<const uint8_t> payload) noexcept;
+
+/**
+ * @brief Decodes the payload of a CORE_GET_DEVICE_INFO_RSP.
+ */
+std::optional<UwbDeviceInformation>
+DecodeGetDeviceInfoResponse(std::span<const uint8_t> payload);
+
+/**
+ * @brief Decodes the payload of a SESSION_SET_APP_CONFIG_RSP.
+ */
+std::optional<SessionSetAppConfigResponse>
+DecodeSessionSetAppConfigResponse(std::span<const uint8_t> payload);
+
+/**
+ * @brief Decodes the payload of a SESSION_GET_APP_CONFIG_RSP.
+ */
+std::optional<SessionGetAppConfigResponse>
+DecodeSessionGetAppConfigResponse(std::span<const uint8_t> payload);
+
+/**
+ * @brief Decodes the payload of a SESSION_GET_COUNT_RSP.
+ */
+std::optional<CountResponse>
+DecodeSessionGetCountResponse(std::span<const uint8_t> payload) noexcept;
+
+/**
+ * @brief Decodes the payload of a SESSION_GET_STATE_RSP.
+ */
+std::optional<SessionGetStateResponse>
+DecodeSessionGetStateResponse(std::span<const uint8_t> payload) noexcept;
+
+/**
+ * @brief Decodes the payload of a RANGE_GET_RANGING_COUNT_RSP.
+ */
+std::optional<CountResponse>
+DecodeRangeGetRangingCountResponse(std::span<const uint8_t> payload) noexcept;
+
+/**
+ * @brief Encodes a CORE_DEVICE_STATUS_NTF.
+ */
+ControlMessage
+EncodeDeviceStatusNotification(const UwbStatusDevice& statusDevice);
+
+/**
+ * @brief Encodes a CORE_GENERIC_ERROR_NTF.
+ */
+ControlMessage
+EncodeGenericErrorNotification(const UwbStatus& status);
+
+/**
+ * @brief Encodes a SESSION_STATUS_NTF.
+ */
+ControlMessage
+EncodeSessionStatusNotification(const UwbSessionStatus& sessionStatus);
+
+/**
+ * @brief Encodes a SESSION_UPDATE_CONTROLLER_MULTICAST_LIST_NTF.
+ */
+ControlMessage
+EncodeSessionUpdateControllerMulticastListNotification(const UwbSessionUpdateMulticastListStatus& multicastListStatus);
+
+/**
+ * @brief Encodes a two-way ranging RANGE_DATA_NTF. The mac address mode is
+ * taken from the first measurement; all measurements must use the same one.
+ *
+ * @param rangingData The ranging data to encode.
+ * @return ControlMessage
+ */
+ControlMessage
+EncodeRangeDataNotification(const UwbRangingData& rangingData);
+
+/**
+ * @brief Decodes the payload of a CORE_DEVICE_STATUS_NTF.
+ */
+std::optional<UwbStatusDevice>
+DecodeDeviceStatusNotification(std::span<const uint8_t> payload) noexcept;
+
+/**
+ * @brief Decodes the payload of a CORE_GENERIC_ERROR_NTF.
+ */
+std::optional<UwbStatus>
+DecodeGenericErrorNotification(std::span<const uint8_t> payload) noexcept;
+
+/**
+ * @brief Decodes the payload of a SESSION_STATUS_NTF.
+ */
+std::optional<UwbSessionStatus>
+DecodeSessionStatusNotification(std::span<const uint8_t> payload) noexcept;
+
+/**
+ * @brief Decodes the payload of a SESSION_UPDATE_CONTROLLER_MULTICAST_LIST_NTF.
+ */
+std::optional<UwbSessionUpdateMulticastListStatus>
+DecodeSessionUpdateControllerMulticastListNotification(std::span<const uint8_t> payload);
+
+/**
+ * @brief Decodes a two-way ranging RANGE_DATA_NTF directly from the payload
+ * into existing ranging data, reusing the storage of its measurements. This
+ * is intended for the ranging hot path, where a notification arrives every
+ * ranging round.
+ *
+ * @param payload The payload of the notification.
+ * @param rangingData The ranging data to decode into. Its contents are
+ * unspecified if decoding fails.
+ * @return true If the payload was decoded.
+ * @return false If the payload is malformed.
+ */
+bool
+DecodeRangeDataNotification(std::span<const uint8_t> payload, UwbRangingData& rangingData);
+
+/**
+ * @brief Decodes a two-way ranging RANGE_DATA_NTF.
+ *
+ * @param payload The payload of the notification.
+ * @return std::optional<UwbRangingData>
+ */
+std::optional<UwbRangingData>
+DecodeRangeDataNotification(std::span<const uint8_t> payload);
+
+/**
+ * @brief Decodes a notification in the core, session or ranging group into
+ * the notification data reported to device and session callbacks.
+ *
+ * @param notification The notification to decode.
+ * @return std::optional<UwbNotificationData> The notification data, or
+ * std::nullopt if the message isn't a supported notification or is
+ * malformed.
+ */
+std::optional<UwbNotificationData>
+DecodeNotification(const ControlMessageView& notification);
+
+} // namespace uwb::protocol::fira::uci
+
+#endif // FIRA_UCI_CONTROL_MESSAGE_CODEC_HXX
@@ -2,10 +2,87 @@
 #ifndef FIRA_UCI_CONTROL_PACKET_HXX
 #define FIRA_UCI_CONTROL_PACKET_HXX
 
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+
+#include <uwb/protocols/fira/uci/Opcodes.hxx>
+
 namespace uwb::protocol::fira::uci
 {
+/**
+ * @brief The header of a UCI control packet.
+ *
+ * See FiRa Consortium - UCI Generic Specification v1.1.0, Section 4.4.1,
+ * Figure 6, 'UCI Control Packet Header'. The header is 4 octets:
+ *
+ *  octet 0: MT (bits 7-5), PBF (bit 4), GID (bits 3-0)
+ *  octet 1: RFU (bits 7-6), OID (bits 5-0)
+ *  octet 2: RFU
+ *  octet 3: payload length
+ */
+struct ControlPacketHeader
+{
+    static constexpr std::size_t Size = 4;
+    static constexpr std::size_t PayloadLengthMaximum = 255;
+
+    MessageType Type{ MessageType::Command };
+    bool PacketBoundaryFlag{ false };
+    uint8_t Group{ 0 };
+    uint8_t Opcode{ 0 };
+    uint8_t PayloadLength{ 0 };
+
+    auto
+    operator<=>(const ControlPacketHeader&) const noexcept = default;
+
+    /**
+     * @brief Parses a header from the start of a buffer.
+     *
+     * @param data The buffer holding the header.
+     * @return std::optional<ControlPacketHeader> The header, or std::nullopt
+     * if the buffer is too small to hold one, or it describes a data packet.
+     */
+    static std::optional<ControlPacketHeader>
+    Parse(std::span<const uint8_t> data) noexcept;
+
+    /**
+     * @brief Encodes the header.
+     *
+     * @return std::array<uint8_t, Size>
+     */
+    std::array<uint8_t, Size>
+    Encode() const noexcept;
+};
+
+/**
+ * @brief A view of a single UCI control packet. The payload refers to the
+ * buffer the packet was parsed from; it isn't copied.
+ */
 struct ControlPacket
 {
+    ControlPacketHeader Header;
+    std::span<const uint8_t> Payload;
+
+    /**
+     * @brief Parses a packet from the start of a buffer.
+     *
+     * @param data The buffer holding the packet, which may hold more data
+     * following it.
+     * @return std::optional<ControlPacket> The packet, or std::nullopt if the
+     * header is invalid or the buffer doesn't hold the complete payload.
+     */
+    static std::optional<ControlPacket>
+    Parse(std::span<const uint8_t> data) noexcept;
+
+    /**
+     * @brief Get the total size of the packet, including the header.
+     *
+     * @return std::size_t
+     */
+    std::size_t
+    Size() const noexcept;
 };
 
 } // namespace uwb::protocol::fira::uci
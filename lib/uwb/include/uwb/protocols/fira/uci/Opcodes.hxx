@@ -0,0 +1,74 @@
+
+#ifndef FIRA_UCI_OPCODES_HXX
+#define FIRA_UCI_OPCODES_HXX
+
+#include <cstdint>
+
+namespace uwb::protocol::fira::uci
+{
+/**
+ * @brief See FiRa Consortium - UCI Generic Specification v1.1.0, Section 4.3,
+ * Table 2, 'Message Type (MT)'.
+ */
+enum class MessageType : uint8_t {
+    Data = 0b000U,
+    Command = 0b001U,
+    Response = 0b010U,
+    Notification = 0b011U,
+};
+
+/**
+ * @brief See FiRa Consortium - UCI Generic Specification v1.1.0, Section 8.4,
+ * Table 38, 'UCI Group Identifiers (GID)'.
+ */
+enum class GroupId : uint8_t {
+    Core = 0x0U,
+    Session = 0x1U,
+    Ranging = 0x2U,
+    Test = 0xDU,
+};
+
+/**
+ * @brief See FiRa Consortium - UCI Generic Specification v1.1.0, Section 8.4,
+ * Table 39, 'UCI Opcode Identifiers (OID)', core group.
+ */
+enum class CoreOpcodeId : uint8_t {
+    DeviceReset = 0x00U,
+    DeviceStatus = 0x01U,
+    GetDeviceInfo = 0x02U,
+    GetCapsInfo = 0x03U,
+    SetConfig = 0x04U,
+    GetConfig = 0x05U,
+    GenericError = 0x07U,
+};
+
+/**
+ * @brief See FiRa Consortium - UCI Generic Specification v1.1.0, Section 8.4,
+ * Table 39, 'UCI Opcode Identifiers (OID)', session group.
+ */
+enum class SessionOpcodeId : uint8_t {
+    Init = 0x00U,
+    Deinit = 0x01U,
+    Status = 0x02U,
+    SetAppConfig = 0x03U,
+    GetAppConfig = 0x04U,
+    GetCount = 0x05U,
+    GetState = 0x06U,
+    UpdateControllerMulticastList = 0x07U,
+};
+
+/**
+ * @brief See FiRa Consortium - UCI Generic Specification v1.1.0, Section 8.4,
+ * Table 39, 'UCI Opcode Identifiers (OID)', ranging group. Note that the
+ * start command and the ranging data notification share an opcode.
+ */
+enum class RangingOpcodeId : uint8_t {
+    Start = 0x00U,
+    RangeData = 0x00U,
+    Stop = 0x01U,
+    GetRangingCount = 0x03U,
+};
+
+} // namespace uwb::protocol::fira::uci
+
+#endif // FIRA_UCI_OPCODES_HXX
@@ -0,0 +1,107 @@
+
+#ifndef UWB_SIMULATOR_CONFIGURATION_HXX
+#define UWB_SIMULATOR_CONFIGURATION_HXX
+
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+namespace uwb::simulator
+{
+/**
+ * @brief The position of a simulated peer relative to the simulated device.
+ */
+struct UwbSimulatorPosition
+{
+    /**
+     * @brief Distance in centimeters, the unit reported by FiRa ranging
+     * measurements.
+     */
+    double Distance{ 100.0 };
+
+    /**
+     * @brief Azimuth angle in degrees, in the range [-180, 180).
+     */
+    double Azimuth{ 0.0 };
+
+    /**
+     * @brief Elevation angle in degrees, in the range [-90, 90].
+     */
+    double Elevation{ 0.0 };
+
+    auto
+    operator<=>(const UwbSimulatorPosition&) const noexcept = default;
+};
+
+/**
+ * @brief The ways a simulated peer can move.
+ */
+enum class UwbSimulatorMotionModelType {
+    /**
+     * @brief The peer stays at its initial position.
+     */
+    Stationary,
+
+    /**
+     * @brief The peer takes a normally distributed random step in distance
+     * and angle each ranging round, scaled by its speeds.
+     */
+    RandomWalk,
+
+    /**
+     * @brief The peer circles the device at a fixed distance, at its angular
+     * speed.
+     */
+    Orbit,
+
+    /**
+     * @brief The peer moves directly towards and away from the device at its
+     * speed, turning around at the distance limits.
+     */
+    Oscillate,
+};
+
+/**
+ * @brief Describes how a simulated peer moves, and how noisy its measurements
+ * are.
+ */
+struct UwbSimulatorPeerMotion
+{
+    UwbSimulatorMotionModelType Model{ UwbSimulatorMotionModelType::Stationary };
+    UwbSimulatorPosition Initial{};
+    double DistanceMinimum{ 10.0 };
+    double DistanceMaximum{ 1000.0 };
+    double Speed{ 50.0 }; // centimeters per second
+    double AngularSpeed{ 30.0 }; // degrees per second
+    double DistanceNoise{ 0.0 }; // standard deviation, centimeters
+    double AngleNoise{ 0.0 }; // standard deviation, degrees
+};
+
+/**
+ * @brief Configuration of a simulated UWB device.
+ */
+struct UwbSimulatorConfiguration
+{
+    static constexpr std::chrono::milliseconds RangingIntervalDefault{ 200 };
+
+    /**
+     * @brief Seed for all generated values. Simulations with the same seed
+     * and configuration produce the same measurements, regardless of
+     * timing or the standard library in use.
+     */
+    uint64_t Seed{ 0 };
+
+    /**
+     * @brief The interval between ranging rounds of each session. Sessions
+     * override this when configured with a RangingInterval parameter.
+     */
+    std::chrono::microseconds RangingInterval{ RangingIntervalDefault };
+
+    /**
+     * @brief The peers present in each session.
+     */
+    std::vector<UwbSimulatorPeerMotion> Peers{ UwbSimulatorPeerMotion{} };
+};
+} // namespace uwb::simulator
+
+#endif // UWB_SIMULATOR_CONFIGURATION_HXX
@@ -0,0 +1,229 @@
+
+#ifndef UWB_SIMULATOR_DEVICE_HXX
+#define UWB_SIMULATOR_DEVICE_HXX
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <stop_token>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include <uwb/UwbDevice.hxx>
+#include <uwb/protocols/fira/FiraDevice.hxx>
+#include <uwb/simulator/UwbSimulatorConfiguration.hxx>
+
+namespace uwb::simulator
+{
+class UwbSimulatorSession;
+
+/**
+ * @brief A simulated UWB device which doesn't require any hardware or
+ * platform support.
+ *
+ * Each session simulates the peers described by the configuration. The
+ * ranging rounds of all sessions are driven by a single timer thread, so
+ * many sessions with short ranging intervals can be simulated to load test
+ * the layers above the device. Session event callbacks are invoked on the
+ * timer thread.
+ */
+class UwbSimulatorDevice :
+    public uwb::UwbDevice,
+    public std::enable_shared_from_this<UwbSimulatorDevice>
+{
+protected:
+    /**
+     * @brief Construct a new UwbSimulatorDevice object.
+     *
+     * @param configuration The simulation configuration.
+     */
+    explicit UwbSimulatorDevice(UwbSimulatorConfiguration configuration);
+
+public:
+    /**
+     * @brief Create a new UwbSimulatorDevice object instance.
+     *
+     * @param configuration The simulation configuration.
+     * @return std::shared_ptr<UwbSimulatorDevice>
+     */
+    static std::shared_ptr<UwbSimulatorDevice>
+    Create(UwbSimulatorConfiguration configuration = {});
+
+    /**
+     * @brief Destroy the UwbSimulatorDevice object, stopping the timer thread.
+     */
+    ~UwbSimulatorDevice() override;
+
+    /**
+     * @brief Get the simulation configuration.
+     *
+     * @return const UwbSimulatorConfiguration&
+     */
+    const UwbSimulatorConfiguration&
+    GetConfiguration() const noexcept;
+
+    /**
+     * @brief Get the total number of ranging measurements generated across
+     * all sessions.
+     *
+     * @return uint64_t
+     */
+    uint64_t
+    GetNumberOfMeasurementsGenerated() const noexcept;
+
+    /**
+     * @brief Determine if this device is the same as another.
+     *
+     * @param other
+     * @return true
+     * @return false
+     */
+    bool
+    IsEqual(const uwb::UwbDevice& other) const noexcept override;
+
+private:
+    friend class UwbSimulatorSession;
+
+    /**
+     * @brief Start running ranging rounds for a session.
+     *
+     * @param sessionId The session identifier.
+     * @param rangingInterval The interval between ranging rounds.
+     */
+    void
+    StartRanging(uint32_t sessionId, std::chrono::microseconds rangingInterval);
+
+    /**
+     * @brief Change the interval between the ranging rounds of a session, if
+     * it is ranging. The next round is due one new interval from now.
+     *
+     * @param sessionId The session identifier.
+     * @param rangingInterval The interval between ranging rounds.
+     */
+    void
+    UpdateRangingInterval(uint32_t sessionId, std::chrono::microseconds rangingInterval);
+
+    /**
+     * @brief Stop running ranging rounds for a session. If a ranging round is
+     * in progress, this waits for it to complete, unless called from the
+     * round itself.
+     *
+     * @param sessionId The session identifier.
+     */
+    void
+    StopRanging(uint32_t sessionId);
+
+    /**
+     * @brief Remove a session from the device. This waits for a ranging round
+     * in progress like StopRanging().
+     *
+     * @param sessionId The session identifier.
+     */
+    void
+    OnSessionDestroyed(uint32_t sessionId);
+
+    /**
+     * @brief Schedule the ranging rounds of a session, replacing any existing
+     * schedule for it. The caller must hold m_scheduleGate.
+     *
+     * @param sessionId The session identifier.
+     * @param session The session.
+     * @param rangingInterval The interval between ranging rounds.
+     */
+    void
+    ScheduleRangingLocked(uint32_t sessionId, std::weak_ptr<UwbSimulatorSession> session, std::chrono::microseconds rangingInterval);
+
+    /**
+     * @brief Wait for a ranging round in progress, if any, to complete. Does
+     * nothing when called from the timer thread, since that is running the
+     * round.
+     */
+    void
+    WaitForRangingRound();
+
+    /**
+     * @brief Timer thread entry point.
+     *
+     * @param stopToken The token signaling the thread to stop.
+     */
+    void
+    ProcessSchedule(std::stop_token stopToken);
+
+    std::shared_ptr<uwb::UwbSession>
+    CreateSessionImpl(uint32_t sessionId, std::weak_ptr<uwb::UwbSessionEventCallbacks> callbacks) override;
+
+    std::shared_ptr<uwb::UwbSession>
+    ResolveSessionImpl(uint32_t sessionId) override;
+
+    uwb::protocol::fira::UwbCapability
+    GetCapabilitiesImpl() override;
+
+    uwb::protocol::fira::UwbDeviceInformation
+    GetDeviceInformationImpl() override;
+
+    uint32_t
+    GetSessionCountImpl() override;
+
+    void
+    ResetImpl() override;
+
+private:
+    /**
+     * @brief The next ranging round of a session.
+     */
+    struct ScheduleEntry
+    {
+        std::chrono::steady_clock::time_point Due;
+        uint32_t SessionId;
+        uint64_t Generation;
+
+        auto
+        operator<=>(const ScheduleEntry&) const noexcept = default;
+    };
+
+    /**
+     * @brief A session that is ranging.
+     */
+    struct RangingSession
+    {
+        std::weak_ptr<UwbSimulatorSession> Session;
+        std::chrono::steady_clock::duration RangingInterval;
+        uint64_t Generation;
+    };
+
+    /**
+     * @brief A ranging round that has come due.
+     */
+    struct RangingRound
+    {
+        std::shared_ptr<UwbSimulatorSession> Session;
+        uint64_t Generation;
+    };
+
+    const UwbSimulatorConfiguration m_configuration;
+    std::atomic<uint64_t> m_numberOfMeasurementsGenerated{ 0 };
+
+    std::mutex m_scheduleGate;
+    std::condition_variable_any m_scheduleChanged;
+    // Entries for sessions that stopped ranging are discarded when they come due.
+    std::priority_queue<ScheduleEntry, std::vector<ScheduleEntry>, std::greater<>> m_schedule;
+    std::unordered_map<uint32_t, RangingSession> m_rangingSessions;
+    std::unordered_set<uint32_t> m_sessionIds;
+    uint64_t m_generationNext{ 0 };
+    // Held by the timer thread while it runs a ranging round, so that stopping
+    // ranging can wait for the round to complete.
+    std::mutex m_roundGate;
+
+    // Declared last so it is stopped before the members it uses are destroyed.
+    std::jthread m_timerThread;
+};
+} // namespace uwb::simulator
+
+#endif // UWB_SIMULATOR_DEVICE_HXX
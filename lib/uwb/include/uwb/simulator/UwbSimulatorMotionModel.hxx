@@ -0,0 +1,111 @@
+
+#ifndef UWB_SIMULATOR_MOTION_MODEL_HXX
+#define UWB_SIMULATOR_MOTION_MODEL_HXX
+
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <random>
+
+#include <uwb/simulator/UwbSimulatorConfiguration.hxx>
+
+namespace uwb::simulator
+{
+/**
+ * @brief Pseudo-random number source for simulations.
+ *
+ * The distributions in <random> are implementation-defined, so they produce
+ * different sequences with different standard libraries. This only relies on
+ * std::mt19937_64, whose output is fully specified, so a seed produces the
+ * same sequence regardless of the standard library in use.
+ */
+class UwbSimulatorRandom
+{
+public:
+    /**
+     * @brief Construct a new UwbSimulatorRandom object.
+     *
+     * @param seed The seed.
+     */
+    explicit UwbSimulatorRandom(uint64_t seed) noexcept;
+
+    /**
+     * @brief Derive a seed for an independent stream of values from a base
+     * seed, such that nearby stream identifiers produce unrelated seeds.
+     *
+     * @param seed The base seed.
+     * @param stream The stream identifier, eg. a session id.
+     * @return uint64_t
+     */
+    static uint64_t
+    DeriveSeed(uint64_t seed, uint64_t stream) noexcept;
+
+    /**
+     * @brief Generate a uniformly distributed value in [0, 1).
+     *
+     * @return double
+     */
+    double
+    Uniform() noexcept;
+
+    /**
+     * @brief Generate a normally distributed value with a mean of 0.
+     *
+     * @param standardDeviation The standard deviation of the distribution.
+     * @return double
+     */
+    double
+    Normal(double standardDeviation) noexcept;
+
+private:
+    std::mt19937_64 m_engine;
+    std::optional<double> m_normalSpare;
+};
+
+/**
+ * @brief Tracks the position of a simulated peer as it moves.
+ */
+class UwbSimulatorMotionModel
+{
+public:
+    /**
+     * @brief Construct a new UwbSimulatorMotionModel object.
+     *
+     * @param motion Describes how the peer moves.
+     */
+    explicit UwbSimulatorMotionModel(const UwbSimulatorPeerMotion& motion) noexcept;
+
+    /**
+     * @brief Move the peer.
+     *
+     * @param elapsed The simulated time that has passed.
+     * @param random The source of randomness for the movement.
+     */
+    void
+    Advance(std::chrono::duration<double> elapsed, UwbSimulatorRandom& random) noexcept;
+
+    /**
+     * @brief Get the true position of the peer.
+     *
+     * @return const UwbSimulatorPosition&
+     */
+    const UwbSimulatorPosition&
+    GetPosition() const noexcept;
+
+    /**
+     * @brief Get the position of the peer as measured, with noise applied.
+     *
+     * @param random The source of randomness for the noise.
+     * @return UwbSimulatorPosition
+     */
+    UwbSimulatorPosition
+    Measure(UwbSimulatorRandom& random) const noexcept;
+
+private:
+    UwbSimulatorPeerMotion m_motion;
+    UwbSimulatorPosition m_position;
+    double m_direction{ 1.0 };
+};
+} // namespace uwb::simulator
+
+#endif // UWB_SIMULATOR_MOTION_MODEL_HXX
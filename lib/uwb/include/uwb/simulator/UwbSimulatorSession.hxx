@@ -0,0 +1,119 @@
+
+#ifndef UWB_SIMULATOR_SESSION_HXX
+#define UWB_SIMULATOR_SESSION_HXX
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include <uwb/UwbMacAddress.hxx>
+#include <uwb/UwbSession.hxx>
+#include <uwb/protocols/fira/FiraDevice.hxx>
+#include <uwb/simulator/UwbSimulatorConfiguration.hxx>
+#include <uwb/simulator/UwbSimulatorMotionModel.hxx>
+
+namespace uwb::simulator
+{
+/**
+ * @brief A simulated UWB session, which generates ranging data for a set of
+ * moving peers. Ranging rounds are driven by the parent UwbSimulatorDevice.
+ */
+class UwbSimulatorSession :
+    public uwb::UwbSession
+{
+public:
+    /**
+     * @brief Construct a new UwbSimulatorSession object.
+     *
+     * @param sessionId The unique session identifier.
+     * @param device The parent device.
+     * @param callbacks The event callback instance.
+     * @param configuration The simulation configuration.
+     */
+    UwbSimulatorSession(uint32_t sessionId, std::weak_ptr<uwb::UwbDevice> device, std::weak_ptr<UwbSessionEventCallbacks> callbacks, const UwbSimulatorConfiguration& configuration);
+
+    /**
+     * @brief Get the interval between ranging rounds.
+     *
+     * @return std::chrono::microseconds
+     */
+    std::chrono::microseconds
+    GetRangingInterval() const noexcept;
+
+    /**
+     * @brief Advance the simulation by one ranging interval and generate the
+     * resulting ranging data.
+     *
+     * @return uwb::protocol::fira::UwbRangingData
+     */
+    uwb::protocol::fira::UwbRangingData
+    GenerateNextRangingData();
+
+    /**
+     * @brief Run a ranging round, reporting the resulting measurements to the
+     * session event callbacks. Invoked by the parent device.
+     *
+     * @return std::size_t The number of measurements generated.
+     */
+    std::size_t
+    OnRangingRound();
+
+private:
+    /**
+     * @brief Advance the simulation by one ranging interval.
+     *
+     * @param rangingData The ranging data to fill in. Its storage is reused.
+     */
+    void
+    GenerateNextRangingDataLocked(uwb::protocol::fira::UwbRangingData& rangingData);
+
+    void
+    ConfigureImpl(const std::vector<uwb::protocol::fira::UwbApplicationConfigurationParameter> configParams) override;
+
+    void
+    StartRangingImpl() override;
+
+    void
+    StopRangingImpl() override;
+
+    uwb::protocol::fira::UwbStatus
+    TryAddControleeImpl(UwbMacAddress controleeMacAddress) override;
+
+    std::vector<uwb::protocol::fira::UwbApplicationConfigurationParameter>
+    GetApplicationConfigurationParametersImpl(std::vector<uwb::protocol::fira::UwbApplicationConfigurationParameterType> requestedTypes) override;
+
+    void
+    SetApplicationConfigurationParametersImpl(std::vector<uwb::protocol::fira::UwbApplicationConfigurationParameter> uwbApplicationConfigurationParameters) override;
+
+    uwb::protocol::fira::UwbSessionState
+    GetSessionStateImpl() override;
+
+    void
+    DestroyImpl() override;
+
+private:
+    /**
+     * @brief A simulated peer.
+     */
+    struct SimulatedPeer
+    {
+        UwbMacAddress Address;
+        UwbSimulatorMotionModel Motion;
+    };
+
+    mutable std::mutex m_simulationGate;
+    UwbSimulatorRandom m_random;
+    std::chrono::microseconds m_rangingInterval;
+    uint32_t m_sequenceNumber{ 0 };
+    std::vector<SimulatedPeer> m_simulatedPeers;
+    std::unordered_map<uwb::protocol::fira::UwbApplicationConfigurationParameterType, uwb::protocol::fira::UwbApplicationConfigurationParameter> m_applicationConfigurationParameters;
+    // Only accessed by the device's timer thread.
+    uwb::protocol::fira::UwbRangingData m_rangingData{};
+};
+} // namespace uwb::simulator
+
+#endif // UWB_SIMULATOR_SESSION_HXX
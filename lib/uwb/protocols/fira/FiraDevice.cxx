@@ -5,11 +5,13 @@
 #include <sstream>
 #include <string_view>
 #include <typeindex>
+#include <type_traits>
 #include <typeinfo>
 #include <unordered_map>
 
 #include <magic_enum.hpp>
 #include <notstd/tostring.hxx>
+#include <notstd/utility.hxx>
 
 using namespace uwb::protocol::fira;
 using namespace strings::ostream_operators;
@@ -266,6 +268,45 @@ uwb::protocol::fira::IsUwbStatusRetry(const UwbStatus& uwbStatus) noexcept
     return (status != nullptr) && (*status == UwbStatusGeneric::CommandRetry);
 }
 
+uint8_t
+uwb::protocol::fira::EncodeUwbStatus(const UwbStatus& uwbStatus) noexcept
+{
+    // The generic, session and ranging status enumerations are declared in
+    // the same order as their status codes, which are contiguous within each
+    // range.
+    return std::visit([](auto&& arg) -> uint8_t {
+        using T = std::decay_t<decltype(arg)>;
+        if constexpr (std::is_same_v<T, UwbStatusGeneric>) {
+            return static_cast<uint8_t>(notstd::to_underlying(UwbStatusCode::Ok) + notstd::to_underlying(arg));
+        } else if constexpr (std::is_same_v<T, UwbStatusSession>) {
+            return static_cast<uint8_t>(notstd::to_underlying(UwbStatusCode::UwbSessionNotExist) + notstd::to_underlying(arg));
+        } else {
+            return static_cast<uint8_t>(notstd::to_underlying(UwbStatusCode::RangingTxFailed) + notstd::to_underlying(arg));
+        }
+    },
+        uwbStatus);
+}
+
+std::optional<UwbStatus>
+uwb::protocol::fira::DecodeUwbStatus(uint8_t value) noexcept
+{
+    static_assert(notstd::to_underlying(UwbStatusGeneric::CommandRetry) == notstd::to_underlying(UwbStatusCode::CommandRetry));
+    static_assert(notstd::to_underlying(UwbStatusSession::AddressAlreadyPresent) == notstd::to_underlying(UwbStatusCode::UwbSessionAddressAlreadyPresent) - notstd::to_underlying(UwbStatusCode::UwbSessionNotExist));
+    static_assert(notstd::to_underlying(UwbStatusRanging::RxMacIeMissing) == notstd::to_underlying(UwbStatusCode::RangingRxMaxIeMissing) - notstd::to_underlying(UwbStatusCode::RangingTxFailed));
+
+    if (value <= notstd::to_underlying(UwbStatusCode::CommandRetry)) {
+        return static_cast<UwbStatusGeneric>(value);
+    }
+    if (value >= notstd::to_underlying(UwbStatusCode::UwbSessionNotExist) && value <= notstd::to_underlying(UwbStatusCode::UwbSessionAddressAlreadyPresent)) {
+        return static_cast<UwbStatusSession>(value - notstd::to_underlying(UwbStatusCode::UwbSessionNotExist));
+    }
+    if (value >= notstd::to_underlying(UwbStatusCode::RangingTxFailed) && value <= notstd::to_underlying(UwbStatusCode::RangingRxMaxIeMissing)) {
+        return static_cast<UwbStatusRanging>(value - notstd::to_underlying(UwbStatusCode::RangingTxFailed));
+    }
+
+    return std::nullopt;
+}
+
 std::string
 UwbApplicationConfigurationParameter::ToString() const
 {
@@ -1,6 +1,7 @@
 
-#include <stdexcept>
+#include <memory>
 
+#include <uwb/protocols/fira/FiraDataObjectSchema.hxx>
 #include <uwb/protocols/fira/UwbConfiguration.hxx>
 #include <uwb/protocols/fira/UwbConfigurationBuilder.hxx>
 
@@ -18,17 +19,50 @@ const std::unordered_set<ResultReportConfiguration> UwbConfiguration::ResultRepo
     ResultReportConfiguration::AoAAzimuthReport
 };
 
+namespace
+{
+/**
+ * @brief Decodes a UwbConfiguration from its data object.
+ *
+ * @tparam TlvT The type of tlv to decode from.
+ * @param tlv The tlv to decode.
+ * @return UwbConfiguration
+ */
+template <typename TlvT>
+UwbConfiguration
+FromDataObjectImpl(const TlvT& tlv)
+{
+    if (encoding::TlvBer::GetTagValue(tlv.GetTag()) != UwbConfigurationSchema::Tag) {
+        throw UwbConfiguration::IncorrectTlvTag();
+    }
+
+    UwbConfiguration uwbConfiguration{};
+    if (!UwbConfigurationSchema::DecodeValue(tlv, uwbConfiguration)) {
+        throw UwbConfiguration::IncorrectNumberOfBytesInValueError();
+    }
+
+    return uwbConfiguration;
+}
+} // namespace
+
 std::unique_ptr<encoding::TlvBer>
 UwbConfiguration::ToDataObject() const
 {
-    throw std::logic_error("not implemented");
+    return std::make_unique<encoding::TlvBer>(UwbConfigurationSchema::ToTlvBer(*this));
+}
+
+/* static */
+UwbConfiguration
+UwbConfiguration::FromDataObject(const encoding::TlvBer& tlv)
+{
+    return FromDataObjectImpl(tlv);
 }
 
 /* static */
 UwbConfiguration
-UwbConfiguration::FromDataObject(const encoding::TlvBer& /* tlv */)
+UwbConfiguration::FromDataObject(const encoding::TlvBerView& tlv)
 {
-    throw std::logic_error("not implemented");
+    return FromDataObjectImpl(tlv);
 }
 
 std::optional<uint16_t>
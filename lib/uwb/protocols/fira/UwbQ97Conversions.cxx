@@ -0,0 +1,337 @@
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+
+#include <uwb/protocols/fira/UwbQ97Conversions.hxx>
+
+// Select the SIMD kernels available for the target. SSE2 is part of the
+// x86-64 baseline. AVX2 is used if the compiler targets it, or, with GCC and
+// Clang, if the processor supports it at runtime.
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define UWB_Q97_SSE2
+#endif
+#if defined(__AVX2__)
+#define UWB_Q97_AVX2
+#define UWB_Q97_TARGET_AVX2
+#elif defined(__GNUC__)
+#define UWB_Q97_AVX2
+#define UWB_Q97_AVX2_RUNTIME_CHECK
+#define UWB_Q97_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#define UWB_Q97_NEON
+#if defined(__aarch64__) || defined(_M_ARM64)
+#define UWB_Q97_NEON_FLOAT64
+#endif
+#endif
+
+#if defined(UWB_Q97_SSE2) || defined(UWB_Q97_AVX2)
+#include <immintrin.h>
+#endif
+#if defined(UWB_Q97_NEON)
+#include <arm_neon.h>
+#endif
+
+using namespace uwb::protocol::fira;
+
+namespace
+{
+constexpr uint16_t Q97SignMask = 0x8000U;
+constexpr uint16_t Q97MagnitudeMask = 0x7FFFU;
+constexpr float Q97Scale = 0x1.0p-7F;
+
+// The sign bit moves from bit 15 of the Q9.7 value to bit 31 of a float.
+constexpr int Q97SignShift = 16;
+
+/**
+ * @brief Converts a Q9.7-formatted value to a floating point value.
+ *
+ * @tparam ValueT The floating point type to convert to.
+ * @param q97 The value in Q9.7 format.
+ * @return ValueT
+ */
+template <typename ValueT>
+ValueT
+ConvertQ97Scalar(uint16_t q97) noexcept
+{
+    const auto magnitude = static_cast<ValueT>(q97 & Q97MagnitudeMask) * static_cast<ValueT>(Q97Scale);
+    return ((q97 & Q97SignMask) != 0) ? -magnitude : magnitude;
+}
+
+#if defined(UWB_Q97_SSE2)
+/**
+ * @brief Converts 4 Q9.7-formatted values, zero-extended to 32 bits, to floats.
+ *
+ * @param q97 The values in Q9.7 format.
+ * @return __m128
+ */
+inline __m128
+ConvertQ97x4Sse2(__m128i q97) noexcept
+{
+    const __m128i magnitude = _mm_and_si128(q97, _mm_set1_epi32(Q97MagnitudeMask));
+    const __m128i sign = _mm_slli_epi32(_mm_and_si128(q97, _mm_set1_epi32(Q97SignMask)), Q97SignShift);
+    const __m128 value = _mm_mul_ps(_mm_cvtepi32_ps(magnitude), _mm_set1_ps(Q97Scale));
+    return _mm_or_ps(value, _mm_castsi128_ps(sign));
+}
+
+/**
+ * @brief Converts Q9.7-formatted values to floats, 8 at a time.
+ *
+ * @param q97 The values in Q9.7 format.
+ * @param values The converted values.
+ * @param count The number of values available.
+ * @return std::size_t The number of values converted.
+ */
+std::size_t
+ConvertQ97Sse2(const uint16_t* q97, float* values, std::size_t count) noexcept
+{
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const __m128i packed = _mm_loadu_si128(reinterpret_cast<const __m128i*>(q97 + i));
+        _mm_storeu_ps(values + i, ConvertQ97x4Sse2(_mm_unpacklo_epi16(packed, _mm_setzero_si128())));
+        _mm_storeu_ps(values + i + 4, ConvertQ97x4Sse2(_mm_unpackhi_epi16(packed, _mm_setzero_si128())));
+    }
+    return i;
+}
+
+/**
+ * @brief Converts Q9.7-formatted values to doubles, 8 at a time.
+ *
+ * @param q97 The values in Q9.7 format.
+ * @param values The converted values.
+ * @param count The number of values available.
+ * @return std::size_t The number of values converted.
+ */
+std::size_t
+ConvertQ97Sse2(const uint16_t* q97, double* values, std::size_t count) noexcept
+{
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const __m128i packed = _mm_loadu_si128(reinterpret_cast<const __m128i*>(q97 + i));
+        const __m128 low = ConvertQ97x4Sse2(_mm_unpacklo_epi16(packed, _mm_setzero_si128()));
+        const __m128 high = ConvertQ97x4Sse2(_mm_unpackhi_epi16(packed, _mm_setzero_si128()));
+        // Widening is exact since every Q9.7 value is exactly representable as a float.
+        _mm_storeu_pd(values + i, _mm_cvtps_pd(low));
+        _mm_storeu_pd(values + i + 2, _mm_cvtps_pd(_mm_movehl_ps(low, low)));
+        _mm_storeu_pd(values + i + 4, _mm_cvtps_pd(high));
+        _mm_storeu_pd(values + i + 6, _mm_cvtps_pd(_mm_movehl_ps(high, high)));
+    }
+    return i;
+}
+#endif // UWB_Q97_SSE2
+
+#if defined(UWB_Q97_AVX2)
+/**
+ * @brief Determines if the processor supports AVX2.
+ *
+ * @return true
+ * @return false
+ */
+bool
+IsAvx2Supported() noexcept
+{
+#if defined(UWB_Q97_AVX2_RUNTIME_CHECK)
+    static const bool isAvx2Supported = __builtin_cpu_supports("avx2");
+    return isAvx2Supported;
+#else
+    return true;
+#endif
+}
+
+/**
+ * @brief Converts 8 Q9.7-formatted values to floats.
+ *
+ * @param q97 The values in Q9.7 format.
+ * @return __m256
+ */
+UWB_Q97_TARGET_AVX2 inline __m256
+ConvertQ97x8Avx2(__m128i q97) noexcept
+{
+    const __m256i widened = _mm256_cvtepu16_epi32(q97);
+    const __m256i magnitude = _mm256_and_si256(widened, _mm256_set1_epi32(Q97MagnitudeMask));
+    const __m256i sign = _mm256_slli_epi32(_mm256_and_si256(widened, _mm256_set1_epi32(Q97SignMask)), Q97SignShift);
+    const __m256 value = _mm256_mul_ps(_mm256_cvtepi32_ps(magnitude), _mm256_set1_ps(Q97Scale));
+    return _mm256_or_ps(value, _mm256_castsi256_ps(sign));
+}
+
+/**
+ * @brief Converts Q9.7-formatted values to floats, 16 at a time.
+ *
+ * @param q97 The values in Q9.7 format.
+ * @param values The converted values.
+ * @param count The number of values available.
+ * @return std::size_t The number of values converted.
+ */
+UWB_Q97_TARGET_AVX2 std::size_t
+ConvertQ97Avx2(const uint16_t* q97, float* values, std::size_t count) noexcept
+{
+    std::size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        const __m256i packed = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(q97 + i));
+        _mm256_storeu_ps(values + i, ConvertQ97x8Avx2(_mm256_castsi256_si128(packed)));
+        _mm256_storeu_ps(values + i + 8, ConvertQ97x8Avx2(_mm256_extracti128_si256(packed, 1)));
+    }
+    return i;
+}
+
+/**
+ * @brief Converts Q9.7-formatted values to doubles, 16 at a time.
+ *
+ * @param q97 The values in Q9.7 format.
+ * @param values The converted values.
+ * @param count The number of values available.
+ * @return std::size_t The number of values converted.
+ */
+UWB_Q97_TARGET_AVX2 std::size_t
+ConvertQ97Avx2(const uint16_t* q97, double* values, std::size_t count) noexcept
+{
+    std::size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        const __m256i packed = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(q97 + i));
+        const __m256 low = ConvertQ97x8Avx2(_mm256_castsi256_si128(packed));
+        const __m256 high = ConvertQ97x8Avx2(_mm256_extracti128_si256(packed, 1));
+        // Widening is exact since every Q9.7 value is exactly representable as a float.
+        _mm256_storeu_pd(values + i, _mm256_cvtps_pd(_mm256_castps256_ps128(low)));
+        _mm256_storeu_pd(values + i + 4, _mm256_cvtps_pd(_mm256_extractf128_ps(low, 1)));
+        _mm256_storeu_pd(values + i + 8, _mm256_cvtps_pd(_mm256_castps256_ps128(high)));
+        _mm256_storeu_pd(values + i + 12, _mm256_cvtps_pd(_mm256_extractf128_ps(high, 1)));
+    }
+    return i;
+}
+#endif // UWB_Q97_AVX2
+
+#if defined(UWB_Q97_NEON)
+/**
+ * @brief Converts 4 Q9.7-formatted values, zero-extended to 32 bits, to floats.
+ *
+ * @param q97 The values in Q9.7 format.
+ * @return float32x4_t
+ */
+inline float32x4_t
+ConvertQ97x4Neon(uint32x4_t q97) noexcept
+{
+    const uint32x4_t magnitude = vandq_u32(q97, vdupq_n_u32(Q97MagnitudeMask));
+    const uint32x4_t sign = vshlq_n_u32(vandq_u32(q97, vdupq_n_u32(Q97SignMask)), Q97SignShift);
+    const float32x4_t value = vmulq_n_f32(vcvtq_f32_u32(magnitude), Q97Scale);
+    return vreinterpretq_f32_u32(vorrq_u32(vreinterpretq_u32_f32(value), sign));
+}
+
+/**
+ * @brief Converts Q9.7-formatted values to floats, 8 at a time.
+ *
+ * @param q97 The values in Q9.7 format.
+ * @param values The converted values.
+ * @param count The number of values available.
+ * @return std::size_t The number of values converted.
+ */
+std::size_t
+ConvertQ97Neon(const uint16_t* q97, float* values, std::size_t count) noexcept
+{
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const uint16x8_t packed = vld1q_u16(q97 + i);
+        vst1q_f32(values + i, ConvertQ97x4Neon(vmovl_u16(vget_low_u16(packed))));
+        vst1q_f32(values + i + 4, ConvertQ97x4Neon(vmovl_u16(vget_high_u16(packed))));
+    }
+    return i;
+}
+
+/**
+ * @brief Converts Q9.7-formatted values to doubles, 8 at a time.
+ *
+ * @param q97 The values in Q9.7 format.
+ * @param values The converted values.
+ * @param count The number of values available.
+ * @return std::size_t The number of values converted.
+ */
+std::size_t
+ConvertQ97Neon([[maybe_unused]] const uint16_t* q97, [[maybe_unused]] double* values, [[maybe_unused]] std::size_t count) noexcept
+{
+    std::size_t i = 0;
+#if defined(UWB_Q97_NEON_FLOAT64)
+    for (; i + 8 <= count; i += 8) {
+        const uint16x8_t packed = vld1q_u16(q97 + i);
+        const float32x4_t low = ConvertQ97x4Neon(vmovl_u16(vget_low_u16(packed)));
+        const float32x4_t high = ConvertQ97x4Neon(vmovl_u16(vget_high_u16(packed)));
+        // Widening is exact since every Q9.7 value is exactly representable as a float.
+        vst1q_f64(values + i, vcvt_f64_f32(vget_low_f32(low)));
+        vst1q_f64(values + i + 2, vcvt_high_f64_f32(low));
+        vst1q_f64(values + i + 4, vcvt_f64_f32(vget_low_f32(high)));
+        vst1q_f64(values + i + 6, vcvt_high_f64_f32(high));
+    }
+#endif // UWB_Q97_NEON_FLOAT64
+    return i;
+}
+#endif // UWB_Q97_NEON
+
+/**
+ * @brief Converts Q9.7-formatted values to floating point values, using the
+ * widest kernel available first and finishing the remainder with narrower
+ * ones.
+ *
+ * @tparam ValueT The floating point type to convert to.
+ * @param q97 The values in Q9.7 format.
+ * @param values The converted values.
+ */
+template <typename ValueT>
+void
+ConvertQ97Impl(std::span<const uint16_t> q97, std::span<ValueT> values)
+{
+    if (std::size(values) < std::size(q97)) {
+        throw std::invalid_argument("output span is smaller than the input span");
+    }
+
+    const uint16_t* source = std::data(q97);
+    ValueT* destination = std::data(values);
+    const std::size_t count = std::size(q97);
+    std::size_t converted = 0;
+
+#if defined(UWB_Q97_AVX2)
+    if (IsAvx2Supported()) {
+        converted += ConvertQ97Avx2(source, destination, count);
+    }
+#endif
+#if defined(UWB_Q97_SSE2)
+    converted += ConvertQ97Sse2(source + converted, destination + converted, count - converted);
+#endif
+#if defined(UWB_Q97_NEON)
+    converted += ConvertQ97Neon(source + converted, destination + converted, count - converted);
+#endif
+
+    for (; converted < count; converted++) {
+        destination[converted] = ConvertQ97Scalar<ValueT>(source[converted]);
+    }
+}
+} // namespace
+
+double
+uwb::protocol::fira::ConvertQ97(uint16_t q97) noexcept
+{
+    return ConvertQ97Scalar<double>(q97);
+}
+
+uint16_t
+uwb::protocol::fira::EncodeQ97(double value) noexcept
+{
+    constexpr uint16_t SignMask = 0x8000U;
+    constexpr uint16_t MagnitudeMask = 0x7FFFU;
+
+    const auto magnitude = std::min(std::lround(std::abs(value) * 128.0), static_cast<long>(MagnitudeMask));
+    const auto sign = (value < 0.0) ? SignMask : uint16_t{ 0 };
+    return static_cast<uint16_t>(sign | static_cast<uint16_t>(magnitude));
+}
+
+void
+uwb::protocol::fira::ConvertQ97(std::span<const uint16_t> q97, std::span<float> values)
+{
+    ConvertQ97Impl(q97, values);
+}
+
+void
+uwb::protocol::fira::ConvertQ97(std::span<const uint16_t> q97, std::span<double> values)
+{
+    ConvertQ97Impl(q97, values);
+}
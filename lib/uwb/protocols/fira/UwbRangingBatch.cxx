@@ -0,0 +1,305 @@
+
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+
+#include <notstd/utility.hxx>
+
+#include <uwb/protocols/fira/UwbQ97Conversions.hxx>
+#include <uwb/protocols/fira/UwbRangingBatch.hxx>
+
+using namespace uwb::protocol::fira;
+
+namespace
+{
+/**
+ * @brief Gets an angle of a measurement.
+ *
+ * @param measurement The measurement.
+ * @param angle The angle to get.
+ * @return const UwbRangingMeasurementData&
+ */
+const UwbRangingMeasurementData&
+GetAngle(const UwbRangingMeasurement& measurement, UwbRangingAngle angle) noexcept
+{
+    switch (angle) {
+    case UwbRangingAngle::AoAElevation:
+        return measurement.AoAElevation;
+    case UwbRangingAngle::AoaDestinationAzimuth:
+        return measurement.AoaDestinationAzimuth;
+    case UwbRangingAngle::AoaDestinationElevation:
+        return measurement.AoaDestinationElevation;
+    case UwbRangingAngle::AoAAzimuth:
+    default:
+        return measurement.AoAAzimuth;
+    }
+}
+
+/**
+ * @brief Gets an angle of a measurement.
+ *
+ * @param measurement The measurement.
+ * @param angle The angle to get.
+ * @return UwbRangingMeasurementData&
+ */
+UwbRangingMeasurementData&
+GetAngle(UwbRangingMeasurement& measurement, UwbRangingAngle angle) noexcept
+{
+    return const_cast<UwbRangingMeasurementData&>(GetAngle(std::as_const(measurement), angle));
+}
+} // namespace
+
+UwbRangingBatch::UwbRangingBatch(std::span<const UwbRangingData> rangingData)
+{
+    std::size_t numberOfMeasurements = 0;
+    for (const auto& rangingDataEntry : rangingData) {
+        numberOfMeasurements += std::size(rangingDataEntry.RangingMeasurements);
+    }
+
+    Reserve(std::size(rangingData), numberOfMeasurements);
+    for (const auto& rangingDataEntry : rangingData) {
+        Append(rangingDataEntry);
+    }
+}
+
+void
+UwbRangingBatch::Reserve(std::size_t numberOfRangingData, std::size_t numberOfMeasurements)
+{
+    m_sequenceNumbers.reserve(numberOfRangingData);
+    m_sessionIds.reserve(numberOfRangingData);
+    m_currentRangingIntervals.reserve(numberOfRangingData);
+    m_rangingMeasurementTypes.reserve(numberOfRangingData);
+    m_measurementOffsets.reserve(numberOfRangingData + 1);
+
+    m_slotIndexes.reserve(numberOfMeasurements);
+    m_distances.reserve(numberOfMeasurements);
+    m_statusCodes.reserve(numberOfMeasurements);
+    m_lineOfSightIndicators.reserve(numberOfMeasurements);
+    m_peerIndexes.reserve(numberOfMeasurements);
+    for (std::size_t i = 0; i < NumberOfAngles; i++) {
+        m_angles[i].reserve(numberOfMeasurements);
+        m_figuresOfMerit[i].reserve(numberOfMeasurements);
+    }
+    m_figureOfMeritPresence.reserve(numberOfMeasurements);
+}
+
+void
+UwbRangingBatch::Append(const UwbRangingData& rangingData)
+{
+    m_sequenceNumbers.push_back(rangingData.SequenceNumber);
+    m_sessionIds.push_back(rangingData.SessionId);
+    m_currentRangingIntervals.push_back(rangingData.CurrentRangingInterval);
+    m_rangingMeasurementTypes.push_back(rangingData.RangingMeasurementType);
+
+    for (const auto& measurement : rangingData.RangingMeasurements) {
+        m_slotIndexes.push_back(measurement.SlotIndex);
+        m_distances.push_back(measurement.Distance);
+        m_statusCodes.push_back(EncodeUwbStatus(measurement.Status));
+        m_lineOfSightIndicators.push_back(measurement.LineOfSightIndicator);
+
+        auto [peerIndex, inserted] = m_peerIndexLookup.try_emplace(measurement.PeerMacAddress, static_cast<uint32_t>(std::size(m_peers)));
+        if (inserted) {
+            m_peers.push_back(measurement.PeerMacAddress);
+        }
+        m_peerIndexes.push_back(peerIndex->second);
+
+        uint8_t figureOfMeritPresence = 0;
+        for (std::size_t i = 0; i < NumberOfAngles; i++) {
+            const auto angle = static_cast<UwbRangingAngle>(i);
+            const auto& measurementData = GetAngle(measurement, angle);
+            m_angles[i].push_back(measurementData.Result);
+            m_figuresOfMerit[i].push_back(measurementData.FigureOfMerit.value_or(0));
+            if (measurementData.FigureOfMerit.has_value()) {
+                figureOfMeritPresence |= FigureOfMeritPresentMask(angle);
+            }
+        }
+        m_figureOfMeritPresence.push_back(figureOfMeritPresence);
+    }
+
+    m_measurementOffsets.push_back(std::size(m_distances));
+}
+
+void
+UwbRangingBatch::Clear() noexcept
+{
+    m_sequenceNumbers.clear();
+    m_sessionIds.clear();
+    m_currentRangingIntervals.clear();
+    m_rangingMeasurementTypes.clear();
+    m_measurementOffsets.resize(1);
+
+    m_slotIndexes.clear();
+    m_distances.clear();
+    m_statusCodes.clear();
+    m_lineOfSightIndicators.clear();
+    m_peerIndexes.clear();
+    for (std::size_t i = 0; i < NumberOfAngles; i++) {
+        m_angles[i].clear();
+        m_figuresOfMerit[i].clear();
+    }
+    m_figureOfMeritPresence.clear();
+
+    m_peers.clear();
+    m_peerIndexLookup.clear();
+}
+
+std::size_t
+UwbRangingBatch::GetNumberOfRangingData() const noexcept
+{
+    return std::size(m_sequenceNumbers);
+}
+
+std::size_t
+UwbRangingBatch::GetNumberOfMeasurements() const noexcept
+{
+    return std::size(m_distances);
+}
+
+UwbRangingData
+UwbRangingBatch::GetRangingData(std::size_t index) const
+{
+    if (index >= GetNumberOfRangingData()) {
+        throw std::out_of_range("ranging data index out of range");
+    }
+
+    UwbRangingData rangingData{
+        .SequenceNumber = m_sequenceNumbers[index],
+        .SessionId = m_sessionIds[index],
+        .CurrentRangingInterval = m_currentRangingIntervals[index],
+        .RangingMeasurementType = m_rangingMeasurementTypes[index],
+        .RangingMeasurements = {},
+    };
+
+    const auto measurementBegin = m_measurementOffsets[index];
+    const auto measurementEnd = m_measurementOffsets[index + 1];
+    rangingData.RangingMeasurements.resize(measurementEnd - measurementBegin);
+
+    for (std::size_t m = measurementBegin; m < measurementEnd; m++) {
+        auto& measurement = rangingData.RangingMeasurements[m - measurementBegin];
+        measurement.SlotIndex = m_slotIndexes[m];
+        measurement.Distance = m_distances[m];
+        // Status codes are only ever stored by EncodeUwbStatus(), so they always decode.
+        measurement.Status = DecodeUwbStatus(m_statusCodes[m]).value_or(UwbStatusGeneric::Failed);
+        measurement.PeerMacAddress = m_peers[m_peerIndexes[m]];
+        measurement.LineOfSightIndicator = m_lineOfSightIndicators[m];
+
+        for (std::size_t i = 0; i < NumberOfAngles; i++) {
+            const auto angle = static_cast<UwbRangingAngle>(i);
+            auto& measurementData = GetAngle(measurement, angle);
+            measurementData.Result = m_angles[i][m];
+            if ((m_figureOfMeritPresence[m] & FigureOfMeritPresentMask(angle)) != 0) {
+                measurementData.FigureOfMerit = m_figuresOfMerit[i][m];
+            }
+        }
+    }
+
+    return rangingData;
+}
+
+std::vector<UwbRangingData>
+UwbRangingBatch::ToRangingData() const
+{
+    std::vector<UwbRangingData> rangingData;
+    rangingData.reserve(GetNumberOfRangingData());
+    for (std::size_t i = 0; i < GetNumberOfRangingData(); i++) {
+        rangingData.push_back(GetRangingData(i));
+    }
+
+    return rangingData;
+}
+
+std::span<const uint32_t>
+UwbRangingBatch::GetSequenceNumbers() const noexcept
+{
+    return m_sequenceNumbers;
+}
+
+std::span<const uint32_t>
+UwbRangingBatch::GetSessionIds() const noexcept
+{
+    return m_sessionIds;
+}
+
+std::span<const uint32_t>
+UwbRangingBatch::GetCurrentRangingIntervals() const noexcept
+{
+    return m_currentRangingIntervals;
+}
+
+std::span<const UwbRangingMeasurementType>
+UwbRangingBatch::GetRangingMeasurementTypes() const noexcept
+{
+    return m_rangingMeasurementTypes;
+}
+
+std::span<const std::size_t>
+UwbRangingBatch::GetMeasurementOffsets() const noexcept
+{
+    return m_measurementOffsets;
+}
+
+std::span<const uint8_t>
+UwbRangingBatch::GetSlotIndexes() const noexcept
+{
+    return m_slotIndexes;
+}
+
+std::span<const uint16_t>
+UwbRangingBatch::GetDistances() const noexcept
+{
+    return m_distances;
+}
+
+std::span<const uint8_t>
+UwbRangingBatch::GetStatusCodes() const noexcept
+{
+    return m_statusCodes;
+}
+
+std::span<const UwbLineOfSightIndicator>
+UwbRangingBatch::GetLineOfSightIndicators() const noexcept
+{
+    return m_lineOfSightIndicators;
+}
+
+std::span<const uint32_t>
+UwbRangingBatch::GetPeerIndexes() const noexcept
+{
+    return m_peerIndexes;
+}
+
+std::span<const uwb::UwbMacAddress>
+UwbRangingBatch::GetPeers() const noexcept
+{
+    return m_peers;
+}
+
+std::span<const uint16_t>
+UwbRangingBatch::GetAngles(UwbRangingAngle angle) const noexcept
+{
+    return m_angles[notstd::to_underlying(angle)];
+}
+
+void
+UwbRangingBatch::GetAngles(UwbRangingAngle angle, std::span<float> degrees) const
+{
+    ConvertQ97(GetAngles(angle), degrees);
+}
+
+void
+UwbRangingBatch::GetAngles(UwbRangingAngle angle, std::span<double> degrees) const
+{
+    ConvertQ97(GetAngles(angle), degrees);
+}
+
+std::span<const uint8_t>
+UwbRangingBatch::GetFiguresOfMerit(UwbRangingAngle angle) const noexcept
+{
+    return m_figuresOfMerit[notstd::to_underlying(angle)];
+}
+
+std::span<const uint8_t>
+UwbRangingBatch::GetFigureOfMeritPresence() const noexcept
+{
+    return m_figureOfMeritPresence;
+}
@@ -1,19 +1,55 @@
 
-#include <stdexcept>
+#include <memory>
 
+#include <uwb/protocols/fira/FiraDataObjectSchema.hxx>
 #include <uwb/protocols/fira/UwbSessionData.hxx>
 
 using namespace uwb::protocol::fira;
 
+namespace
+{
+/**
+ * @brief Decodes a UwbSessionData from its data object.
+ *
+ * @tparam TlvT The type of tlv to decode from.
+ * @param tlv The tlv to decode.
+ * @return UwbSessionData
+ */
+template <typename TlvT>
+UwbSessionData
+FromDataObjectImpl(const TlvT& tlv)
+{
+    if (encoding::TlvBer::GetTagValue(tlv.GetTag()) != UwbSessionDataSchema::Tag) {
+        throw UwbSessionData::IncorrectTlvTag();
+    }
+
+    // Parameters not described by the schema are not yet represented in
+    // UwbSessionData, and are ignored.
+    UwbSessionData uwbSessionData{};
+    if (!UwbSessionDataSchema::DecodeValue(tlv, uwbSessionData)) {
+        throw UwbSessionData::IncorrectNumberOfBytesInValueError();
+    }
+
+    return uwbSessionData;
+}
+} // namespace
+
 std::unique_ptr<encoding::TlvBer>
 UwbSessionData::ToDataObject() const
 {
-    throw std::logic_error("not implemented");
+    return std::make_unique<encoding::TlvBer>(UwbSessionDataSchema::ToTlvBer(*this));
+}
+
+/* static */
+UwbSessionData
+UwbSessionData::FromDataObject(const encoding::TlvBer& tlv)
+{
+    return FromDataObjectImpl(tlv);
 }
 
 /* static */
 UwbSessionData
-UwbSessionData::FromDataObject(const encoding::TlvBer& /* tlv */)
+UwbSessionData::FromDataObject(const encoding::TlvBerView& tlv)
 {
-    throw std::logic_error("not implemented");
+    return FromDataObjectImpl(tlv);
 }
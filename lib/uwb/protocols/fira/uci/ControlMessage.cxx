@@ -1,4 +1,116 @@
 
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+
 #include <uwb/protocols/fira/uci/ControlMessage.hxx>
 
 using namespace uwb::protocol::fira::uci;
+
+/* static */
+ControlMessage
+ControlMessage::FromView(const ControlMessageView& view)
+{
+    return ControlMessage{
+        .Type = view.Type,
+        .Group = view.Group,
+        .Opcode = view.Opcode,
+        .Payload = { std::cbegin(view.Payload), std::cend(view.Payload) },
+    };
+}
+
+ControlMessageView
+ControlMessage::View() const noexcept
+{
+    return ControlMessageView{
+        .Type = Type,
+        .Group = Group,
+        .Opcode = Opcode,
+        .Payload = Payload,
+    };
+}
+
+std::vector<uint8_t>
+ControlMessage::Encode(std::size_t payloadLengthMaximum) const
+{
+    if (payloadLengthMaximum == 0 || payloadLengthMaximum > ControlPacketHeader::PayloadLengthMaximum) {
+        throw std::invalid_argument("maximum payload length must be between 1 and 255");
+    }
+
+    // A message with an empty payload is still sent as a single packet.
+    const auto numPackets = std::max<std::size_t>(1, (std::size(Payload) + payloadLengthMaximum - 1) / payloadLengthMaximum);
+    std::vector<uint8_t> packets{};
+    packets.reserve(std::size(Payload) + (numPackets * ControlPacketHeader::Size));
+
+    auto payloadRemaining = std::span<const uint8_t>(Payload);
+    for (std::size_t packet = 0; packet < numPackets; packet++) {
+        const auto payloadLength = std::min(std::size(payloadRemaining), payloadLengthMaximum);
+        const ControlPacketHeader header{
+            .Type = Type,
+            .PacketBoundaryFlag = (packet + 1 < numPackets),
+            .Group = Group,
+            .Opcode = Opcode,
+            .PayloadLength = static_cast<uint8_t>(payloadLength),
+        };
+
+        const auto headerEncoded = header.Encode();
+        packets.insert(std::cend(packets), std::cbegin(headerEncoded), std::cend(headerEncoded));
+        packets.insert(std::cend(packets), std::cbegin(payloadRemaining), std::cbegin(payloadRemaining) + static_cast<std::ptrdiff_t>(payloadLength));
+        payloadRemaining = payloadRemaining.subspan(payloadLength);
+    }
+
+    return packets;
+}
+
+std::optional<ControlMessageView>
+ControlMessageReassembler::Push(const ControlPacket& packet)
+{
+    const auto& header = packet.Header;
+
+    // Segments of a message must be sent one after the other, so a packet
+    // for a different message means the pending one was abandoned.
+    if (m_header.has_value() && (m_header->Type != header.Type || m_header->Group != header.Group || m_header->Opcode != header.Opcode)) {
+        Reset();
+        m_numberOfMessagesDiscarded++;
+    }
+
+    if (!m_header.has_value() && !header.PacketBoundaryFlag) {
+        return ControlMessageView{
+            .Type = header.Type,
+            .Group = header.Group,
+            .Opcode = header.Opcode,
+            .Payload = packet.Payload,
+        };
+    }
+
+    if (!m_header.has_value()) {
+        m_header = header;
+        m_payload.clear();
+    }
+
+    m_payload.insert(std::cend(m_payload), std::cbegin(packet.Payload), std::cend(packet.Payload));
+    if (header.PacketBoundaryFlag) {
+        return std::nullopt;
+    }
+
+    m_header.reset();
+    return ControlMessageView{
+        .Type = header.Type,
+        .Group = header.Group,
+        .Opcode = header.Opcode,
+        .Payload = m_payload,
+    };
+}
+
+void
+ControlMessageReassembler::Reset() noexcept
+{
+    m_header.reset();
+    m_payload.clear();
+}
+
+std::size_t
+ControlMessageReassembler::GetNumberOfMessagesDiscarded() const noexcept
+{
+    return m_numberOfMessagesDiscarded;
+}
@@ -0,0 +1,1256 @@
+
+#include <algorithm>
+#include <array>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <unordered_set>
+#include <utility>
+
+#include <notstd/utility.hxx>
+#include <uwb/protocols/fira/uci/ControlMessageCodec.hxx>
+
+using namespace uwb::protocol::fira;
+using namespace uwb::protocol::fira::uci;
+
+namespace
+{
+/**
+ * @brief Reads little-endian fields from the front of a payload.
+ *
+ * Reading past the end of the payload doesn't fail immediately; instead, the
+ * read yields zero and the reader is marked invalid, so decoders can read all
+ * fields unconditionally and check for validity once at the end.
+ */
+class PayloadReader
+{
+public:
+    explicit PayloadReader(std::span<const uint8_t> data) noexcept :
+        m_data(data)
+    {}
+
+    template <typename T>
+    requires(std::is_unsigned_v<T> && !std::is_same_v<T, bool>)
+    T
+    Read() noexcept
+    {
+        const auto data = ReadBytes(sizeof(T));
+        T value{ 0 };
+        for (std::size_t i = 0; i < std::size(data); i++) {
+            value |= static_cast<T>(static_cast<T>(data[i]) << (8U * i));
+        }
+        return value;
+    }
+
+    std::span<const uint8_t>
+    ReadBytes(std::size_t count) noexcept
+    {
+        if (std::size(m_data) < count) {
+            m_isValid = false;
+            m_data = {};
+            return {};
+        }
+
+        const auto data = m_data.first(count);
+        m_data = m_data.subspan(count);
+        return data;
+    }
+
+    template <std::size_t Length>
+    std::array<uint8_t, Length>
+    ReadArray() noexcept
+    {
+        std::array<uint8_t, Length> value{};
+        const auto data = ReadBytes(Length);
+        std::ranges::copy(data, std::begin(value));
+        return value;
+    }
+
+    bool
+    IsValid() const noexcept
+    {
+        return m_isValid;
+    }
+
+    std::size_t
+    GetRemaining() const noexcept
+    {
+        return std::size(m_data);
+    }
+
+private:
+    std::span<const uint8_t> m_data;
+    bool m_isValid{ true };
+};
+
+/**
+ * @brief Appends little-endian fields to a payload.
+ */
+class PayloadWriter
+{
+public:
+    explicit PayloadWriter(std::vector<uint8_t>& payload) noexcept :
+        m_payload(payload)
+    {}
+
+    template <typename T>
+    requires(std::is_unsigned_v<T> && !std::is_same_v<T, bool>)
+    void
+    Write(T value)
+    {
+        for (std::size_t i = 0; i < sizeof(T); i++) {
+            m_payload.push_back(static_cast<uint8_t>(value >> (8U * i)));
+        }
+    }
+
+    void
+    WriteBytes(std::span<const uint8_t> data)
+    {
+        m_payload.insert(std::cend(m_payload), std::cbegin(data), std::cend(data));
+    }
+
+private:
+    std::vector<uint8_t>& m_payload;
+};
+
+/**
+ * @brief Untyped UwbDeviceInfoVendor implementation that stores the data in a
+ * vector.
+ */
+class UwbDeviceInfoVendorUci :
+    public UwbDeviceInfoVendor
+{
+public:
+    explicit UwbDeviceInfoVendorUci(std::span<const uint8_t> data) :
+        m_data(std::cbegin(data), std::cend(data))
+    {}
+
+    std::span<const uint8_t>
+    GetData() const noexcept override
+    {
+        return m_data;
+    }
+
+private:
+    std::vector<uint8_t> m_data;
+};
+
+constexpr uint8_t SessionTypeRanging = 0x00U;
+constexpr uint8_t SessionTypeDeviceTestMode = 0xD0U;
+
+constexpr uint8_t DeviceStateReady = 0x01U;
+constexpr uint8_t DeviceStateActive = 0x02U;
+constexpr uint8_t DeviceStateError = 0xFFU;
+
+constexpr uint8_t RangingMeasurementTypeTwoWay = 0x01U;
+constexpr uint8_t MacAddressModeIndicatorShort = 0x00U;
+constexpr uint8_t MacAddressModeIndicatorExtended = 0x01U;
+
+constexpr uint8_t LineOfSight = 0x00U;
+constexpr uint8_t NonLineOfSight = 0x01U;
+constexpr uint8_t LineOfSightIndeterminate = 0xFFU;
+
+constexpr std::size_t RangeDataNotificationReserved = 8;
+constexpr std::size_t RangingMeasurementReservedShort = 12;
+constexpr std::size_t RangingMeasurementReservedExtended = 6;
+
+constexpr std::array<ResultReportConfiguration, 4> ResultReportConfigurations{
+    ResultReportConfiguration::TofReport,
+    ResultReportConfiguration::AoAAzimuthReport,
+    ResultReportConfiguration::AoAElevationReport,
+    ResultReportConfiguration::AoAFoMReport,
+};
+
+template <typename OpcodeT>
+ControlMessage
+CreateMessage(MessageType type, GroupId group, OpcodeT opcode, std::vector<uint8_t> payload = {})
+{
+    return ControlMessage::Create(type, group, opcode, std::move(payload));
+}
+
+ControlMessage
+EncodeSessionIdCommand(GroupId group, uint8_t opcode, uint32_t sessionId)
+{
+    std::vector<uint8_t> payload{};
+    PayloadWriter writer{ payload };
+    writer.Write(sessionId);
+    return ControlMessage{ MessageType::Command, notstd::to_underlying(group), opcode, std::move(payload) };
+}
+
+uint8_t
+EncodeSessionState(UwbSessionState sessionState) noexcept
+{
+    switch (sessionState) {
+    case UwbSessionState::Initialized:
+        return 0x00U;
+    case UwbSessionState::Deinitialized:
+        return 0x01U;
+    case UwbSessionState::Active:
+        return 0x02U;
+    case UwbSessionState::Idle:
+        return 0x03U;
+    }
+
+    return 0x01U;
+}
+
+std::optional<UwbSessionState>
+DecodeSessionState(uint8_t value) noexcept
+{
+    switch (value) {
+    case 0x00U:
+        return UwbSessionState::Initialized;
+    case 0x01U:
+        return UwbSessionState::Deinitialized;
+    case 0x02U:
+        return UwbSessionState::Active;
+    case 0x03U:
+        return UwbSessionState::Idle;
+    default:
+        return std::nullopt;
+    }
+}
+
+uint8_t
+EncodeSessionReasonCode(UwbSessionReasonCode reasonCode) noexcept
+{
+    switch (reasonCode) {
+    case UwbSessionReasonCode::StateChangeWithSessionManagementCommands:
+        return 0x00U;
+    case UwbSessionReasonCode::MaxRangignRoundRetryCountReached:
+        return 0x01U;
+    case UwbSessionReasonCode::MaxNumberOfMeasurementsReached:
+        return 0x02U;
+    case UwbSessionReasonCode::ErrorSlotLengthNotSupported:
+        return 0x20U;
+    case UwbSessionReasonCode::ErrorInsufficientSlotsPerRangingRound:
+        return 0x21U;
+    case UwbSessionReasonCode::ErrorMacAddressModeNotSupported:
+        return 0x22U;
+    case UwbSessionReasonCode::ErrorInvalidRangingInterval:
+        return 0x23U;
+    case UwbSessionReasonCode::ErrorInvalidStsConfiguration:
+        return 0x24U;
+    case UwbSessionReasonCode::ErrorInvalidRFrameConfiguration:
+        return 0x25U;
+    }
+
+    return 0x00U;
+}
+
+std::optional<UwbSessionReasonCode>
+DecodeSessionReasonCode(uint8_t value) noexcept
+{
+    switch (value) {
+    case 0x00U:
+        return UwbSessionReasonCode::StateChangeWithSessionManagementCommands;
+    case 0x01U:
+        return UwbSessionReasonCode::MaxRangignRoundRetryCountReached;
+    case 0x02U:
+        return UwbSessionReasonCode::MaxNumberOfMeasurementsReached;
+    case 0x20U:
+        return UwbSessionReasonCode::ErrorSlotLengthNotSupported;
+    case 0x21U:
+        return UwbSessionReasonCode::ErrorInsufficientSlotsPerRangingRound;
+    case 0x22U:
+        return UwbSessionReasonCode::ErrorMacAddressModeNotSupported;
+    case 0x23U:
+        return UwbSessionReasonCode::ErrorInvalidRangingInterval;
+    case 0x24U:
+        return UwbSessionReasonCode::ErrorInvalidStsConfiguration;
+    case 0x25U:
+        return UwbSessionReasonCode::ErrorInvalidRFrameConfiguration;
+    default:
+        return std::nullopt;
+    }
+}
+
+std::optional<UwbStatusMulticast>
+DecodeStatusMulticast(uint8_t value) noexcept
+{
+    switch (value) {
+    case 0x00U:
+        return UwbStatusMulticast::OkUpdate;
+    case 0x01U:
+        return UwbStatusMulticast::ErrorListFull;
+    case 0x02U:
+        return UwbStatusMulticast::ErrorKeyFetchFail;
+    case 0x03U:
+        return UwbStatusMulticast::ErrorSubSessionIdNotFound;
+    default:
+        return std::nullopt;
+    }
+}
+
+uint8_t
+EncodeLineOfSightIndicator(UwbLineOfSightIndicator lineOfSightIndicator) noexcept
+{
+    switch (lineOfSightIndicator) {
+    case UwbLineOfSightIndicator::LineOfSight:
+        return LineOfSight;
+    case UwbLineOfSightIndicator::NonLineOfSight:
+        return NonLineOfSight;
+    case UwbLineOfSightIndicator::Indeterminant:
+        return LineOfSightIndeterminate;
+    }
+
+    return LineOfSightIndeterminate;
+}
+
+std::optional<UwbLineOfSightIndicator>
+DecodeLineOfSightIndicator(uint8_t value) noexcept
+{
+    switch (value) {
+    case LineOfSight:
+        return UwbLineOfSightIndicator::LineOfSight;
+    case NonLineOfSight:
+        return UwbLineOfSightIndicator::NonLineOfSight;
+    case LineOfSightIndeterminate:
+        return UwbLineOfSightIndicator::Indeterminant;
+    default:
+        return std::nullopt;
+    }
+}
+
+/**
+ * @brief Writes a short mac address, which is the only address type allowed
+ * in controller multicast lists.
+ *
+ * @param writer The writer to write the address with.
+ * @param macAddress The address to write.
+ */
+void
+WriteShortMacAddress(PayloadWriter& writer, const ::uwb::UwbMacAddress& macAddress)
+{
+    if (macAddress.GetType() != ::uwb::UwbMacAddressType::Short) {
+        throw std::invalid_argument("multicast list entries require a short mac address");
+    }
+    writer.WriteBytes(macAddress.GetValue());
+}
+
+/**
+ * @brief Encodes the value of an application configuration parameter. Enum
+ * values are encoded in a single octet, irrespective of their underlying
+ * type, as all enumerated parameters are a single octet.
+ *
+ * @param value The value to encode.
+ * @return std::vector<uint8_t>
+ */
+std::vector<uint8_t>
+EncodeApplicationConfigurationParameterValue(const UwbApplicationConfigurationParameterValue& value)
+{
+    std::vector<uint8_t> valueEncoded{};
+    PayloadWriter writer{ valueEncoded };
+
+    std::visit([&](auto&& arg) {
+        using T = std::decay_t<decltype(arg)>;
+        if constexpr (std::is_same_v<T, bool>) {
+            writer.Write(static_cast<uint8_t>(arg ? 1U : 0U));
+        } else if constexpr (std::is_enum_v<T>) {
+            writer.Write(static_cast<uint8_t>(notstd::to_underlying(arg)));
+        } else if constexpr (std::is_unsigned_v<T>) {
+            writer.Write(arg);
+        } else if constexpr (std::is_same_v<T, ::uwb::UwbMacAddress>) {
+            writer.WriteBytes(arg.GetValue());
+        } else if constexpr (std::is_same_v<T, std::array<uint8_t, StaticStsInitializationVectorLength>>) {
+            writer.WriteBytes(arg);
+        } else if constexpr (std::is_same_v<T, std::unordered_set<ResultReportConfiguration>>) {
+            uint8_t bitmap = 0;
+            for (const auto& resultReportConfiguration : arg) {
+                bitmap |= notstd::to_underlying(resultReportConfiguration);
+            }
+            writer.Write(bitmap);
+        } else if constexpr (std::is_same_v<T, std::unordered_set<::uwb::UwbMacAddress>>) {
+            for (const auto& macAddress : arg) {
+                writer.WriteBytes(macAddress.GetValue());
+            }
+        } else {
+            static_assert(!std::is_same_v<T, T>, "unhandled application configuration parameter value type");
+        }
+    },
+        value);
+
+    return valueEncoded;
+}
+
+void
+WriteApplicationConfigurationParameters(PayloadWriter& writer, const std::vector<UwbApplicationConfigurationParameter>& parameters)
+{
+    writer.Write(static_cast<uint8_t>(std::size(parameters)));
+    for (const auto& parameter : parameters) {
+        const auto value = EncodeApplicationConfigurationParameterValue(parameter.Value);
+        writer.Write(notstd::to_underlying(parameter.Type));
+        writer.Write(static_cast<uint8_t>(std::size(value)));
+        writer.WriteBytes(value);
+    }
+}
+
+template <typename T>
+std::optional<UwbApplicationConfigurationParameterValue>
+DecodeApplicationConfigurationParameterValueAs(std::span<const uint8_t> value) noexcept
+{
+    if constexpr (std::is_same_v<T, bool>) {
+        if (std::size(value) != 1) {
+            return std::nullopt;
+        }
+        return value[0] != 0;
+    } else if constexpr (std::is_enum_v<T>) {
+        if (std::size(value) != 1) {
+            return std::nullopt;
+        }
+        return static_cast<T>(value[0]);
+    } else {
+        if (std::size(value) != sizeof(T)) {
+            return std::nullopt;
+        }
+        PayloadReader reader{ value };
+        return reader.Read<T>();
+    }
+}
+
+std::optional<::uwb::UwbMacAddress>
+DecodeMacAddress(std::span<const uint8_t> value) noexcept
+{
+    switch (std::size(value)) {
+    case ::uwb::UwbMacAddress::ShortLength:
+        return ::uwb::UwbMacAddress(PayloadReader{ value }.ReadArray<::uwb::UwbMacAddress::ShortLength>());
+    case ::uwb::UwbMacAddress::ExtendedLength:
+        return ::uwb::UwbMacAddress(PayloadReader{ value }.ReadArray<::uwb::UwbMacAddress::ExtendedLength>());
+    default:
+        return std::nullopt;
+    }
+}
+
+/**
+ * @brief Decodes the value of an application configuration parameter.
+ *
+ * @param type The type of the parameter.
+ * @param value The encoded value.
+ * @param macAddressMode The mac address mode of the session, which
+ * determines the size of the addresses in the destination mac address list.
+ * @return std::optional<UwbApplicationConfigurationParameterValue> The value,
+ * or std::nullopt if the type is unknown or the value is malformed.
+ */
+std::optional<UwbApplicationConfigurationParameterValue>
+DecodeApplicationConfigurationParameterValue(UwbApplicationConfigurationParameterType type, std::span<const uint8_t> value, ::uwb::UwbMacAddressType macAddressMode)
+{
+    using enum UwbApplicationConfigurationParameterType;
+
+    switch (type) {
+    case HoppingMode:
+        return DecodeApplicationConfigurationParameterValueAs<bool>(value);
+    case NumberOfControlees:
+    case PreambleCodeIndex:
+    case SfdId:
+    case SlotsPerRangingRound:
+    case ResponderSlotIndex:
+    case KeyRotationRate:
+    case SessionPriority:
+    case NumberOfStsSegments:
+    case BlockStrideLength:
+    case InBandTerminationAttemptCount:
+        return DecodeApplicationConfigurationParameterValueAs<uint8_t>(value);
+    case SlotDuration:
+    case RangeDataNotificationProximityNear:
+    case RangeDataNotificationProximityFar:
+    case VendorId:
+    case MaxRangingRoundRetry:
+    case MaxNumberOfMeasurements:
+        return DecodeApplicationConfigurationParameterValueAs<uint16_t>(value);
+    case RangingInterval:
+    case StsIndex:
+    case UwbInitiationTime:
+    case SubSessionId:
+        return DecodeApplicationConfigurationParameterValueAs<uint32_t>(value);
+    case AoAResultRequest:
+        return DecodeApplicationConfigurationParameterValueAs<AoAResult>(value);
+    case BprfPhrDataRate:
+        return DecodeApplicationConfigurationParameterValueAs<::uwb::protocol::fira::BprfPhrDataRate>(value);
+    case ChannelNumber:
+        return DecodeApplicationConfigurationParameterValueAs<Channel>(value);
+    case DeviceRole:
+        return DecodeApplicationConfigurationParameterValueAs<::uwb::protocol::fira::DeviceRole>(value);
+    case DeviceType:
+        return DecodeApplicationConfigurationParameterValueAs<::uwb::protocol::fira::DeviceType>(value);
+    case KeyRotation:
+        return DecodeApplicationConfigurationParameterValueAs<::uwb::protocol::fira::KeyRotation>(value);
+    case MultiNodeMode:
+        return DecodeApplicationConfigurationParameterValueAs<::uwb::protocol::fira::MultiNodeMode>(value);
+    case PreambleDuration:
+        return DecodeApplicationConfigurationParameterValueAs<::uwb::protocol::fira::PreambleDuration>(value);
+    case PrfMode:
+        return DecodeApplicationConfigurationParameterValueAs<PrfModeDetailed>(value);
+    case PsduDataRate:
+        return DecodeApplicationConfigurationParameterValueAs<::uwb::protocol::fira::PsduDataRate>(value);
+    case RangeDataNotificationConfig:
+        return DecodeApplicationConfigurationParameterValueAs<RangeDataNotificationConfiguration>(value);
+    case RangingRoundUsage:
+        return DecodeApplicationConfigurationParameterValueAs<::uwb::protocol::fira::RangingRoundUsage>(value);
+    case RangingTimeStruct:
+        return DecodeApplicationConfigurationParameterValueAs<RangingMode>(value);
+    case RangingRoundControl:
+        return DecodeApplicationConfigurationParameterValueAs<::uwb::protocol::fira::RangingRoundControl>(value);
+    case ScheduledMode:
+        return DecodeApplicationConfigurationParameterValueAs<SchedulingMode>(value);
+    case StsConfiguration:
+        return DecodeApplicationConfigurationParameterValueAs<::uwb::protocol::fira::StsConfiguration>(value);
+    case StsLength:
+        return DecodeApplicationConfigurationParameterValueAs<::uwb::protocol::fira::StsLength>(value);
+    case RFrameConfiguration:
+        return DecodeApplicationConfigurationParameterValueAs<::uwb::protocol::fira::RFrameConfiguration>(value);
+    case TxAdaptivePayloadPower:
+        return DecodeApplicationConfigurationParameterValueAs<::uwb::protocol::fira::TxAdaptivePayloadPower>(value);
+    case MacFcsType:
+        return DecodeApplicationConfigurationParameterValueAs<::uwb::UwbMacAddressFcsType>(value);
+    case MacAddressMode:
+        return DecodeApplicationConfigurationParameterValueAs<::uwb::UwbMacAddressType>(value);
+    case ResultReportConfig: {
+        if (std::size(value) != 1) {
+            return std::nullopt;
+        }
+        std::unordered_set<ResultReportConfiguration> resultReportConfigurations{};
+        for (const auto resultReportConfiguration : ResultReportConfigurations) {
+            if ((value[0] & notstd::to_underlying(resultReportConfiguration)) != 0) {
+                resultReportConfigurations.insert(resultReportConfiguration);
+            }
+        }
+        return resultReportConfigurations;
+    }
+    case DeviceMacAddress: {
+        auto macAddress = DecodeMacAddress(value);
+        if (!macAddress.has_value()) {
+            return std::nullopt;
+        }
+        return std::move(*macAddress);
+    }
+    case StaticStsIv: {
+        if (std::size(value) != StaticStsInitializationVectorLength) {
+            return std::nullopt;
+        }
+        return PayloadReader{ value }.ReadArray<StaticStsInitializationVectorLength>();
+    }
+    case DestinationMacAddresses: {
+        const auto macAddressLength = (macAddressMode == ::uwb::UwbMacAddressType::Short) ? ::uwb::UwbMacAddress::ShortLength : ::uwb::UwbMacAddress::ExtendedLength;
+        if (std::size(value) % macAddressLength != 0) {
+            return std::nullopt;
+        }
+        std::unordered_set<::uwb::UwbMacAddress> macAddresses{};
+        for (std::size_t offset = 0; offset < std::size(value); offset += macAddressLength) {
+            macAddresses.insert(*DecodeMacAddress(value.subspan(offset, macAddressLength)));
+        }
+        return macAddresses;
+    }
+    }
+
+    return std::nullopt;
+}
+
+/**
+ * @brief Reads a list of application configuration parameter TLVs.
+ *
+ * The size of the addresses in the destination mac address list depends on
+ * the mac address mode, which may follow it in the list, so it is decoded
+ * after all other parameters. If the list doesn't include the mac address
+ * mode, short addresses are assumed, which is the default mode. Parameters
+ * with unknown types are skipped.
+ *
+ * @param reader The reader positioned at the number of parameters.
+ * @return std::optional<std::vector<UwbApplicationConfigurationParameter>>
+ */
+std::optional<std::vector<UwbApplicationConfigurationParameter>>
+ReadApplicationConfigurationParameters(PayloadReader& reader)
+{
+    const auto numParameters = reader.Read<uint8_t>();
+
+    std::vector<UwbApplicationConfigurationParameter> parameters{};
+    parameters.reserve(numParameters);
+    auto macAddressMode = ::uwb::UwbMacAddressType::Short;
+    std::optional<std::span<const uint8_t>> destinationMacAddresses{};
+
+    for (std::size_t i = 0; i < numParameters; i++) {
+        const auto type = static_cast<UwbApplicationConfigurationParameterType>(reader.Read<uint8_t>());
+        const auto length = reader.Read<uint8_t>();
+        const auto value = reader.ReadBytes(length);
+        if (!reader.IsValid()) {
+            return std::nullopt;
+        }
+
+        if (type == UwbApplicationConfigurationParameterType::DestinationMacAddresses) {
+            destinationMacAddresses = value;
+            continue;
+        }
+
+        auto valueDecoded = DecodeApplicationConfigurationParameterValue(type, value, macAddressMode);
+        if (!valueDecoded.has_value()) {
+            continue;
+        }
+        if (type == UwbApplicationConfigurationParameterType::MacAddressMode) {
+            macAddressMode = std::get<::uwb::UwbMacAddressType>(*valueDecoded);
+        }
+        parameters.push_back({ .Type = type, .Value = std::move(*valueDecoded) });
+    }
+
+    if (destinationMacAddresses.has_value()) {
+        auto valueDecoded = DecodeApplicationConfigurationParameterValue(UwbApplicationConfigurationParameterType::DestinationMacAddresses, *destinationMacAddresses, macAddressMode);
+        if (!valueDecoded.has_value()) {
+            return std::nullopt;
+        }
+        parameters.push_back({ .Type = UwbApplicationConfigurationParameterType::DestinationMacAddresses, .Value = std::move(*valueDecoded) });
+    }
+
+    return parameters;
+}
+
+void
+WriteVersion(PayloadWriter& writer, const ::uwb::UwbVersion& version)
+{
+    writer.Write(version.Major);
+    writer.Write(static_cast<uint8_t>((version.Minor << 4U) | (version.Maintenance & 0x0FU)));
+}
+
+::uwb::UwbVersion
+ReadVersion(PayloadReader& reader) noexcept
+{
+    const auto major = reader.Read<uint8_t>();
+    const auto minorAndMaintenance = reader.Read<uint8_t>();
+    return ::uwb::UwbVersion::FromUci(major, minorAndMaintenance);
+}
+
+void
+WriteRangingMeasurementData(PayloadWriter& writer, const UwbRangingMeasurementData& measurementData)
+{
+    writer.Write(measurementData.Result);
+    writer.Write(measurementData.FigureOfMerit.value_or(0));
+}
+
+/**
+ * @brief Reads an angle of arrival measurement and its figure of merit. A
+ * figure of merit of zero indicates it isn't available.
+ */
+void
+ReadRangingMeasurementData(PayloadReader& reader, UwbRangingMeasurementData& measurementData) noexcept
+{
+    measurementData.Result = reader.Read<uint16_t>();
+    const auto figureOfMerit = reader.Read<uint8_t>();
+    measurementData.FigureOfMerit = (figureOfMerit != 0) ? std::optional<uint8_t>(figureOfMerit) : std::nullopt;
+}
+
+std::optional<UwbStatus>
+ReadStatus(PayloadReader& reader) noexcept
+{
+    const auto status = reader.Read<uint8_t>();
+    if (!reader.IsValid()) {
+        return std::nullopt;
+    }
+    return DecodeUwbStatus(status);
+}
+
+std::optional<CountResponse>
+DecodeCountResponse(std::span<const uint8_t> payload, bool isCountWide) noexcept
+{
+    PayloadReader reader{ payload };
+    const auto status = ReadStatus(reader);
+    const uint32_t count = isCountWide ? reader.Read<uint32_t>() : reader.Read<uint8_t>();
+    if (!status.has_value() || !reader.IsValid()) {
+        return std::nullopt;
+    }
+
+    return CountResponse{ .Status = *status, .Count = count };
+}
+} // namespace
+
+ControlMessage
+uwb::protocol::fira::uci::EncodeDeviceResetCommand()
+{
+    // The only defined reset configuration is a UWBS reset, 0x00.
+    return CreateMessage(MessageType::Command, GroupId::Core, CoreOpcodeId::DeviceReset, { 0x00U });
+}
+
+ControlMessage
+uwb::protocol::fira::uci::EncodeGetDeviceInfoCommand()
+{
+    return CreateMessage(MessageType::Command, GroupId::Core, CoreOpcodeId::GetDeviceInfo);
+}
+
+ControlMessage
+uwb::protocol::fira::uci::EncodeSessionInitCommand(const SessionInitCommand& command)
+{
+    std::vector<uint8_t> payload{};
+    PayloadWriter writer{ payload };
+    writer.Write(command.SessionId);
+    writer.Write((command.SessionType == UwbSessionType::TestMode) ? SessionTypeDeviceTestMode : SessionTypeRanging);
+    return CreateMessage(MessageType::Command, GroupId::Session, SessionOpcodeId::Init, std::move(payload));
+}
+
+ControlMessage
+uwb::protocol::fira::uci::EncodeSessionDeinitCommand(uint32_t sessionId)
+{
+    return EncodeSessionIdCommand(GroupId::Session, notstd::to_underlying(SessionOpcodeId::Deinit), sessionId);
+}
+
+ControlMessage
+uwb::protocol::fira::uci::EncodeSessionSetAppConfigCommand(const SessionSetAppConfigCommand& command)
+{
+    std::vector<uint8_t> payload{};
+    PayloadWriter writer{ payload };
+    writer.Write(command.SessionId);
+    WriteApplicationConfigurationParameters(writer, command.Parameters);
+    return CreateMessage(MessageType::Command, GroupId::Session, SessionOpcodeId::SetAppConfig, std::move(payload));
+}
+
+ControlMessage
+uwb::protocol::fira::uci::EncodeSessionGetAppConfigCommand(const SessionGetAppConfigCommand& command)
+{
+    std::vector<uint8_t> payload{};
+    PayloadWriter writer{ payload };
+    writer.Write(command.SessionId);
+    writer.Write(static_cast<uint8_t>(std::size(command.ParameterTypes)));
+    for (const auto parameterType : command.ParameterTypes) {
+        writer.Write(notstd::to_underlying(parameterType));
+    }
+    return CreateMessage(MessageType::Command, GroupId::Session, SessionOpcodeId::GetAppConfig, std::move(payload));
+}
+
+ControlMessage
+uwb::protocol::fira::uci::EncodeSessionGetCountCommand()
+{
+    return CreateMessage(MessageType::Command, GroupId::Session, SessionOpcodeId::GetCount);
+}
+
+ControlMessage
+uwb::protocol::fira::uci::EncodeSessionGetStateCommand(uint32_t sessionId)
+{
+    return EncodeSessionIdCommand(GroupId::Session, notstd::to_underlying(SessionOpcodeId::GetState), sessionId);
+}
+
+ControlMessage
+uwb::protocol::fira::uci::EncodeSessionUpdateControllerMulticastListCommand(const UwbSessionUpdateMulicastList& command)
+{
+    std::vector<uint8_t> payload{};
+    PayloadWriter writer{ payload };
+    writer.Write(command.SessionId);
+    writer.Write(static_cast<uint8_t>((command.Action == UwbMulticastAction::AddShortAddress) ? 0x00U : 0x01U));
+    writer.Write(static_cast<uint8_t>(std::size(command.Controlees)));
+    for (const auto& controlee : command.Controlees) {
+        WriteShortMacAddress(writer, controlee.ControleeMacAddress);
+        writer.Write(controlee.SubSessionId);
+    }
+    return CreateMessage(MessageType::Command, GroupId::Session, SessionOpcodeId::UpdateControllerMulticastList, std::move(payload));
+}
+
+ControlMessage
+uwb::protocol::fira::uci::EncodeRangeStartCommand(uint32_t sessionId)
+{
+    return EncodeSessionIdCommand(GroupId::Ranging, notstd::to_underlying(RangingOpcodeId::Start), sessionId);
+}
+
+ControlMessage
+uwb::protocol::fira::uci::EncodeRangeStopCommand(uint32_t sessionId)
+{
+    return EncodeSessionIdCommand(GroupId::Ranging, notstd::to_underlying(RangingOpcodeId::Stop), sessionId);
+}
+
+ControlMessage
+uwb::protocol::fira::uci::EncodeRangeGetRangingCountCommand(uint32_t sessionId)
+{
+    return EncodeSessionIdCommand(GroupId::Ranging, notstd::to_underlying(RangingOpcodeId::GetRangingCount), sessionId);
+}
+
+std::optional<uint32_t>
+uwb::protocol::fira::uci::DecodeSessionIdCommand(std::span<const uint8_t> payload) noexcept
+{
+    PayloadReader reader{ payload };
+    const auto sessionId = reader.Read<uint32_t>();
+    if (!reader.IsValid()) {
+        return std::nullopt;
+    }
+
+    return sessionId;
+}
+
+std::optional<SessionInitCommand>
+uwb::protocol::fira::uci::DecodeSessionInitCommand(std::span<const uint8_t> payload) noexcept
+{
+    PayloadReader reader{ payload };
+    const auto sessionId = reader.Read<uint32_t>();
+    const auto sessionType = reader.Read<uint8_t>();
+    if (!reader.IsValid() || (sessionType != SessionTypeRanging && sessionType != SessionTypeDeviceTestMode)) {
+        return std::nullopt;
+    }
+
+    return SessionInitCommand{
+        .SessionId = sessionId,
+        .SessionType = (sessionType == SessionTypeDeviceTestMode) ? UwbSessionType::TestMode : UwbSessionType::RangingSession,
+    };
+}
+
+std::optional<SessionSetAppConfigCommand>
+uwb::protocol::fira::uci::DecodeSessionSetAppConfigCommand(std::span<const uint8_t> payload)
+{
+    PayloadReader reader{ payload };
+    const auto sessionId = reader.Read<uint32_t>();
+    auto parameters = ReadApplicationConfigurationParameters(reader);
+    if (!parameters.has_value() || !reader.IsValid()) {
+        return std::nullopt;
+    }
+
+    return SessionSetAppConfigCommand{ .SessionId = sessionId, .Parameters = std::move(*parameters) };
+}
+
+std::optional<SessionGetAppConfigCommand>
+uwb::protocol::fira::uci::DecodeSessionGetAppConfigCommand(std::span<const uint8_t> payload)
+{
+    PayloadReader reader{ payload };
+    const auto sessionId = reader.Read<uint32_t>();
+    const auto numParameters = reader.Read<uint8_t>();
+    const auto parameterTypes = reader.ReadBytes(numParameters);
+    if (!reader.IsValid()) {
+        return std::nullopt;
+    }
+
+    SessionGetAppConfigCommand command{ .SessionId = sessionId, .ParameterTypes = {} };
+    command.ParameterTypes.reserve(numParameters);
+    for (const auto parameterType : parameterTypes) {
+        command.ParameterTypes.push_back(static_cast<UwbApplicationConfigurationParameterType>(parameterType));
+    }
+
+    return command;
+}
+
+std::optional<UwbSessionUpdateMulicastList>
+uwb::protocol::fira::uci::DecodeSessionUpdateControllerMulticastListCommand(std::span<const uint8_t> payload)
+{
+    PayloadReader reader{ payload };
+    const auto sessionId = reader.Read<uint32_t>();
+    const auto action = reader.Read<uint8_t>();
+    const auto numControlees = reader.Read<uint8_t>();
+    if (!reader.IsValid() || action > 0x01U) {
+        return std::nullopt;
+    }
+
+    UwbSessionUpdateMulicastList command{
+        .SessionId = sessionId,
+        .Action = (action == 0x00U) ? UwbMulticastAction::AddShortAddress : UwbMulticastAction::DeleteShortAddress,
+        .Controlees = {},
+    };
+    command.Controlees.reserve(numControlees);
+    for (std::size_t i = 0; i < numControlees; i++) {
+        const auto macAddress = reader.ReadArray<::uwb::UwbMacAddress::ShortLength>();
+        const auto subSessionId = reader.Read<uint32_t>();
+        command.Controlees.push_back({ .ControleeMacAddress = ::uwb::UwbMacAddress(macAddress), .SubSessionId = subSessionId });
+    }
+    if (!reader.IsValid()) {
+        return std::nullopt;
+    }
+
+    return command;
+}
+
+ControlMessage
+uwb::protocol::fira::uci::EncodeStatusResponse(const ControlMessageView& command, const UwbStatus& status)
+{
+    return ControlMessage{ MessageType::Response, command.Group, command.Opcode, { EncodeUwbStatus(status) } };
+}
+
+ControlMessage
+uwb::protocol::fira::uci::EncodeGetDeviceInfoResponse(const UwbDeviceInformation& deviceInformation)
+{
+    std::vector<uint8_t> payload{};
+    PayloadWriter writer{ payload };
+    writer.Write(EncodeUwbStatus(deviceInformation.Status));
+    WriteVersion(writer, deviceInformation.VersionUci);
+    WriteVersion(writer, deviceInformation.VersionMac);
+    WriteVersion(writer, deviceInformation.VersionPhy);
+    WriteVersion(writer, deviceInformation.VersionUciTest);
+
+    const auto vendorSpecificInfo = (deviceInformation.VendorSpecificInfo != nullptr) ? deviceInformation.VendorSpecificInfo->GetData() : std::span<const uint8_t>{};
+    writer.Write(static_cast<uint8_t>(std::size(vendorSpecificInfo)));
+    writer.WriteBytes(vendorSpecificInfo);
+    return CreateMessage(MessageType::Response, GroupId::Core, CoreOpcodeId::GetDeviceInfo, std::move(payload));
+}
+
+ControlMessage
+uwb::protocol::fira::uci::EncodeSessionSetAppConfigResponse(const SessionSetAppConfigResponse& response)
+{
+    std::vector<uint8_t> payload{};
+    PayloadWriter writer{ payload };
+    writer.Write(EncodeUwbStatus(response.Status));
+    writer.Write(static_cast<uint8_t>(std::size(response.ParameterStatuses)));
+    for (const auto& parameterStatus : response.ParameterStatuses) {
+        writer.Write(notstd::to_underlying(parameterStatus.ParameterType));
+        writer.Write(EncodeUwbStatus(parameterStatus.Status));
+    }
+    return CreateMessage(MessageType::Response, GroupId::Session, SessionOpcodeId::SetAppConfig, std::move(payload));
+}
+
+ControlMessage
+uwb::protocol::fira::uci::EncodeSessionGetAppConfigResponse(const SessionGetAppConfigResponse& response)
+{
+    std::vector<uint8_t> payload{};
+    PayloadWriter writer{ payload };
+    writer.Write(EncodeUwbStatus(response.Status));
+    WriteApplicationConfigurationParameters(writer, response.Parameters);
+    return CreateMessage(MessageType::Response, GroupId::Session, SessionOpcodeId::GetAppConfig, std::move(payload));
+}
+
+ControlMessage
+uwb::protocol::fira::uci::EncodeSessionGetCountResponse(const CountResponse& response)
+{
+    return CreateMessage(MessageType::Response, GroupId::Session, SessionOpcodeId::GetCount, { EncodeUwbStatus(response.Status), static_cast<uint8_t>(response.Count) });
+}
+
+ControlMessage
+uwb::protocol::fira::uci::EncodeSessionGetStateResponse(const SessionGetStateResponse& response)
+{
+    return CreateMessage(MessageType::Response, GroupId::Session, SessionOpcodeId::GetState, { EncodeUwbStatus(response.Status), EncodeSessionState(response.State) });
+}
+
+ControlMessage
+uwb::protocol::fira::uci::EncodeRangeGetRangingCountResponse(const CountResponse& response)
+{
+    std::vector<uint8_t> payload{};
+    PayloadWriter writer{ payload };
+    writer.Write(EncodeUwbStatus(response.Status));
+    writer.Write(response.Count);
+    return CreateMessage(MessageType::Response, GroupId::Ranging, RangingOpcodeId::GetRangingCount, std::move(payload));
+}
+
+std::optional<UwbStatus>
+uwb::protocol::fira::uci::DecodeStatusResponse(std::span<const uint8_t> payload) noexcept
+{
+    PayloadReader reader{ payload };
+    return ReadStatus(reader);
+}
+
+std::optional<UwbDeviceInformation>
+uwb::protocol::fira::uci::DecodeGetDeviceInfoResponse(std::span<const uint8_t> payload)
+{
+    PayloadReader reader{ payload };
+    const auto status = ReadStatus(reader);
+
+    UwbDeviceInformation deviceInformation{};
+    deviceInformation.VersionUci = ReadVersion(reader);
+    deviceInformation.VersionMac = ReadVersion(reader);
+    deviceInformation.VersionPhy = ReadVersion(reader);
+    deviceInformation.VersionUciTest = ReadVersion(reader);
+    const auto vendorSpecificInfoLength = reader.Read<uint8_t>();
+    const auto vendorSpecificInfo = reader.ReadBytes(vendorSpecificInfoLength);
+    if (!status.has_value() || !reader.IsValid()) {
+        return std::nullopt;
+    }
+
+    deviceInformation.Status = *status;
+    if (!std::empty(vendorSpecificInfo)) {
+        deviceInformation.VendorSpecificInfo = std::make_shared<UwbDeviceInfoVendorUci>(vendorSpecificInfo);
+    }
+
+    return deviceInformation;
+}
+
+std::optional<SessionSetAppConfigResponse>
+uwb::protocol::fira::uci::DecodeSessionSetAppConfigResponse(std::span<const uint8_t> payload)
+{
+    PayloadReader reader{ payload };
+    const auto status = ReadStatus(reader);
+    const auto numParameters = reader.Read<uint8_t>();
+    if (!status.has_value() || !reader.IsValid()) {
+        return std::nullopt;
+    }
+
+    SessionSetAppConfigResponse response{ .Status = *status, .ParameterStatuses = {} };
+    response.ParameterStatuses.reserve(numParameters);
+    for (std::size_t i = 0; i < numParameters; i++) {
+        const auto parameterType = static_cast<UwbApplicationConfigurationParameterType>(reader.Read<uint8_t>());
+        const auto parameterStatus = ReadStatus(reader);
+        if (!parameterStatus.has_value()) {
+            return std::nullopt;
+        }
+        response.ParameterStatuses.push_back({ .Status = *parameterStatus, .ParameterType = parameterType });
+    }
+
+    return response;
+}
+
+std::optional<SessionGetAppConfigResponse>
+uwb::protocol::fira::uci::DecodeSessionGetAppConfigResponse(std::span<const uint8_t> payload)
+{
+    PayloadReader reader{ payload };
+    const auto status = ReadStatus(reader);
+    if (!status.has_value()) {
+        return std::nullopt;
+    }
+
+    auto parameters = ReadApplicationConfigurationParameters(reader);
+    if (!parameters.has_value() || !reader.IsValid()) {
+        return std::nullopt;
+    }
+
+    return SessionGetAppConfigResponse{ .Status = *status, .Parameters = std::move(*parameters) };
+}
+
+std::optional<CountResponse>
+uwb::protocol::fira::uci::DecodeSessionGetCountResponse(std::span<const uint8_t> payload) noexcept
+{
+    return DecodeCountResponse(payload, /* isCountWide */ false);
+}
+
+std::optional<SessionGetStateResponse>
+uwb::protocol::fira::uci::DecodeSessionGetStateResponse(std::span<const uint8_t> payload) noexcept
+{
+    PayloadReader reader{ payload };
+    const auto status = ReadStatus(reader);
+    const auto state = DecodeSessionState(reader.Read<uint8_t>());
+    if (!status.has_value() || !state.has_value() || !reader.IsValid()) {
+        return std::nullopt;
+    }
+
+    return SessionGetStateResponse{ .Status = *status, .State = *state };
+}
+
+std::optional<CountResponse>
+uwb::protocol::fira::uci::DecodeRangeGetRangingCountResponse(std::span<const uint8_t> payload) noexcept
+{
+    return DecodeCountResponse(payload, /* isCountWide */ true);
+}
+
+ControlMessage
+uwb::protocol::fira::uci::EncodeDeviceStatusNotification(const UwbStatusDevice& statusDevice)
+{
+    uint8_t state = DeviceStateError;
+    switch (statusDevice.State) {
+    case UwbDeviceState::Ready:
+        state = DeviceStateReady;
+        break;
+    case UwbDeviceState::Active:
+        state = DeviceStateActive;
+        break;
+    default:
+        break;
+    }
+
+    return CreateMessage(MessageType::Notification, GroupId::Core, CoreOpcodeId::DeviceStatus, { state });
+}
+
+ControlMessage
+uwb::protocol::fira::uci::EncodeGenericErrorNotification(const UwbStatus& status)
+{
+    return CreateMessage(MessageType::Notification, GroupId::Core, CoreOpcodeId::GenericError, { EncodeUwbStatus(status) });
+}
+
+ControlMessage
+uwb::protocol::fira::uci::EncodeSessionStatusNotification(const UwbSessionStatus& sessionStatus)
+{
+    std::vector<uint8_t> payload{};
+    PayloadWriter writer{ payload };
+    writer.Write(sessionStatus.SessionId);
+    writer.Write(EncodeSessionState(sessionStatus.State));
+    writer.Write(EncodeSessionReasonCode(sessionStatus.ReasonCode.value_or(UwbSessionReasonCode::StateChangeWithSessionManagementCommands)));
+    return CreateMessage(MessageType::Notification, GroupId::Session, SessionOpcodeId::Status, std::move(payload));
+}
+
+ControlMessage
+uwb::protocol::fira::uci::EncodeSessionUpdateControllerMulticastListNotification(const UwbSessionUpdateMulticastListStatus& multicastListStatus)
+{
+    std::vector<uint8_t> payload{};
+    PayloadWriter writer{ payload };
+    writer.Write(multicastListStatus.SessionId);
+    // The remaining multicast list size isn't tracked by the status type.
+    writer.Write(uint8_t{ 0 });
+    writer.Write(static_cast<uint8_t>(std::size(multicastListStatus.Status)));
+    for (const auto& status : multicastListStatus.Status) {
+        WriteShortMacAddress(writer, status.ControleeMacAddress);
+        writer.Write(status.SubSessionId);
+        writer.Write(static_cast<uint8_t>(notstd::to_underlying(status.Status)));
+    }
+    return CreateMessage(MessageType::Notification, GroupId::Session, SessionOpcodeId::UpdateControllerMulticastList, std::move(payload));
+}
+
+ControlMessage
+uwb::protocol::fira::uci::EncodeRangeDataNotification(const UwbRangingData& rangingData)
+{
+    const auto& measurements = rangingData.RangingMeasurements;
+    const auto macAddressType = std::empty(measurements) ? ::uwb::UwbMacAddressType::Short : measurements.front().PeerMacAddress.GetType();
+
+    std::vector<uint8_t> payload{};
+    payload.reserve(RangeDataNotificationHeaderLength + (std::size(measurements) * RangingMeasurementLength));
+    PayloadWriter writer{ payload };
+    writer.Write(rangingData.SequenceNumber);
+    writer.Write(rangingData.SessionId);
+    writer.Write(uint8_t{ 0 }); // RCR indicator
+    writer.Write(rangingData.CurrentRangingInterval);
+    writer.Write(RangingMeasurementTypeTwoWay);
+    writer.Write(uint8_t{ 0 }); // RFU
+    writer.Write((macAddressType == ::uwb::UwbMacAddressType::Short) ? MacAddressModeIndicatorShort : MacAddressModeIndicatorExtended);
+    payload.resize(std::size(payload) + RangeDataNotificationReserved);
+    writer.Write(static_cast<uint8_t>(std::size(measurements)));
+
+    for (const auto& measurement : measurements) {
+        if (measurement.PeerMacAddress.GetType() != macAddressType) {
+            throw std::invalid_argument("all ranging measurements must use the same mac address type");
+        }
+        writer.WriteBytes(measurement.PeerMacAddress.GetValue());
+        writer.Write(EncodeUwbStatus(measurement.Status));
+        writer.Write(EncodeLineOfSightIndicator(measurement.LineOfSightIndicator));
+        writer.Write(measurement.Distance);
+        WriteRangingMeasurementData(writer, measurement.AoAAzimuth);
+        WriteRangingMeasurementData(writer, measurement.AoAElevation);
+        WriteRangingMeasurementData(writer, measurement.AoaDestinationAzimuth);
+        WriteRangingMeasurementData(writer, measurement.AoaDestinationElevation);
+        writer.Write(measurement.SlotIndex);
+        payload.resize(std::size(payload) + ((macAddressType == ::uwb::UwbMacAddressType::Short) ? RangingMeasurementReservedShort : RangingMeasurementReservedExtended));
+    }
+
+    return CreateMessage(MessageType::Notification, GroupId::Ranging, RangingOpcodeId::RangeData, std::move(payload));
+}
+
+std::optional<UwbStatusDevice>
+uwb::protocol::fira::uci::DecodeDeviceStatusNotification(std::span<const uint8_t> payload) noexcept
+{
+    PayloadReader reader{ payload };
+    const auto state = reader.Read<uint8_t>();
+    if (!reader.IsValid()) {
+        return std::nullopt;
+    }
+
+    switch (state) {
+    case DeviceStateReady:
+        return UwbStatusDevice{ .State = UwbDeviceState::Ready };
+    case DeviceStateActive:
+        return UwbStatusDevice{ .State = UwbDeviceState::Active };
+    case DeviceStateError:
+        return UwbStatusDevice{ .State = UwbDeviceState::Error };
+    default:
+        return std::nullopt;
+    }
+}
+
+std::optional<UwbStatus>
+uwb::protocol::fira::uci::DecodeGenericErrorNotification(std::span<const uint8_t> payload) noexcept
+{
+    return DecodeStatusResponse(payload);
+}
+
+std::optional<UwbSessionStatus>
+uwb::protocol::fira::uci::DecodeSessionStatusNotification(std::span<const uint8_t> payload) noexcept
+{
+    PayloadReader reader{ payload };
+    const auto sessionId = reader.Read<uint32_t>();
+    const auto state = DecodeSessionState(reader.Read<uint8_t>());
+    const auto reasonCode = DecodeSessionReasonCode(reader.Read<uint8_t>());
+    if (!state.has_value() || !reader.IsValid()) {
+        return std::nullopt;
+    }
+
+    return UwbSessionStatus{ .SessionId = sessionId, .State = *state, .ReasonCode = reasonCode };
+}
+
+std::optional<UwbSessionUpdateMulticastListStatus>
+uwb::protocol::fira::uci::DecodeSessionUpdateControllerMulticastListNotification(std::span<const uint8_t> payload)
+{
+    PayloadReader reader{ payload };
+    const auto sessionId = reader.Read<uint32_t>();
+    reader.Read<uint8_t>(); // remaining multicast list size
+    const auto numControlees = reader.Read<uint8_t>();
+    if (!reader.IsValid()) {
+        return std::nullopt;
+    }
+
+    UwbSessionUpdateMulticastListStatus multicastListStatus{ .SessionId = sessionId, .Status = {} };
+    multicastListStatus.Status.reserve(numControlees);
+    for (std::size_t i = 0; i < numControlees; i++) {
+        const auto macAddress = reader.ReadArray<::uwb::UwbMacAddress::ShortLength>();
+        const auto subSessionId = reader.Read<uint32_t>();
+        const auto status = DecodeStatusMulticast(reader.Read<uint8_t>());
+        if (!status.has_value() || !reader.IsValid()) {
+            return std::nullopt;
+        }
+        multicastListStatus.Status.push_back({ .ControleeMacAddress = ::uwb::UwbMacAddress(macAddress), .SubSessionId = subSessionId, .Status = *status });
+    }
+
+    return multicastListStatus;
+}
+
+bool
+uwb::protocol::fira::uci::DecodeRangeDataNotification(std::span<const uint8_t> payload, UwbRangingData& rangingData)
+{
+    PayloadReader reader{ payload };
+    rangingData.SequenceNumber = reader.Read<uint32_t>();
+    rangingData.SessionId = reader.Read<uint32_t>();
+    reader.Read<uint8_t>(); // RCR indicator
+    rangingData.CurrentRangingInterval = reader.Read<uint32_t>();
+    const auto rangingMeasurementType = reader.Read<uint8_t>();
+    reader.Read<uint8_t>(); // RFU
+    const auto macAddressModeIndicator = reader.Read<uint8_t>();
+    reader.ReadBytes(RangeDataNotificationReserved);
+    const auto numMeasurements = reader.Read<uint8_t>();
+
+    // Validate the length of the whole notification up-front, so the
+    // measurements can be decoded without further checks.
+    if (!reader.IsValid() || rangingMeasurementType != RangingMeasurementTypeTwoWay || macAddressModeIndicator > MacAddressModeIndicatorExtended || reader.GetRemaining() < (numMeasurements * RangingMeasurementLength)) {
+        return false;
+    }
+
+    const bool isMacAddressShort = (macAddressModeIndicator == MacAddressModeIndicatorShort);
+    rangingData.RangingMeasurementType = UwbRangingMeasurementType::TwoWay;
+    rangingData.RangingMeasurements.resize(numMeasurements);
+
+    for (auto& measurement : rangingData.RangingMeasurements) {
+        if (isMacAddressShort) {
+            measurement.PeerMacAddress = ::uwb::UwbMacAddress(reader.ReadArray<::uwb::UwbMacAddress::ShortLength>());
+        } else {
+            measurement.PeerMacAddress = ::uwb::UwbMacAddress(reader.ReadArray<::uwb::UwbMacAddress::ExtendedLength>());
+        }
+
+        const auto status = DecodeUwbStatus(reader.Read<uint8_t>());
+        const auto lineOfSightIndicator = DecodeLineOfSightIndicator(reader.Read<uint8_t>());
+        if (!status.has_value() || !lineOfSightIndicator.has_value()) {
+            return false;
+        }
+
+        measurement.Status = *status;
+        measurement.LineOfSightIndicator = *lineOfSightIndicator;
+        measurement.Distance = reader.Read<uint16_t>();
+        ReadRangingMeasurementData(reader, measurement.AoAAzimuth);
+        ReadRangingMeasurementData(reader, measurement.AoAElevation);
+        ReadRangingMeasurementData(reader, measurement.AoaDestinationAzimuth);
+        ReadRangingMeasurementData(reader, measurement.AoaDestinationElevation);
+        measurement.SlotIndex = reader.Read<uint8_t>();
+        reader.ReadBytes(isMacAddressShort ? RangingMeasurementReservedShort : RangingMeasurementReservedExtended);
+    }
+
+    return reader.IsValid();
+}
+
+std::optional<UwbRangingData>
+uwb::protocol::fira::uci::DecodeRangeDataNotification(std::span<const uint8_t> payload)
+{
+    UwbRangingData rangingData{};
+    if (!DecodeRangeDataNotification(payload, rangingData)) {
+        return std::nullopt;
+    }
+
+    return rangingData;
+}
+
+std::optional<UwbNotificationData>
+uwb::protocol::fira::uci::DecodeNotification(const ControlMessageView& notification)
+{
+    if (notification.Is(MessageType::Notification, GroupId::Core, CoreOpcodeId::DeviceStatus)) {
+        return DecodeDeviceStatusNotification(notification.Payload);
+    }
+    if (notification.Is(MessageType::Notification, GroupId::Core, CoreOpcodeId::GenericError)) {
+        return DecodeGenericErrorNotification(notification.Payload);
+    }
+    if (notification.Is(MessageType::Notification, GroupId::Session, SessionOpcodeId::Status)) {
+        return DecodeSessionStatusNotification(notification.Payload);
+    }
+    if (notification.Is(MessageType::Notification, GroupId::Session, SessionOpcodeId::UpdateControllerMulticastList)) {
+        return DecodeSessionUpdateControllerMulticastListNotification(notification.Payload);
+    }
+    if (notification.Is(MessageType::Notification, GroupId::Ranging, RangingOpcodeId::RangeData)) {
+        return DecodeRangeDataNotification(notification.Payload);
+    }
+
+    return std::nullopt;
+}
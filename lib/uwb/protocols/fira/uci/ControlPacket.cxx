@@ -0,0 +1,73 @@
+
+#include <notstd/utility.hxx>
+#include <uwb/protocols/fira/uci/ControlPacket.hxx>
+
+using namespace uwb::protocol::fira::uci;
+
+namespace
+{
+constexpr uint8_t MessageTypeShift = 5;
+constexpr uint8_t MessageTypeMask = 0b111U;
+constexpr uint8_t PacketBoundaryFlagBit = 0b0001'0000U;
+constexpr uint8_t GroupMask = 0b0000'1111U;
+constexpr uint8_t OpcodeMask = 0b0011'1111U;
+} // namespace
+
+/* static */
+std::optional<ControlPacketHeader>
+ControlPacketHeader::Parse(std::span<const uint8_t> data) noexcept
+{
+    if (std::size(data) < Size) {
+        return std::nullopt;
+    }
+
+    const auto type = static_cast<MessageType>((data[0] >> MessageTypeShift) & MessageTypeMask);
+    switch (type) {
+    case MessageType::Command:
+    case MessageType::Response:
+    case MessageType::Notification:
+        break;
+    default:
+        return std::nullopt;
+    }
+
+    return ControlPacketHeader{
+        .Type = type,
+        .PacketBoundaryFlag = (data[0] & PacketBoundaryFlagBit) != 0,
+        .Group = static_cast<uint8_t>(data[0] & GroupMask),
+        .Opcode = static_cast<uint8_t>(data[1] & OpcodeMask),
+        .PayloadLength = data[3],
+    };
+}
+
+std::array<uint8_t, ControlPacketHeader::Size>
+ControlPacketHeader::Encode() const noexcept
+{
+    return {
+        static_cast<uint8_t>((notstd::to_underlying(Type) << MessageTypeShift) | (PacketBoundaryFlag ? PacketBoundaryFlagBit : 0U) | (Group & GroupMask)),
+        static_cast<uint8_t>(Opcode & OpcodeMask),
+        0x00U,
+        PayloadLength,
+    };
+}
+
+/* static */
+std::optional<ControlPacket>
+ControlPacket::Parse(std::span<const uint8_t> data) noexcept
+{
+    const auto header = ControlPacketHeader::Parse(data);
+    if (!header.has_value() || std::size(data) < ControlPacketHeader::Size + header->PayloadLength) {
+        return std::nullopt;
+    }
+
+    return ControlPacket{
+        .Header = *header,
+        .Payload = data.subspan(ControlPacketHeader::Size, header->PayloadLength),
+    };
+}
+
+std::size_t
+ControlPacket::Size() const noexcept
+{
+    return ControlPacketHeader::Size + std::size(Payload);
+}
@@ -0,0 +1,262 @@
+
+#include <exception>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+#include <notstd/memory.hxx>
+#include <plog/Log.h>
+
+#include <uwb/protocols/fira/UwbException.hxx>
+#include <uwb/simulator/UwbSimulatorDevice.hxx>
+#include <uwb/simulator/UwbSimulatorSession.hxx>
+
+using namespace uwb::simulator;
+using namespace uwb::protocol::fira;
+
+UwbSimulatorDevice::UwbSimulatorDevice(UwbSimulatorConfiguration configuration) :
+    m_configuration(std::move(configuration)),
+    m_timerThread([this](std::stop_token stopToken) {
+        ProcessSchedule(std::move(stopToken));
+    })
+{}
+
+UwbSimulatorDevice::~UwbSimulatorDevice()
+{
+    // Sessions are invoked from the timer thread, so ensure it is stopped
+    // before any other members go away.
+    m_timerThread.request_stop();
+    if (m_timerThread.joinable()) {
+        m_timerThread.join();
+    }
+}
+
+/* static */
+std::shared_ptr<UwbSimulatorDevice>
+UwbSimulatorDevice::Create(UwbSimulatorConfiguration configuration)
+{
+    return std::make_shared<notstd::enable_make_protected<UwbSimulatorDevice>>(std::move(configuration));
+}
+
+const UwbSimulatorConfiguration&
+UwbSimulatorDevice::GetConfiguration() const noexcept
+{
+    return m_configuration;
+}
+
+uint64_t
+UwbSimulatorDevice::GetNumberOfMeasurementsGenerated() const noexcept
+{
+    return m_numberOfMeasurementsGenerated.load(std::memory_order_relaxed);
+}
+
+bool
+UwbSimulatorDevice::IsEqual(const uwb::UwbDevice& other) const noexcept
+{
+    // Simulated devices have no identity beyond the instance itself.
+    return (this == &other);
+}
+
+void
+UwbSimulatorDevice::StartRanging(uint32_t sessionId, std::chrono::microseconds rangingInterval)
+{
+    auto session = std::dynamic_pointer_cast<UwbSimulatorSession>(GetSession(sessionId));
+    if (session == nullptr) {
+        PLOG_ERROR << "simulator session with id " << sessionId << " does not exist";
+        throw UwbException(UwbStatusSession::NotExist);
+    }
+
+    {
+        std::scoped_lock scheduleLock{ m_scheduleGate };
+        ScheduleRangingLocked(sessionId, session, rangingInterval);
+    }
+
+    m_scheduleChanged.notify_one();
+}
+
+void
+UwbSimulatorDevice::UpdateRangingInterval(uint32_t sessionId, std::chrono::microseconds rangingInterval)
+{
+    {
+        std::scoped_lock scheduleLock{ m_scheduleGate };
+        auto rangingSession = m_rangingSessions.find(sessionId);
+        if (rangingSession == std::end(m_rangingSessions)) {
+            return;
+        }
+        ScheduleRangingLocked(sessionId, rangingSession->second.Session, rangingInterval);
+    }
+
+    m_scheduleChanged.notify_one();
+}
+
+void
+UwbSimulatorDevice::StopRanging(uint32_t sessionId)
+{
+    {
+        std::scoped_lock scheduleLock{ m_scheduleGate };
+        m_rangingSessions.erase(sessionId);
+    }
+
+    WaitForRangingRound();
+}
+
+void
+UwbSimulatorDevice::OnSessionDestroyed(uint32_t sessionId)
+{
+    {
+        std::scoped_lock scheduleLock{ m_scheduleGate };
+        m_rangingSessions.erase(sessionId);
+        m_sessionIds.erase(sessionId);
+    }
+
+    WaitForRangingRound();
+}
+
+void
+UwbSimulatorDevice::ScheduleRangingLocked(uint32_t sessionId, std::weak_ptr<UwbSimulatorSession> session, std::chrono::microseconds rangingInterval)
+{
+    // A new generation invalidates the entries already scheduled for the session.
+    const auto generation = m_generationNext++;
+    const auto interval = std::chrono::duration_cast<std::chrono::steady_clock::duration>(rangingInterval);
+    m_rangingSessions.insert_or_assign(sessionId, RangingSession{ std::move(session), interval, generation });
+    m_schedule.push(ScheduleEntry{ std::chrono::steady_clock::now() + interval, sessionId, generation });
+}
+
+void
+UwbSimulatorDevice::WaitForRangingRound()
+{
+    if (std::this_thread::get_id() != m_timerThread.get_id()) {
+        std::scoped_lock roundLock{ m_roundGate };
+    }
+}
+
+void
+UwbSimulatorDevice::ProcessSchedule(std::stop_token stopToken)
+{
+    std::vector<RangingRound> roundsDue;
+
+    while (!stopToken.stop_requested()) {
+        {
+            std::unique_lock scheduleLock{ m_scheduleGate };
+            if (m_schedule.empty()) {
+                m_scheduleChanged.wait(scheduleLock, stopToken, [&] {
+                    return !m_schedule.empty();
+                });
+                continue;
+            }
+
+            // Wait for the earliest round to come due, re-evaluating if an
+            // earlier one is scheduled in the meantime.
+            const auto due = m_schedule.top().Due;
+            if (m_scheduleChanged.wait_until(scheduleLock, stopToken, due, [&] {
+                    return m_schedule.top().Due < due;
+                })) {
+                continue;
+            }
+
+            const auto now = std::chrono::steady_clock::now();
+            while (!m_schedule.empty() && m_schedule.top().Due <= now) {
+                const auto entry = m_schedule.top();
+                m_schedule.pop();
+
+                // Discard entries for sessions that stopped or restarted ranging.
+                auto rangingSession = m_rangingSessions.find(entry.SessionId);
+                if (rangingSession == std::end(m_rangingSessions) || rangingSession->second.Generation != entry.Generation) {
+                    continue;
+                }
+
+                auto session = rangingSession->second.Session.lock();
+                if (session == nullptr) {
+                    m_rangingSessions.erase(rangingSession);
+                    continue;
+                }
+
+                // Keep a fixed rate, but skip rounds that were missed instead of
+                // running them back-to-back.
+                auto dueNext = entry.Due + rangingSession->second.RangingInterval;
+                if (dueNext <= now) {
+                    dueNext = now + rangingSession->second.RangingInterval;
+                }
+                m_schedule.push(ScheduleEntry{ dueNext, entry.SessionId, entry.Generation });
+                roundsDue.push_back(RangingRound{ std::move(session), entry.Generation });
+            }
+        }
+
+        // Run the rounds without holding the schedule lock, since the callbacks
+        // may start or stop ranging. Ranging may have stopped since the rounds
+        // were collected, so re-check each one while holding the round lock,
+        // which StopRanging() waits for.
+        for (auto& [session, generation] : roundsDue) {
+            std::scoped_lock roundLock{ m_roundGate };
+            {
+                std::scoped_lock scheduleLock{ m_scheduleGate };
+                auto rangingSession = m_rangingSessions.find(session->GetId());
+                if (rangingSession == std::end(m_rangingSessions) || rangingSession->second.Generation != generation) {
+                    continue;
+                }
+            }
+
+            try {
+                const auto numberOfMeasurements = session->OnRangingRound();
+                m_numberOfMeasurementsGenerated.fetch_add(numberOfMeasurements, std::memory_order_relaxed);
+            } catch (const std::exception& e) {
+                PLOG_ERROR << "unexpected exception running ranging round for session id " << session->GetId() << ": " << e.what();
+            }
+        }
+
+        roundsDue.clear();
+    }
+}
+
+std::shared_ptr<uwb::UwbSession>
+UwbSimulatorDevice::CreateSessionImpl(uint32_t sessionId, std::weak_ptr<uwb::UwbSessionEventCallbacks> callbacks)
+{
+    auto session = std::make_shared<UwbSimulatorSession>(sessionId, weak_from_this(), std::move(callbacks), m_configuration);
+    {
+        std::scoped_lock scheduleLock{ m_scheduleGate };
+        m_sessionIds.insert(sessionId);
+    }
+
+    return session;
+}
+
+std::shared_ptr<uwb::UwbSession>
+UwbSimulatorDevice::ResolveSessionImpl(uint32_t /* sessionId */)
+{
+    // Simulated sessions only exist while a reference to them is held.
+    return nullptr;
+}
+
+UwbCapability
+UwbSimulatorDevice::GetCapabilitiesImpl()
+{
+    return {};
+}
+
+UwbDeviceInformation
+UwbSimulatorDevice::GetDeviceInformationImpl()
+{
+    return UwbDeviceInformation{
+        .VersionUci = { 1, 1, 0 },
+        .VersionUciTest = { 1, 1, 0 },
+        .VersionMac = { 1, 3, 0 },
+        .VersionPhy = { 1, 3, 0 },
+        .Status = UwbStatusGeneric::Ok,
+        .VendorSpecificInfo = nullptr,
+    };
+}
+
+uint32_t
+UwbSimulatorDevice::GetSessionCountImpl()
+{
+    std::scoped_lock scheduleLock{ m_scheduleGate };
+    return static_cast<uint32_t>(std::size(m_sessionIds));
+}
+
+void
+UwbSimulatorDevice::ResetImpl()
+{
+    std::scoped_lock scheduleLock{ m_scheduleGate };
+    m_rangingSessions.clear();
+    m_sessionIds.clear();
+}
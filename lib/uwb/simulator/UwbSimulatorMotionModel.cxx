@@ -0,0 +1,142 @@
+
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+
+#include <uwb/simulator/UwbSimulatorMotionModel.hxx>
+
+using namespace uwb::simulator;
+
+namespace
+{
+/**
+ * @brief Wraps an angle to the range [-180, 180).
+ *
+ * @param angle The angle, in degrees.
+ * @return double
+ */
+double
+WrapAzimuth(double angle) noexcept
+{
+    angle = std::fmod(angle + 180.0, 360.0);
+    if (angle < 0.0) {
+        angle += 360.0;
+    }
+    return angle - 180.0;
+}
+
+/**
+ * @brief Reflects a value back into a range, as if it bounced off the limits.
+ *
+ * @param value The value.
+ * @param minimum The lower limit.
+ * @param maximum The upper limit.
+ * @return double
+ */
+double
+Reflect(double value, double minimum, double maximum) noexcept
+{
+    if (value < minimum) {
+        value = minimum + (minimum - value);
+    } else if (value > maximum) {
+        value = maximum - (value - maximum);
+    }
+    return std::clamp(value, minimum, maximum);
+}
+} // namespace
+
+UwbSimulatorRandom::UwbSimulatorRandom(uint64_t seed) noexcept :
+    m_engine(seed)
+{}
+
+/* static */
+uint64_t
+UwbSimulatorRandom::DeriveSeed(uint64_t seed, uint64_t stream) noexcept
+{
+    // splitmix64 finalizer.
+    uint64_t value = seed + ((stream + 1U) * 0x9E3779B97F4A7C15ULL);
+    value = (value ^ (value >> 30U)) * 0xBF58476D1CE4E5B9ULL;
+    value = (value ^ (value >> 27U)) * 0x94D049BB133111EBULL;
+    return value ^ (value >> 31U);
+}
+
+double
+UwbSimulatorRandom::Uniform() noexcept
+{
+    // Use the top 53 bits to fill the mantissa of a double.
+    return static_cast<double>(m_engine() >> 11U) * 0x1.0p-53;
+}
+
+double
+UwbSimulatorRandom::Normal(double standardDeviation) noexcept
+{
+    if (m_normalSpare.has_value()) {
+        const double value = *m_normalSpare;
+        m_normalSpare.reset();
+        return value * standardDeviation;
+    }
+
+    // Box-Muller transform, which produces two values at a time.
+    const double u1 = 1.0 - Uniform();
+    const double u2 = Uniform();
+    const double radius = std::sqrt(-2.0 * std::log(u1));
+    const double theta = 2.0 * std::numbers::pi * u2;
+    m_normalSpare = radius * std::sin(theta);
+    return radius * std::cos(theta) * standardDeviation;
+}
+
+UwbSimulatorMotionModel::UwbSimulatorMotionModel(const UwbSimulatorPeerMotion& motion) noexcept :
+    m_motion(motion),
+    m_position(motion.Initial)
+{
+    m_position.Distance = std::clamp(m_position.Distance, m_motion.DistanceMinimum, m_motion.DistanceMaximum);
+    m_position.Azimuth = WrapAzimuth(m_position.Azimuth);
+    m_position.Elevation = std::clamp(m_position.Elevation, -90.0, 90.0);
+}
+
+void
+UwbSimulatorMotionModel::Advance(std::chrono::duration<double> elapsed, UwbSimulatorRandom& random) noexcept
+{
+    const double seconds = elapsed.count();
+
+    switch (m_motion.Model) {
+    case UwbSimulatorMotionModelType::Stationary:
+        break;
+    case UwbSimulatorMotionModelType::RandomWalk:
+        m_position.Distance = Reflect(m_position.Distance + random.Normal(m_motion.Speed * seconds), m_motion.DistanceMinimum, m_motion.DistanceMaximum);
+        m_position.Azimuth = WrapAzimuth(m_position.Azimuth + random.Normal(m_motion.AngularSpeed * seconds));
+        m_position.Elevation = Reflect(m_position.Elevation + random.Normal(m_motion.AngularSpeed * seconds), -90.0, 90.0);
+        break;
+    case UwbSimulatorMotionModelType::Orbit:
+        m_position.Azimuth = WrapAzimuth(m_position.Azimuth + (m_motion.AngularSpeed * seconds));
+        break;
+    case UwbSimulatorMotionModelType::Oscillate: {
+        const double distance = m_position.Distance + (m_direction * m_motion.Speed * seconds);
+        if (distance > m_motion.DistanceMaximum || distance < m_motion.DistanceMinimum) {
+            m_direction = -m_direction;
+        }
+        m_position.Distance = Reflect(distance, m_motion.DistanceMinimum, m_motion.DistanceMaximum);
+        break;
+    }
+    }
+}
+
+const UwbSimulatorPosition&
+UwbSimulatorMotionModel::GetPosition() const noexcept
+{
+    return m_position;
+}
+
+UwbSimulatorPosition
+UwbSimulatorMotionModel::Measure(UwbSimulatorRandom& random) const noexcept
+{
+    UwbSimulatorPosition position = m_position;
+    if (m_motion.DistanceNoise > 0.0) {
+        position.Distance = std::max(0.0, position.Distance + random.Normal(m_motion.DistanceNoise));
+    }
+    if (m_motion.AngleNoise > 0.0) {
+        position.Azimuth = WrapAzimuth(position.Azimuth + random.Normal(m_motion.AngleNoise));
+        position.Elevation = std::clamp(position.Elevation + random.Normal(m_motion.AngleNoise), -90.0, 90.0);
+    }
+    return position;
+}
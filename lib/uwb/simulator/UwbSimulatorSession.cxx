@@ -0,0 +1,272 @@
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <iterator>
+#include <optional>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include <plog/Log.h>
+
+#include <uwb/UwbPeer.hxx>
+#include <uwb/UwbSessionEventCallbacks.hxx>
+#include <uwb/protocols/fira/UwbException.hxx>
+#include <uwb/protocols/fira/UwbQ97Conversions.hxx>
+#include <uwb/simulator/UwbSimulatorDevice.hxx>
+#include <uwb/simulator/UwbSimulatorSession.hxx>
+
+using namespace uwb::simulator;
+using namespace uwb::protocol::fira;
+
+namespace
+{
+/**
+ * @brief Figure of merit reported for simulated angle measurements.
+ */
+constexpr uint8_t FigureOfMeritSimulated = 100;
+
+/**
+ * @brief Creates the short mac address of a simulated peer.
+ *
+ * @param index The index of the peer in the session.
+ * @return uwb::UwbMacAddress
+ */
+uwb::UwbMacAddress
+MakePeerMacAddress(std::size_t index)
+{
+    const auto value = static_cast<uint16_t>(index + 1U);
+    return uwb::UwbMacAddress{ std::array<uint8_t, 2>{ static_cast<uint8_t>(value >> 8U), static_cast<uint8_t>(value & 0xFFU) } };
+}
+
+/**
+ * @brief Creates a session status describing a state change made by the
+ * session itself.
+ *
+ * @param sessionId The session identifier.
+ * @param state The new state of the session.
+ * @return UwbSessionStatus
+ */
+UwbSessionStatus
+MakeSessionStatus(uint32_t sessionId, UwbSessionState state) noexcept
+{
+    return UwbSessionStatus{ .SessionId = sessionId, .State = state, .ReasonCode = UwbSessionReasonCode::StateChangeWithSessionManagementCommands };
+}
+} // namespace
+
+UwbSimulatorSession::UwbSimulatorSession(uint32_t sessionId, std::weak_ptr<uwb::UwbDevice> device, std::weak_ptr<UwbSessionEventCallbacks> callbacks, const UwbSimulatorConfiguration& configuration) :
+    uwb::UwbSession(sessionId, std::move(device), std::move(callbacks)),
+    m_random(UwbSimulatorRandom::DeriveSeed(configuration.Seed, sessionId)),
+    m_rangingInterval(configuration.RangingInterval)
+{
+    m_simulatedPeers.reserve(std::size(configuration.Peers));
+    for (const auto& peerMotion : configuration.Peers) {
+        m_simulatedPeers.push_back(SimulatedPeer{ MakePeerMacAddress(std::size(m_simulatedPeers)), UwbSimulatorMotionModel{ peerMotion } });
+    }
+}
+
+std::chrono::microseconds
+UwbSimulatorSession::GetRangingInterval() const noexcept
+{
+    std::scoped_lock simulationLock{ m_simulationGate };
+    return m_rangingInterval;
+}
+
+UwbRangingData
+UwbSimulatorSession::GenerateNextRangingData()
+{
+    UwbRangingData rangingData{};
+    std::scoped_lock simulationLock{ m_simulationGate };
+    GenerateNextRangingDataLocked(rangingData);
+    return rangingData;
+}
+
+void
+UwbSimulatorSession::GenerateNextRangingDataLocked(UwbRangingData& rangingData)
+{
+    // Advance by the nominal interval rather than the time that actually
+    // passed, so the generated data doesn't depend on scheduling jitter.
+    const std::chrono::duration<double> elapsed{ m_rangingInterval };
+
+    rangingData.SequenceNumber = m_sequenceNumber++;
+    rangingData.SessionId = m_sessionId;
+    rangingData.CurrentRangingInterval = static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::milliseconds>(m_rangingInterval).count());
+    rangingData.RangingMeasurementType = UwbRangingMeasurementType::TwoWay;
+    rangingData.RangingMeasurements.resize(std::size(m_simulatedPeers));
+
+    for (std::size_t i = 0; i < std::size(m_simulatedPeers); i++) {
+        auto& [address, motion] = m_simulatedPeers[i];
+        motion.Advance(elapsed, m_random);
+        const auto position = motion.Measure(m_random);
+
+        auto& measurement = rangingData.RangingMeasurements[i];
+        measurement.SlotIndex = static_cast<uint8_t>(i);
+        measurement.Distance = static_cast<uint16_t>(std::clamp(std::lround(position.Distance), 0L, 0xFFFFL));
+        measurement.Status = UwbStatusGeneric::Ok;
+        measurement.PeerMacAddress = address;
+        measurement.LineOfSightIndicator = UwbLineOfSightIndicator::LineOfSight;
+        measurement.AoAAzimuth = { EncodeQ97(position.Azimuth), FigureOfMeritSimulated };
+        measurement.AoAElevation = { EncodeQ97(position.Elevation), FigureOfMeritSimulated };
+        measurement.AoaDestinationAzimuth = { EncodeQ97(position.Azimuth), FigureOfMeritSimulated };
+        measurement.AoaDestinationElevation = { EncodeQ97(position.Elevation), FigureOfMeritSimulated };
+    }
+}
+
+std::size_t
+UwbSimulatorSession::OnRangingRound()
+{
+    {
+        std::scoped_lock simulationLock{ m_simulationGate };
+        GenerateNextRangingDataLocked(m_rangingData);
+    }
+
+    auto callbacks = ResolveEventCallbacks();
+    if (callbacks == nullptr) {
+        PLOG_WARNING << "missing session event callback for ranging data, skipping";
+        return std::size(m_rangingData.RangingMeasurements);
+    }
+
+    std::vector<uwb::UwbPeer> peersChanged;
+    peersChanged.reserve(std::size(m_rangingData.RangingMeasurements));
+    for (const auto& rangingMeasurement : m_rangingData.RangingMeasurements) {
+        peersChanged.emplace_back(rangingMeasurement);
+    }
+
+    callbacks->OnPeerPropertiesChanged(this, std::move(peersChanged));
+    return std::size(m_rangingData.RangingMeasurements);
+}
+
+void
+UwbSimulatorSession::ConfigureImpl(const std::vector<UwbApplicationConfigurationParameter> configParams)
+{
+    PLOG_VERBOSE << "ConfigureImpl";
+
+    SetApplicationConfigurationParametersImpl(configParams);
+    SetSessionStatus(MakeSessionStatus(m_sessionId, UwbSessionState::Idle));
+}
+
+void
+UwbSimulatorSession::StartRangingImpl()
+{
+    auto device = std::dynamic_pointer_cast<UwbSimulatorDevice>(ResolveParentDevice());
+    if (device == nullptr) {
+        PLOG_ERROR << "simulator device for session id " << m_sessionId << " no longer exists";
+        m_rangingActive = false;
+        throw UwbException(UwbStatusGeneric::Failed);
+    }
+
+    device->StartRanging(m_sessionId, GetRangingInterval());
+    SetSessionStatus(MakeSessionStatus(m_sessionId, UwbSessionState::Active));
+
+    auto callbacks = ResolveEventCallbacks();
+    if (callbacks != nullptr) {
+        callbacks->OnRangingStarted(this);
+    }
+}
+
+void
+UwbSimulatorSession::StopRangingImpl()
+{
+    auto device = std::dynamic_pointer_cast<UwbSimulatorDevice>(ResolveParentDevice());
+    if (device != nullptr) {
+        device->StopRanging(m_sessionId);
+    }
+
+    SetSessionStatus(MakeSessionStatus(m_sessionId, UwbSessionState::Idle));
+
+    auto callbacks = ResolveEventCallbacks();
+    if (callbacks != nullptr) {
+        callbacks->OnRangingStopped(this);
+    }
+}
+
+UwbStatus
+UwbSimulatorSession::TryAddControleeImpl(uwb::UwbMacAddress controleeMacAddress)
+{
+    std::scoped_lock simulationLock{ m_simulationGate };
+    const auto isPresent = std::ranges::any_of(m_simulatedPeers, [&](const auto& simulatedPeer) {
+        return simulatedPeer.Address == controleeMacAddress;
+    });
+    if (isPresent) {
+        PLOG_INFO << "controleeMacAddress already added, skipping";
+        return UwbStatusSession::AddressAlreadyPresent;
+    }
+
+    m_simulatedPeers.push_back(SimulatedPeer{ std::move(controleeMacAddress), UwbSimulatorMotionModel{ UwbSimulatorPeerMotion{} } });
+    return UwbStatusGeneric::Ok;
+}
+
+std::vector<UwbApplicationConfigurationParameter>
+UwbSimulatorSession::GetApplicationConfigurationParametersImpl(std::vector<UwbApplicationConfigurationParameterType> requestedTypes)
+{
+    std::scoped_lock simulationLock{ m_simulationGate };
+
+    std::vector<UwbApplicationConfigurationParameter> applicationConfigurationParameters;
+    for (const auto& requestedType : requestedTypes) {
+        auto applicationConfigurationParameter = m_applicationConfigurationParameters.find(requestedType);
+        if (applicationConfigurationParameter != std::cend(m_applicationConfigurationParameters)) {
+            applicationConfigurationParameters.push_back(applicationConfigurationParameter->second);
+        }
+    }
+
+    return applicationConfigurationParameters;
+}
+
+void
+UwbSimulatorSession::SetApplicationConfigurationParametersImpl(std::vector<UwbApplicationConfigurationParameter> uwbApplicationConfigurationParameters)
+{
+    std::optional<std::chrono::microseconds> rangingIntervalUpdated;
+    {
+        std::scoped_lock simulationLock{ m_simulationGate };
+
+        for (auto& applicationConfigurationParameter : uwbApplicationConfigurationParameters) {
+            // The ranging interval is the only parameter that affects the simulation.
+            if (applicationConfigurationParameter.Type == UwbApplicationConfigurationParameterType::RangingInterval) {
+                const auto* rangingInterval = std::get_if<uint32_t>(&applicationConfigurationParameter.Value);
+                if (rangingInterval == nullptr || *rangingInterval == 0) {
+                    PLOG_ERROR << "invalid ranging interval for session id " << m_sessionId;
+                    throw UwbException(UwbStatusGeneric::InvalidParameter);
+                }
+                m_rangingInterval = std::chrono::milliseconds(*rangingInterval);
+                rangingIntervalUpdated = m_rangingInterval;
+            }
+
+            const auto type = applicationConfigurationParameter.Type;
+            m_applicationConfigurationParameters.insert_or_assign(type, std::move(applicationConfigurationParameter));
+        }
+    }
+
+    // Reschedule the rounds of a session that is ranging, so they keep pace
+    // with the interval reported in its ranging data.
+    if (rangingIntervalUpdated.has_value()) {
+        auto device = std::dynamic_pointer_cast<UwbSimulatorDevice>(ResolveParentDevice());
+        if (device != nullptr) {
+            device->UpdateRangingInterval(m_sessionId, *rangingIntervalUpdated);
+        }
+    }
+}
+
+UwbSessionState
+UwbSimulatorSession::GetSessionStateImpl()
+{
+    return m_sessionStatus.State;
+}
+
+void
+UwbSimulatorSession::DestroyImpl()
+{
+    auto device = std::dynamic_pointer_cast<UwbSimulatorDevice>(ResolveParentDevice());
+    if (device != nullptr) {
+        device->StopRanging(m_sessionId);
+        device->OnSessionDestroyed(m_sessionId);
+    }
+
+    m_rangingActive = false;
+    SetSessionStatus(MakeSessionStatus(m_sessionId, UwbSessionState::Deinitialized));
+
+    auto callbacks = ResolveEventCallbacks();
+    if (callbacks != nullptr) {
+        callbacks->OnSessionEnded(this, uwb::UwbSessionEndReason::Stopped);
+    }
+}
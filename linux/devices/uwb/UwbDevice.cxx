@@ -1,33 +1,228 @@
 
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+#include <notstd/memory.hxx>
+#include <plog/Log.h>
+
 #include <linux/uwb/UwbDevice.hxx>
+#include <linux/uwb/UwbSession.hxx>
+#include <uwb/protocols/fira/UwbException.hxx>
+#include <uwb/protocols/fira/uci/ControlMessageCodec.hxx>
 
 using namespace linux::devices;
 using namespace uwb::protocol::fira;
+using namespace uwb::protocol::fira::uci;
+
+UwbDevice::UwbDevice(std::string deviceName) :
+    UwbDevice(std::move(deviceName), nullptr)
+{}
+
+UwbDevice::UwbDevice(std::string deviceName, std::shared_ptr<UwbDeviceDriver> driver) :
+    m_deviceName(std::move(deviceName)),
+    m_driver(std::move(driver))
+{}
+
+UwbDevice::~UwbDevice()
+{
+    // The notification handler refers to this instance, so ensure the reader
+    // thread is stopped before it goes away.
+    if (m_driver) {
+        m_driver->Stop();
+    }
+}
+
+/* static */
+std::shared_ptr<UwbDevice>
+UwbDevice::Create(std::string deviceName)
+{
+    return std::make_shared<notstd::enable_make_protected<UwbDevice>>(std::move(deviceName));
+}
+
+/* static */
+std::shared_ptr<UwbDevice>
+UwbDevice::Create(std::string deviceName, std::shared_ptr<UwbDeviceDriver> driver)
+{
+    return std::make_shared<notstd::enable_make_protected<UwbDevice>>(std::move(deviceName), std::move(driver));
+}
+
+const std::string&
+UwbDevice::DeviceName() const noexcept
+{
+    return m_deviceName;
+}
+
+std::shared_ptr<uwb::UwbSession>
+UwbDevice::CreateSessionImpl(uint32_t sessionId, std::weak_ptr<uwb::UwbSessionEventCallbacks> callbacks)
+{
+    return std::make_shared<UwbSession>(sessionId, shared_from_this(), GetDriver(), std::move(callbacks));
+}
 
 std::shared_ptr<uwb::UwbSession>
-UwbDevice::CreateSessionImpl(uint32_t sessionId, std::weak_ptr<uwb::UwbSessionEventCallbacks> /* callbacks */)
+UwbDevice::ResolveSessionImpl(uint32_t sessionId)
 {
-    // TODO
-    return nullptr;
+    auto driver = GetDriver();
+    auto command = EncodeSessionGetAppConfigCommand({ sessionId, { UwbApplicationConfigurationParameterType::DeviceType } });
+
+    SessionGetAppConfigResponse response;
+    try {
+        response = driver->ExecuteCommand(command, DecodeSessionGetAppConfigResponse);
+    } catch (const UwbException& uwbException) {
+        PLOG_ERROR << "caught exception attempting to obtain application configuration parameters for session id " << sessionId << " (" << ToString(uwbException.Status) << ")";
+        throw;
+    }
+
+    if (!IsUwbStatusOk(response.Status)) {
+        PLOG_ERROR << "failed to obtain device type for session id " << sessionId << " (" << ToString(response.Status) << ")";
+        throw UwbException(response.Status);
+    }
+
+    // Validate the device provided the expected DeviceType parameter.
+    if (std::size(response.Parameters) < 1 || !std::holds_alternative<DeviceType>(response.Parameters.front().Value)) {
+        PLOG_ERROR << "invalid application configuration parameters returned for session id " << sessionId;
+        throw UwbException(UwbStatusGeneric::SyntaxError);
+    }
+
+    auto deviceType = std::get<DeviceType>(response.Parameters.front().Value);
+    return std::make_shared<UwbSession>(sessionId, shared_from_this(), std::move(driver), deviceType);
 }
 
 UwbCapability
 UwbDevice::GetCapabilitiesImpl()
 {
-    // TODO
-    return {};
+    PLOG_ERROR << "uwb capabilities are not supported on this device";
+    throw UwbException(UwbStatusGeneric::Rejected);
 }
 
 UwbDeviceInformation
-GetDeviceInformationImpl()
+UwbDevice::GetDeviceInformationImpl()
 {
-    // TODO
-    return {};
+    try {
+        return GetDriver()->ExecuteCommand(EncodeGetDeviceInfoCommand(), DecodeGetDeviceInfoResponse);
+    } catch (const UwbException& uwbException) {
+        PLOG_ERROR << "caught exception obtaining uwb device information (" << ToString(uwbException.Status) << ")";
+        throw;
+    }
+}
+
+uint32_t
+UwbDevice::GetSessionCountImpl()
+{
+    CountResponse response;
+    try {
+        response = GetDriver()->ExecuteCommand(EncodeSessionGetCountCommand(), DecodeSessionGetCountResponse);
+    } catch (const UwbException& uwbException) {
+        PLOG_ERROR << "caught exception obtaining session count (" << ToString(uwbException.Status) << ")";
+        throw;
+    }
+
+    if (!IsUwbStatusOk(response.Status)) {
+        PLOG_ERROR << "uwb device reported an error obtaining session count, status=" << ToString(response.Status);
+        throw UwbException(response.Status);
+    }
+
+    return response.Count;
 }
 
 void
-ResetImpl()
+UwbDevice::ResetImpl()
+{
+    UwbStatus status;
+    try {
+        status = GetDriver()->ExecuteCommand(EncodeDeviceResetCommand(), DecodeStatusResponse);
+    } catch (const UwbException& uwbException) {
+        PLOG_ERROR << "caught exception resetting the uwb device (" << ToString(uwbException.Status) << ")";
+        throw;
+    }
+
+    if (!IsUwbStatusOk(status)) {
+        PLOG_ERROR << "uwb device reported an error resetting, status=" << ToString(status);
+        throw UwbException(status);
+    }
+}
+
+std::shared_ptr<UwbDeviceDriver>
+UwbDevice::GetDriver() const
 {
+    if (!m_driver) {
+        PLOG_ERROR << "uwb device " << m_deviceName << " has not been initialized";
+        throw UwbException(UwbStatusGeneric::Rejected);
+    }
+
+    return m_driver;
+}
+
+bool
+UwbDevice::InitializeImpl()
+{
+    try {
+        if (!m_driver) {
+            m_driver = UwbDeviceDriver::Open(m_deviceName);
+        }
+        m_driver->Start([this](const ControlMessageView& notification) {
+            OnNotification(notification);
+        });
+    } catch (const std::system_error& e) {
+        PLOG_ERROR << "failed to initialize uwb device " << m_deviceName << " (" << e.what() << ")";
+        return false;
+    }
+
+    return true;
+}
+
+void
+UwbDevice::OnNotification(const ControlMessageView& notification)
+{
+    // Ranging data is by far the most frequent notification, so decode it
+    // into storage that is reused across notifications.
+    if (notification.Is(MessageType::Notification, GroupId::Ranging, RangingOpcodeId::RangeData)) {
+        if (!DecodeRangeDataNotification(notification.Payload, m_rangingData)) {
+            PLOG_WARNING << "ignoring malformed ranging data notification";
+            return;
+        }
+        auto session = std::dynamic_pointer_cast<UwbSession>(FindSession(m_rangingData.SessionId));
+        if (!session) {
+            PLOG_WARNING << "ignoring ranging data for unknown session id " << m_rangingData.SessionId;
+            return;
+        }
+        session->OnRangingData(m_rangingData);
+        return;
+    }
+
+    auto notificationData = DecodeNotification(notification);
+    if (!notificationData.has_value()) {
+        PLOG_WARNING << "ignoring unsupported notification, gid=" << +notification.Group << " oid=" << +notification.Opcode;
+        return;
+    }
+
+    std::visit([this](auto&& arg) {
+        using ValueType = std::decay_t<decltype(arg)>;
+
+        if constexpr (std::is_same_v<ValueType, UwbStatus>) {
+            OnStatusChanged(arg);
+        } else if constexpr (std::is_same_v<ValueType, UwbStatusDevice>) {
+            OnDeviceStatusChanged(arg);
+        } else if constexpr (std::is_same_v<ValueType, UwbSessionStatus>) {
+            auto session = std::dynamic_pointer_cast<UwbSession>(FindSession(arg.SessionId));
+            if (!session) {
+                PLOG_WARNING << "ignoring session status for unknown session id " << arg.SessionId;
+                return;
+            }
+            session->OnSessionStatus(arg);
+        } else if constexpr (std::is_same_v<ValueType, UwbSessionUpdateMulticastListStatus>) {
+            auto session = std::dynamic_pointer_cast<UwbSession>(FindSession(arg.SessionId));
+            if (!session) {
+                PLOG_WARNING << "ignoring multicast list status for unknown session id " << arg.SessionId;
+                return;
+            }
+            session->OnMulticastListStatus(arg);
+        } else if constexpr (std::is_same_v<ValueType, UwbRangingData>) {
+            // Handled above.
+        }
+    },
+        *notificationData);
 }
 
 bool
@@ -35,7 +230,5 @@ UwbDevice::IsEqual(const uwb::UwbDevice& other) const noexcept
 {
     // NOLINTNEXTLINE(cppcoreguidelines-pro-type-static-cast-downcast)
     const auto& rhs = static_cast<const linux::devices::UwbDevice&>(other);
-
-    // TODO: implement this properly
-    return (this == &rhs);
+    return (this->DeviceName() == rhs.DeviceName());
 }
@@ -0,0 +1,390 @@
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstring>
+#include <exception>
+
+#include <fcntl.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include <linux/uwb/UwbDeviceDriver.hxx>
+#include <plog/Log.h>
+
+using namespace linux::devices;
+using namespace uwb::protocol::fira::uci;
+
+namespace
+{
+/**
+ * @brief The size of a UCI data packet header.
+ *
+ * See FiRa Consortium - UCI Generic Specification v1.1.0, Section 4.4.2.
+ */
+constexpr std::size_t DataPacketHeaderSize = 4;
+
+/**
+ * @brief Closes a file descriptor, if valid, and invalidates it.
+ *
+ * @param fd The file descriptor to close.
+ */
+void
+CloseFileDescriptor(int& fd) noexcept
+{
+    if (fd >= 0) {
+        ::close(fd);
+        fd = -1;
+    }
+}
+
+/**
+ * @brief Creates a std::system_error from the current value of errno.
+ *
+ * @param what The description of the operation that failed.
+ * @return std::system_error
+ */
+std::system_error
+MakeSystemErrorFromErrno(const char* what)
+{
+    return std::system_error(errno, std::system_category(), what);
+}
+} // namespace
+
+UwbDeviceDriver::UwbDeviceDriver(int fd) :
+    m_fd(fd)
+{
+    m_receiveBuffer.resize(ReceiveBufferSize);
+}
+
+/* static */
+std::unique_ptr<UwbDeviceDriver>
+UwbDeviceDriver::Open(const std::string& devicePath)
+{
+    const int fd = ::open(devicePath.c_str(), O_RDWR | O_CLOEXEC | O_NOCTTY);
+    if (fd < 0) {
+        auto error = MakeSystemErrorFromErrno("failed to open uci device");
+        PLOG_ERROR << "failed to open uci device " << devicePath << " (" << error.what() << ")";
+        throw error;
+    }
+
+    return std::make_unique<UwbDeviceDriver>(fd);
+}
+
+UwbDeviceDriver::~UwbDeviceDriver()
+{
+    Stop();
+    CloseFileDescriptor(m_fd);
+}
+
+void
+UwbDeviceDriver::Start(NotificationHandler notificationHandler)
+{
+    if (m_readerThread.joinable()) {
+        throw std::system_error(std::make_error_code(std::errc::device_or_resource_busy), "uci driver already started");
+    }
+
+    m_fdEpoll = ::epoll_create1(EPOLL_CLOEXEC);
+    if (m_fdEpoll < 0) {
+        auto error = MakeSystemErrorFromErrno("failed to create epoll instance");
+        PLOG_ERROR << error.what();
+        throw error;
+    }
+
+    m_fdEventStop = ::eventfd(0, EFD_CLOEXEC);
+    if (m_fdEventStop < 0) {
+        auto error = MakeSystemErrorFromErrno("failed to create stop event");
+        PLOG_ERROR << error.what();
+        CloseFileDescriptor(m_fdEpoll);
+        throw error;
+    }
+
+    for (const int fd : { m_fd, m_fdEventStop }) {
+        epoll_event event{};
+        event.events = EPOLLIN;
+        event.data.fd = fd;
+        if (::epoll_ctl(m_fdEpoll, EPOLL_CTL_ADD, fd, &event) < 0) {
+            auto error = MakeSystemErrorFromErrno("failed to register file descriptor with epoll");
+            PLOG_ERROR << error.what();
+            CloseFileDescriptor(m_fdEventStop);
+            CloseFileDescriptor(m_fdEpoll);
+            throw error;
+        }
+    }
+
+    m_notificationHandler = std::move(notificationHandler);
+    m_notificationQueue = std::make_unique<notstd::task_queue>();
+    m_notificationDispatcher = m_notificationQueue->get_dispatcher();
+    m_receiveBufferLength = 0;
+    m_receiveSkipLength = 0;
+    m_reassembler.Reset();
+    {
+        std::lock_guard pendingCommandLock{ m_pendingCommandGate };
+        m_running = true;
+        m_timedOutCommand.reset();
+    }
+
+    m_readerThread = std::thread([this] {
+        ProcessMessages();
+    });
+}
+
+void
+UwbDeviceDriver::Stop() noexcept
+{
+    if (!m_readerThread.joinable()) {
+        return;
+    }
+
+    const uint64_t value = 1;
+    if (::write(m_fdEventStop, &value, sizeof value) < 0) {
+        PLOG_ERROR << "failed to signal uci reader thread to stop (" << std::strerror(errno) << ")";
+    }
+
+    m_readerThread.join();
+    CloseFileDescriptor(m_fdEventStop);
+    CloseFileDescriptor(m_fdEpoll);
+
+    // Destroying the queue runs the pending notification tasks, then joins
+    // the notification thread.
+    m_notificationDispatcher.reset();
+    m_notificationQueue.reset();
+}
+
+bool
+UwbDeviceDriver::IsRunning() const noexcept
+{
+    std::lock_guard pendingCommandLock{ m_pendingCommandGate };
+    return m_running;
+}
+
+ControlMessage
+UwbDeviceDriver::ExecuteCommand(const ControlMessage& command, std::chrono::milliseconds timeout)
+{
+    // UCI allows only a single outstanding command, so serialize them.
+    std::lock_guard commandLock{ m_commandGate };
+
+    std::future<ControlMessage> response;
+    {
+        std::lock_guard pendingCommandLock{ m_pendingCommandGate };
+        if (!m_running) {
+            throw std::system_error(std::make_error_code(std::errc::not_connected), "uci driver is not running");
+        }
+        m_pendingResponse = {};
+        m_pendingCommand = CommandIdentifier{ command.Group, command.Opcode };
+        response = m_pendingResponse.get_future();
+    }
+
+    // Write each packet of a segmented command separately, since character
+    // devices typically expect one packet per write.
+    try {
+        const auto packets = command.Encode();
+        std::span<const uint8_t> data{ packets };
+        while (!data.empty()) {
+            const auto packet = ControlPacket::Parse(data);
+            Write(data.first(packet->Size()));
+            data = data.subspan(packet->Size());
+        }
+    } catch (...) {
+        std::lock_guard pendingCommandLock{ m_pendingCommandGate };
+        m_pendingCommand.reset();
+        throw;
+    }
+
+    if (response.wait_for(timeout) != std::future_status::ready) {
+        std::lock_guard pendingCommandLock{ m_pendingCommandGate };
+        // The response may have been delivered after the wait timed out but
+        // before the lock was acquired, in which case it is ready.
+        if (m_pendingCommand.has_value()) {
+            m_timedOutCommand = m_pendingCommand;
+            m_pendingCommand.reset();
+            PLOG_ERROR << "timed out waiting for uci response, gid=" << +command.Group << " oid=" << +command.Opcode;
+            throw std::system_error(std::make_error_code(std::errc::timed_out), "timed out waiting for uci response");
+        }
+    }
+
+    return response.get();
+}
+
+std::size_t
+UwbDeviceDriver::GetNumberOfResponsesDiscarded() const noexcept
+{
+    return m_numberOfResponsesDiscarded.load(std::memory_order_relaxed);
+}
+
+void
+UwbDeviceDriver::ProcessMessages()
+{
+    std::array<epoll_event, 2> events{};
+    std::error_code error = std::make_error_code(std::errc::operation_canceled);
+
+    for (bool stop = false; !stop;) {
+        const int numberOfEvents = ::epoll_wait(m_fdEpoll, std::data(events), static_cast<int>(std::size(events)), -1);
+        if (numberOfEvents < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            error = std::error_code(errno, std::system_category());
+            PLOG_ERROR << "failed to wait for uci device events (" << error.message() << ")";
+            break;
+        }
+
+        for (const auto& event : std::span{ std::data(events), static_cast<std::size_t>(numberOfEvents) }) {
+            if (event.data.fd == m_fdEventStop) {
+                stop = true;
+                break;
+            }
+
+            if ((event.events & EPOLLIN) != 0U) {
+                // The buffer always has room for at least one complete packet
+                // since ProcessReceiveBuffer() only leaves a partial one.
+                const auto numberOfOctetsRead = ::read(m_fd, std::data(m_receiveBuffer) + m_receiveBufferLength, std::size(m_receiveBuffer) - m_receiveBufferLength);
+                if (numberOfOctetsRead > 0) {
+                    m_receiveBufferLength += static_cast<std::size_t>(numberOfOctetsRead);
+                    ProcessReceiveBuffer();
+                    continue;
+                } else if (numberOfOctetsRead < 0 && (errno == EINTR || errno == EAGAIN)) {
+                    continue;
+                }
+                error = (numberOfOctetsRead == 0) ? std::make_error_code(std::errc::connection_reset) : std::error_code(errno, std::system_category());
+            } else {
+                error = std::make_error_code(std::errc::connection_reset);
+            }
+
+            PLOG_ERROR << "uci device is no longer readable (" << error.message() << ")";
+            stop = true;
+            break;
+        }
+    }
+
+    OnReaderStopped(error);
+}
+
+void
+UwbDeviceDriver::ProcessReceiveBuffer()
+{
+    std::span<const uint8_t> data{ std::data(m_receiveBuffer), m_receiveBufferLength };
+
+    // Skip the remainder of a data packet that started in a previous read.
+    const auto numberOfOctetsToSkip = std::min(m_receiveSkipLength, std::size(data));
+    data = data.subspan(numberOfOctetsToSkip);
+    m_receiveSkipLength -= numberOfOctetsToSkip;
+
+    while (!data.empty()) {
+        const auto packet = ControlPacket::Parse(data);
+        if (!packet.has_value()) {
+            if (std::size(data) < ControlPacketHeader::Size || ControlPacketHeader::Parse(data).has_value()) {
+                // Incomplete packet; wait for the rest of it.
+                break;
+            }
+
+            // Data packets aren't supported, but have a 16-bit payload length
+            // in octets 2-3, so they can be skipped.
+            if (static_cast<MessageType>(data[0] >> 5U) == MessageType::Data) {
+                const std::size_t dataPacketSize = DataPacketHeaderSize + (static_cast<std::size_t>(data[2]) | (static_cast<std::size_t>(data[3]) << 8U));
+                PLOG_WARNING << "discarding unsupported uci data packet of " << dataPacketSize << " octets";
+                m_receiveSkipLength = dataPacketSize - std::min(dataPacketSize, std::size(data));
+                data = data.subspan(std::min(dataPacketSize, std::size(data)));
+                continue;
+            }
+
+            // The stream is corrupt and there's no way to find the next
+            // packet boundary, so start over.
+            PLOG_ERROR << "received invalid uci packet header, discarding " << std::size(data) << " octets";
+            m_reassembler.Reset();
+            data = {};
+            break;
+        }
+
+        data = data.subspan(packet->Size());
+        const auto message = m_reassembler.Push(*packet);
+        if (message.has_value()) {
+            OnMessage(*message);
+        }
+    }
+
+    // Move any partial packet to the start of the buffer for the next read to complete.
+    if (!data.empty() && std::data(data) != std::data(m_receiveBuffer)) {
+        std::memmove(std::data(m_receiveBuffer), std::data(data), std::size(data));
+    }
+    m_receiveBufferLength = std::size(data);
+}
+
+void
+UwbDeviceDriver::OnMessage(const ControlMessageView& message)
+{
+    switch (message.Type) {
+    case MessageType::Response: {
+        std::lock_guard pendingCommandLock{ m_pendingCommandGate };
+        // The UWBS responds to commands in order, so the first response
+        // matching a command that timed out is the late response to it, even
+        // if a command with the same identifier is now outstanding. Any other
+        // response means the late one is never coming.
+        const auto timedOutCommand = std::exchange(m_timedOutCommand, std::nullopt);
+        if (timedOutCommand.has_value() && timedOutCommand->Group == message.Group && timedOutCommand->Opcode == message.Opcode) {
+            m_numberOfResponsesDiscarded.fetch_add(1, std::memory_order_relaxed);
+            PLOG_WARNING << "discarding late uci response to timed out command, gid=" << +message.Group << " oid=" << +message.Opcode;
+        } else if (m_pendingCommand.has_value() && m_pendingCommand->Group == message.Group && m_pendingCommand->Opcode == message.Opcode) {
+            m_pendingResponse.set_value(ControlMessage::FromView(message));
+            m_pendingCommand.reset();
+        } else {
+            m_numberOfResponsesDiscarded.fetch_add(1, std::memory_order_relaxed);
+            PLOG_WARNING << "discarding unexpected uci response, gid=" << +message.Group << " oid=" << +message.Opcode;
+        }
+        break;
+    }
+    case MessageType::Notification:
+        if (m_notificationHandler) {
+            try {
+                m_notificationDispatcher->post_detached([this, notification = ControlMessage::FromView(message)] {
+                    OnNotification(notification);
+                });
+            } catch (const std::exception& e) {
+                PLOG_ERROR << "failed to queue uci notification, gid=" << +message.Group << " oid=" << +message.Opcode << " (" << e.what() << ")";
+            }
+        }
+        break;
+    default:
+        PLOG_WARNING << "ignoring unexpected uci message, mt=" << +notstd::to_underlying(message.Type);
+        break;
+    }
+}
+
+void
+UwbDeviceDriver::OnNotification(const ControlMessage& notification)
+{
+    try {
+        m_notificationHandler(notification.View());
+    } catch (const std::exception& e) {
+        PLOG_ERROR << "caught exception handling uci notification, gid=" << +notification.Group << " oid=" << +notification.Opcode << " (" << e.what() << ")";
+    }
+}
+
+void
+UwbDeviceDriver::OnReaderStopped(std::error_code error)
+{
+    std::lock_guard pendingCommandLock{ m_pendingCommandGate };
+    m_running = false;
+    if (m_pendingCommand.has_value()) {
+        m_pendingResponse.set_exception(std::make_exception_ptr(std::system_error(error, "uci reader stopped")));
+        m_pendingCommand.reset();
+    }
+}
+
+void
+UwbDeviceDriver::Write(std::span<const uint8_t> data)
+{
+    while (!data.empty()) {
+        const auto numberOfOctetsWritten = ::write(m_fd, std::data(data), std::size(data));
+        if (numberOfOctetsWritten < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            auto error = MakeSystemErrorFromErrno("failed to write uci packet");
+            PLOG_ERROR << error.what();
+            throw error;
+        }
+        data = data.subspan(static_cast<std::size_t>(numberOfOctetsWritten));
+    }
+}
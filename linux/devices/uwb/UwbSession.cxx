@@ -0,0 +1,235 @@
+
+#include <stdexcept>
+#include <unordered_set>
+#include <utility>
+
+#include <magic_enum.hpp>
+#include <plog/Log.h>
+
+#include <linux/uwb/UwbSession.hxx>
+#include <uwb/UwbDevice.hxx>
+#include <uwb/protocols/fira/UwbException.hxx>
+#include <uwb/protocols/fira/uci/ControlMessageCodec.hxx>
+
+using namespace linux::devices;
+using namespace ::uwb::protocol::fira;
+using namespace ::uwb::protocol::fira::uci;
+
+namespace
+{
+const UwbStatus&
+GetResponseStatus(const UwbStatus& status) noexcept
+{
+    return status;
+}
+
+template <typename ResponseT>
+const UwbStatus&
+GetResponseStatus(const ResponseT& response) noexcept
+{
+    return response.Status;
+}
+
+/**
+ * @brief Executes a session command, validating the status of the response.
+ *
+ * @tparam DecodeFunctionT The type of the function to decode the response.
+ * @param driver The driver to execute the command with.
+ * @param sessionId The session the command is for, used for logging.
+ * @param operation A description of the command, used for logging.
+ * @param command The command to execute.
+ * @param decode The function to decode the response payload.
+ * @return auto The decoded response.
+ * @throws UwbException If the command failed or the response status isn't ok.
+ */
+template <typename DecodeFunctionT>
+auto
+ExecuteSessionCommand(UwbDeviceDriver& driver, uint32_t sessionId, const char* operation, const ControlMessage& command, DecodeFunctionT decode)
+{
+    try {
+        auto response = driver.ExecuteCommand(command, decode);
+        const auto& status = GetResponseStatus(response);
+        if (!IsUwbStatusOk(status)) {
+            throw UwbException(status);
+        }
+        return response;
+    } catch (const UwbException& uwbException) {
+        PLOG_ERROR << "failed to " << operation << " for session id " << sessionId << " (" << ToString(uwbException.Status) << ")";
+        throw;
+    }
+}
+} // namespace
+
+UwbSession::UwbSession(uint32_t sessionId, std::weak_ptr<::uwb::UwbDevice> device, std::shared_ptr<UwbDeviceDriver> driver, std::weak_ptr<::uwb::UwbSessionEventCallbacks> callbacks, DeviceType deviceType) :
+    ::uwb::UwbSession(sessionId, std::move(device), std::move(callbacks), deviceType),
+    m_driver(std::move(driver))
+{}
+
+UwbSession::UwbSession(uint32_t sessionId, std::weak_ptr<::uwb::UwbDevice> device, std::shared_ptr<UwbDeviceDriver> driver, DeviceType deviceType) :
+    UwbSession(sessionId, std::move(device), std::move(driver), std::weak_ptr<::uwb::UwbSessionEventCallbacks>{}, deviceType)
+{}
+
+void
+UwbSession::OnSessionStatus(const UwbSessionStatus& sessionStatus)
+{
+    const auto statePrevious = m_sessionStatus.State;
+    SetSessionStatus(sessionStatus);
+    if (statePrevious == sessionStatus.State) {
+        return;
+    }
+
+    auto callbacks = ResolveEventCallbacks();
+    if (callbacks == nullptr) {
+        PLOG_WARNING << "missing session event callback for session status, skipping";
+        return;
+    }
+
+    switch (sessionStatus.State) {
+    case UwbSessionState::Active:
+        callbacks->OnRangingStarted(this);
+        break;
+    case UwbSessionState::Idle:
+        if (statePrevious == UwbSessionState::Active) {
+            callbacks->OnRangingStopped(this);
+        }
+        break;
+    case UwbSessionState::Deinitialized:
+        callbacks->OnSessionEnded(this, ::uwb::UwbSessionEndReason::Stopped);
+        break;
+    default:
+        break;
+    }
+}
+
+void
+UwbSession::OnMulticastListStatus(const UwbSessionUpdateMulticastListStatus& multicastListStatus)
+{
+    std::vector<::uwb::UwbPeer> peersAdded;
+    for (const auto& peer : multicastListStatus.Status) {
+        if (peer.Status == UwbStatusMulticast::OkUpdate) {
+            peersAdded.push_back(::uwb::UwbPeer{ peer.ControleeMacAddress });
+        } else {
+            PLOG_VERBOSE << "peer has bad status: " << peer.ToString();
+        }
+    }
+
+    auto callbacks = ResolveEventCallbacks();
+    if (callbacks == nullptr) {
+        PLOG_WARNING << "missing session event callback for peer list changes, skipping";
+        return;
+    }
+
+    callbacks->OnSessionMembershipChanged(this, std::move(peersAdded), {});
+}
+
+void
+UwbSession::OnRangingData(const UwbRangingData& rangingData)
+{
+    auto callbacks = ResolveEventCallbacks();
+    if (callbacks == nullptr) {
+        PLOG_WARNING << "missing session event callback for ranging data, skipping";
+        return;
+    }
+
+    std::vector<::uwb::UwbPeer> peersChanged;
+    peersChanged.reserve(std::size(rangingData.RangingMeasurements));
+    for (const auto& rangingMeasurement : rangingData.RangingMeasurements) {
+        peersChanged.emplace_back(rangingMeasurement);
+    }
+
+    callbacks->OnPeerPropertiesChanged(this, std::move(peersChanged));
+}
+
+void
+UwbSession::ConfigureImpl(const std::vector<UwbApplicationConfigurationParameter> configParams)
+{
+    PLOG_VERBOSE << "ConfigureImpl";
+
+    ExecuteSessionCommand(*m_driver, m_sessionId, "initialize session", EncodeSessionInitCommand({ m_sessionId, UwbSessionType::RangingSession }), DecodeStatusResponse);
+    SetApplicationConfigurationParametersImpl(configParams);
+}
+
+void
+UwbSession::StartRangingImpl()
+{
+    try {
+        ExecuteSessionCommand(*m_driver, m_sessionId, "start ranging", EncodeRangeStartCommand(m_sessionId), DecodeStatusResponse);
+    } catch (...) {
+        m_rangingActive = false;
+        throw;
+    }
+}
+
+void
+UwbSession::StopRangingImpl()
+{
+    try {
+        ExecuteSessionCommand(*m_driver, m_sessionId, "stop ranging", EncodeRangeStopCommand(m_sessionId), DecodeStatusResponse);
+    } catch (...) {
+        m_rangingActive = true;
+        throw;
+    }
+}
+
+UwbStatus
+UwbSession::TryAddControleeImpl(::uwb::UwbMacAddress controleeMacAddress)
+{
+    PLOG_VERBOSE << "TryAddControleeImpl";
+
+    auto params = GetApplicationConfigurationParametersImpl({ UwbApplicationConfigurationParameterType::DestinationMacAddresses });
+    if (std::size(params) != 1 || !std::holds_alternative<std::unordered_set<::uwb::UwbMacAddress>>(params.front().Value)) {
+        throw std::runtime_error("GetApplicationConfigurationParameters() for DestinationMacAddresses returned bad data");
+    }
+
+    auto macAddresses = std::get<std::unordered_set<::uwb::UwbMacAddress>>(params.front().Value);
+    auto [_, inserted] = macAddresses.insert(controleeMacAddress);
+    if (!inserted) {
+        PLOG_INFO << "controleeMacAddress already added, skipping";
+        return UwbStatusSession::AddressAlreadyPresent;
+    }
+
+    UwbApplicationConfigurationParameter numControlees{ .Type = UwbApplicationConfigurationParameterType::NumberOfControlees, .Value = static_cast<uint8_t>(std::size(macAddresses)) };
+    UwbApplicationConfigurationParameter dstMacAddresses{ .Type = UwbApplicationConfigurationParameterType::DestinationMacAddresses, .Value = std::move(macAddresses) };
+    SetApplicationConfigurationParametersImpl({ std::move(numControlees), std::move(dstMacAddresses) });
+
+    return UwbStatusGeneric::Ok;
+}
+
+std::vector<UwbApplicationConfigurationParameter>
+UwbSession::GetApplicationConfigurationParametersImpl(std::vector<UwbApplicationConfigurationParameterType> requestedTypes)
+{
+    auto command = EncodeSessionGetAppConfigCommand({ m_sessionId, std::move(requestedTypes) });
+    auto response = ExecuteSessionCommand(*m_driver, m_sessionId, "obtain application configuration parameters", command, DecodeSessionGetAppConfigResponse);
+    return std::move(response.Parameters);
+}
+
+void
+UwbSession::SetApplicationConfigurationParametersImpl(std::vector<UwbApplicationConfigurationParameter> uwbApplicationConfigurationParameters)
+{
+    auto command = EncodeSessionSetAppConfigCommand({ m_sessionId, std::move(uwbApplicationConfigurationParameters) });
+    auto response = ExecuteSessionCommand(*m_driver, m_sessionId, "set application configuration parameters", command, [](std::span<const uint8_t> payload) {
+        auto decoded = DecodeSessionSetAppConfigResponse(payload);
+        if (decoded.has_value()) {
+            // Log each parameter the device rejected before the overall status is checked.
+            for (const auto& [statusSetParameter, applicationConfigurationParameterType] : decoded->ParameterStatuses) {
+                if (!IsUwbStatusOk(statusSetParameter)) {
+                    PLOG_ERROR << "failed to set application configuration parameter " << magic_enum::enum_name(applicationConfigurationParameterType) << ", status=" << ToString(statusSetParameter);
+                }
+            }
+        }
+        return decoded;
+    });
+}
+
+UwbSessionState
+UwbSession::GetSessionStateImpl()
+{
+    auto response = ExecuteSessionCommand(*m_driver, m_sessionId, "obtain session state", EncodeSessionGetStateCommand(m_sessionId), DecodeSessionGetStateResponse);
+    return response.State;
+}
+
+void
+UwbSession::DestroyImpl()
+{
+    ExecuteSessionCommand(*m_driver, m_sessionId, "deinitialize session", EncodeSessionDeinitCommand(m_sessionId), DecodeStatusResponse);
+}
@@ -4,22 +4,72 @@
 
 #include <cstdint>
 #include <memory>
+#include <string>
 
+#include <linux/uwb/UwbDeviceDriver.hxx>
 #include <uwb/UwbDevice.hxx>
 #include <uwb/UwbSessionEventCallbacks.hxx>
+#include <uwb/protocols/fira/FiraDevice.hxx>
 
-namespace linux
-{
-namespace devices
+namespace linux::devices
 {
+/**
+ * @brief Helper class to interact with Linux UWB devices which expose a UCI
+ * character device.
+ */
 class UwbDevice :
-    public uwb::UwbDevice
+    public uwb::UwbDevice,
+    public std::enable_shared_from_this<UwbDevice>
 {
-public:
+protected:
     /**
      * @brief Construct a new UwbDevice object.
+     *
+     * @param deviceName The path of the UCI character device.
+     */
+    explicit UwbDevice(std::string deviceName);
+
+    /**
+     * @brief Construct a new UwbDevice object which uses an existing driver.
+     *
+     * @param deviceName The name of the device.
+     * @param driver The driver to use.
      */
-    UwbDevice() = default;
+    UwbDevice(std::string deviceName, std::shared_ptr<UwbDeviceDriver> driver);
+
+public:
+    /**
+     * @brief Create a new UwbDevice object instance.
+     *
+     * @param deviceName The path of the UCI character device.
+     * @return std::shared_ptr<UwbDevice>
+     */
+    static std::shared_ptr<UwbDevice>
+    Create(std::string deviceName);
+
+    /**
+     * @brief Create a new UwbDevice object instance which uses an existing
+     * driver, for example one backed by a pty or socketpair.
+     *
+     * @param deviceName The name of the device.
+     * @param driver The driver to use.
+     * @return std::shared_ptr<UwbDevice>
+     */
+    static std::shared_ptr<UwbDevice>
+    Create(std::string deviceName, std::shared_ptr<UwbDeviceDriver> driver);
+
+    /**
+     * @brief Destroy the UwbDevice object, stopping the driver.
+     */
+    ~UwbDevice() override;
+
+    /**
+     * @brief Get the name of this device.
+     *
+     * @return const std::string&
+     */
+    const std::string&
+    DeviceName() const noexcept;
 
     /**
      * @brief Determine if this device is the same as another.
@@ -33,7 +83,7 @@ public:
 
 private:
     /**
-     * @brief Create a Session object
+     * @brief Create a new UWB session.
      *
      * @param sessionId
      * @param callbacks
@@ -43,9 +93,21 @@ private:
     CreateSessionImpl(uint32_t sessionId, std::weak_ptr<uwb::UwbSessionEventCallbacks> callbacks) override;
 
     /**
-     * @brief Get the capabilities of the device.
+     * @brief Attempt to resolve a session that already exists on the device.
+     *
+     * @param sessionId
+     * @return std::shared_ptr<uwb::UwbSession>
+     */
+    std::shared_ptr<uwb::UwbSession>
+    ResolveSessionImpl(uint32_t sessionId) override;
+
+    /**
+     * @brief Get the capabilities of the device. CORE_GET_CAPS_INFO is not
+     * supported, so this always fails.
      *
      * @return uwb::protocol::fira::UwbCapability
+     * @throws uwb::protocol::fira::UwbException With
+     * UwbStatusGeneric::Rejected.
      */
     uwb::protocol::fira::UwbCapability
     GetCapabilitiesImpl() override;
@@ -58,14 +120,56 @@ private:
     uwb::protocol::fira::UwbDeviceInformation
     GetDeviceInformationImpl() override;
 
+    /**
+     * @brief Get the number of sessions on the device.
+     *
+     * @return uint32_t
+     */
+    uint32_t
+    GetSessionCountImpl() override;
+
     /**
      * @brief Reset the device to an initial clean state.
      */
     void
     ResetImpl() override;
-};
 
-} // namespace devices
-} // namespace linux
+    /**
+     * @brief Get the driver used to communicate with the device.
+     *
+     * @return std::shared_ptr<UwbDeviceDriver>
+     * @throws uwb::protocol::fira::UwbException With
+     * UwbStatusGeneric::Rejected if the device was created without a driver
+     * and hasn't been initialized.
+     */
+    std::shared_ptr<UwbDeviceDriver>
+    GetDriver() const;
+
+    /**
+     * @brief Open the device, if needed, and start processing notifications.
+     *
+     * @return true
+     * @return false
+     */
+    bool
+    InitializeImpl() override;
+
+    /**
+     * @brief Dispatch a notification received from the device. Invoked on
+     * the driver's notification thread.
+     *
+     * @param notification The notification.
+     */
+    void
+    OnNotification(const uwb::protocol::fira::uci::ControlMessageView& notification);
+
+private:
+    const std::string m_deviceName;
+    std::shared_ptr<UwbDeviceDriver> m_driver;
+    // Only accessed on the driver's notification thread; reused so that
+    // decoding ranging data doesn't allocate once its capacity has grown.
+    uwb::protocol::fira::UwbRangingData m_rangingData{};
+};
+} // namespace linux::devices
 
 #endif // LINUX_DEVICE_UWB_HXX
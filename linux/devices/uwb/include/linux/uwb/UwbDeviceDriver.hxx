@@ -2,14 +2,266 @@
 #ifndef UWB_DEVICE_DRIVER_HXX
 #define UWB_DEVICE_DRIVER_HXX
 
-namespace linux
-{
-namespace devices
+#include <atomic>
+#include <chrono>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <notstd/task_queue.hxx>
+#include <uwb/protocols/fira/UwbException.hxx>
+#include <uwb/protocols/fira/uci/ControlMessage.hxx>
+
+namespace linux::devices
 {
-namespace uwb
+/**
+ * @brief Transport for exchanging UCI control messages with a UWB subsystem
+ * (UWBS) over a file descriptor.
+ *
+ * The file descriptor is typically a UCI character device exposed by a kernel
+ * driver, but can be anything that carries a stream of UCI control packets,
+ * such as a pty or a socketpair.
+ *
+ * A single reader thread waits on the file descriptor with epoll, reads into a
+ * receive buffer that is allocated once up front, and reassembles the packets
+ * into messages. Responses are matched to the outstanding command; UCI allows
+ * only one command to be outstanding at a time, so commands are serialized.
+ * Notifications are copied and passed to the handler provided to Start() on a
+ * separate notification thread, so the reader thread remains free to receive
+ * the responses to any commands the handler executes.
+ */
+class UwbDeviceDriver
 {
-}
-} // namespace devices
-} // namespace linux
+public:
+    /**
+     * @brief Handler invoked for each notification received from the UWBS.
+     *
+     * The handler runs on the notification thread, which invokes it for one
+     * notification at a time, in the order they were received. It may execute
+     * commands, but must not stop the driver. The message payload is only
+     * valid for the duration of the call.
+     */
+    using NotificationHandler = std::function<void(const uwb::protocol::fira::uci::ControlMessageView&)>;
+
+    /**
+     * @brief The size of the receive buffer; large enough to hold several
+     * maximum size control packets.
+     */
+    static constexpr std::size_t ReceiveBufferSize = 4 * (uwb::protocol::fira::uci::ControlPacketHeader::Size + uwb::protocol::fira::uci::ControlPacketHeader::PayloadLengthMaximum);
+
+    /**
+     * @brief The default time to wait for a response to a command.
+     */
+    static constexpr std::chrono::milliseconds CommandTimeoutDefault{ 2000 };
+
+    /**
+     * @brief Construct a new UwbDeviceDriver object.
+     *
+     * @param fd The file descriptor to use. The driver takes ownership of it
+     * and closes it upon destruction.
+     */
+    explicit UwbDeviceDriver(int fd);
+
+    /**
+     * @brief Create a driver for the UCI character device at the specified
+     * path.
+     *
+     * @param devicePath The path of the character device, eg. /dev/uci0.
+     * @return std::unique_ptr<UwbDeviceDriver>
+     * @throws std::system_error If the device could not be opened.
+     */
+    static std::unique_ptr<UwbDeviceDriver>
+    Open(const std::string& devicePath);
+
+    /**
+     * @brief Destroy the UwbDeviceDriver object, stopping the reader thread
+     * and closing the file descriptor.
+     */
+    ~UwbDeviceDriver();
+
+    UwbDeviceDriver(const UwbDeviceDriver&) = delete;
+    UwbDeviceDriver&
+    operator=(const UwbDeviceDriver&) = delete;
+    UwbDeviceDriver(UwbDeviceDriver&&) = delete;
+    UwbDeviceDriver&
+    operator=(UwbDeviceDriver&&) = delete;
+
+    /**
+     * @brief Start the reader and notification threads.
+     *
+     * @param notificationHandler The handler to invoke for each notification.
+     * @throws std::system_error If the driver is already started or the
+     * reader thread could not be set up.
+     */
+    void
+    Start(NotificationHandler notificationHandler);
+
+    /**
+     * @brief Stop the reader thread, failing any outstanding command, then
+     * stop the notification thread once it has delivered the notifications
+     * already received. Does nothing if the driver isn't started. This must
+     * not be called from the notification handler.
+     */
+    void
+    Stop() noexcept;
+
+    /**
+     * @brief Determines whether the reader thread is processing messages.
+     * This becomes false if the file descriptor is hung up.
+     *
+     * @return true
+     * @return false
+     */
+    bool
+    IsRunning() const noexcept;
+
+    /**
+     * @brief Send a command and wait for its response.
+     *
+     * @param command The command to send.
+     * @param timeout The time to wait for the response.
+     * @return uwb::protocol::fira::uci::ControlMessage The response.
+     * @throws std::system_error If the driver isn't running, the command
+     * couldn't be written, or no response was received in time
+     * (std::errc::timed_out).
+     */
+    uwb::protocol::fira::uci::ControlMessage
+    ExecuteCommand(const uwb::protocol::fira::uci::ControlMessage& command, std::chrono::milliseconds timeout = CommandTimeoutDefault);
+
+    /**
+     * @brief Send a command, wait for its response and decode it.
+     *
+     * @tparam DecodeFunctionT The type of the function to decode the
+     * response payload, which returns a std::optional.
+     * @param command The command to send.
+     * @param decode The function to decode the response payload.
+     * @param timeout The time to wait for the response.
+     * @return auto The decoded response.
+     * @throws uwb::protocol::fira::UwbException If the command failed
+     * (UwbStatusGeneric::Failed) or the response is malformed
+     * (UwbStatusGeneric::SyntaxError).
+     */
+    template <typename DecodeFunctionT>
+    requires std::invocable<DecodeFunctionT, std::span<const uint8_t>>
+    auto
+    ExecuteCommand(const uwb::protocol::fira::uci::ControlMessage& command, DecodeFunctionT decode, std::chrono::milliseconds timeout = CommandTimeoutDefault)
+    {
+        uwb::protocol::fira::uci::ControlMessage response;
+        try {
+            response = ExecuteCommand(command, timeout);
+        } catch (const std::system_error&) {
+            throw uwb::protocol::fira::UwbException(uwb::protocol::fira::UwbStatusGeneric::Failed);
+        }
+
+        auto result = decode(std::span<const uint8_t>{ response.Payload });
+        if (!result.has_value()) {
+            throw uwb::protocol::fira::UwbException(uwb::protocol::fira::UwbStatusGeneric::SyntaxError);
+        }
+
+        return std::move(result).value();
+    }
+
+    /**
+     * @brief Get the number of responses discarded because they didn't match
+     * the outstanding command, or arrived after it timed out.
+     *
+     * @return std::size_t
+     */
+    std::size_t
+    GetNumberOfResponsesDiscarded() const noexcept;
+
+private:
+    /**
+     * @brief Reader thread entry point.
+     */
+    void
+    ProcessMessages();
+
+    /**
+     * @brief Parse and dispatch the complete packets in the receive buffer,
+     * moving any trailing partial packet to the start of it. Unsupported data
+     * packets are skipped.
+     */
+    void
+    ProcessReceiveBuffer();
+
+    /**
+     * @brief Dispatch a complete message received from the UWBS.
+     *
+     * @param message The message.
+     */
+    void
+    OnMessage(const uwb::protocol::fira::uci::ControlMessageView& message);
+
+    /**
+     * @brief Pass a notification to the notification handler. Invoked on the
+     * notification thread.
+     *
+     * @param notification The notification.
+     */
+    void
+    OnNotification(const uwb::protocol::fira::uci::ControlMessage& notification);
+
+    /**
+     * @brief Fail the outstanding command, if any, and prevent further
+     * commands from being executed.
+     *
+     * @param error The error to fail the outstanding command with.
+     */
+    void
+    OnReaderStopped(std::error_code error);
+
+    /**
+     * @brief Write an encoded command to the file descriptor.
+     *
+     * @param data The data to write.
+     */
+    void
+    Write(std::span<const uint8_t> data);
+
+private:
+    /**
+     * @brief The group and opcode identifying a command.
+     */
+    struct CommandIdentifier
+    {
+        uint8_t Group;
+        uint8_t Opcode;
+    };
+
+    int m_fd{ -1 };
+    int m_fdEpoll{ -1 };
+    int m_fdEventStop{ -1 };
+    std::thread m_readerThread;
+    NotificationHandler m_notificationHandler;
+    std::unique_ptr<notstd::task_queue> m_notificationQueue;
+    std::shared_ptr<notstd::task_queue::dispatcher> m_notificationDispatcher;
+
+    std::vector<uint8_t> m_receiveBuffer;
+    std::size_t m_receiveBufferLength{ 0 };
+    std::size_t m_receiveSkipLength{ 0 };
+    uwb::protocol::fira::uci::ControlMessageReassembler m_reassembler;
+
+    std::mutex m_commandGate;
+    mutable std::mutex m_pendingCommandGate;
+    bool m_running{ false };
+    std::optional<CommandIdentifier> m_pendingCommand;
+    std::optional<CommandIdentifier> m_timedOutCommand;
+    std::promise<uwb::protocol::fira::uci::ControlMessage> m_pendingResponse;
+    std::atomic<std::size_t> m_numberOfResponsesDiscarded{ 0 };
+};
+
+} // namespace linux::devices
 
 #endif // UWB_DEVICE_DRIVER_HXX
@@ -0,0 +1,143 @@
+
+#ifndef LINUX_DEVICE_UWB_SESSION_HXX
+#define LINUX_DEVICE_UWB_SESSION_HXX
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <linux/uwb/UwbDeviceDriver.hxx>
+#include <uwb/UwbSession.hxx>
+#include <uwb/protocols/fira/FiraDevice.hxx>
+
+namespace uwb
+{
+class UwbDevice;
+}
+
+namespace linux::devices
+{
+/**
+ * @brief UWB session driven by UCI control messages exchanged with a UwbDeviceDriver.
+ */
+class UwbSession :
+    public ::uwb::UwbSession
+{
+public:
+    /**
+     * @brief Construct a new UwbSession object.
+     *
+     * @param sessionId The unique session identifier.
+     * @param device The parent device.
+     * @param driver The driver to send commands with.
+     * @param callbacks The event callback instance.
+     * @param deviceType The type of device for the session.
+     */
+    UwbSession(uint32_t sessionId, std::weak_ptr<::uwb::UwbDevice> device, std::shared_ptr<UwbDeviceDriver> driver, std::weak_ptr<::uwb::UwbSessionEventCallbacks> callbacks, ::uwb::protocol::fira::DeviceType deviceType = DeviceTypeDefault);
+
+    /**
+     * @brief Construct a new UwbSession object without callbacks.
+     *
+     * @param sessionId The unique session identifier.
+     * @param device The parent device.
+     * @param driver The driver to send commands with.
+     * @param deviceType The type of device for the session.
+     */
+    UwbSession(uint32_t sessionId, std::weak_ptr<::uwb::UwbDevice> device, std::shared_ptr<UwbDeviceDriver> driver, ::uwb::protocol::fira::DeviceType deviceType = DeviceTypeDefault);
+
+    /**
+     * @brief Invoked by the parent device when a SESSION_STATUS_NTF is
+     * received for this session.
+     *
+     * @param sessionStatus The new status of the session.
+     */
+    void
+    OnSessionStatus(const ::uwb::protocol::fira::UwbSessionStatus& sessionStatus);
+
+    /**
+     * @brief Invoked by the parent device when a
+     * SESSION_UPDATE_CONTROLLER_MULTICAST_LIST_NTF is received for this
+     * session.
+     *
+     * @param multicastListStatus The status of the multicast list update.
+     */
+    void
+    OnMulticastListStatus(const ::uwb::protocol::fira::UwbSessionUpdateMulticastListStatus& multicastListStatus);
+
+    /**
+     * @brief Invoked by the parent device when a RANGE_DATA_NTF is received
+     * for this session.
+     *
+     * @param rangingData The ranging data. This is only valid for the duration
+     * of the call.
+     */
+    void
+    OnRangingData(const ::uwb::protocol::fira::UwbRangingData& rangingData);
+
+private:
+    /**
+     * @brief Configures the session for use.
+     *
+     * @param configParams The application configuration parameters to set.
+     */
+    void
+    ConfigureImpl(const std::vector<::uwb::protocol::fira::UwbApplicationConfigurationParameter> configParams) override;
+
+    /**
+     * @brief Start ranging.
+     */
+    void
+    StartRangingImpl() override;
+
+    /**
+     * @brief Stop ranging.
+     */
+    void
+    StopRangingImpl() override;
+
+    /**
+     * @brief Try to add a new peer to the session.
+     *
+     * @param controleeMacAddress The mac address of the new peer.
+     * @return ::uwb::protocol::fira::UwbStatus
+     */
+    ::uwb::protocol::fira::UwbStatus
+    TryAddControleeImpl(::uwb::UwbMacAddress controleeMacAddress) override;
+
+    /**
+     * @brief Get the application configuration parameters of the session.
+     *
+     * @param requestedTypes The types of parameters to get.
+     * @return std::vector<::uwb::protocol::fira::UwbApplicationConfigurationParameter>
+     */
+    std::vector<::uwb::protocol::fira::UwbApplicationConfigurationParameter>
+    GetApplicationConfigurationParametersImpl(std::vector<::uwb::protocol::fira::UwbApplicationConfigurationParameterType> requestedTypes) override;
+
+    /**
+     * @brief Set the application configuration parameters of the session.
+     *
+     * @param uwbApplicationConfigurationParameters The parameters to set.
+     */
+    void
+    SetApplicationConfigurationParametersImpl(std::vector<::uwb::protocol::fira::UwbApplicationConfigurationParameter> uwbApplicationConfigurationParameters) override;
+
+    /**
+     * @brief Get the current state of the session.
+     *
+     * @return ::uwb::protocol::fira::UwbSessionState
+     */
+    ::uwb::protocol::fira::UwbSessionState
+    GetSessionStateImpl() override;
+
+    /**
+     * @brief Deinitialize the session.
+     */
+    void
+    DestroyImpl() override;
+
+private:
+    std::shared_ptr<UwbDeviceDriver> m_driver;
+};
+} // namespace linux::devices
+
+#endif // LINUX_DEVICE_UWB_SESSION_HXX
@@ -0,0 +1,78 @@
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <notstd/flextype_wrapper.hxx>
+
+namespace notstd::test
+{
+/**
+ * @brief A single ranging measurement, shaped like those reported by UWB
+ * drivers in a flex-array.
+ */
+struct RangingMeasurement
+{
+    uint16_t MacAddress;
+    uint8_t Status;
+    uint8_t LineOfSight;
+    uint16_t Distance;
+    int16_t AoaAzimuth;
+    int16_t AoaElevation;
+    uint8_t AoaAzimuthFigureOfMerit;
+    uint8_t AoaElevationFigureOfMerit;
+};
+
+/**
+ * @brief Ranging data with a trailing flex-array of measurements.
+ */
+struct RangingData
+{
+    uint32_t SessionId;
+    uint32_t SequenceNumber;
+    std::size_t NumMeasurements;
+    RangingMeasurement Measurements[1];
+};
+
+using RangingDataWrapper = notstd::flextype_wrapper<RangingData>;
+} // namespace notstd::test
+
+TEST_CASE("flextype_wrapper construction and copy", "[notstd][shared][utility][flextype_wrapper]")
+{
+    using namespace notstd::test;
+
+    for (const std::size_t numMeasurements : { 1, 8, 64 }) {
+        const auto suffix = " (" + std::to_string(numMeasurements) + " elements)";
+
+        BENCHMARK("from_num_elements" + suffix)
+        {
+            return RangingDataWrapper::from_num_elements<RangingMeasurement>(numMeasurements);
+        };
+
+        BENCHMARK_ADVANCED("copy construction" + suffix)(Catch::Benchmark::Chronometer meter)
+        {
+            auto wrapper = RangingDataWrapper::from_num_elements<RangingMeasurement>(numMeasurements);
+            RangingData& rangingData = wrapper;
+            rangingData.NumMeasurements = numMeasurements;
+            meter.measure([&] {
+                return RangingDataWrapper{ wrapper };
+            });
+        };
+
+        BENCHMARK_ADVANCED("move construction" + suffix)(Catch::Benchmark::Chronometer meter)
+        {
+            std::vector<std::optional<RangingDataWrapper>> wrappers(static_cast<std::size_t>(meter.runs()));
+            for (auto& wrapper : wrappers) {
+                wrapper.emplace(RangingDataWrapper::from_num_elements<RangingMeasurement>(numMeasurements));
+            }
+            meter.measure([&](int run) {
+                return RangingDataWrapper{ std::move(*wrappers[static_cast<std::size_t>(run)]) };
+            });
+        };
+    }
+}
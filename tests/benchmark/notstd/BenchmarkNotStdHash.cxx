@@ -0,0 +1,142 @@
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <notstd/hash.hxx>
+#include <uwb/UwbMacAddress.hxx>
+#include <uwb/protocols/fira/StaticRangingInfo.hxx>
+
+namespace notstd::test
+{
+/**
+ * @brief The number of keys hashed by each benchmark, so the per-key cost is
+ * large enough to measure reliably.
+ */
+static constexpr std::size_t NumKeys = 1024;
+
+/**
+ * @brief Key identifying a peer within a ranging session, as used to look up
+ * per-peer state when processing ranging data.
+ */
+struct SessionPeerKey
+{
+    uint32_t SessionId;
+    uint16_t ShortAddress;
+};
+
+/**
+ * @brief Creates a set of random addresses.
+ *
+ * @tparam AddressType The type of address to create.
+ * @return std::vector<uwb::UwbMacAddress>
+ */
+template <uwb::UwbMacAddressType AddressType>
+std::vector<uwb::UwbMacAddress>
+MakeAddresses()
+{
+    std::vector<uwb::UwbMacAddress> addresses{};
+    addresses.reserve(NumKeys);
+    for (std::size_t i = 0; i < NumKeys; i++) {
+        addresses.push_back(uwb::UwbMacAddress::Random<AddressType>());
+    }
+
+    return addresses;
+}
+} // namespace notstd::test
+
+TEST_CASE("hash_combine and hash_range over uwb key types", "[notstd][shared][utility][hash]")
+{
+    using namespace notstd::test;
+
+    BENCHMARK_ADVANCED("hash_combine, session id and short address (x" + std::to_string(NumKeys) + ")")(Catch::Benchmark::Chronometer meter)
+    {
+        std::vector<SessionPeerKey> keys(NumKeys);
+        for (std::size_t i = 0; i < NumKeys; i++) {
+            keys[i] = { static_cast<uint32_t>(0x10000000U + i), static_cast<uint16_t>(i * 7) };
+        }
+        meter.measure([&] {
+            std::size_t result = 0;
+            for (const auto& key : keys) {
+                std::size_t seed = 0;
+                notstd::hash_combine(seed, key.SessionId, key.ShortAddress);
+                result ^= seed;
+            }
+            return result;
+        });
+    };
+
+    BENCHMARK_ADVANCED("hash_range, short mac address (x" + std::to_string(NumKeys) + ")")(Catch::Benchmark::Chronometer meter)
+    {
+        const auto addresses = MakeAddresses<uwb::UwbMacAddressType::Short>();
+        meter.measure([&] {
+            std::size_t result = 0;
+            for (const auto& address : addresses) {
+                result ^= std::hash<uwb::UwbMacAddress>{}(address);
+            }
+            return result;
+        });
+    };
+
+    BENCHMARK_ADVANCED("hash_range, extended mac address (x" + std::to_string(NumKeys) + ")")(Catch::Benchmark::Chronometer meter)
+    {
+        const auto addresses = MakeAddresses<uwb::UwbMacAddressType::Extended>();
+        meter.measure([&] {
+            std::size_t result = 0;
+            for (const auto& address : addresses) {
+                result ^= std::hash<uwb::UwbMacAddress>{}(address);
+            }
+            return result;
+        });
+    };
+
+    BENCHMARK_ADVANCED("hash_range, 16 byte session key (x" + std::to_string(NumKeys) + ")")(Catch::Benchmark::Chronometer meter)
+    {
+        std::vector<std::array<uint8_t, 16>> sessionKeys(NumKeys);
+        for (std::size_t i = 0; i < NumKeys; i++) {
+            sessionKeys[i].fill(static_cast<uint8_t>(i));
+        }
+        meter.measure([&] {
+            std::size_t result = 0;
+            for (const auto& sessionKey : sessionKeys) {
+                result ^= notstd::hash_range(std::cbegin(sessionKey), std::cend(sessionKey));
+            }
+            return result;
+        });
+    };
+
+    BENCHMARK_ADVANCED("hash_combine, static ranging info (x" + std::to_string(NumKeys) + ")")(Catch::Benchmark::Chronometer meter)
+    {
+        std::vector<uwb::protocol::fira::StaticRangingInfo> staticRangingInfos(NumKeys);
+        for (std::size_t i = 0; i < NumKeys; i++) {
+            staticRangingInfos[i].VendorId = static_cast<uint16_t>(i);
+            staticRangingInfos[i].InitializationVector.fill(static_cast<uint8_t>(i));
+        }
+        meter.measure([&] {
+            std::size_t result = 0;
+            for (const auto& staticRangingInfo : staticRangingInfos) {
+                result ^= std::hash<uwb::protocol::fira::StaticRangingInfo>{}(staticRangingInfo);
+            }
+            return result;
+        });
+    };
+
+    BENCHMARK_ADVANCED("unordered_set lookup, extended mac address (x" + std::to_string(NumKeys) + ")")(Catch::Benchmark::Chronometer meter)
+    {
+        const auto addresses = MakeAddresses<uwb::UwbMacAddressType::Extended>();
+        const std::unordered_set<uwb::UwbMacAddress> addressSet(std::cbegin(addresses), std::cend(addresses));
+        meter.measure([&] {
+            std::size_t numFound = 0;
+            for (const auto& address : addresses) {
+                numFound += addressSet.count(address);
+            }
+            return numFound;
+        });
+    };
+}
@@ -0,0 +1,244 @@
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <notstd/histogram.hxx>
+#include <notstd/task_queue.hxx>
+
+namespace notstd::test
+{
+/**
+ * @brief The maximum number of producer threads posting concurrently.
+ */
+static constexpr std::size_t NumProducersMaximum = 8;
+
+/**
+ * @brief The number of tasks posted by each producer per iteration.
+ */
+static constexpr std::size_t NumTasksPerProducer = 10000;
+
+/**
+ * @brief Get a name for a task queue backend for use in benchmark names.
+ *
+ * @param backend The backend.
+ * @return std::string
+ */
+std::string
+BackendName(notstd::task_queue::queue_backend backend)
+{
+    return (backend == notstd::task_queue::queue_backend::locked) ? "locked" : "lock-free";
+}
+
+/**
+ * @brief Posts tasks to a queue from a number of threads concurrently, waiting
+ * for the threads to finish.
+ *
+ * @tparam PostFnT The type of function used to post a task.
+ * @param numProducers The number of threads to post from.
+ * @param post The function each thread calls to post one task.
+ */
+template <typename PostFnT>
+void
+PostConcurrently(std::size_t numProducers, PostFnT post)
+{
+    std::vector<std::thread> producers{};
+    producers.reserve(numProducers);
+    for (std::size_t producer = 0; producer < numProducers; producer++) {
+        producers.emplace_back([&post] {
+            for (std::size_t i = 0; i < NumTasksPerProducer; i++) {
+                post();
+            }
+        });
+    }
+    for (auto& producer : producers) {
+        producer.join();
+    }
+}
+
+/**
+ * @brief A task queue whose worker thread is blocked, so that tasks posted to
+ * it remain pending until it's released.
+ */
+struct BlockedTaskQueue
+{
+    // The lock-free backend blocks producers once a ring is full, so size the
+    // rings to hold all of the pending tasks.
+    BlockedTaskQueue(notstd::task_queue::queue_backend backend, std::size_t numTasksPending) :
+        Queue(std::make_unique<notstd::task_queue>(backend, numTasksPending))
+    {
+        auto dispatcher = Queue->get_dispatcher();
+        dispatcher->post_detached([this, release = Release.get_future()] {
+            Started.set_value();
+            release.wait();
+        }, notstd::task_queue::task_priority::control);
+        Started.get_future().wait();
+
+        for (std::size_t i = 0; i < numTasksPending; i++) {
+            dispatcher->post_detached([] {});
+        }
+    }
+
+    std::promise<void> Started{};
+    std::promise<void> Release{};
+    std::unique_ptr<notstd::task_queue> Queue;
+};
+} // namespace notstd::test
+
+TEST_CASE("task queue post latency", "[notstd][shared][utility][task_queue]")
+{
+    using notstd::task_queue;
+    using namespace notstd::test;
+
+    for (const auto backend : { task_queue::queue_backend::locked, task_queue::queue_backend::lock_free }) {
+        const auto backendName = BackendName(backend);
+
+        BENCHMARK_ADVANCED("post (" + backendName + ")")(Catch::Benchmark::Chronometer meter)
+        {
+            task_queue taskQueue{ backend };
+            auto dispatcher = taskQueue.get_dispatcher();
+            meter.measure([&] {
+                return dispatcher->post([] {});
+            });
+        };
+
+        BENCHMARK_ADVANCED("post_detached (" + backendName + ")")(Catch::Benchmark::Chronometer meter)
+        {
+            task_queue taskQueue{ backend };
+            auto dispatcher = taskQueue.get_dispatcher();
+            meter.measure([&] {
+                dispatcher->post_detached([] {});
+            });
+        };
+
+        BENCHMARK_ADVANCED("post and wait round trip (" + backendName + ")")(Catch::Benchmark::Chronometer meter)
+        {
+            task_queue taskQueue{ backend };
+            auto dispatcher = taskQueue.get_dispatcher();
+            meter.measure([&] {
+                dispatcher->post([] {}).wait();
+            });
+        };
+    }
+}
+
+TEST_CASE("task queue post and drain throughput", "[notstd][shared][utility][task_queue]")
+{
+    using notstd::task_queue;
+    using namespace notstd::test;
+
+    for (const auto backend : { task_queue::queue_backend::locked, task_queue::queue_backend::lock_free }) {
+        const auto backendName = BackendName(backend);
+
+        for (std::size_t numProducers = 1; numProducers <= NumProducersMaximum; numProducers *= 2) {
+            const auto suffix = ", " + std::to_string(numProducers) + " producers x " + std::to_string(NumTasksPerProducer) + " tasks (" + backendName + ")";
+
+            BENCHMARK("post" + suffix)
+            {
+                task_queue taskQueue{ backend };
+                auto dispatcher = taskQueue.get_dispatcher();
+                PostConcurrently(numProducers, [&] {
+                    dispatcher->post([] {});
+                });
+                taskQueue.stop_and_wait_for_task_completion();
+            };
+
+            BENCHMARK("post_detached" + suffix)
+            {
+                task_queue taskQueue{ backend };
+                auto dispatcher = taskQueue.get_dispatcher();
+                PostConcurrently(numProducers, [&] {
+                    dispatcher->post_detached([] {});
+                });
+                taskQueue.stop_and_wait_for_task_completion();
+            };
+        }
+    }
+}
+
+TEST_CASE("task queue stop and cancel cost", "[notstd][shared][utility][task_queue]")
+{
+    using notstd::task_queue;
+    using namespace notstd::test;
+
+    static constexpr std::size_t NumTasksPending = 4096;
+
+    for (const auto backend : { task_queue::queue_backend::locked, task_queue::queue_backend::lock_free }) {
+        const auto suffix = " with " + std::to_string(NumTasksPending) + " pending tasks (" + BackendName(backend) + ")";
+
+        BENCHMARK_ADVANCED("stop and drain" + suffix)(Catch::Benchmark::Chronometer meter)
+        {
+            std::vector<std::unique_ptr<BlockedTaskQueue>> queues{};
+            for (int run = 0; run < meter.runs(); run++) {
+                queues.push_back(std::make_unique<BlockedTaskQueue>(backend, NumTasksPending));
+            }
+            meter.measure([&](int run) {
+                auto& queue = *queues[static_cast<std::size_t>(run)];
+                queue.Release.set_value();
+                queue.Queue->stop_and_wait_for_task_completion();
+            });
+        };
+
+        BENCHMARK_ADVANCED("cancel and destroy" + suffix)(Catch::Benchmark::Chronometer meter)
+        {
+            std::vector<std::unique_ptr<BlockedTaskQueue>> queues{};
+            for (int run = 0; run < meter.runs(); run++) {
+                queues.push_back(std::make_unique<BlockedTaskQueue>(backend, NumTasksPending));
+            }
+            meter.measure([&](int run) {
+                auto& queue = *queues[static_cast<std::size_t>(run)];
+                queue.Queue->stop(task_queue::pending_task_action::cancel);
+                queue.Release.set_value();
+                queue.Queue.reset();
+            });
+        };
+    }
+}
+
+TEST_CASE("task queue post to run tail latency", "[notstd][shared][utility][task_queue]")
+{
+    using notstd::histogram;
+    using notstd::task_queue;
+    using namespace notstd::test;
+
+    // Report the time between posting each task and it starting to run, as a
+    // distribution rather than the mean reported by the benchmarks above.
+    std::cout << std::left << std::setw(40) << "post to run latency (ns)" << std::right
+              << std::setw(10) << "p50" << std::setw(10) << "p90" << std::setw(10) << "p99"
+              << std::setw(10) << "p99.9" << std::setw(12) << "max" << '\n';
+
+    for (const auto backend : { task_queue::queue_backend::locked, task_queue::queue_backend::lock_free }) {
+        for (std::size_t numProducers = 1; numProducers <= NumProducersMaximum; numProducers *= 2) {
+            // Only recorded from the worker thread.
+            histogram latencies{};
+            task_queue taskQueue{ backend };
+            auto dispatcher = taskQueue.get_dispatcher();
+            PostConcurrently(numProducers, [&] {
+                dispatcher->post_detached([&latencies, posted = task_queue::clock::now()] {
+                    latencies.record(static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(task_queue::clock::now() - posted).count()));
+                });
+            });
+            taskQueue.stop_and_wait_for_task_completion();
+
+            const auto snapshot = latencies.get_snapshot();
+            REQUIRE(snapshot.count == numProducers * NumTasksPerProducer);
+
+            const auto name = std::to_string(numProducers) + " producers (" + BackendName(backend) + ")";
+            std::cout << std::left << std::setw(40) << name << std::right
+                      << std::setw(10) << snapshot.value_at_percentile(50)
+                      << std::setw(10) << snapshot.value_at_percentile(90)
+                      << std::setw(10) << snapshot.value_at_percentile(99)
+                      << std::setw(10) << snapshot.value_at_percentile(99.9)
+                      << std::setw(12) << snapshot.max << '\n';
+        }
+    }
+}
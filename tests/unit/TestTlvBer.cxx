@@ -1,10 +1,16 @@
 
 #include <algorithm>
+#include <array>
 #include <chrono>
 #include <climits>
 #include <cstdint>
 #include <iterator>
+#include <memory_resource>
+#include <new>
+#include <optional>
 #include <random>
+#include <span>
+#include <thread>
 #include <vector>
 
 #include <notstd/unique_ptr_out.hxx>
@@ -464,6 +470,443 @@ TEST_CASE("test TlvBer", "[basic][infra]")
         auto pValuesConstructedCopy = tlvBerCopy.GetValues();
         REQUIRE(std::equal(std::cbegin(pValuesConstructed), std::cend(pValuesConstructed), std::cbegin(pValuesConstructedCopy)));
     }
+
+    SECTION("GetLengthEncodingSize matches the size of GetLengthEncoding")
+    {
+        for (const std::size_t length : { std::size_t{ 0 }, std::size_t{ 127 }, minSizeForTwoLengthOctets, minSizeForThreeLengthOctets - 1, minSizeForThreeLengthOctets, minSizeForFourLengthOctets, minSizeForFiveLengthOctets }) {
+            REQUIRE(TlvBer::GetLengthEncodingSize(length) == TlvBer::GetLengthEncoding(length).size());
+        }
+    }
+
+    SECTION("Encode into a buffer matches ToBytes for a two level constructed tlv")
+    {
+        const auto valueLarge = encoding::test::getOctets(minSizeForThreeLengthOctets);
+        TlvBer::Builder builder{};
+        auto child = builder
+                         .SetTag(tagTwoBytesPrimitive)
+                         .SetValue(valueTwoBytes)
+                         .Build();
+        auto childLarge = builder
+                              .Reset()
+                              .SetTag(tagThreeBytesPrimitive)
+                              .SetValue(valueLarge)
+                              .Build();
+        auto parent = builder
+                          .Reset()
+                          .SetTag(tagTwoBytesConstructed)
+                          .AddTlv(child)
+                          .AddTlv(childLarge)
+                          .Build();
+        auto parentparent = builder
+                                .Reset()
+                                .SetTag(tagTwoBytesConstructed)
+                                .AddTlv(child)
+                                .AddTlv(parent)
+                                .Build();
+
+        const auto bytes = parentparent.ToBytes();
+        REQUIRE(parentparent.EncodedSize() == bytes.size());
+
+        std::vector<uint8_t> buffer(parentparent.EncodedSize() + 1, 0xEE);
+        REQUIRE(parentparent.Encode(buffer) == bytes.size());
+        REQUIRE(std::equal(std::cbegin(bytes), std::cend(bytes), std::cbegin(buffer)));
+        REQUIRE(buffer.back() == 0xEE);
+
+        std::vector<uint8_t> output;
+        parentparent.Encode(std::back_inserter(output));
+        REQUIRE(output == bytes);
+
+        std::unique_ptr<TlvBer> tlvParsed;
+        REQUIRE(TlvBer::Parse(notstd::unique_ptr_out(tlvParsed), output) == Tlv::ParseResult::Succeeded);
+        REQUIRE(*tlvParsed == parentparent);
+    }
+
+    SECTION("Encode into a buffer that is too small throws")
+    {
+        TlvBer::Builder builder{};
+        auto tlvBer = builder
+                          .SetTag(tagTwoBytesPrimitive)
+                          .SetValue(valueFiveBytes)
+                          .Build();
+        std::vector<uint8_t> buffer(tlvBer.EncodedSize() - 1);
+        REQUIRE_THROWS_AS(tlvBer.Encode(buffer), std::length_error);
+    }
+}
+
+TEST_CASE("TlvBer supports polymorphic allocators", "[basic][infra]")
+{
+    static constexpr std::array<uint8_t, 2> tagTwoBytesConstructed{ 0xFF, 0x24 };
+    static constexpr std::array<uint8_t, 3> valueThreeBytes{ 0x91, 0x92, 0x93 };
+
+    // Back the arena with the null memory resource so any allocation that
+    // escapes the arena throws.
+    std::array<std::byte, 4096> arenaBuffer{};
+    std::pmr::monotonic_buffer_resource arena{ std::data(arenaBuffer), std::size(arenaBuffer), std::pmr::null_memory_resource() };
+    const TlvBer::allocator_type allocator{ &arena };
+
+    const auto requireAllocatedFromArena = [&](const TlvBer& tlv) {
+        REQUIRE(tlv.get_allocator() == allocator);
+        for (const auto& value : tlv.GetValues()) {
+            REQUIRE(value.get_allocator() == allocator);
+        }
+    };
+
+    SECTION("Builder allocates the built tree from the arena")
+    {
+        TlvBer::Builder builder{ allocator };
+        auto child = builder.SetTag(0x80).SetValue(valueThreeBytes).Build();
+        auto parent = builder.Reset().SetTag(tagTwoBytesConstructed).AddTlv(child).AddTlv(child).Build();
+
+        REQUIRE(builder.get_allocator() == allocator);
+        requireAllocatedFromArena(child);
+        requireAllocatedFromArena(parent);
+        REQUIRE(parent.GetValues().size() == 2);
+        REQUIRE(std::ranges::equal(parent.GetValues()[1].GetValue(), valueThreeBytes));
+    }
+
+    SECTION("Parse allocates the parsed tree from the arena of the output")
+    {
+        TlvBer::Builder builder{};
+        auto child = builder.SetTag(0x80).SetValue(valueThreeBytes).Build();
+        auto parent = builder.Reset().SetTag(tagTwoBytesConstructed).AddTlv(child).AddTlv(child).Build();
+        auto bytes = parent.ToBytes();
+
+        TlvBer tlvParsed{ allocator };
+        std::size_t bytesParsed = 0;
+        REQUIRE(TlvBer::Parse(tlvParsed, bytes, bytesParsed) == Tlv::ParseResult::Succeeded);
+        requireAllocatedFromArena(tlvParsed);
+        REQUIRE(tlvParsed == parent);
+    }
+
+    SECTION("copies keep referring to their own storage")
+    {
+        TlvBer::Builder builder{ allocator };
+        auto child = builder.SetTag(0x80).SetValue(valueThreeBytes).Build();
+
+        const TlvBer copy{ child };
+        REQUIRE(copy.get_allocator() == TlvBer::allocator_type{});
+        REQUIRE(copy.Value.data() == copy.GetValue().data());
+        REQUIRE(copy.Value.data() != child.Value.data());
+
+        const TlvBer copyInArena{ copy, allocator };
+        REQUIRE(copyInArena.get_allocator() == allocator);
+        REQUIRE(copyInArena.Tag.data() == copyInArena.GetTag().data());
+        REQUIRE(copyInArena == child);
+    }
+}
+
+TEST_CASE("TlvBer stores tags and short values inline", "[basic][infra]")
+{
+    static constexpr std::array<uint8_t, 3> tagThreeBytes{ 0xDF, 0x81, 0x01 };
+
+    // Any allocation from the null memory resource throws.
+    const TlvBer::allocator_type allocatorNull{ std::pmr::null_memory_resource() };
+
+    SECTION("tags and values up to the inline capacity do not allocate")
+    {
+        const std::vector<uint8_t> value(TlvBer::ValueInlineCapacity, 0xA5);
+        std::optional<TlvBer> tlv;
+        REQUIRE_NOTHROW(tlv.emplace(TlvBer::Class::Private, TlvBer::Type::Primitive, 0x81U, tagThreeBytes, value, allocatorNull));
+        REQUIRE(std::ranges::equal(tlv->GetTag(), tagThreeBytes));
+        REQUIRE(std::ranges::equal(tlv->GetValue(), value));
+
+        // Moving copies the inline storage, so the views must follow it.
+        TlvBer tlvMoved{ std::move(*tlv), allocatorNull };
+        REQUIRE(tlvMoved.Tag.data() == tlvMoved.GetTag().data());
+        REQUIRE(tlvMoved.Value.data() == tlvMoved.GetValue().data());
+        REQUIRE(std::ranges::equal(tlvMoved.Value, value));
+    }
+
+    SECTION("values exceeding the inline capacity are allocated")
+    {
+        const std::vector<uint8_t> value(TlvBer::ValueInlineCapacity + 1, 0xA5);
+        REQUIRE_THROWS_AS((TlvBer{ TlvBer::Class::Private, TlvBer::Type::Primitive, 0x81U, tagThreeBytes, value, allocatorNull }), std::bad_alloc);
+
+        const TlvBer tlv{ TlvBer::Class::Private, TlvBer::Type::Primitive, 0x81U, tagThreeBytes, value };
+        REQUIRE(std::ranges::equal(tlv.GetValue(), value));
+        TlvBer tlvCopy{ tlv };
+        REQUIRE(tlvCopy == tlv);
+        tlvCopy = TlvBer{ TlvBer::Class::ContextSpecific, TlvBer::Type::Primitive, 0U, std::array<uint8_t, 1>{ 0x80 }, std::array<uint8_t, 1>{ 0x01 } };
+        REQUIRE(tlvCopy.GetValue().size() == 1);
+        REQUIRE(tlvCopy.Value.data() == tlvCopy.GetValue().data());
+    }
+
+    SECTION("setting the tag of a builder replaces the previous tag")
+    {
+        TlvBer::Builder builder{};
+        auto tlv = builder.SetTag(tagThreeBytes).SetTag(0x80).SetValue(0x01).Build();
+        REQUIRE(tlv.GetTag().size() == 1);
+        REQUIRE(tlv.GetTag()[0] == 0x80);
+    }
+}
+
+TEST_CASE("TlvBer nested tlvs can be found by tag", "[basic][infra]")
+{
+    static constexpr std::array<uint8_t, 2> tagTwoBytesConstructed{ 0xBF, 0x78 };
+    static constexpr std::array<uint8_t, 2> tagTwoBytesPrimitive{ 0x9F, 0x20 };
+
+    TlvBer::Builder builder{};
+    auto child80 = builder.SetTag(0x80).SetValue(0x01).Build();
+    auto child81 = builder.Reset().SetTag(0x81).SetValue(0x02).Build();
+    auto child9F20 = builder.Reset().SetTag(tagTwoBytesPrimitive).SetValue(0x03).Build();
+    auto parentSmall = builder.Reset().SetTag(0xA3).AddTlv(child80).AddTlv(child81).Build();
+    auto parentNested = builder.Reset().SetTag(tagTwoBytesConstructed).AddTlv(child80).AddTlv(parentSmall).AddTlv(child9F20).Build();
+
+    SECTION("tag values are the tag octets in big-endian order")
+    {
+        REQUIRE(child80.GetTagValue() == 0x80);
+        REQUIRE(child9F20.GetTagValue() == 0x9F20);
+        REQUIRE(parentNested.GetTagValue() == 0xBF78);
+    }
+
+    SECTION("Find works without an index")
+    {
+        REQUIRE(parentSmall.Find(0x81) != nullptr);
+        REQUIRE(*parentSmall.Find(0x81) == child81);
+        REQUIRE(parentSmall.Find(0x82) == nullptr);
+        REQUIRE(child80.Find(0x80) == nullptr);
+    }
+
+    SECTION("Find and FindAll work with an index")
+    {
+        // Enough nested tlvs to require an index, including repeated tags.
+        TlvBer::Builder builderLarge{};
+        builderLarge.SetTag(tagTwoBytesConstructed);
+        for (uint8_t i = 0; i < 12; i++) {
+            builderLarge.AddTlv(builder.Reset().SetTag(0x81).SetValue(i).Build());
+        }
+        auto tlv = builderLarge.AddTlv(child9F20).AddTlv(parentSmall).Build();
+
+        REQUIRE(tlv.Find(0x9F20) == &tlv.GetValues()[12]);
+        REQUIRE(tlv.Find(0xA3) == &tlv.GetValues()[13]);
+        REQUIRE(tlv.Find(0x81) == &tlv.GetValues()[0]);
+        REQUIRE(tlv.Find(0x82) == nullptr);
+
+        const auto values81 = tlv.FindAll(0x81);
+        REQUIRE(values81.size() == 12);
+        for (std::size_t i = 0; i < values81.size(); i++) {
+            REQUIRE(values81[i]->GetValue()[0] == i);
+        }
+        REQUIRE(tlv.FindAll(0x82).empty());
+
+        // Copies must build their own index referring to their own nested tlvs.
+        const TlvBer tlvCopy{ tlv };
+        REQUIRE(tlvCopy.Find(0xA3) == &tlvCopy.GetValues()[13]);
+        const TlvBer tlvMoved{ std::move(tlv) };
+        REQUIRE(tlvMoved.Find(0xA3) == &tlvMoved.GetValues()[13]);
+
+        // Lookups don't modify the object, so they may be made concurrently.
+        std::vector<const TlvBer*> found(4);
+        {
+            std::vector<std::jthread> threads{};
+            for (std::size_t i = 0; i < found.size(); i++) {
+                threads.emplace_back([&, i] {
+                    found[i] = tlvCopy.Find(0xA3);
+                });
+            }
+        }
+        REQUIRE(std::ranges::all_of(found, [&](const auto* value) {
+            return value == &tlvCopy.GetValues()[13];
+        }));
+    }
+
+    SECTION("Find follows a path of tags")
+    {
+        REQUIRE(parentNested.Find({ 0xA3, 0x81 }) != nullptr);
+        REQUIRE(*parentNested.Find({ 0xA3, 0x81 }) == child81);
+        REQUIRE(parentNested.Find({ 0xA3, 0x82 }) == nullptr);
+        REQUIRE(parentNested.Find({ 0x80, 0x81 }) == nullptr);
+        REQUIRE(parentNested.Find({ 0x9F20 }) == &parentNested.GetValues()[2]);
+    }
+
+    SECTION("Find follows a path of tags beginning with the root tag")
+    {
+        REQUIRE(parentNested.Find({ 0xBF78, 0xA3, 0x81 }) != nullptr);
+        REQUIRE(parentNested.Find({ 0xBF78, 0xA3, 0x81 }) == parentNested.Find({ 0xA3, 0x81 }));
+        REQUIRE(parentNested.Find({ 0xBF78, 0xA3, 0x82 }) == nullptr);
+        REQUIRE(parentNested.Find({ 0xBF78 }) == &parentNested);
+        REQUIRE(parentSmall.Find({ 0xBF78, 0x81 }) == nullptr);
+
+        // Nested tlvs with the same tag as the root are followed first.
+        auto parentRepeated = builder.Reset().SetTag(0xA3).AddTlv(child81).AddTlv(parentSmall).Build();
+        REQUIRE(parentRepeated.Find({ 0xA3, 0x80 }) == &parentRepeated.GetValues()[1].GetValues()[0]);
+        REQUIRE(parentRepeated.Find({ 0xA3, 0x81 }) == &parentRepeated.GetValues()[1].GetValues()[1]);
+        REQUIRE(parentRepeated.Find({ 0xA3, 0x82 }) == nullptr);
+    }
+
+    SECTION("FindAll works without an index")
+    {
+        const auto values = parentSmall.FindAll(0x80);
+        REQUIRE(values.size() == 1);
+        REQUIRE(values.front() == &parentSmall.GetValues()[0]);
+    }
+}
+
+TEST_CASE("TlvBer sequences can be parsed", "[basic][infra]")
+{
+    using namespace encoding::test;
+
+    static constexpr std::array<uint8_t, 2> tagTwoBytesPrimitive{ 0x9F, 0x25 };
+    static constexpr std::array<uint8_t, 2> tagTwoBytesConstructed{ 0xBF, 0x78 };
+
+    // Mix short and long-form tags and lengths, and primitive and constructed tlvs.
+    std::vector<TlvBer> tlvs{};
+    std::vector<uint8_t> sequence{};
+    TlvBer::Builder builder{};
+    for (std::size_t i = 0; i < 100; i++) {
+        switch (i % 3) {
+        case 0: {
+            auto value = getOctets(i % 16);
+            tlvs.push_back(builder.Reset().SetTag(0x80).SetValue(value).Build());
+            break;
+        }
+        case 1: {
+            auto value = getOctets(128 + i);
+            tlvs.push_back(builder.Reset().SetTag(tagTwoBytesPrimitive).SetValue(value).Build());
+            break;
+        }
+        case 2: {
+            auto value = getOctets(4);
+            auto child = builder.Reset().SetTag(0x81).SetValue(value).Build();
+            tlvs.push_back(builder.Reset().SetTag(tagTwoBytesConstructed).AddTlv(child).AddTlv(child).Build());
+            break;
+        }
+        }
+        const auto encoding = tlvs.back().ToBytes();
+        sequence.insert(std::cend(sequence), std::cbegin(encoding), std::cend(encoding));
+    }
+
+    std::vector<TlvBer> parsed{};
+    const auto onTlvParsed = [&](TlvBer& tlv) {
+        parsed.push_back(std::move(tlv));
+    };
+
+    SECTION("all tlvs are parsed, in order")
+    {
+        for (const std::size_t concurrency : { 0U, 1U, 3U, 8U, 1000U }) {
+            parsed.clear();
+            REQUIRE(TlvBer::ParseSequence(sequence, onTlvParsed, concurrency) == Tlv::ParseResult::Succeeded);
+            REQUIRE(parsed == tlvs);
+        }
+    }
+
+    SECTION("an empty sequence is parsed")
+    {
+        REQUIRE(TlvBer::ParseSequence({}, onTlvParsed, 4) == Tlv::ParseResult::Succeeded);
+        REQUIRE(parsed.empty());
+    }
+
+    SECTION("tlvs preceding a truncated tlv are reported")
+    {
+        const auto truncated = std::span{ sequence }.first(sequence.size() - 1);
+        for (const std::size_t concurrency : { 1U, 4U }) {
+            parsed.clear();
+            REQUIRE(TlvBer::ParseSequence(truncated, onTlvParsed, concurrency) == Tlv::ParseResult::Failed);
+            REQUIRE(parsed.size() == tlvs.size() - 1);
+            REQUIRE(std::equal(std::cbegin(parsed), std::cend(parsed), std::cbegin(tlvs)));
+        }
+    }
+
+    SECTION("tlvs preceding a tlv with an invalid nested tlv are reported")
+    {
+        static constexpr std::array<uint8_t, 6> invalid{ 0xA3, 0x04, 0x80, 0x03, 0x01, 0x02 };
+        const auto encoding = tlvs.front().ToBytes();
+        std::vector<uint8_t> sequenceInvalid{ std::cbegin(sequence), std::cbegin(sequence) + static_cast<long>(encoding.size()) };
+        sequenceInvalid.insert(std::cend(sequenceInvalid), std::cbegin(invalid), std::cend(invalid));
+        sequenceInvalid.insert(std::cend(sequenceInvalid), std::cbegin(sequence), std::cend(sequence));
+
+        for (const std::size_t concurrency : { 1U, 4U }) {
+            parsed.clear();
+            REQUIRE(TlvBer::ParseSequence(sequenceInvalid, onTlvParsed, concurrency) == Tlv::ParseResult::Failed);
+            REQUIRE(parsed.size() == 1);
+            REQUIRE(parsed.front() == tlvs.front());
+        }
+    }
+}
+
+
+TEST_CASE("TlvBer encoded sizes are cached and can be encoded with DER", "[basic][infra]")
+{
+    using namespace encoding::test;
+
+    static constexpr uint8_t tagSet = 0x31;
+    static constexpr uint8_t tagSequence = 0x30;
+
+    TlvBer::Builder builder{};
+    auto valueLong = getOctets(300);
+    std::vector<uint8_t> valueA{ 0x01, 0x02 };
+    std::vector<uint8_t> valueB{ 0x01 };
+    auto tlvLong = builder.Reset().SetTag(0x04).SetValue(valueLong).Build();
+    auto tlvA = builder.Reset().SetTag(0x04).SetValue(valueA).Build();
+    auto tlvB = builder.Reset().SetTag(0x04).SetValue(valueB).Build();
+    auto tlvC = builder.Reset().SetTag(0x02).SetValue(valueA).Build();
+
+    SECTION("the length encoding matches the encoding of the value length")
+    {
+        for (const auto& tlv : { tlvLong, tlvA, tlvB }) {
+            REQUIRE(std::ranges::equal(tlv.GetLengthEncoding(), TlvBer::GetLengthEncoding(tlv.Value.size())));
+        }
+
+        auto parent = builder.Reset().SetTag(tagSequence).AddTlv(tlvLong).AddTlv(tlvA).Build();
+        const auto bytes = parent.ToBytes();
+        REQUIRE(parent.EncodedSize() == bytes.size());
+        REQUIRE(std::ranges::equal(parent.GetLengthEncoding(), TlvBer::GetLengthEncoding(tlvLong.EncodedSize() + tlvA.EncodedSize())));
+    }
+
+    SECTION("cached sizes follow copies, moves, and assignments")
+    {
+        auto parent = builder.Reset().SetTag(tagSequence).AddTlv(tlvLong).AddTlv(tlvA).Build();
+        const auto encodedSize = parent.EncodedSize();
+
+        TlvBer copy{ parent };
+        REQUIRE(copy.EncodedSize() == encodedSize);
+
+        TlvBer moved{ std::move(copy) };
+        REQUIRE(moved.EncodedSize() == encodedSize);
+        REQUIRE(copy.EncodedSize() == copy.ToBytes().size());
+
+        moved = tlvB;
+        REQUIRE(moved.EncodedSize() == tlvB.ToBytes().size());
+        REQUIRE(moved.ToBytes() == tlvB.ToBytes());
+    }
+
+    SECTION("members of a set are sorted by their encodings with DER")
+    {
+        auto set = builder.Reset().SetTag(tagSet).AddTlv(tlvLong).AddTlv(tlvA).AddTlv(tlvB).AddTlv(tlvC).Build();
+        auto setReordered = builder.Reset().SetTag(tagSet).AddTlv(tlvC).AddTlv(tlvB).AddTlv(tlvA).AddTlv(tlvLong).Build();
+        REQUIRE(set.ToBytes() != setReordered.ToBytes());
+
+        const auto encoding = set.ToBytes(TlvBer::EncodingRules::Distinguished);
+        REQUIRE(encoding == setReordered.ToBytes(TlvBer::EncodingRules::Distinguished));
+        REQUIRE(encoding.size() == set.EncodedSize());
+
+        auto setSorted = builder.Reset().SetTag(tagSet).AddTlv(tlvC).AddTlv(tlvB).AddTlv(tlvA).AddTlv(tlvLong).Build();
+        REQUIRE(encoding == setSorted.ToBytes());
+    }
+
+    SECTION("sets nested in other tlvs are sorted with DER, while other tlvs keep their order")
+    {
+        auto set = builder.Reset().SetTag(tagSet).AddTlv(tlvA).AddTlv(tlvB).Build();
+        auto setReordered = builder.Reset().SetTag(tagSet).AddTlv(tlvB).AddTlv(tlvA).Build();
+        auto sequence = builder.Reset().SetTag(tagSequence).AddTlv(tlvA).AddTlv(set).AddTlv(tlvB).Build();
+        auto sequenceReordered = builder.Reset().SetTag(tagSequence).AddTlv(tlvA).AddTlv(setReordered).AddTlv(tlvB).Build();
+
+        REQUIRE(sequence.ToBytes(TlvBer::EncodingRules::Distinguished) == sequenceReordered.ToBytes(TlvBer::EncodingRules::Distinguished));
+        REQUIRE(sequence.ToBytes(TlvBer::EncodingRules::Distinguished) == sequenceReordered.ToBytes());
+
+        auto sequenceOther = builder.Reset().SetTag(tagSequence).AddTlv(tlvB).AddTlv(set).AddTlv(tlvA).Build();
+        REQUIRE(sequence.ToBytes(TlvBer::EncodingRules::Distinguished) != sequenceOther.ToBytes(TlvBer::EncodingRules::Distinguished));
+    }
+
+    SECTION("tlvs without sets encode identically with BER and DER")
+    {
+        auto parent = builder.Reset().SetTag(tagSequence).AddTlv(tlvLong).AddTlv(tlvA).Build();
+        REQUIRE(parent.ToBytes() == parent.ToBytes(TlvBer::EncodingRules::Distinguished));
+
+        std::vector<uint8_t> buffer(parent.EncodedSize());
+        REQUIRE(parent.Encode(buffer, TlvBer::EncodingRules::Distinguished) == buffer.size());
+        REQUIRE(buffer == parent.ToBytes());
+    }
 }
 
 // NOLINTEND(cppcoreguidelines-avoid-magic-numbers)
@@ -0,0 +1,140 @@
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <iterator>
+#include <span>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <tlv/TlvBer.hxx>
+#include <tlv/TlvBerDecoder.hxx>
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers)
+
+using namespace encoding;
+
+namespace encoding::test
+{
+/**
+ * @brief Build a two level constructed tlv with a value large enough to
+ * require a long-form length.
+ *
+ * @return TlvBer
+ */
+TlvBer
+MakeNestedTlv()
+{
+    static constexpr std::array<uint8_t, 2> tagTwoBytesConstructed{ 0xBF, 0x78 };
+    const std::vector<uint8_t> valueSmall{ 0x01, 0x02 };
+    const std::vector<uint8_t> valueLarge(200, 0x5A);
+
+    TlvBer::Builder builder{};
+    auto child = builder.SetTag(0x80).SetValue(valueSmall).Build();
+    auto childLarge = builder.Reset().SetTag(0x8B).SetValue(valueLarge).Build();
+    auto childEmpty = builder.Reset().SetTag(0x81).Build();
+    auto parent = builder.Reset().SetTag(0xA3).AddTlv(child).AddTlv(childLarge).Build();
+    return builder.Reset().SetTag(tagTwoBytesConstructed).AddTlv(child).AddTlv(parent).AddTlv(childEmpty).Build();
+}
+} // namespace encoding::test
+
+TEST_CASE("test TlvBerDecoder", "[basic][infra]")
+{
+    const auto tlv = encoding::test::MakeNestedTlv();
+    const auto encoded = tlv.ToBytes();
+
+    std::vector<TlvBer> decoded;
+    TlvBerDecoder decoder{ [&](TlvBer& tlvDecoded) {
+        decoded.push_back(tlvDecoded);
+    } };
+
+    SECTION("decoding the complete encoding at once works")
+    {
+        REQUIRE(decoder.Push(encoded) == TlvBerDecoder::Result::Succeeded);
+        REQUIRE(decoder.BytesRequired() == 0);
+        REQUIRE(decoded.size() == 1);
+        REQUIRE(decoded.front() == tlv);
+    }
+
+    SECTION("decoding one byte at a time works")
+    {
+        for (std::size_t i = 0; i < encoded.size() - 1; i++) {
+            REQUIRE(decoder.Push(std::span{ encoded }.subspan(i, 1)) == TlvBerDecoder::Result::NeedMoreData);
+            REQUIRE(decoded.empty());
+        }
+
+        REQUIRE(decoder.Push(std::span{ encoded }.last(1)) == TlvBerDecoder::Result::Succeeded);
+        REQUIRE(decoded.size() == 1);
+        REQUIRE(decoded.front() == tlv);
+    }
+
+    SECTION("decoding arbitrary chunks works")
+    {
+        for (const std::size_t chunkSize : { 2U, 3U, 7U, 64U, 150U }) {
+            decoded.clear();
+            std::span<const uint8_t> remaining{ encoded };
+            while (!remaining.empty()) {
+                const auto chunk = remaining.first(std::min(chunkSize, remaining.size()));
+                remaining = remaining.subspan(chunk.size());
+                const auto result = decoder.Push(chunk);
+                REQUIRE(result == (remaining.empty() ? TlvBerDecoder::Result::Succeeded : TlvBerDecoder::Result::NeedMoreData));
+            }
+            REQUIRE(decoded.size() == 1);
+            REQUIRE(decoded.front() == tlv);
+        }
+    }
+
+    SECTION("the exact number of bytes required is reported once the outer length is known")
+    {
+        // Tag (2) + long-form length (2).
+        REQUIRE(decoder.Push(std::span{ encoded }.first(4)) == TlvBerDecoder::Result::NeedMoreData);
+        REQUIRE(decoder.BytesRequired() == encoded.size() - 4);
+        REQUIRE(decoder.Push(std::span{ encoded }.subspan(4, 10)) == TlvBerDecoder::Result::NeedMoreData);
+        REQUIRE(decoder.BytesRequired() == encoded.size() - 14);
+        REQUIRE(decoder.Push(std::span{ encoded }.subspan(14)) == TlvBerDecoder::Result::Succeeded);
+        REQUIRE(decoded.size() == 1);
+    }
+
+    SECTION("back-to-back tlvs are each reported")
+    {
+        std::vector<uint8_t> stream{ encoded };
+        stream.insert(std::cend(stream), { 0x81, 0x01, 0xAA });
+        stream.insert(std::cend(stream), std::cbegin(encoded), std::cend(encoded));
+
+        REQUIRE(decoder.Push(std::span{ stream }.first(encoded.size() + 2)) == TlvBerDecoder::Result::NeedMoreData);
+        REQUIRE(decoded.size() == 1);
+        REQUIRE(decoder.BytesRequired() == 1);
+        REQUIRE(decoder.Push(std::span{ stream }.subspan(encoded.size() + 2)) == TlvBerDecoder::Result::Succeeded);
+        REQUIRE(decoded.size() == 3);
+        REQUIRE(decoded[0] == tlv);
+        REQUIRE(decoded[1].GetTag()[0] == 0x81);
+        REQUIRE(std::ranges::equal(decoded[1].GetValue(), std::array<uint8_t, 1>{ 0xAA }));
+        REQUIRE(decoded[2] == tlv);
+    }
+
+    SECTION("a nested tlv extending beyond its parent fails")
+    {
+        static constexpr std::array<uint8_t, 8> invalid{ 0xA3, 0x04, 0x80, 0x03, 0x01, 0x02, 0x03, 0x04 };
+        REQUIRE(decoder.Push(invalid) == TlvBerDecoder::Result::Failed);
+        REQUIRE(decoder.Push(encoded) == TlvBerDecoder::Result::Failed);
+
+        decoder.Reset();
+        REQUIRE(decoder.Push(encoded) == TlvBerDecoder::Result::Succeeded);
+        REQUIRE(decoded.size() == 1);
+    }
+
+    SECTION("a length with too many octets fails")
+    {
+        static constexpr std::array<uint8_t, 2> invalid{ 0x80, 0x85 };
+        REQUIRE(decoder.Push(invalid) == TlvBerDecoder::Result::Failed);
+    }
+
+    SECTION("a tag with too many octets fails")
+    {
+        static constexpr std::array<uint8_t, 3> invalid{ 0xDF, 0x84, 0x85 };
+        REQUIRE(decoder.Push(invalid) == TlvBerDecoder::Result::Failed);
+    }
+}
+
+// NOLINTEND(cppcoreguidelines-avoid-magic-numbers)
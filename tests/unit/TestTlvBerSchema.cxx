@@ -0,0 +1,178 @@
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <memory_resource>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <tlv/TlvBer.hxx>
+#include <tlv/TlvBerSchema.hxx>
+#include <tlv/TlvBerView.hxx>
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers)
+
+using namespace encoding;
+
+namespace encoding::test
+{
+enum class ShapeColor : uint8_t {
+    Red = 1,
+    Green = 2,
+};
+
+struct Point
+{
+    uint16_t X{ 0 };
+    uint16_t Y{ 0 };
+};
+
+struct Shape
+{
+    uint32_t Id{ 0 };
+    ShapeColor Color{ ShapeColor::Red };
+    bool Filled{ false };
+    Point Origin{};
+    std::optional<Point> Extent;
+    std::vector<uint8_t> Label;
+};
+
+using PointSchema = TlvBerSchema<Point, 0xA1,
+    TlvBerField<0x80, TlvBerMember<&Point::X>, TlvBerIntegerCodec<uint16_t>>,
+    TlvBerField<0x81, TlvBerMember<&Point::Y>, TlvBerIntegerCodec<uint16_t>>>;
+
+using ShapeSchema = TlvBerSchema<Shape, 0xBF20,
+    TlvBerField<0x80, TlvBerMember<&Shape::Id>, TlvBerIntegerCodec<uint32_t, 3>>,
+    TlvBerField<0x81, TlvBerMember<&Shape::Color>, TlvBerIntegerCodec<ShapeColor>>,
+    TlvBerField<0x82, TlvBerMember<&Shape::Filled>, TlvBerIntegerCodec<bool>>,
+    TlvBerField<0xA3, TlvBerMember<&Shape::Origin>, TlvBerSchemaCodec<PointSchema>>,
+    TlvBerField<0xA4, TlvBerOptionalMember<&Shape::Extent>, TlvBerSchemaCodec<PointSchema>>,
+    TlvBerField<0x9F25, TlvBerMember<&Shape::Label>, TlvBerOctetsCodec>>;
+
+using PointPrimitiveTagSchema = TlvBerSchema<Point, 0x81,
+    TlvBerField<0x80, TlvBerMember<&Point::X>, TlvBerIntegerCodec<uint16_t>>>;
+} // namespace encoding::test
+
+TEST_CASE("TlvBerSchema generates encoders and decoders", "[basic][infra]")
+{
+    using namespace encoding::test;
+
+    Shape shape{};
+    shape.Id = 0x010203;
+    shape.Color = ShapeColor::Green;
+    shape.Filled = true;
+    shape.Origin = Point{ 0x0A0B, 0x0C0D };
+    shape.Label = { 'a', 'b' };
+
+    const auto requireEqual = [](const Shape& lhs, const Shape& rhs) {
+        REQUIRE(lhs.Id == rhs.Id);
+        REQUIRE(lhs.Color == rhs.Color);
+        REQUIRE(lhs.Filled == rhs.Filled);
+        REQUIRE(lhs.Origin.X == rhs.Origin.X);
+        REQUIRE(lhs.Origin.Y == rhs.Origin.Y);
+        REQUIRE(lhs.Extent.has_value() == rhs.Extent.has_value());
+        if (lhs.Extent.has_value()) {
+            REQUIRE(lhs.Extent->X == rhs.Extent->X);
+            REQUIRE(lhs.Extent->Y == rhs.Extent->Y);
+        }
+        REQUIRE(lhs.Label == rhs.Label);
+    };
+
+    SECTION("encoding matches the equivalent tlv built by hand")
+    {
+        static constexpr std::array<uint8_t, 29> expected{
+            0xBF, 0x20, 0x1A,
+            0x80, 0x03, 0x01, 0x02, 0x03,
+            0x81, 0x01, 0x02,
+            0x82, 0x01, 0x01,
+            0xA3, 0x08, 0x80, 0x02, 0x0A, 0x0B, 0x81, 0x02, 0x0C, 0x0D,
+            0x9F, 0x25, 0x02, 'a', 'b',
+        };
+
+        std::vector<uint8_t> encoded(ShapeSchema::EncodedSize(shape));
+        REQUIRE(encoded.size() == expected.size());
+        REQUIRE(ShapeSchema::Encode(shape, std::begin(encoded)) == std::end(encoded));
+        REQUIRE(std::ranges::equal(encoded, expected));
+        REQUIRE(ShapeSchema::ToTlvBer(shape).ToBytes() == encoded);
+    }
+
+    SECTION("a round-trip through a TlvBer preserves all fields")
+    {
+        shape.Extent = Point{ 1, 2 };
+        const auto tlv = ShapeSchema::ToTlvBer(shape);
+        Shape decoded{};
+        REQUIRE(ShapeSchema::DecodeValue(tlv, decoded));
+        requireEqual(decoded, shape);
+    }
+
+    SECTION("a round-trip through a TlvBerView preserves all fields")
+    {
+        const auto encoded = ShapeSchema::ToTlvBer(shape).ToBytes();
+        TlvBerView tlv{};
+        std::size_t bytesParsed = 0;
+        REQUIRE(TlvBerView::Parse(tlv, encoded, bytesParsed) == Tlv::ParseResult::Succeeded);
+        Shape decoded{};
+        REQUIRE(ShapeSchema::DecodeValue(tlv, decoded));
+        requireEqual(decoded, shape);
+    }
+
+    SECTION("unknown tags are ignored and missing fields are left unmodified")
+    {
+        static constexpr std::array<uint8_t, 9> encoded{ 0xBF, 0x20, 0x06, 0x85, 0x01, 0xFF, 0x82, 0x01, 0x01 };
+        TlvBerView tlv{};
+        std::size_t bytesParsed = 0;
+        REQUIRE(TlvBerView::Parse(tlv, encoded, bytesParsed) == Tlv::ParseResult::Succeeded);
+        Shape decoded{};
+        decoded.Id = 42;
+        REQUIRE(ShapeSchema::DecodeValue(tlv, decoded));
+        REQUIRE(decoded.Id == 42);
+        REQUIRE(decoded.Filled);
+        REQUIRE(!decoded.Extent.has_value());
+    }
+
+    SECTION("a value with an incorrect size fails to decode")
+    {
+        static constexpr std::array<uint8_t, 6> encoded{ 0xBF, 0x20, 0x03, 0x81, 0x02, 0x01 };
+        TlvBerView tlv{};
+        std::size_t bytesParsed = 0;
+        REQUIRE(TlvBerView::Parse(tlv, encoded, bytesParsed) == Tlv::ParseResult::Failed);
+
+        static constexpr std::array<uint8_t, 7> encodedInvalid{ 0xBF, 0x20, 0x04, 0x81, 0x02, 0x01, 0x02 };
+        REQUIRE(TlvBerView::Parse(tlv, encodedInvalid, bytesParsed) == Tlv::ParseResult::Succeeded);
+        Shape decoded{};
+        REQUIRE(!ShapeSchema::DecodeValue(tlv, decoded));
+    }
+
+    SECTION("ToTlvBer allocates only from the specified allocator")
+    {
+        shape.Extent = Point{ 1, 2 };
+        shape.Label = std::vector<uint8_t>(64, 'a');
+        const auto encoded = [&] {
+            std::vector<uint8_t> encoding(ShapeSchema::EncodedSize(shape));
+            ShapeSchema::Encode(shape, std::begin(encoding));
+            return encoding;
+        }();
+
+        std::array<std::byte, 4096> buffer{};
+        std::pmr::monotonic_buffer_resource resource{ std::data(buffer), std::size(buffer), std::pmr::null_memory_resource() };
+        auto* const resourceDefault = std::pmr::set_default_resource(std::pmr::null_memory_resource());
+        const auto tlv = ShapeSchema::ToTlvBer(shape, &resource);
+        std::pmr::set_default_resource(resourceDefault);
+
+        REQUIRE(tlv.get_allocator().resource() == &resource);
+        REQUIRE(tlv.ToBytes() == encoded);
+        Shape decoded{};
+        REQUIRE(ShapeSchema::DecodeValue(tlv, decoded));
+        requireEqual(decoded, shape);
+    }
+
+    SECTION("ToTlvBer rejects a schema with a primitive tag")
+    {
+        REQUIRE_THROWS_AS(PointPrimitiveTagSchema::ToTlvBer(shape.Origin), TlvBer::Builder::InvalidTlvBerTagException);
+    }
+}
+
+// NOLINTEND(cppcoreguidelines-avoid-magic-numbers)
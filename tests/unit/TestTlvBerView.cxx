@@ -0,0 +1,132 @@
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <iterator>
+#include <span>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <tlv/TlvBer.hxx>
+#include <tlv/TlvBerView.hxx>
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers)
+
+using namespace encoding;
+
+TEST_CASE("test TlvBerView", "[basic][infra]")
+{
+    // Constructed tag 0xBF78 containing a primitive tag 0x80, and a constructed
+    // tag 0xA3 which itself contains primitive tags 0x80 and 0x8B.
+    static constexpr std::array<uint8_t, 19> encoded{
+        0xBF, 0x78, 0x10,
+        0x80, 0x02, 0x01, 0x02,
+        0xA3, 0x0A,
+        0x80, 0x02, 0xAA, 0xBB,
+        0x8B, 0x04, 0x01, 0x02, 0x03, 0x04
+    };
+
+    SECTION("Parse succeeds for a primitive tlv with a single byte tag")
+    {
+        static constexpr std::array<uint8_t, 4> data{ 0x81, 0x02, 0x11, 0x22 };
+        TlvBerView tlv{};
+        std::size_t bytesParsed = 0;
+        REQUIRE(TlvBerView::Parse(tlv, data, bytesParsed) == Tlv::ParseResult::Succeeded);
+        REQUIRE(bytesParsed == data.size());
+        REQUIRE(tlv.IsPrimitive());
+        REQUIRE(tlv.GetClass() == TlvBer::Class::ContextSpecific);
+        REQUIRE(tlv.GetTagNumber() == 1);
+        REQUIRE(tlv.GetTag().size() == 1);
+        REQUIRE(tlv.GetTag()[0] == 0x81);
+        REQUIRE(tlv.GetValue().size() == 2);
+        REQUIRE(std::ranges::equal(tlv.GetValue(), std::array<uint8_t, 2>{ 0x11, 0x22 }));
+        REQUIRE(tlv.GetValues().empty());
+    }
+
+    SECTION("Parse refers to the input buffer instead of copying it")
+    {
+        TlvBerView tlv{};
+        std::size_t bytesParsed = 0;
+        REQUIRE(TlvBerView::Parse(tlv, encoded, bytesParsed) == Tlv::ParseResult::Succeeded);
+        REQUIRE(bytesParsed == encoded.size());
+        REQUIRE(tlv.GetTag().data() == encoded.data());
+        REQUIRE(tlv.GetValue().data() == encoded.data() + 3);
+        REQUIRE(tlv.GetEncoding().data() == encoded.data());
+        REQUIRE(tlv.GetEncoding().size() == encoded.size());
+    }
+
+    SECTION("Parse only consumes the first tlv")
+    {
+        std::vector<uint8_t> data(std::cbegin(encoded), std::cend(encoded));
+        data.insert(std::cend(data), { 0x81, 0x00 });
+        TlvBerView tlv{};
+        std::size_t bytesParsed = 0;
+        REQUIRE(TlvBerView::Parse(tlv, data, bytesParsed) == Tlv::ParseResult::Succeeded);
+        REQUIRE(bytesParsed == encoded.size());
+    }
+
+    SECTION("nested tlvs can be iterated")
+    {
+        TlvBerView tlv{};
+        std::size_t bytesParsed = 0;
+        REQUIRE(TlvBerView::Parse(tlv, encoded, bytesParsed) == Tlv::ParseResult::Succeeded);
+        REQUIRE(tlv.IsConstructed());
+        REQUIRE(tlv.GetTagNumber() == 0x78);
+
+        auto values = tlv.GetValues();
+        REQUIRE(std::distance(std::begin(values), std::end(values)) == 2);
+
+        auto it = std::begin(values);
+        REQUIRE(it->GetTag()[0] == 0x80);
+        REQUIRE(std::ranges::equal(it->GetValue(), std::array<uint8_t, 2>{ 0x01, 0x02 }));
+
+        ++it;
+        REQUIRE(it->IsConstructed());
+        REQUIRE(it->GetTag()[0] == 0xA3);
+        std::vector<uint8_t> tags;
+        for (const auto& nested : it->GetValues()) {
+            tags.push_back(nested.GetTag()[0]);
+        }
+        REQUIRE(tags == std::vector<uint8_t>{ 0x80, 0x8B });
+
+        ++it;
+        REQUIRE(it == std::end(values));
+    }
+
+    SECTION("Parse fails if the value is truncated")
+    {
+        const auto truncated = std::span<const uint8_t>(encoded).first(encoded.size() - 1);
+        TlvBerView tlv{};
+        std::size_t bytesParsed = 0;
+        REQUIRE(TlvBerView::Parse(tlv, truncated, bytesParsed) == Tlv::ParseResult::Failed);
+    }
+
+    SECTION("Parse fails if a nested tlv overruns its parent")
+    {
+        auto data = encoded;
+        data[14] = 0x05; // tag 0x8B length now exceeds the enclosing 0xA3 value
+        TlvBerView tlv{};
+        std::size_t bytesParsed = 0;
+        REQUIRE(TlvBerView::Parse(tlv, data, bytesParsed) == Tlv::ParseResult::Failed);
+    }
+
+    SECTION("Parse fails for empty input")
+    {
+        TlvBerView tlv{};
+        std::size_t bytesParsed = 0;
+        REQUIRE(TlvBerView::Parse(tlv, std::span<const uint8_t>{}, bytesParsed) == Tlv::ParseResult::Failed);
+    }
+
+    SECTION("ToTlvBer produces an equivalent owning tlv")
+    {
+        TlvBerView tlv{};
+        std::size_t bytesParsed = 0;
+        REQUIRE(TlvBerView::Parse(tlv, encoded, bytesParsed) == Tlv::ParseResult::Succeeded);
+        const auto tlvBer = tlv.ToTlvBer();
+        REQUIRE(tlvBer.GetValues().size() == 2);
+        REQUIRE(std::ranges::equal(tlvBer.ToBytes(), encoded));
+    }
+}
+
+// NOLINTEND(cppcoreguidelines-avoid-magic-numbers)
@@ -5,6 +5,7 @@
 
 #include <catch2/catch_test_macros.hpp>
 #include <tlv/TlvSimple.hxx>
+#include <tlv/TlvSimpleView.hxx>
 
 // NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers)
 
@@ -150,4 +151,87 @@ TEST_CASE("TlvSimple object can be created properly from the Parse function", "[
     }
 }
 
+
+TEST_CASE("TlvSimpleView sequences can be parsed", "[basic][infra]")
+{
+    using encoding::Tlv;
+    using encoding::TlvSimple;
+    using encoding::TlvSimpleView;
+
+    const std::vector<uint8_t> valueLong(0x123, 0xA5);
+    std::vector<uint8_t> packet{ 0x01, 0x02, 0xAA, 0xBB, 0x02, 0x00 };
+    packet.insert(std::cend(packet), { 0x03, TlvSimple::ThreeByteLengthIndicatorValue, 0x01, 0x23 });
+    packet.insert(std::cend(packet), std::cbegin(valueLong), std::cend(valueLong));
+
+    SECTION("parsing a single TLV from the front of the data works as expected")
+    {
+        TlvSimpleView tlv{};
+        std::size_t bytesParsed = 0;
+        REQUIRE(TlvSimpleView::Parse(tlv, packet, bytesParsed) == Tlv::ParseResult::Succeeded);
+        REQUIRE(bytesParsed == 4);
+        REQUIRE(tlv.GetTag() == 0x01);
+        REQUIRE(std::ranges::equal(tlv.GetValue(), std::vector<uint8_t>{ 0xAA, 0xBB }));
+        REQUIRE(tlv.GetValue().data() == packet.data() + 2);
+        REQUIRE(tlv.GetEncoding().size() == 4);
+    }
+
+    SECTION("parsing all TLVs with 1- and 3-byte lengths works as expected")
+    {
+        std::size_t bytesParsed = 0;
+        auto tlvs = TlvSimpleView::ParseAll(packet, bytesParsed);
+        REQUIRE(bytesParsed == packet.size());
+
+        std::vector<TlvSimpleView> parsed(std::cbegin(tlvs), std::cend(tlvs));
+        REQUIRE(parsed.size() == 3);
+        REQUIRE(parsed[0].GetTag() == 0x01);
+        REQUIRE(parsed[0].GetValue().size() == 2);
+        REQUIRE(parsed[1].GetTag() == 0x02);
+        REQUIRE(parsed[1].GetValue().empty());
+        REQUIRE(parsed[2].GetTag() == 0x03);
+        REQUIRE(std::ranges::equal(parsed[2].GetValue(), valueLong));
+    }
+
+    SECTION("parsing all TLVs stops before trailing incomplete data")
+    {
+        const auto packetSizeComplete = packet.size();
+        packet.insert(std::cend(packet), { 0x04, TlvSimple::ThreeByteLengthIndicatorValue, 0x00 });
+
+        std::size_t bytesParsed = 0;
+        auto tlvs = TlvSimpleView::ParseAll(packet, bytesParsed);
+        REQUIRE(bytesParsed == packetSizeComplete);
+        REQUIRE(std::distance(std::cbegin(tlvs), std::cend(tlvs)) == 3);
+
+        TlvSimpleView tlv{};
+        REQUIRE(TlvSimpleView::Parse(tlv, std::span(packet).subspan(bytesParsed), bytesParsed) == Tlv::ParseResult::Failed);
+    }
+
+    SECTION("parsing all TLVs from empty data yields no TLVs")
+    {
+        std::size_t bytesParsed = 1;
+        auto tlvs = TlvSimpleView::ParseAll({}, bytesParsed);
+        REQUIRE(bytesParsed == 0);
+        REQUIRE(tlvs.empty());
+        REQUIRE(std::cbegin(tlvs) == std::cend(tlvs));
+    }
+
+    SECTION("views can be converted to owning TlvSimple objects")
+    {
+        std::size_t bytesParsed = 0;
+        auto tlvs = TlvSimpleView::ParseAll(packet, bytesParsed);
+        for (const auto& tlv : tlvs) {
+            auto tlvSimple = tlv.ToTlvSimple();
+            REQUIRE(tlvSimple != nullptr);
+            REQUIRE(tlvSimple->Tag[0] == tlv.GetTag());
+            REQUIRE(std::ranges::equal(tlvSimple->Value, tlv.GetValue()));
+
+            std::unique_ptr<TlvSimple> tlvSimpleParsed;
+            REQUIRE(TlvSimple::Parse(tlvSimpleParsed, tlv.GetEncoding()) == Tlv::ParseResult::Succeeded);
+            REQUIRE(std::ranges::equal(tlvSimpleParsed->Value, tlv.GetValue()));
+        }
+
+        std::unique_ptr<TlvSimple> tlvSimpleParsed;
+        REQUIRE(TlvSimple::Parse(tlvSimpleParsed, packet) == Tlv::ParseResult::Failed);
+    }
+}
+
 // NOLINTEND(cppcoreguidelines-avoid-magic-numbers)
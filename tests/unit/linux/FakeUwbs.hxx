@@ -0,0 +1,194 @@
+
+#ifndef FAKE_UWBS_HXX
+#define FAKE_UWBS_HXX
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <span>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <uwb/protocols/fira/uci/ControlMessage.hxx>
+
+namespace linux::test
+{
+/**
+ * @brief A fake UWB subsystem (UWBS) on one end of a socketpair. The other end
+ * is handed to the driver under test.
+ *
+ * Commands received from the driver are passed to a handler, which returns
+ * the messages to send back, typically a response and possibly some
+ * notifications.
+ */
+class FakeUwbs
+{
+public:
+    using ControlMessage = uwb::protocol::fira::uci::ControlMessage;
+    using CommandHandler = std::function<std::vector<ControlMessage>(const ControlMessage& command)>;
+
+    FakeUwbs()
+    {
+        std::array<int, 2> fds{};
+        if (::socketpair(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0, std::data(fds)) < 0) {
+            throw std::runtime_error("failed to create socketpair");
+        }
+        m_fd = fds[0];
+        m_fdDriver = fds[1];
+    }
+
+    ~FakeUwbs()
+    {
+        Close();
+        if (m_fdDriver >= 0) {
+            ::close(m_fdDriver);
+        }
+    }
+
+    FakeUwbs(const FakeUwbs&) = delete;
+    FakeUwbs&
+    operator=(const FakeUwbs&) = delete;
+
+    /**
+     * @brief Release the driver end of the socketpair. The caller takes
+     * ownership of it.
+     *
+     * @return int
+     */
+    int
+    ReleaseDriverFileDescriptor() noexcept
+    {
+        return std::exchange(m_fdDriver, -1);
+    }
+
+    /**
+     * @brief Start processing commands.
+     *
+     * @param commandHandler The handler to invoke for each command.
+     */
+    void
+    Start(CommandHandler commandHandler)
+    {
+        m_commandHandler = std::move(commandHandler);
+        m_thread = std::thread([this] {
+            ProcessCommands();
+        });
+    }
+
+    /**
+     * @brief Hang up the connection to the driver.
+     */
+    void
+    Close()
+    {
+        if (m_fd < 0) {
+            return;
+        }
+        ::shutdown(m_fd, SHUT_RDWR);
+        if (m_thread.joinable()) {
+            m_thread.join();
+        }
+        ::close(m_fd);
+        m_fd = -1;
+    }
+
+    /**
+     * @brief Send a message to the driver.
+     *
+     * @param message The message to send.
+     * @param payloadLengthMaximum The largest payload to put in one packet.
+     */
+    void
+    Send(const ControlMessage& message, std::size_t payloadLengthMaximum = uwb::protocol::fira::uci::ControlPacketHeader::PayloadLengthMaximum)
+    {
+        SendBytes(message.Encode(payloadLengthMaximum));
+    }
+
+    /**
+     * @brief Send raw bytes to the driver.
+     *
+     * @param data The data to send.
+     */
+    void
+    SendBytes(std::span<const uint8_t> data)
+    {
+        std::lock_guard sendLock{ m_sendGate };
+        while (!data.empty()) {
+            const auto numberOfOctetsWritten = ::send(m_fd, std::data(data), std::size(data), MSG_NOSIGNAL);
+            if (numberOfOctetsWritten <= 0) {
+                return;
+            }
+            data = data.subspan(static_cast<std::size_t>(numberOfOctetsWritten));
+        }
+    }
+
+    /**
+     * @brief Get the commands received so far.
+     *
+     * @return std::vector<ControlMessage>
+     */
+    std::vector<ControlMessage>
+    GetCommandsReceived()
+    {
+        std::lock_guard commandsLock{ m_commandsGate };
+        return m_commandsReceived;
+    }
+
+private:
+    void
+    ProcessCommands()
+    {
+        using namespace uwb::protocol::fira::uci;
+
+        std::vector<uint8_t> buffer;
+        std::array<uint8_t, 512> chunk{};
+        ControlMessageReassembler reassembler;
+
+        for (;;) {
+            const auto numberOfOctetsRead = ::read(m_fd, std::data(chunk), std::size(chunk));
+            if (numberOfOctetsRead <= 0) {
+                return;
+            }
+            buffer.insert(std::end(buffer), std::begin(chunk), std::next(std::begin(chunk), numberOfOctetsRead));
+
+            std::span<const uint8_t> data{ buffer };
+            std::vector<ControlMessage> commands;
+            for (auto packet = ControlPacket::Parse(data); packet.has_value(); packet = ControlPacket::Parse(data)) {
+                data = data.subspan(packet->Size());
+                if (auto message = reassembler.Push(*packet); message.has_value()) {
+                    commands.push_back(ControlMessage::FromView(*message));
+                }
+            }
+            buffer.erase(std::begin(buffer), std::next(std::begin(buffer), static_cast<std::ptrdiff_t>(std::size(buffer) - std::size(data))));
+
+            for (const auto& command : commands) {
+                {
+                    std::lock_guard commandsLock{ m_commandsGate };
+                    m_commandsReceived.push_back(command);
+                }
+                for (const auto& message : m_commandHandler(command)) {
+                    Send(message);
+                }
+            }
+        }
+    }
+
+private:
+    int m_fd{ -1 };
+    int m_fdDriver{ -1 };
+    CommandHandler m_commandHandler;
+    std::thread m_thread;
+    std::mutex m_sendGate;
+    std::mutex m_commandsGate;
+    std::vector<ControlMessage> m_commandsReceived;
+};
+} // namespace linux::test
+
+#endif // FAKE_UWBS_HXX
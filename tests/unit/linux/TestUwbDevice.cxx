@@ -0,0 +1,170 @@
+
+#include <array>
+#include <chrono>
+#include <future>
+#include <memory>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <linux/uwb/UwbDevice.hxx>
+#include <uwb/UwbSession.hxx>
+#include <uwb/UwbSessionEventCallbacks.hxx>
+#include <uwb/protocols/fira/FiraDevice.hxx>
+#include <uwb/protocols/fira/UwbException.hxx>
+#include <uwb/protocols/fira/uci/ControlMessageCodec.hxx>
+
+#include "FakeUwbs.hxx"
+
+namespace linux::test
+{
+/**
+ * @brief Session event callbacks which signal the events of interest.
+ */
+struct UwbSessionEventCallbacksTest :
+    public uwb::UwbSessionEventCallbacks
+{
+    void
+    OnSessionEnded(uwb::UwbSession* /* session */, uwb::UwbSessionEndReason /* reason */) override
+    {
+        SessionEnded.set_value();
+    }
+
+    void
+    OnRangingStarted(uwb::UwbSession* /* session */) override
+    {
+        RangingStarted.set_value();
+    }
+
+    void
+    OnRangingStopped(uwb::UwbSession* /* session */) override
+    {
+    }
+
+    void
+    OnPeerPropertiesChanged(uwb::UwbSession* /* session */, std::vector<uwb::UwbPeer> peersChanged) override
+    {
+        PeersChanged.set_value(std::move(peersChanged));
+    }
+
+    void
+    OnSessionMembershipChanged(uwb::UwbSession* /* session */, std::vector<uwb::UwbPeer> /* peersAdded */, std::vector<uwb::UwbPeer> /* peersRemoved */) override
+    {
+    }
+
+    std::promise<void> SessionEnded;
+    std::promise<void> RangingStarted;
+    std::promise<std::vector<uwb::UwbPeer>> PeersChanged;
+};
+} // namespace linux::test
+
+TEST_CASE("linux uwb device drives a uci device", "[basic][linux][uci]")
+{
+    using namespace linux::devices;
+    using namespace uwb::protocol::fira;
+    using namespace uwb::protocol::fira::uci;
+
+    constexpr uint32_t SessionId = 0x11223344;
+    const std::vector<uint8_t> deviceInformationEncoded{ 0x00, 0x01, 0x10, 0x01, 0x30, 0x01, 0x25, 0x01, 0x00, 0x02, 0xCA, 0xFE };
+    const uwb::UwbMacAddress peerMacAddress{ std::array<uint8_t, 2>{ 0xAB, 0xCD } };
+    UwbStatus rangeStartStatus = UwbStatusOk;
+
+    // A UWBS which accepts every command, and starts ranging with a single peer.
+    linux::test::FakeUwbs uwbs;
+    uwbs.Start([&](const ControlMessage& command) -> std::vector<ControlMessage> {
+        const auto view = command.View();
+        if (view.Is(MessageType::Command, GroupId::Core, CoreOpcodeId::GetDeviceInfo)) {
+            return { EncodeGetDeviceInfoResponse(*DecodeGetDeviceInfoResponse(deviceInformationEncoded)) };
+        } else if (view.Is(MessageType::Command, GroupId::Session, SessionOpcodeId::GetCount)) {
+            return { EncodeSessionGetCountResponse({ .Status = UwbStatusOk, .Count = 2 }) };
+        } else if (view.Is(MessageType::Command, GroupId::Session, SessionOpcodeId::SetAppConfig)) {
+            return { EncodeSessionSetAppConfigResponse({ .Status = UwbStatusOk, .ParameterStatuses = {} }) };
+        } else if (view.Is(MessageType::Command, GroupId::Session, SessionOpcodeId::GetAppConfig)) {
+            return { EncodeSessionGetAppConfigResponse({ .Status = UwbStatusOk, .Parameters = { { .Type = UwbApplicationConfigurationParameterType::DeviceType, .Value = DeviceType::Controlee } } }) };
+        } else if (view.Is(MessageType::Command, GroupId::Ranging, RangingOpcodeId::Start)) {
+            if (!IsUwbStatusOk(rangeStartStatus)) {
+                return { EncodeStatusResponse(view, rangeStartStatus) };
+            }
+            UwbRangingMeasurement rangingMeasurement{};
+            rangingMeasurement.PeerMacAddress = peerMacAddress;
+            rangingMeasurement.Distance = 100;
+            return {
+                EncodeStatusResponse(view, UwbStatusOk),
+                EncodeSessionStatusNotification({ .SessionId = SessionId, .State = UwbSessionState::Active, .ReasonCode = UwbSessionReasonCode::StateChangeWithSessionManagementCommands }),
+                EncodeRangeDataNotification({ .SequenceNumber = 1, .SessionId = SessionId, .CurrentRangingInterval = 200, .RangingMeasurementType = UwbRangingMeasurementType::TwoWay, .RangingMeasurements = { rangingMeasurement } }),
+            };
+        } else if (view.Is(MessageType::Command, GroupId::Session, SessionOpcodeId::Deinit)) {
+            return {
+                EncodeStatusResponse(view, UwbStatusOk),
+                EncodeSessionStatusNotification({ .SessionId = SessionId, .State = UwbSessionState::Deinitialized, .ReasonCode = UwbSessionReasonCode::StateChangeWithSessionManagementCommands }),
+            };
+        }
+        return { EncodeStatusResponse(view, UwbStatusOk) };
+    });
+
+    auto device = UwbDevice::Create("fake", std::make_shared<UwbDeviceDriver>(uwbs.ReleaseDriverFileDescriptor()));
+    REQUIRE(device->Initialize());
+
+    SECTION("device commands succeed")
+    {
+        const auto deviceInformation = device->GetDeviceInformation();
+        REQUIRE(deviceInformation.VersionUci == uwb::UwbVersion{ 1, 1, 0 });
+        REQUIRE(device->GetSessionCount() == 2);
+        REQUIRE_NOTHROW(device->Reset());
+    }
+
+    SECTION("session events are routed to the session")
+    {
+        auto callbacks = std::make_shared<linux::test::UwbSessionEventCallbacksTest>();
+        auto session = device->CreateSession(SessionId, callbacks);
+        REQUIRE(session != nullptr);
+        REQUIRE_NOTHROW(session->Configure({}));
+        REQUIRE_NOTHROW(session->StartRanging());
+
+        auto rangingStarted = callbacks->RangingStarted.get_future();
+        REQUIRE(rangingStarted.wait_for(std::chrono::seconds(5)) == std::future_status::ready);
+
+        auto peersChanged = callbacks->PeersChanged.get_future();
+        REQUIRE(peersChanged.wait_for(std::chrono::seconds(5)) == std::future_status::ready);
+        const auto peers = peersChanged.get();
+        REQUIRE(std::size(peers) == 1);
+        REQUIRE(peers.front().GetAddress() == peerMacAddress);
+
+        REQUIRE_NOTHROW(session->Destroy());
+        auto sessionEnded = callbacks->SessionEnded.get_future();
+        REQUIRE(sessionEnded.wait_for(std::chrono::seconds(5)) == std::future_status::ready);
+    }
+
+    SECTION("a session can be resolved")
+    {
+        auto session = device->GetSession(SessionId);
+        REQUIRE(session != nullptr);
+        REQUIRE(session->GetDeviceType() == DeviceType::Controlee);
+    }
+
+    SECTION("a failure status is surfaced as an exception")
+    {
+        rangeStartStatus = UwbStatusSession::NotExist;
+        auto session = device->CreateSession(SessionId, std::make_shared<linux::test::UwbSessionEventCallbacksTest>());
+        REQUIRE_THROWS_AS(session->StartRanging(), UwbException);
+    }
+
+    SECTION("capabilities are not supported")
+    {
+        REQUIRE_THROWS_AS(device->GetCapabilities(), UwbException);
+    }
+}
+
+TEST_CASE("linux uwb device rejects commands before it is initialized", "[basic][linux][uci]")
+{
+    using namespace linux::devices;
+    using namespace uwb::protocol::fira;
+
+    auto device = UwbDevice::Create("/dev/null/uci");
+
+    REQUIRE_THROWS_AS(device->GetDeviceInformation(), UwbException);
+    REQUIRE_THROWS_AS(device->GetSessionCount(), UwbException);
+    REQUIRE_THROWS_AS(device->Reset(), UwbException);
+    REQUIRE_THROWS_AS(device->GetSession(1), UwbException);
+    REQUIRE_THROWS_AS(device->CreateSession(1, std::make_shared<linux::test::UwbSessionEventCallbacksTest>()), UwbException);
+}
@@ -0,0 +1,275 @@
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <linux/uwb/UwbDeviceDriver.hxx>
+#include <uwb/protocols/fira/FiraDevice.hxx>
+#include <uwb/protocols/fira/uci/ControlMessageCodec.hxx>
+
+#include "FakeUwbs.hxx"
+
+namespace linux::test
+{
+/**
+ * @brief Collects the notifications received by a driver.
+ */
+struct NotificationCollector
+{
+    void
+    operator()(const uwb::protocol::fira::uci::ControlMessageView& notification)
+    {
+        std::lock_guard notificationsLock{ Gate };
+        Notifications.push_back(uwb::protocol::fira::uci::ControlMessage::FromView(notification));
+        NotificationReceived.notify_all();
+    }
+
+    bool
+    WaitFor(std::size_t numberOfNotifications)
+    {
+        std::unique_lock notificationsLock{ Gate };
+        return NotificationReceived.wait_for(notificationsLock, std::chrono::seconds(5), [&] {
+            return std::size(Notifications) >= numberOfNotifications;
+        });
+    }
+
+    std::mutex Gate;
+    std::condition_variable NotificationReceived;
+    std::vector<uwb::protocol::fira::uci::ControlMessage> Notifications;
+};
+} // namespace linux::test
+
+TEST_CASE("uci driver matches responses to commands", "[basic][linux][uci]")
+{
+    using namespace linux::devices;
+    using namespace uwb::protocol::fira;
+    using namespace uwb::protocol::fira::uci;
+
+    const std::vector<uint8_t> deviceInformationEncoded{ 0x00, 0x01, 0x10, 0x01, 0x30, 0x01, 0x25, 0x01, 0x00, 0x02, 0xCA, 0xFE };
+    const auto deviceInformation = DecodeGetDeviceInfoResponse(deviceInformationEncoded);
+    REQUIRE(deviceInformation.has_value());
+
+    linux::test::FakeUwbs uwbs;
+    UwbDeviceDriver driver{ uwbs.ReleaseDriverFileDescriptor() };
+
+    SECTION("a single packet response is returned")
+    {
+        uwbs.Start([&](const ControlMessage& command) -> std::vector<ControlMessage> {
+            return { EncodeStatusResponse(command.View(), UwbStatusOk) };
+        });
+        driver.Start(nullptr);
+        REQUIRE(driver.IsRunning());
+
+        const auto response = driver.ExecuteCommand(EncodeDeviceResetCommand());
+        REQUIRE(response.View().Is(MessageType::Response, GroupId::Core, CoreOpcodeId::DeviceReset));
+        REQUIRE(DecodeStatusResponse(response.Payload) == UwbStatus{ UwbStatusOk });
+        REQUIRE(driver.ExecuteCommand(EncodeDeviceResetCommand(), DecodeStatusResponse) == UwbStatus{ UwbStatusOk });
+        REQUIRE(std::size(uwbs.GetCommandsReceived()) == 2);
+    }
+
+    SECTION("a segmented response is reassembled")
+    {
+        uwbs.Start([&](const ControlMessage&) -> std::vector<ControlMessage> {
+            return {};
+        });
+        driver.Start(nullptr);
+
+        auto response = std::async(std::launch::async, [&] {
+            return driver.ExecuteCommand(EncodeGetDeviceInfoCommand(), DecodeGetDeviceInfoResponse);
+        });
+        while (std::empty(uwbs.GetCommandsReceived())) {
+            std::this_thread::yield();
+        }
+        uwbs.Send(EncodeGetDeviceInfoResponse(*deviceInformation), 5);
+
+        const auto deviceInformationReceived = response.get();
+        REQUIRE(deviceInformationReceived.VersionUci == deviceInformation->VersionUci);
+        REQUIRE(deviceInformationReceived.VersionPhy == deviceInformation->VersionPhy);
+    }
+
+    SECTION("a response that doesn't match the command is discarded")
+    {
+        uwbs.Start([&](const ControlMessage& command) -> std::vector<ControlMessage> {
+            return {
+                EncodeSessionGetCountResponse({ .Status = UwbStatusOk, .Count = 1 }),
+                EncodeStatusResponse(command.View(), UwbStatusOk),
+            };
+        });
+        driver.Start(nullptr);
+
+        REQUIRE(driver.ExecuteCommand(EncodeDeviceResetCommand(), DecodeStatusResponse) == UwbStatus{ UwbStatusOk });
+        REQUIRE(driver.GetNumberOfResponsesDiscarded() == 1);
+    }
+
+    SECTION("a command without a response times out")
+    {
+        uwbs.Start([&](const ControlMessage& command) -> std::vector<ControlMessage> {
+            if (command.View().Is(MessageType::Command, GroupId::Core, CoreOpcodeId::DeviceReset)) {
+                return {};
+            }
+            return { EncodeGetDeviceInfoResponse(*deviceInformation) };
+        });
+        driver.Start(nullptr);
+
+        try {
+            driver.ExecuteCommand(EncodeDeviceResetCommand(), std::chrono::milliseconds(50));
+            FAIL("command did not time out");
+        } catch (const std::system_error& e) {
+            REQUIRE(e.code() == std::errc::timed_out);
+        }
+        REQUIRE_THROWS_AS(driver.ExecuteCommand(EncodeDeviceResetCommand(), DecodeStatusResponse, std::chrono::milliseconds(50)), UwbException);
+
+        // Subsequent commands are unaffected.
+        const auto deviceInformationReceived = driver.ExecuteCommand(EncodeGetDeviceInfoCommand(), DecodeGetDeviceInfoResponse);
+        REQUIRE(deviceInformationReceived.VersionMac == deviceInformation->VersionMac);
+    }
+
+    SECTION("a late response to a timed out command is discarded")
+    {
+        std::size_t numberOfCommands = 0;
+        uwbs.Start([&](const ControlMessage& command) -> std::vector<ControlMessage> {
+            if (numberOfCommands++ == 0) {
+                return {};
+            }
+            return {
+                EncodeStatusResponse(command.View(), UwbStatusGeneric::Failed),
+                EncodeStatusResponse(command.View(), UwbStatusOk),
+            };
+        });
+        driver.Start(nullptr);
+
+        REQUIRE_THROWS_AS(driver.ExecuteCommand(EncodeDeviceResetCommand(), std::chrono::milliseconds(50)), std::system_error);
+        REQUIRE(driver.ExecuteCommand(EncodeDeviceResetCommand(), DecodeStatusResponse) == UwbStatus{ UwbStatusOk });
+        REQUIRE(driver.GetNumberOfResponsesDiscarded() == 1);
+    }
+
+    SECTION("a hang up fails the outstanding command")
+    {
+        std::promise<void> commandReceived;
+        uwbs.Start([&](const ControlMessage&) -> std::vector<ControlMessage> {
+            commandReceived.set_value();
+            return {};
+        });
+        driver.Start(nullptr);
+
+        auto response = std::async(std::launch::async, [&] {
+            return driver.ExecuteCommand(EncodeDeviceResetCommand(), std::chrono::seconds(10));
+        });
+        commandReceived.get_future().wait();
+        uwbs.Close();
+
+        REQUIRE_THROWS_AS(response.get(), std::system_error);
+        REQUIRE_FALSE(driver.IsRunning());
+        REQUIRE_THROWS_AS(driver.ExecuteCommand(EncodeDeviceResetCommand()), std::system_error);
+    }
+
+    SECTION("the driver can't be started twice")
+    {
+        driver.Start(nullptr);
+        REQUIRE_THROWS_AS(driver.Start(nullptr), std::system_error);
+        driver.Stop();
+        REQUIRE_FALSE(driver.IsRunning());
+    }
+}
+
+TEST_CASE("uci driver delivers notifications", "[basic][linux][uci]")
+{
+    using namespace linux::devices;
+    using namespace uwb::protocol::fira;
+    using namespace uwb::protocol::fira::uci;
+
+    linux::test::FakeUwbs uwbs;
+    UwbDeviceDriver driver{ uwbs.ReleaseDriverFileDescriptor() };
+    auto collector = std::make_shared<linux::test::NotificationCollector>();
+    driver.Start([collector](const ControlMessageView& notification) {
+        (*collector)(notification);
+    });
+
+    const auto deviceStatus = EncodeDeviceStatusNotification({ .State = UwbDeviceState::Ready });
+    const auto sessionStatus = EncodeSessionStatusNotification({ .SessionId = 7, .State = UwbSessionState::Active, .ReasonCode = UwbSessionReasonCode::StateChangeWithSessionManagementCommands });
+
+    SECTION("notifications are delivered in order")
+    {
+        uwbs.Send(deviceStatus);
+        uwbs.Send(sessionStatus, 2);
+        REQUIRE(collector->WaitFor(2));
+        REQUIRE(collector->Notifications[0] == deviceStatus);
+        REQUIRE(collector->Notifications[1] == sessionStatus);
+    }
+
+    SECTION("packets split across reads are reassembled")
+    {
+        auto data = deviceStatus.Encode();
+        const auto sessionStatusEncoded = sessionStatus.Encode();
+        data.insert(std::end(data), std::cbegin(sessionStatusEncoded), std::cend(sessionStatusEncoded));
+        for (const auto octet : data) {
+            uwbs.SendBytes(std::span<const uint8_t>{ &octet, 1 });
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+        }
+
+        REQUIRE(collector->WaitFor(2));
+        REQUIRE(collector->Notifications[0] == deviceStatus);
+        REQUIRE(collector->Notifications[1] == sessionStatus);
+    }
+
+    SECTION("data packets are skipped")
+    {
+        std::vector<uint8_t> data{ 0x00, 0x00, 0x02, 0x00, 0xAA, 0xBB };
+        const auto deviceStatusEncoded = deviceStatus.Encode();
+        data.insert(std::end(data), std::cbegin(deviceStatusEncoded), std::cend(deviceStatusEncoded));
+        uwbs.SendBytes(data);
+
+        // A data packet larger than the receive buffer.
+        std::vector<uint8_t> dataLarge(4 + 0x1000, 0xCC);
+        dataLarge[0] = 0x00;
+        dataLarge[2] = 0x00;
+        dataLarge[3] = 0x10;
+        uwbs.SendBytes(dataLarge);
+        uwbs.Send(sessionStatus);
+
+        REQUIRE(collector->WaitFor(2));
+        REQUIRE(collector->Notifications[0] == deviceStatus);
+        REQUIRE(collector->Notifications[1] == sessionStatus);
+        REQUIRE(driver.IsRunning());
+    }
+
+    driver.Stop();
+}
+
+TEST_CASE("uci driver notification handlers can execute commands", "[basic][linux][uci]")
+{
+    using namespace linux::devices;
+    using namespace uwb::protocol::fira;
+    using namespace uwb::protocol::fira::uci;
+
+    linux::test::FakeUwbs uwbs;
+    UwbDeviceDriver driver{ uwbs.ReleaseDriverFileDescriptor() };
+    uwbs.Start([&](const ControlMessage& command) -> std::vector<ControlMessage> {
+        return { EncodeStatusResponse(command.View(), UwbStatusOk) };
+    });
+
+    std::promise<UwbStatus> statusReceived;
+    driver.Start([&](const ControlMessageView&) {
+        try {
+            statusReceived.set_value(driver.ExecuteCommand(EncodeDeviceResetCommand(), DecodeStatusResponse, std::chrono::seconds(5)));
+        } catch (...) {
+            statusReceived.set_exception(std::current_exception());
+        }
+    });
+
+    uwbs.Send(EncodeDeviceStatusNotification({ .State = UwbDeviceState::Ready }));
+    auto status = statusReceived.get_future();
+    REQUIRE(status.wait_for(std::chrono::seconds(10)) == std::future_status::ready);
+    REQUIRE(status.get() == UwbStatus{ UwbStatusOk });
+
+    driver.Stop();
+}
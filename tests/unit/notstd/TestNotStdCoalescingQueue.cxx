@@ -0,0 +1,248 @@
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <notstd/coalescing_queue.hxx>
+#include <notstd/inline_task.hxx>
+#include <notstd/strand.hxx>
+#include <notstd/thread_pool.hxx>
+
+namespace notstd::test
+{
+/**
+ * @brief Executor which holds scheduled tasks until they're explicitly run.
+ */
+struct ManualExecutor
+{
+    void
+    RunAll()
+    {
+        auto tasks = std::move(Tasks);
+        Tasks.clear();
+        for (auto& task : tasks) {
+            task();
+        }
+    }
+
+    std::vector<notstd::inline_task> Tasks{};
+};
+} // namespace notstd::test
+
+TEST_CASE("coalescing_queue runs the latest task for each key", "[notstd][shared][utility]")
+{
+    using notstd::coalescing_queue;
+    using notstd::inline_task;
+
+    notstd::test::ManualExecutor executor{};
+    coalescing_queue<std::string> queue{ [&](inline_task task) {
+        executor.Tasks.push_back(std::move(task));
+    } };
+
+    SECTION("tasks with distinct keys all run in the order they were posted")
+    {
+        std::vector<int> order{};
+        for (int i = 0; i < 3; i++) {
+            REQUIRE(queue.post(std::to_string(i), [&order, i] {
+                order.push_back(i);
+            }));
+        }
+        REQUIRE(queue.size() == 3);
+        REQUIRE(executor.Tasks.size() == 1);
+
+        executor.RunAll();
+        REQUIRE(order == std::vector<int>{ 0, 1, 2 });
+        REQUIRE(queue.size() == 0);
+        REQUIRE(queue.coalesced() == 0);
+    }
+
+    SECTION("newer tasks replace pending ones with the same key, keeping their position")
+    {
+        std::vector<int> order{};
+        queue.post("a", [&] {
+            order.push_back(1);
+        });
+        queue.post("b", [&] {
+            order.push_back(2);
+        });
+        queue.post("a", [&] {
+            order.push_back(3);
+        });
+        REQUIRE(queue.size() == 2);
+        REQUIRE(queue.coalesced() == 1);
+
+        executor.RunAll();
+        REQUIRE(order == std::vector<int>{ 3, 2 });
+    }
+
+    SECTION("posting after the queue is drained schedules it again")
+    {
+        int runs = 0;
+        queue.post("a", [&] {
+            runs++;
+        });
+        executor.RunAll();
+        queue.post("a", [&] {
+            runs++;
+        });
+        REQUIRE(executor.Tasks.size() == 1);
+        executor.RunAll();
+        REQUIRE(runs == 2);
+        REQUIRE(queue.coalesced() == 0);
+    }
+
+    SECTION("tasks posted while draining replace pending tasks")
+    {
+        std::vector<int> order{};
+        queue.post("a", [&] {
+            order.push_back(1);
+            queue.post("b", [&] {
+                order.push_back(3);
+            });
+        });
+        queue.post("b", [&] {
+            order.push_back(2);
+        });
+
+        executor.RunAll();
+        REQUIRE(order == std::vector<int>{ 1, 3 });
+        REQUIRE(queue.coalesced() == 1);
+        REQUIRE(executor.Tasks.empty());
+    }
+
+    SECTION("exceptions thrown by tasks don't stop the drain")
+    {
+        bool hasRun = false;
+        queue.post("a", [] {
+            throw std::runtime_error("task failure");
+        });
+        queue.post("b", [&] {
+            hasRun = true;
+        });
+
+        executor.RunAll();
+        REQUIRE(hasRun);
+    }
+}
+
+TEST_CASE("coalescing_queue bounds the number of pending tasks", "[notstd][shared][utility]")
+{
+    using notstd::coalescing_queue;
+    using notstd::inline_task;
+
+    notstd::test::ManualExecutor executor{};
+
+    SECTION("tasks with new keys are dropped when the queue is full")
+    {
+        coalescing_queue<int> queue{ [&](inline_task task) {
+            executor.Tasks.push_back(std::move(task));
+        }, 2 };
+        std::vector<int> order{};
+        for (int i = 0; i < 4; i++) {
+            queue.post(i, [&order, i] {
+                order.push_back(i);
+            });
+        }
+        REQUIRE(queue.size() == 2);
+        REQUIRE(queue.dropped() == 2);
+
+        // Existing keys can still be replaced while full.
+        REQUIRE(queue.post(1, [&order] {
+            order.push_back(10);
+        }));
+
+        executor.RunAll();
+        REQUIRE(order == std::vector<int>{ 0, 10 });
+    }
+
+    SECTION("pending tasks are dropped when the queue is destroyed")
+    {
+        bool hasRun = false;
+        {
+            coalescing_queue<int> queue{ [&](inline_task task) {
+                executor.Tasks.push_back(std::move(task));
+            } };
+            queue.post(0, [&] {
+                hasRun = true;
+            });
+        }
+
+        executor.RunAll();
+        REQUIRE(!hasRun);
+    }
+
+    SECTION("rejected drain tasks are scheduled again on the next post")
+    {
+        bool reject = true;
+        coalescing_queue<int> queue{ [&](inline_task task) {
+            if (reject) {
+                throw std::runtime_error("executor stopped");
+            }
+            executor.Tasks.push_back(std::move(task));
+        } };
+
+        REQUIRE_THROWS(queue.post(0, [] {}));
+        reject = false;
+        REQUIRE(queue.post(1, [] {}));
+        REQUIRE(executor.Tasks.size() == 1);
+        executor.RunAll();
+        REQUIRE(queue.size() == 0);
+    }
+}
+
+TEST_CASE("coalescing_queue delivers the latest state to a slow consumer", "[notstd][shared][utility]")
+{
+    using notstd::coalescing_queue;
+    using notstd::inline_task;
+    using namespace std::chrono_literals;
+
+    static constexpr int NumKeys = 4;
+    static constexpr int NumUpdates = 10000;
+
+    notstd::thread_pool pool{ 2 };
+    notstd::strand strand{ pool };
+    std::vector<int> latest(NumKeys, -1);
+    std::atomic<int> runs{ 0 };
+    std::atomic<bool> isInOrder{ true };
+    {
+        coalescing_queue<int> queue{ [&](inline_task task) {
+            strand.post_detached(std::move(task));
+        } };
+
+        for (int update = 0; update < NumUpdates; update++) {
+            for (int key = 0; key < NumKeys; key++) {
+                queue.post(key, [&latest, &runs, &isInOrder, key, update] {
+                    if (update <= latest[key]) {
+                        isInOrder = false;
+                    }
+                    latest[key] = update;
+                    runs++;
+                    std::this_thread::sleep_for(1us);
+                });
+            }
+            REQUIRE(queue.size() <= NumKeys);
+        }
+
+        strand.post([] {}).wait();
+        std::promise<void> drained{};
+        queue.post(NumKeys, [&] {
+            drained.set_value();
+        });
+        REQUIRE(drained.get_future().wait_for(5s) == std::future_status::ready);
+
+        REQUIRE(static_cast<std::uint64_t>(runs) + queue.coalesced() == NumKeys * NumUpdates);
+        REQUIRE(queue.dropped() == 0);
+    }
+
+    REQUIRE(isInOrder);
+    for (int key = 0; key < NumKeys; key++) {
+        REQUIRE(latest[key] == NumUpdates - 1);
+    }
+}
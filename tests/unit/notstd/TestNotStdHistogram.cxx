@@ -0,0 +1,108 @@
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <utility>
+
+#include <catch2/catch_test_macros.hpp>
+#include <notstd/histogram.hxx>
+
+TEST_CASE("histogram buckets cover all values", "[notstd][shared][utility][histogram]")
+{
+    using notstd::histogram;
+
+    SECTION("small values have their own bucket")
+    {
+        for (std::uint64_t value = 0; value < histogram::sub_bucket_count; value++) {
+            const auto index = histogram::bucket_index(value);
+            REQUIRE(index == value);
+            REQUIRE(histogram::bucket_lower_bound(index) == value);
+            REQUIRE(histogram::bucket_upper_bound(index) == value);
+        }
+    }
+
+    SECTION("buckets are contiguous")
+    {
+        REQUIRE(histogram::bucket_lower_bound(0) == 0);
+        for (std::size_t index = 1; index < histogram::bucket_count; index++) {
+            REQUIRE(histogram::bucket_lower_bound(index) == histogram::bucket_upper_bound(index - 1) + 1);
+        }
+        REQUIRE(histogram::bucket_upper_bound(histogram::bucket_count - 1) == std::numeric_limits<std::uint64_t>::max());
+    }
+
+    SECTION("values are held by the bucket whose bounds contain them")
+    {
+        for (std::uint64_t value = 1; value < (std::uint64_t{ 1 } << 60); value = (value * 3) + 1) {
+            const auto index = histogram::bucket_index(value);
+            REQUIRE(index < histogram::bucket_count);
+            REQUIRE(histogram::bucket_lower_bound(index) <= value);
+            REQUIRE(histogram::bucket_upper_bound(index) >= value);
+            REQUIRE(histogram::bucket_index(histogram::bucket_lower_bound(index)) == index);
+            REQUIRE(histogram::bucket_index(histogram::bucket_upper_bound(index)) == index);
+        }
+        REQUIRE(histogram::bucket_index(std::numeric_limits<std::uint64_t>::max()) == histogram::bucket_count - 1);
+    }
+
+    SECTION("bucket width is bounded relative to the values it holds")
+    {
+        for (std::size_t index = histogram::sub_bucket_count; index < histogram::bucket_count; index++) {
+            const auto width = histogram::bucket_upper_bound(index) - histogram::bucket_lower_bound(index) + 1;
+            REQUIRE(width * histogram::sub_bucket_count <= histogram::bucket_lower_bound(index));
+        }
+    }
+}
+
+TEST_CASE("histogram snapshots summarize recorded values", "[notstd][shared][utility][histogram]")
+{
+    using notstd::histogram;
+
+    histogram values{};
+
+    SECTION("empty histogram reports zeros")
+    {
+        const auto snapshot = values.get_snapshot();
+        REQUIRE(snapshot.count == 0);
+        REQUIRE(snapshot.sum == 0);
+        REQUIRE(snapshot.max == 0);
+        REQUIRE(snapshot.mean() == 0.0);
+        REQUIRE(snapshot.value_at_percentile(50) == 0);
+    }
+
+    SECTION("count, sum, mean, and maximum are exact")
+    {
+        for (std::uint64_t value = 1; value <= 100; value++) {
+            values.record(value);
+        }
+
+        const auto snapshot = values.get_snapshot();
+        REQUIRE(snapshot.count == 100);
+        REQUIRE(snapshot.sum == 5050);
+        REQUIRE(snapshot.max == 100);
+        REQUIRE(snapshot.mean() == 50.5);
+    }
+
+    SECTION("percentiles are within the resolution of the buckets")
+    {
+        for (std::uint64_t value = 1; value <= 1000; value++) {
+            values.record(value * 1000);
+        }
+
+        const auto snapshot = values.get_snapshot();
+        for (const auto& [percentile, expected] : { std::pair{ 50.0, 500000ULL }, std::pair{ 90.0, 900000ULL }, std::pair{ 99.0, 990000ULL } }) {
+            const auto value = snapshot.value_at_percentile(percentile);
+            REQUIRE(value >= expected);
+            REQUIRE(value - expected <= expected / histogram::sub_bucket_count);
+        }
+        REQUIRE(snapshot.value_at_percentile(100) == 1000000);
+        REQUIRE(snapshot.value_at_percentile(0) <= 1000 + (1000 / histogram::sub_bucket_count));
+    }
+
+    SECTION("snapshot is unaffected by later records")
+    {
+        values.record(1);
+        const auto snapshot = values.get_snapshot();
+        values.record(2);
+        REQUIRE(snapshot.count == 1);
+        REQUIRE(values.get_snapshot().count == 2);
+    }
+}
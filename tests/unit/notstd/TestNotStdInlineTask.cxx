@@ -0,0 +1,118 @@
+
+#include <array>
+#include <functional>
+#include <memory>
+#include <utility>
+
+#include <catch2/catch_test_macros.hpp>
+#include <notstd/inline_task.hxx>
+
+TEST_CASE("inline_task can be created", "[notstd][shared][utility]")
+{
+    using notstd::inline_task;
+
+    SECTION("default constructed task is empty")
+    {
+        inline_task task{};
+        REQUIRE(!task);
+        REQUIRE(!task.is_inline());
+    }
+
+    SECTION("small callables are stored inline")
+    {
+        int value = 0;
+        inline_task task{ [&value] {
+            value++;
+        } };
+        REQUIRE(task);
+        REQUIRE(task.is_inline());
+        task();
+        REQUIRE(value == 1);
+    }
+
+    SECTION("callables up to the inline capacity are stored inline")
+    {
+        std::function<void()> function = [] {};
+        int* value = nullptr;
+        inline_task task{ [value, function = std::move(function)] {
+            (void)value;
+            function();
+        } };
+        REQUIRE(task.is_inline());
+    }
+
+    SECTION("large callables are stored on the heap")
+    {
+        std::array<char, inline_task::inline_capacity + 1> data{};
+        int value = 0;
+        inline_task task{ [data, &value] {
+            value = data.size();
+        } };
+        REQUIRE(task);
+        REQUIRE(!task.is_inline());
+        task();
+        REQUIRE(value == inline_task::inline_capacity + 1);
+    }
+
+    SECTION("move-only callables are supported")
+    {
+        auto valuePtr = std::make_unique<int>(5);
+        int value = 0;
+        inline_task task{ [valuePtr = std::move(valuePtr), &value] {
+            value = *valuePtr;
+        } };
+        task();
+        REQUIRE(value == 5);
+    }
+}
+
+TEST_CASE("inline_task can be moved and destroyed", "[notstd][shared][utility]")
+{
+    using notstd::inline_task;
+
+    auto tracker = std::make_shared<int>(0);
+
+    SECTION("moving transfers the callable")
+    {
+        for (const bool stored_inline : { true, false }) {
+            std::array<char, inline_task::inline_capacity> data{};
+            inline_task task = stored_inline
+                ? inline_task{ [tracker] { (*tracker)++; } }
+                : inline_task{ [tracker, data] { (*tracker) += static_cast<int>(data.size()) > 0 ? 1 : 0; } };
+            REQUIRE(task.is_inline() == stored_inline);
+
+            inline_task taskMoved{ std::move(task) };
+            REQUIRE(!task);
+            REQUIRE(taskMoved);
+            REQUIRE(tracker.use_count() == 2);
+
+            inline_task taskAssigned{};
+            taskAssigned = std::move(taskMoved);
+            REQUIRE(!taskMoved);
+            REQUIRE(tracker.use_count() == 2);
+
+            taskAssigned();
+            taskAssigned.reset();
+            REQUIRE(!taskAssigned);
+            REQUIRE(tracker.use_count() == 1);
+        }
+        REQUIRE(*tracker == 2);
+    }
+
+    SECTION("assigning destroys the previous callable")
+    {
+        inline_task task{ [tracker] {} };
+        REQUIRE(tracker.use_count() == 2);
+        task = inline_task{ [] {} };
+        REQUIRE(tracker.use_count() == 1);
+    }
+
+    SECTION("destroying destroys the callable")
+    {
+        {
+            inline_task task{ [tracker] {} };
+            REQUIRE(tracker.use_count() == 2);
+        }
+        REQUIRE(tracker.use_count() == 1);
+    }
+}
@@ -0,0 +1,127 @@
+
+#include <cstddef>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <notstd/mpsc_ring.hxx>
+
+TEST_CASE("mpsc_ring capacity is rounded up to a power of two", "[notstd][shared][utility]")
+{
+    using notstd::mpsc_ring;
+
+    REQUIRE(mpsc_ring<int>{ 0 }.capacity() == 2);
+    REQUIRE(mpsc_ring<int>{ 2 }.capacity() == 2);
+    REQUIRE(mpsc_ring<int>{ 3 }.capacity() == 4);
+    REQUIRE(mpsc_ring<int>{ 1000 }.capacity() == 1024);
+}
+
+TEST_CASE("mpsc_ring values are popped in first-in-first-out (FIFO) order", "[notstd][shared][utility]")
+{
+    using notstd::mpsc_ring;
+
+    mpsc_ring<int> ring{ 4 };
+
+    SECTION("an empty ring has no values")
+    {
+        REQUIRE(ring.empty());
+        REQUIRE(!ring.try_pop().has_value());
+    }
+
+    SECTION("pushing to a full ring fails")
+    {
+        for (int i = 0; i < 4; i++) {
+            REQUIRE(ring.try_push(i));
+        }
+
+        int valueOverflow = 4;
+        REQUIRE(!ring.try_push(valueOverflow));
+        for (int i = 0; i < 4; i++) {
+            REQUIRE(ring.try_pop() == i);
+        }
+        REQUIRE(ring.empty());
+    }
+
+    SECTION("pushing to a full ring does not consume the value")
+    {
+        mpsc_ring<std::unique_ptr<int>> ringUnique{ 2 };
+        for (int i = 0; i < 2; i++) {
+            auto value = std::make_unique<int>(i);
+            REQUIRE(ringUnique.try_push(value));
+            REQUIRE(value == nullptr);
+        }
+
+        auto valueOverflow = std::make_unique<int>(2);
+        REQUIRE(!ringUnique.try_push(valueOverflow));
+        REQUIRE(valueOverflow != nullptr);
+    }
+
+    SECTION("values wrap around the ring")
+    {
+        for (int i = 0; i < 100; i++) {
+            REQUIRE(ring.try_push(i));
+            REQUIRE(!ring.empty());
+            REQUIRE(ring.try_pop() == i);
+            REQUIRE(ring.empty());
+        }
+    }
+
+    SECTION("values still held are destroyed with the ring")
+    {
+        auto value = std::make_shared<int>(0);
+        {
+            mpsc_ring<std::shared_ptr<int>> ringShared{ 4 };
+            auto valueCopy = value;
+            REQUIRE(ringShared.try_push(valueCopy));
+            REQUIRE(value.use_count() == 2);
+        }
+        REQUIRE(value.use_count() == 1);
+    }
+}
+
+TEST_CASE("mpsc_ring supports multiple concurrent producers", "[notstd][shared][utility]")
+{
+    using notstd::mpsc_ring;
+
+    static constexpr std::size_t NumProducers = 4;
+    static constexpr std::size_t NumValuesPerProducer = 10000;
+
+    struct value_t
+    {
+        std::size_t producer;
+        std::size_t sequence;
+    };
+
+    mpsc_ring<value_t> ring{ 64 };
+    std::vector<std::thread> producers{};
+    for (std::size_t producer = 0; producer < NumProducers; producer++) {
+        producers.emplace_back([&ring, producer] {
+            for (std::size_t sequence = 0; sequence < NumValuesPerProducer; sequence++) {
+                value_t value{ producer, sequence };
+                while (!ring.try_push(value)) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    // Each producer's values must be popped in the order they were pushed.
+    std::vector<std::size_t> sequenceNext(NumProducers, 0);
+    for (std::size_t numValues = 0; numValues < NumProducers * NumValuesPerProducer;) {
+        auto value = ring.try_pop();
+        if (!value.has_value()) {
+            std::this_thread::yield();
+            continue;
+        }
+        REQUIRE(value->sequence == sequenceNext[value->producer]);
+        sequenceNext[value->producer]++;
+        numValues++;
+    }
+
+    for (auto& producer : producers) {
+        producer.join();
+    }
+
+    REQUIRE(ring.empty());
+}
@@ -0,0 +1,186 @@
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <future>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <notstd/strand.hxx>
+#include <notstd/thread_pool.hxx>
+
+TEST_CASE("strand can be created", "[notstd][shared][utility]")
+{
+    using notstd::strand;
+    using notstd::thread_pool;
+
+    SECTION("creation on the default pool doesn't cause a crash")
+    {
+        REQUIRE_NOTHROW(strand{});
+    }
+
+    SECTION("creation on an explicit pool doesn't cause a crash")
+    {
+        thread_pool pool{ 1 };
+        REQUIRE_NOTHROW(strand{ pool });
+    }
+}
+
+TEST_CASE("strand tasks are executed serially", "[notstd][shared][utility]")
+{
+    using notstd::strand;
+    using notstd::thread_pool;
+
+    static constexpr std::size_t NumThreads = 4;
+    static constexpr std::size_t NumStrands = 16;
+    static constexpr std::size_t NumTasks = 200;
+
+    thread_pool pool{ NumThreads };
+
+    SECTION("tasks run in the order they were posted")
+    {
+        std::vector<std::unique_ptr<strand>> strands{};
+        std::vector<std::vector<std::size_t>> order(NumStrands);
+        for (std::size_t i = 0; i < NumStrands; i++) {
+            strands.push_back(std::make_unique<strand>(pool));
+        }
+
+        for (std::size_t task = 0; task < NumTasks; task++) {
+            for (std::size_t i = 0; i < NumStrands; i++) {
+                strands[i]->post_detached([&order, i, task] {
+                    order[i].push_back(task);
+                });
+            }
+        }
+
+        for (auto& strandTest : strands) {
+            strandTest->stop_and_wait_for_task_completion();
+        }
+
+        for (const auto& strandOrder : order) {
+            REQUIRE(strandOrder.size() == NumTasks);
+            for (std::size_t task = 0; task < NumTasks; task++) {
+                REQUIRE(strandOrder[task] == task);
+            }
+        }
+    }
+
+    SECTION("tasks don't overlap")
+    {
+        std::atomic<bool> running{ false };
+        std::atomic<bool> overlapped{ false };
+        strand strandTest{ pool };
+        for (std::size_t task = 0; task < NumTasks; task++) {
+            strandTest.post_detached([&] {
+                if (running.exchange(true)) {
+                    overlapped = true;
+                }
+                std::this_thread::yield();
+                running = false;
+            });
+        }
+
+        strandTest.stop_and_wait_for_task_completion();
+        REQUIRE(!overlapped);
+    }
+
+    SECTION("futures complete once their task has run")
+    {
+        strand strandTest{ pool };
+        bool hasRun = false;
+        auto future = strandTest.post([&] {
+            hasRun = true;
+        });
+        REQUIRE(future.wait_for(std::chrono::seconds(10)) == std::future_status::ready);
+        REQUIRE_NOTHROW(future.get());
+        REQUIRE(hasRun);
+    }
+
+    SECTION("task exceptions are propagated through futures")
+    {
+        strand strandTest{ pool };
+        auto future = strandTest.post([] {
+            throw std::runtime_error("task failed");
+        });
+        REQUIRE_THROWS_AS(future.get(), std::runtime_error);
+    }
+}
+
+TEST_CASE("strand can be stopped", "[notstd][shared][utility]")
+{
+    using notstd::strand;
+    using notstd::thread_pool;
+
+    thread_pool pool{ 2 };
+
+    SECTION("pending tasks are run by default")
+    {
+        std::size_t tasksRun = 0;
+        {
+            strand strandTest{ pool };
+            for (std::size_t i = 0; i < 100; i++) {
+                strandTest.post_detached([&] {
+                    tasksRun++;
+                });
+            }
+        }
+
+        REQUIRE(tasksRun == 100);
+    }
+
+    SECTION("pending tasks can be canceled")
+    {
+        std::promise<void> blockerStarted{};
+        std::promise<void> blockerRelease{};
+        strand strandTest{ pool };
+        strandTest.post_detached([&] {
+            blockerStarted.set_value();
+            blockerRelease.get_future().wait();
+        });
+        auto future = strandTest.post([] {});
+
+        blockerStarted.get_future().wait();
+        strandTest.stop(strand::pending_task_action::cancel);
+        blockerRelease.set_value();
+        strandTest.stop_and_wait_for_task_completion();
+
+        REQUIRE_THROWS_AS(future.get(), std::future_error);
+    }
+
+    SECTION("posting after stop throws")
+    {
+        strand strandTest{ pool };
+        strandTest.stop();
+        REQUIRE_THROWS(strandTest.post([] {}));
+        REQUIRE_THROWS(strandTest.post_detached([] {}));
+    }
+
+    SECTION("waiting from within a task doesn't deadlock")
+    {
+        strand strandTest{ pool };
+        auto future = strandTest.post([&] {
+            strandTest.stop_and_wait_for_task_completion();
+        });
+        REQUIRE(future.wait_for(std::chrono::seconds(10)) == std::future_status::ready);
+    }
+}
+
+TEST_CASE("strand reports the executing thread", "[notstd][shared][utility]")
+{
+    using notstd::strand;
+    using notstd::thread_pool;
+
+    thread_pool pool{ 1 };
+    strand strandTest{ pool };
+    strand strandOther{ pool };
+    REQUIRE(!strandTest.running_in_this_thread());
+
+    auto result = strandTest.post([&] {
+        REQUIRE(strandTest.running_in_this_thread());
+        REQUIRE(!strandOther.running_in_this_thread());
+    });
+    REQUIRE_NOTHROW(result.get());
+}
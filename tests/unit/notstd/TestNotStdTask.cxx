@@ -0,0 +1,330 @@
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <future>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <notstd/task.hxx>
+#include <notstd/task_queue.hxx>
+#include <notstd/thread_pool.hxx>
+
+namespace notstd::test
+{
+notstd::task<int>
+GetValue(int value)
+{
+    co_return value;
+}
+
+notstd::task<int>
+GetSum(int count)
+{
+    int sum = 0;
+    for (int i = 1; i <= count; i++) {
+        sum += co_await GetValue(i);
+    }
+
+    co_return sum;
+}
+
+notstd::task<void>
+ThrowError()
+{
+    throw std::runtime_error("task failure");
+    co_return;
+}
+
+notstd::task<bool>
+CatchError()
+{
+    try {
+        co_await ThrowError();
+    } catch (const std::runtime_error&) {
+        co_return true;
+    }
+
+    co_return false;
+}
+
+notstd::task<std::thread::id>
+GetThreadId()
+{
+    co_return std::this_thread::get_id();
+}
+
+notstd::task<long>
+GetUseCount(std::shared_ptr<int> token)
+{
+    co_return token.use_count();
+}
+
+template <typename T>
+bool
+IsBrokenPromise(std::future<T>& result)
+{
+    try {
+        result.get();
+    } catch (const std::future_error& error) {
+        return error.code() == std::future_errc::broken_promise;
+    }
+
+    return false;
+}
+
+/**
+ * @brief Blocks the worker thread of a task queue until released, so tasks
+ * posted in the meantime remain pending.
+ */
+struct WorkerBlocker
+{
+    explicit WorkerBlocker(notstd::task_queue::dispatcher& dispatcher)
+    {
+        auto started = Started.get_future();
+        dispatcher.post_detached([this, released = Released.get_future()] {
+            Started.set_value();
+            released.wait();
+        });
+        started.wait();
+    }
+
+    void
+    Release()
+    {
+        Released.set_value();
+    }
+
+    std::promise<void> Started{};
+    std::promise<void> Released{};
+};
+
+notstd::task<bool>
+SwitchTo(notstd::task_queue::dispatcher& dispatcher)
+{
+    co_await dispatcher.schedule();
+    co_return notstd::task_queue::current_dispatcher().get() == &dispatcher;
+}
+
+notstd::task<bool>
+RunBlockingInPool(notstd::thread_pool& pool)
+{
+    const auto dispatcher = notstd::task_queue::current_dispatcher();
+    const bool ranInPool = co_await notstd::run_blocking([&pool] {
+        return pool.running_in_this_thread();
+    },
+        pool);
+
+    co_return ranInPool && (notstd::task_queue::current_dispatcher() == dispatcher);
+}
+
+notstd::task<void>
+RunBlockingError(notstd::thread_pool& pool)
+{
+    co_await notstd::run_blocking([] {
+        throw std::runtime_error("blocking failure");
+    },
+        pool);
+}
+
+/**
+ * @brief Counts the operations in progress, recording the maximum.
+ */
+struct InFlightCounter
+{
+    void
+    Enter()
+    {
+        const auto current = ++Current;
+        auto maximum = Maximum.load();
+        while (current > maximum && !Maximum.compare_exchange_weak(maximum, current)) {}
+    }
+
+    void
+    Exit()
+    {
+        --Current;
+    }
+
+    std::atomic<std::size_t> Current{ 0 };
+    std::atomic<std::size_t> Maximum{ 0 };
+};
+
+notstd::task<std::size_t>
+RunSequence(notstd::thread_pool& pool, InFlightCounter& inFlight, std::size_t numSteps)
+{
+    using namespace std::chrono_literals;
+
+    std::size_t numStepsOnQueue = 0;
+    for (std::size_t step = 0; step < numSteps; step++) {
+        co_await notstd::run_blocking([&inFlight] {
+            inFlight.Enter();
+            std::this_thread::sleep_for(2ms);
+            inFlight.Exit();
+        },
+            pool);
+        if (notstd::task_queue::current_dispatcher() != nullptr) {
+            numStepsOnQueue++;
+        }
+    }
+
+    co_return numStepsOnQueue;
+}
+} // namespace notstd::test
+
+TEST_CASE("task produces the result of the coroutine", "[notstd][shared][utility][coroutine]")
+{
+    using notstd::task_queue;
+
+    task_queue taskQueue{};
+    auto dispatcher = taskQueue.get_dispatcher();
+
+    SECTION("value is produced")
+    {
+        REQUIRE(notstd::spawn(*dispatcher, notstd::test::GetValue(42)).get() == 42);
+    }
+
+    SECTION("nested tasks are awaited in sequence")
+    {
+        REQUIRE(notstd::spawn(*dispatcher, notstd::test::GetSum(100)).get() == 5050);
+    }
+
+    SECTION("exceptions propagate to the awaiting coroutine")
+    {
+        REQUIRE(notstd::spawn(*dispatcher, notstd::test::CatchError()).get());
+    }
+
+    SECTION("exceptions propagate to the spawned future")
+    {
+        auto result = notstd::spawn(*dispatcher, notstd::test::ThrowError());
+        REQUIRE_THROWS_AS(result.get(), std::runtime_error);
+    }
+
+    SECTION("unawaited task doesn't run")
+    {
+        bool hasRun = false;
+        {
+            auto work = [](bool& hasRunTask) -> notstd::task<void> {
+                hasRunTask = true;
+                co_return;
+            }(hasRun);
+        }
+        REQUIRE(!hasRun);
+    }
+}
+
+TEST_CASE("task runs on the task_queue it's scheduled on", "[notstd][shared][utility][coroutine]")
+{
+    using notstd::task_queue;
+
+    task_queue taskQueue{};
+    auto dispatcher = taskQueue.get_dispatcher();
+
+    SECTION("spawned task starts on the worker thread")
+    {
+        std::thread::id workerThreadId{};
+        dispatcher->post([&] {
+            workerThreadId = std::this_thread::get_id();
+        }).wait();
+        REQUIRE(notstd::spawn(*dispatcher, notstd::test::GetThreadId()).get() == workerThreadId);
+    }
+
+    SECTION("schedule switches the coroutine to another queue")
+    {
+        task_queue taskQueueOther{ task_queue::queue_backend::lock_free };
+        auto dispatcherOther = taskQueueOther.get_dispatcher();
+        REQUIRE(notstd::spawn(*dispatcher, notstd::test::SwitchTo(*dispatcherOther)).get());
+    }
+
+    SECTION("current dispatcher is only available on the worker thread")
+    {
+        REQUIRE(task_queue::current_dispatcher() == nullptr);
+        std::shared_ptr<task_queue::dispatcher> dispatcherCurrent{};
+        dispatcher->post([&] {
+            dispatcherCurrent = task_queue::current_dispatcher();
+        }).wait();
+        REQUIRE(dispatcherCurrent == dispatcher);
+    }
+
+    SECTION("spawning on a stopped queue reports an error")
+    {
+        taskQueue.stop();
+        auto result = notstd::spawn(*dispatcher, notstd::test::GetValue(1));
+        REQUIRE_THROWS(result.get());
+    }
+
+    SECTION("spawning on a queue which drops the task destroys it and breaks the promise")
+    {
+        task_queue taskQueueBounded{ 1, task_queue::overflow_policy::drop_newest };
+        auto dispatcherBounded = taskQueueBounded.get_dispatcher();
+        notstd::test::WorkerBlocker blocker{ *dispatcherBounded };
+        dispatcherBounded->post_detached([] {});
+
+        auto token = std::make_shared<int>(0);
+        auto result = notstd::spawn(*dispatcherBounded, notstd::test::GetUseCount(token));
+        REQUIRE(token.use_count() == 1);
+        REQUIRE(notstd::test::IsBrokenPromise(result));
+        blocker.Release();
+    }
+
+    SECTION("spawning on a queue shut down with pending tasks canceled destroys the task and breaks the promise")
+    {
+        auto token = std::make_shared<int>(0);
+        std::future<long> result{};
+        {
+            task_queue taskQueueCanceled{};
+            auto dispatcherCanceled = taskQueueCanceled.get_dispatcher();
+            notstd::test::WorkerBlocker blocker{ *dispatcherCanceled };
+            result = notstd::spawn(*dispatcherCanceled, notstd::test::GetUseCount(token));
+            REQUIRE(token.use_count() == 2);
+            taskQueueCanceled.stop(task_queue::pending_task_action::cancel);
+            blocker.Release();
+        }
+
+        REQUIRE(token.use_count() == 1);
+        REQUIRE(notstd::test::IsBrokenPromise(result));
+    }
+}
+
+TEST_CASE("run_blocking doesn't block the task_queue", "[notstd][shared][utility][coroutine]")
+{
+    using notstd::task_queue;
+    using notstd::thread_pool;
+
+    task_queue taskQueue{};
+    auto dispatcher = taskQueue.get_dispatcher();
+    thread_pool pool{ 4 };
+
+    SECTION("function runs on the pool and the coroutine resumes on the queue")
+    {
+        REQUIRE(notstd::spawn(*dispatcher, notstd::test::RunBlockingInPool(pool)).get());
+    }
+
+    SECTION("exceptions thrown by the function propagate to the coroutine")
+    {
+        auto result = notstd::spawn(*dispatcher, notstd::test::RunBlockingError(pool));
+        REQUIRE_THROWS_AS(result.get(), std::runtime_error);
+    }
+
+    SECTION("a single queue drives many coroutines concurrently")
+    {
+        static constexpr std::size_t NumSequences = 32;
+        static constexpr std::size_t NumSteps = 4;
+
+        notstd::test::InFlightCounter inFlight{};
+        std::vector<std::future<std::size_t>> results{};
+        for (std::size_t i = 0; i < NumSequences; i++) {
+            results.push_back(notstd::spawn(*dispatcher, notstd::test::RunSequence(pool, inFlight, NumSteps)));
+        }
+
+        for (auto& result : results) {
+            REQUIRE(result.get() == NumSteps);
+        }
+        REQUIRE(inFlight.Maximum > 1);
+        REQUIRE(inFlight.Maximum <= pool.size());
+    }
+}
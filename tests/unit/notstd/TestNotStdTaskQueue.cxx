@@ -1,10 +1,15 @@
 
+#include <atomic>
 #include <chrono>
 #include <condition_variable>
+#include <cstdint>
 #include <future>
 #include <memory>
 #include <mutex>
+#include <numeric>
 #include <optional>
+#include <stdexcept>
+#include <thread>
 #include <vector>
 
 #include <catch2/catch_test_macros.hpp>
@@ -37,6 +42,25 @@ struct RunnableTask {
     std::future<void> Future{};
     TaskState State{ TaskState::NotStarted };
 };
+
+/**
+ * @brief Blocks the worker thread of a task_queue until released, so tasks
+ * can be queued up.
+ */
+struct WorkerBlocker
+{
+    explicit WorkerBlocker(notstd::task_queue& taskQueue)
+    {
+        taskQueue.get_dispatcher()->post_detached([this] {
+            Started.set_value();
+            Release.get_future().wait();
+        }, notstd::task_queue::task_priority::control);
+        Started.get_future().wait();
+    }
+
+    std::promise<void> Started{};
+    std::promise<void> Release{};
+};
 } // namespace test
 } // namespace notstd
 
@@ -365,3 +389,744 @@ TEST_CASE("task queue can be explicitly stopped", "[notstd][shared][utility]")
         REQUIRE(numTasksRan == 1);
     }
 }
+
+TEST_CASE("task queue lock-free backend executes tasks", "[notstd][shared][utility]")
+{
+    using notstd::task_queue;
+
+    SECTION("tasks from multiple producers are executed in per-producer FIFO order")
+    {
+        static constexpr std::size_t NumProducers = 4;
+        static constexpr std::size_t NumTasksPerProducer = 1000;
+
+        // Use a small ring so producers regularly find it full.
+        task_queue taskQueue{ task_queue::queue_backend::lock_free, 8 };
+        auto dispatcher = taskQueue.get_dispatcher();
+
+        std::vector<std::vector<std::size_t>> taskValuesActual(NumProducers);
+        std::vector<std::thread> producers{};
+        for (std::size_t producer = 0; producer < NumProducers; producer++) {
+            producers.emplace_back([&, producer] {
+                for (std::size_t i = 0; i < NumTasksPerProducer; i++) {
+                    dispatcher->post([&, producer, i] {
+                        taskValuesActual[producer].push_back(i);
+                    });
+                }
+            });
+        }
+
+        for (auto& producer : producers) {
+            producer.join();
+        }
+        taskQueue.stop_and_wait_for_task_completion();
+
+        std::vector<std::size_t> taskValuesExpected(NumTasksPerProducer);
+        std::iota(std::begin(taskValuesExpected), std::end(taskValuesExpected), 0);
+        for (const auto& taskValues : taskValuesActual) {
+            REQUIRE(taskValues == taskValuesExpected);
+        }
+    }
+
+    SECTION("tasks posted from the queue while the ring is full are executed in order")
+    {
+        task_queue taskQueue{ task_queue::queue_backend::lock_free, 2 };
+        auto dispatcher = taskQueue.get_dispatcher();
+
+        std::vector<int> taskValuesActual{};
+        std::vector<std::future<void>> taskFutures{};
+        dispatcher->post([&] {
+            for (int i = 0; i < 10; i++) {
+                taskFutures.emplace_back(dispatcher->post([&, i] {
+                    taskValuesActual.push_back(i);
+                }));
+            }
+        }).get();
+
+        for (auto& taskFuture : taskFutures) {
+            REQUIRE(taskFuture.wait_for(1s) == std::future_status::ready);
+        }
+        REQUIRE(taskValuesActual == std::vector<int>{ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 });
+    }
+
+    SECTION("stopping queue executes all pending tasks by default")
+    {
+        std::atomic<std::size_t> numTasksRan = 0;
+        {
+            task_queue taskQueue{ task_queue::queue_backend::lock_free };
+            for (std::size_t i = 0; i < 100; i++) {
+                taskQueue.get_dispatcher()->post([&] {
+                    numTasksRan++;
+                });
+            }
+            taskQueue.stop();
+            REQUIRE_THROWS(taskQueue.get_dispatcher()->post([] {}));
+        }
+
+        REQUIRE(numTasksRan == 100);
+    }
+
+    SECTION("stopping queue cancels all pending tasks when requested")
+    {
+        std::size_t numTasksRan = 0;
+        std::vector<std::future<void>> taskFutures{};
+        {
+            task_queue taskQueue{ task_queue::queue_backend::lock_free };
+            auto dispatcher = taskQueue.get_dispatcher();
+
+            dispatcher->post([&] {
+                numTasksRan++;
+                for (int i = 0; i < 9; i++) {
+                    taskFutures.emplace_back(dispatcher->post([&] {
+                        numTasksRan++;
+                    }));
+                }
+                taskQueue.stop(task_queue::pending_task_action::cancel);
+            }).get();
+        }
+
+        REQUIRE(numTasksRan == 1);
+        REQUIRE(taskFutures.size() == 9);
+        for (auto& taskFuture : taskFutures) {
+            REQUIRE_THROWS_AS(taskFuture.get(), std::future_error);
+        }
+    }
+}
+
+TEST_CASE("task queue dispatcher posts detached tasks", "[notstd][shared][utility]")
+{
+    using notstd::task_queue;
+
+    const auto backends = { task_queue::queue_backend::locked, task_queue::queue_backend::lock_free };
+
+    SECTION("detached tasks are executed in first-in-first-out (FIFO) order")
+    {
+        for (const auto backend : backends) {
+            std::vector<int> taskValuesActual{};
+            task_queue taskQueue{ backend };
+            for (int i = 0; i < 5; i++) {
+                taskQueue.get_dispatcher()->post_detached([&taskValuesActual, i] {
+                    taskValuesActual.push_back(i);
+                });
+            }
+
+            taskQueue.stop_and_wait_for_task_completion();
+            REQUIRE(taskValuesActual == std::vector<int>{ 0, 1, 2, 3, 4 });
+        }
+    }
+
+    SECTION("detached tasks can be move-only")
+    {
+        for (const auto backend : backends) {
+            auto value = std::make_unique<int>(5);
+            int valueActual = 0;
+            task_queue taskQueue{ backend };
+            taskQueue.get_dispatcher()->post_detached([value = std::move(value), &valueActual] {
+                valueActual = *value;
+            });
+
+            taskQueue.stop_and_wait_for_task_completion();
+            REQUIRE(valueActual == 5);
+        }
+    }
+
+    SECTION("exceptions thrown by detached tasks don't stop the queue")
+    {
+        for (const auto backend : backends) {
+            task_queue taskQueue{ backend };
+            auto dispatcher = taskQueue.get_dispatcher();
+            dispatcher->post_detached([] {
+                throw std::runtime_error("detached task failure");
+            });
+
+            auto taskFuture = dispatcher->post([] {});
+            REQUIRE(taskFuture.wait_for(1s) == std::future_status::ready);
+        }
+    }
+
+    SECTION("posting detached tasks to a stopped queue fails")
+    {
+        for (const auto backend : backends) {
+            task_queue taskQueue{ backend };
+            taskQueue.stop();
+            REQUIRE_THROWS(taskQueue.get_dispatcher()->post_detached([] {}));
+        }
+    }
+}
+
+TEST_CASE("task queue dispatcher posts delayed and periodic tasks", "[notstd][shared][utility][timer]")
+{
+    using notstd::task_queue;
+
+    const auto backends = { task_queue::queue_backend::locked, task_queue::queue_backend::lock_free };
+
+    SECTION("delayed task runs on the queue after its delay")
+    {
+        for (const auto backend : backends) {
+            task_queue taskQueue{ backend };
+            std::promise<std::thread::id> threadIdRun{};
+            std::thread::id threadIdQueue{};
+            taskQueue.get_dispatcher()->post([&] {
+                threadIdQueue = std::this_thread::get_id();
+            }).wait();
+
+            const auto timePosted = task_queue::clock::now();
+            taskQueue.get_dispatcher()->post_after(20ms, [&] {
+                threadIdRun.set_value(std::this_thread::get_id());
+            });
+
+            auto threadIdRunFuture = threadIdRun.get_future();
+            REQUIRE(threadIdRunFuture.wait_for(5s) == std::future_status::ready);
+            REQUIRE(task_queue::clock::now() - timePosted >= 20ms);
+            REQUIRE(threadIdRunFuture.get() == threadIdQueue);
+        }
+    }
+
+    SECTION("delayed tasks run in order of expiry")
+    {
+        for (const auto backend : backends) {
+            std::vector<int> order{};
+            std::promise<void> done{};
+            task_queue taskQueue{ backend };
+            auto dispatcher = taskQueue.get_dispatcher();
+            dispatcher->post_after(60ms, [&] {
+                order.push_back(3);
+                done.set_value();
+            });
+            dispatcher->post_after(20ms, [&] {
+                order.push_back(1);
+            });
+            dispatcher->post_after(40ms, [&] {
+                order.push_back(2);
+            });
+
+            REQUIRE(done.get_future().wait_for(5s) == std::future_status::ready);
+            REQUIRE(order == std::vector<int>{ 1, 2, 3 });
+        }
+    }
+
+    SECTION("delayed task scheduled before an earlier one wakes the worker in time")
+    {
+        for (const auto backend : backends) {
+            std::promise<void> done{};
+            task_queue taskQueue{ backend };
+            auto dispatcher = taskQueue.get_dispatcher();
+            dispatcher->post_after(1h, [] {});
+            dispatcher->post_after(10ms, [&] {
+                done.set_value();
+            });
+
+            REQUIRE(done.get_future().wait_for(5s) == std::future_status::ready);
+        }
+    }
+
+    SECTION("canceled delayed task doesn't run")
+    {
+        for (const auto backend : backends) {
+            std::atomic<bool> hasRun{ false };
+            task_queue taskQueue{ backend };
+            auto dispatcher = taskQueue.get_dispatcher();
+            const auto id = dispatcher->post_after(20ms, [&] {
+                hasRun = true;
+            });
+            REQUIRE(dispatcher->cancel(id));
+            REQUIRE(!dispatcher->cancel(id));
+
+            std::this_thread::sleep_for(50ms);
+            REQUIRE(!hasRun);
+        }
+    }
+
+    SECTION("periodic task runs repeatedly until canceled")
+    {
+        for (const auto backend : backends) {
+            static constexpr int RunsExpected = 3;
+            std::atomic<int> runs{ 0 };
+            std::promise<void> done{};
+            task_queue taskQueue{ backend };
+            auto dispatcher = taskQueue.get_dispatcher();
+            std::atomic<task_queue::timer_id> id{};
+            id = dispatcher->post_every(5ms, [&] {
+                if (++runs == RunsExpected) {
+                    dispatcher->cancel(id);
+                    done.set_value();
+                }
+            });
+
+            REQUIRE(done.get_future().wait_for(5s) == std::future_status::ready);
+            std::this_thread::sleep_for(20ms);
+            REQUIRE(runs == RunsExpected);
+        }
+    }
+
+    SECTION("periodic task with non-positive period is rejected")
+    {
+        for (const auto backend : backends) {
+            task_queue taskQueue{ backend };
+            REQUIRE_THROWS_AS(taskQueue.get_dispatcher()->post_every(0ms, [] {}), std::invalid_argument);
+        }
+    }
+
+    SECTION("timers are serviced while the queue is busy")
+    {
+        for (const auto backend : backends) {
+            std::atomic<bool> timerRun{ false };
+            task_queue taskQueue{ backend };
+            auto dispatcher = taskQueue.get_dispatcher();
+            dispatcher->post_after(5ms, [&] {
+                timerRun = true;
+            });
+
+            // Keep the queue busy by having each task post another.
+            std::function<void()> busyTask = [&] {
+                if (!timerRun) {
+                    dispatcher->post_detached(busyTask);
+                }
+            };
+            dispatcher->post_detached(busyTask);
+
+            const auto timeStart = task_queue::clock::now();
+            while (!timerRun && task_queue::clock::now() - timeStart < 5s) {
+                std::this_thread::sleep_for(1ms);
+            }
+            REQUIRE(timerRun);
+            taskQueue.stop_and_wait_for_task_completion();
+        }
+    }
+
+    SECTION("pending timers are discarded when the queue stops")
+    {
+        for (const auto backend : backends) {
+            std::atomic<bool> hasRun{ false };
+            {
+                task_queue taskQueue{ backend };
+                taskQueue.get_dispatcher()->post_after(1h, [&] {
+                    hasRun = true;
+                });
+            }
+            REQUIRE(!hasRun);
+        }
+    }
+
+    SECTION("posting delayed tasks to a stopped queue fails")
+    {
+        for (const auto backend : backends) {
+            task_queue taskQueue{ backend };
+            taskQueue.stop();
+            REQUIRE_THROWS(taskQueue.get_dispatcher()->post_after(1ms, [] {}));
+            REQUIRE_THROWS(taskQueue.get_dispatcher()->post_every(1ms, [] {}));
+        }
+    }
+}
+
+TEST_CASE("task queue runs tasks by priority lane", "[notstd][shared][utility][priority]")
+{
+    using notstd::task_queue;
+    using task_priority = notstd::task_queue::task_priority;
+
+    const auto backends = { task_queue::queue_backend::locked, task_queue::queue_backend::lock_free };
+
+    SECTION("higher priority lanes run first, in FIFO order within each lane")
+    {
+        for (const auto backend : backends) {
+            std::vector<int> order{};
+            task_queue taskQueue{ backend };
+            auto dispatcher = taskQueue.get_dispatcher();
+            notstd::test::WorkerBlocker blocker{ taskQueue };
+            for (int i = 0; i < 3; i++) {
+                dispatcher->post_detached([&order, i] {
+                    order.push_back(20 + i);
+                }, task_priority::data);
+                dispatcher->post_detached([&order, i] {
+                    order.push_back(10 + i);
+                });
+                dispatcher->post_detached([&order, i] {
+                    order.push_back(i);
+                }, task_priority::control);
+            }
+
+            blocker.Release.set_value();
+            taskQueue.stop_and_wait_for_task_completion();
+            REQUIRE(order == std::vector<int>{ 0, 1, 2, 10, 11, 12, 20, 21, 22 });
+        }
+    }
+
+    SECTION("tasks posted to a higher priority lane preempt pending lower priority tasks")
+    {
+        for (const auto backend : backends) {
+            static constexpr int NumDataTasks = 100;
+            std::vector<int> order{};
+            task_queue taskQueue{ backend };
+            auto dispatcher = taskQueue.get_dispatcher();
+            notstd::test::WorkerBlocker blocker{ taskQueue };
+            std::promise<void> done{};
+            for (int i = 0; i < NumDataTasks; i++) {
+                dispatcher->post_detached([&order, &dispatcher, &done, i] {
+                    order.push_back(i);
+                    if (i == 0) {
+                        dispatcher->post_detached([&order] {
+                            order.push_back(-1);
+                        }, task_priority::control);
+                    } else if (i == NumDataTasks - 1) {
+                        done.set_value();
+                    }
+                }, task_priority::data);
+            }
+
+            blocker.Release.set_value();
+            REQUIRE(done.get_future().wait_for(5s) == std::future_status::ready);
+            REQUIRE(order.size() == NumDataTasks + 1);
+            REQUIRE(order[0] == 0);
+            REQUIRE(order[1] == -1);
+            REQUIRE(order[2] == 1);
+            REQUIRE(order.back() == NumDataTasks - 1);
+        }
+    }
+
+    SECTION("queue depths are reported per lane")
+    {
+        for (const auto backend : backends) {
+            task_queue taskQueue{ backend };
+            auto dispatcher = taskQueue.get_dispatcher();
+            notstd::test::WorkerBlocker blocker{ taskQueue };
+            for (int i = 0; i < 3; i++) {
+                dispatcher->post_detached([] {}, task_priority::data);
+            }
+            dispatcher->post_detached([] {}, task_priority::state);
+
+            REQUIRE(taskQueue.queue_depth(task_priority::control) == 0);
+            REQUIRE(taskQueue.queue_depth(task_priority::state) == 1);
+            REQUIRE(taskQueue.queue_depth(task_priority::data) == 3);
+
+            blocker.Release.set_value();
+            dispatcher->post([] {}, task_priority::data).wait();
+            REQUIRE(taskQueue.queue_depth(task_priority::control) == 0);
+            REQUIRE(taskQueue.queue_depth(task_priority::state) == 0);
+            REQUIRE(taskQueue.queue_depth(task_priority::data) == 0);
+        }
+    }
+}
+
+TEST_CASE("task queue drops tasks past their deadline", "[notstd][shared][utility][priority]")
+{
+    using notstd::task_queue;
+    using task_priority = notstd::task_queue::task_priority;
+
+    const auto backends = { task_queue::queue_backend::locked, task_queue::queue_backend::lock_free };
+
+    SECTION("stale tasks are dropped and counted")
+    {
+        for (const auto backend : backends) {
+            std::vector<int> order{};
+            task_queue taskQueue{ backend };
+            auto dispatcher = taskQueue.get_dispatcher();
+            const auto now = task_queue::clock::now();
+            dispatcher->post_detached([&] {
+                order.push_back(0);
+            }, task_priority::data, now - 1ms);
+            dispatcher->post_detached([&] {
+                order.push_back(1);
+            }, task_priority::data, now + 1h);
+            dispatcher->post_detached([&] {
+                order.push_back(2);
+            }, task_priority::data);
+
+            taskQueue.stop_and_wait_for_task_completion();
+            REQUIRE(order == std::vector<int>{ 1, 2 });
+            REQUIRE(taskQueue.tasks_expired(task_priority::data) == 1);
+            REQUIRE(taskQueue.tasks_expired(task_priority::state) == 0);
+            REQUIRE(taskQueue.queue_depth(task_priority::data) == 0);
+        }
+    }
+
+    SECTION("futures of stale tasks report a broken promise")
+    {
+        for (const auto backend : backends) {
+            task_queue taskQueue{ backend };
+            auto future = taskQueue.get_dispatcher()->post([] {}, task_priority::data, task_queue::clock::now() - 1ms);
+            REQUIRE(future.wait_for(5s) == std::future_status::ready);
+            REQUIRE_THROWS_AS(future.get(), std::future_error);
+        }
+    }
+}
+
+TEST_CASE("task queue bounds the number of pending tasks", "[notstd][shared][utility][bounded]")
+{
+    using notstd::task_queue;
+    using overflow_policy = notstd::task_queue::overflow_policy;
+    using post_status = notstd::task_queue::post_status;
+    using task_priority = notstd::task_queue::task_priority;
+
+    static constexpr std::size_t Capacity = 4;
+
+    SECTION("queue can't be created without capacity")
+    {
+        REQUIRE_THROWS_AS(task_queue(0, overflow_policy::block), std::invalid_argument);
+    }
+
+    SECTION("fail policy rejects tasks once full")
+    {
+        std::vector<int> order{};
+        task_queue taskQueue{ Capacity, overflow_policy::fail };
+        auto dispatcher = taskQueue.get_dispatcher();
+        notstd::test::WorkerBlocker blocker{ taskQueue };
+        for (int i = 0; i < static_cast<int>(Capacity); i++) {
+            REQUIRE(dispatcher->try_post_detached([&order, i] {
+                order.push_back(i);
+            }) == post_status::posted);
+        }
+
+        REQUIRE(dispatcher->try_post_detached([] {}) == post_status::full);
+        REQUIRE_THROWS_AS(dispatcher->post_detached([] {}), task_queue::full_exception);
+        REQUIRE_THROWS_AS(dispatcher->post([] {}), task_queue::full_exception);
+
+        blocker.Release.set_value();
+        taskQueue.stop_and_wait_for_task_completion();
+        REQUIRE(order == std::vector<int>{ 0, 1, 2, 3 });
+        REQUIRE(taskQueue.tasks_dropped(task_priority::state) == 0);
+    }
+
+    SECTION("drop newest policy drops the tasks being posted once full")
+    {
+        std::vector<int> order{};
+        task_queue taskQueue{ Capacity, overflow_policy::drop_newest };
+        auto dispatcher = taskQueue.get_dispatcher();
+        notstd::test::WorkerBlocker blocker{ taskQueue };
+        for (int i = 0; i < 6; i++) {
+            dispatcher->post_detached([&order, i] {
+                order.push_back(i);
+            });
+        }
+        auto future = dispatcher->post([] {});
+
+        blocker.Release.set_value();
+        taskQueue.stop_and_wait_for_task_completion();
+        REQUIRE(order == std::vector<int>{ 0, 1, 2, 3 });
+        REQUIRE(taskQueue.tasks_dropped(task_priority::state) == 3);
+        REQUIRE_THROWS_AS(future.get(), std::future_error);
+    }
+
+    SECTION("drop oldest policy drops the oldest task of the lowest priority lane once full")
+    {
+        std::vector<int> order{};
+        task_queue taskQueue{ Capacity, overflow_policy::drop_oldest };
+        auto dispatcher = taskQueue.get_dispatcher();
+        notstd::test::WorkerBlocker blocker{ taskQueue };
+        for (int i = 0; i < 2; i++) {
+            dispatcher->post_detached([&order, i] {
+                order.push_back(10 + i);
+            }, task_priority::control);
+            dispatcher->post_detached([&order, i] {
+                order.push_back(20 + i);
+            }, task_priority::data);
+        }
+
+        // Displaces both data tasks.
+        for (int i = 0; i < 2; i++) {
+            REQUIRE(dispatcher->try_post_detached([&order, i] {
+                order.push_back(30 + i);
+            }, task_priority::data) == post_status::posted);
+        }
+
+        // Higher priority tasks displace lower priority ones, but not the
+        // other way around.
+        for (int i = 0; i < 2; i++) {
+            REQUIRE(dispatcher->try_post_detached([&order, i] {
+                order.push_back(40 + i);
+            }, task_priority::state) == post_status::posted);
+        }
+        REQUIRE(dispatcher->try_post_detached([] {}, task_priority::data) == post_status::dropped);
+
+        blocker.Release.set_value();
+        taskQueue.stop_and_wait_for_task_completion();
+        REQUIRE(order == std::vector<int>{ 10, 11, 40, 41 });
+        REQUIRE(taskQueue.tasks_dropped(task_priority::data) == 5);
+        REQUIRE(taskQueue.tasks_dropped(task_priority::state) == 0);
+        REQUIRE(taskQueue.tasks_dropped(task_priority::control) == 0);
+        REQUIRE(taskQueue.queue_depth(task_priority::data) == 0);
+    }
+
+    SECTION("block policy waits for space once full")
+    {
+        static constexpr int NumProducers = 4;
+        static constexpr int NumTasks = 500;
+
+        std::atomic<std::size_t> depthMaximum{ 0 };
+        std::atomic<int> numTasksRun{ 0 };
+        task_queue taskQueue{ Capacity, overflow_policy::block };
+        auto dispatcher = taskQueue.get_dispatcher();
+        std::vector<std::thread> producers{};
+        for (int i = 0; i < NumProducers; i++) {
+            producers.emplace_back([&] {
+                for (int j = 0; j < NumTasks; j++) {
+                    dispatcher->post_detached([&] {
+                        const auto depth = taskQueue.queue_depth(task_priority::state);
+                        if (depth > depthMaximum) {
+                            depthMaximum = depth;
+                        }
+                        numTasksRun++;
+                    });
+                }
+            });
+        }
+        for (auto& producer : producers) {
+            producer.join();
+        }
+
+        taskQueue.stop_and_wait_for_task_completion();
+        REQUIRE(numTasksRun == NumProducers * NumTasks);
+        REQUIRE(depthMaximum <= Capacity);
+        REQUIRE(taskQueue.tasks_dropped(task_priority::state) == 0);
+    }
+
+    SECTION("block policy accepts tasks posted from the worker thread")
+    {
+        std::promise<int> numTasksPosted{};
+        task_queue taskQueue{ 1, overflow_policy::block };
+        auto dispatcher = taskQueue.get_dispatcher();
+        dispatcher->post_detached([&] {
+            for (int i = 0; i < 3; i++) {
+                dispatcher->post_detached([] {});
+            }
+            numTasksPosted.set_value(3);
+        });
+        auto future = numTasksPosted.get_future();
+        REQUIRE(future.wait_for(5s) == std::future_status::ready);
+        REQUIRE(future.get() == 3);
+    }
+
+    SECTION("producers blocked waiting for space are released when the queue stops")
+    {
+        task_queue taskQueue{ 1, overflow_policy::block };
+        auto dispatcher = taskQueue.get_dispatcher();
+        notstd::test::WorkerBlocker blocker{ taskQueue };
+        dispatcher->post_detached([] {});
+
+        auto status = std::async(std::launch::async, [&] {
+            return dispatcher->try_post_detached([] {});
+        });
+        REQUIRE(status.wait_for(50ms) == std::future_status::timeout);
+
+        taskQueue.stop(task_queue::pending_task_action::cancel);
+        REQUIRE(status.wait_for(5s) == std::future_status::ready);
+        REQUIRE(status.get() == post_status::stopped);
+        blocker.Release.set_value();
+    }
+}
+
+TEST_CASE("task queue reports crossing the watermarks", "[notstd][shared][utility][bounded]")
+{
+    using notstd::task_queue;
+    using watermark = notstd::task_queue::watermark;
+
+    const auto backends = { task_queue::queue_backend::locked, task_queue::queue_backend::lock_free };
+
+    SECTION("watermarks must be ordered")
+    {
+        task_queue taskQueue{};
+        REQUIRE_THROWS_AS(taskQueue.set_watermarks(0, 0, [](auto) {}), std::invalid_argument);
+        REQUIRE_THROWS_AS(taskQueue.set_watermarks(4, 4, [](auto) {}), std::invalid_argument);
+    }
+
+    SECTION("high and low watermarks are reported alternately")
+    {
+        for (const auto backend : backends) {
+            std::mutex watermarksGate{};
+            std::vector<watermark> watermarks{};
+            task_queue taskQueue{ backend };
+            auto dispatcher = taskQueue.get_dispatcher();
+            taskQueue.set_watermarks(4, 1, [&](watermark crossed) {
+                std::scoped_lock watermarksLock{ watermarksGate };
+                watermarks.push_back(crossed);
+            });
+
+            for (int round = 0; round < 2; round++) {
+                notstd::test::WorkerBlocker blocker{ taskQueue };
+                for (int i = 0; i < 3; i++) {
+                    dispatcher->post_detached([] {});
+                }
+                {
+                    std::scoped_lock watermarksLock{ watermarksGate };
+                    REQUIRE(watermarks.size() == static_cast<std::size_t>(round * 2));
+                }
+                for (int i = 0; i < 5; i++) {
+                    dispatcher->post_detached([] {});
+                }
+                {
+                    std::scoped_lock watermarksLock{ watermarksGate };
+                    REQUIRE(watermarks.size() == static_cast<std::size_t>((round * 2) + 1));
+                }
+
+                blocker.Release.set_value();
+                dispatcher->post([] {}).wait();
+            }
+
+            taskQueue.stop_and_wait_for_task_completion();
+            REQUIRE(watermarks == std::vector<watermark>{ watermark::high, watermark::low, watermark::high, watermark::low });
+        }
+    }
+}
+
+TEST_CASE("task queue collects statistics", "[notstd][shared][utility][stats]")
+{
+    using notstd::task_queue;
+    using task_priority = notstd::task_queue::task_priority;
+
+    const auto backends = { task_queue::queue_backend::locked, task_queue::queue_backend::lock_free };
+
+    SECTION("posted, run, and canceled tasks are counted and timed")
+    {
+        for (const auto backend : backends) {
+            task_queue taskQueue{ backend };
+            auto dispatcher = taskQueue.get_dispatcher();
+            notstd::test::WorkerBlocker blocker{ taskQueue };
+            for (int i = 0; i < 3; i++) {
+                dispatcher->post_detached([] {
+                    std::this_thread::sleep_for(1ms);
+                });
+            }
+            dispatcher->post_detached([] {}, task_priority::data, task_queue::clock::now() - 1ms);
+
+            blocker.Release.set_value();
+            taskQueue.stop_and_wait_for_task_completion();
+
+            const auto stats = taskQueue.stats();
+            REQUIRE(stats.depth == 0);
+            if constexpr (task_queue::stats_enabled) {
+                static constexpr auto OneMillisecond = static_cast<std::uint64_t>(std::chrono::nanoseconds(1ms).count());
+
+                REQUIRE(stats.depth_high_water >= 4);
+                REQUIRE(stats.tasks_posted == 5);
+                REQUIRE(stats.tasks_run == 4);
+                REQUIRE(stats.tasks_canceled == 1);
+                REQUIRE(stats.run_time.count == 4);
+                REQUIRE(stats.run_time.value_at_percentile(50) >= OneMillisecond);
+                REQUIRE(stats.wait_time.count == 4);
+                REQUIRE(stats.wait_time.max >= 2 * OneMillisecond);
+            } else {
+                REQUIRE(stats.depth_high_water == 0);
+                REQUIRE(stats.tasks_posted == 0);
+                REQUIRE(stats.tasks_run == 0);
+                REQUIRE(stats.tasks_canceled == 0);
+                REQUIRE(stats.run_time.count == 0);
+                REQUIRE(stats.wait_time.count == 0);
+            }
+        }
+    }
+
+    SECTION("tasks dropped by the overflow policy are counted as canceled")
+    {
+        task_queue taskQueue{ 2, task_queue::overflow_policy::drop_newest };
+        auto dispatcher = taskQueue.get_dispatcher();
+        notstd::test::WorkerBlocker blocker{ taskQueue };
+        for (int i = 0; i < 5; i++) {
+            dispatcher->post_detached([] {});
+        }
+
+        blocker.Release.set_value();
+        taskQueue.stop_and_wait_for_task_completion();
+
+        const auto stats = taskQueue.stats();
+        REQUIRE(stats.tasks_canceled == (task_queue::stats_enabled ? 3 : 0));
+        REQUIRE(stats.tasks_run == (task_queue::stats_enabled ? 3 : 0));
+    }
+}
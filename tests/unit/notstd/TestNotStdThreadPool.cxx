@@ -0,0 +1,132 @@
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <future>
+#include <thread>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <notstd/thread_pool.hxx>
+
+TEST_CASE("thread_pool can be created", "[notstd][shared][utility]")
+{
+    using notstd::thread_pool;
+
+    SECTION("creation with an explicit size doesn't cause a crash")
+    {
+        REQUIRE_NOTHROW(thread_pool{ 2 });
+    }
+
+    SECTION("creation with a default size uses at least one thread")
+    {
+        thread_pool pool{};
+        REQUIRE(pool.size() >= 1);
+    }
+
+    SECTION("default pool is shared")
+    {
+        REQUIRE(&thread_pool::get_default() == &thread_pool::get_default());
+        REQUIRE(thread_pool::get_default().size() >= 1);
+    }
+
+    SECTION("blocking pool is shared and separate from the default pool")
+    {
+        REQUIRE(&thread_pool::get_blocking() == &thread_pool::get_blocking());
+        REQUIRE(&thread_pool::get_blocking() != &thread_pool::get_default());
+        REQUIRE(thread_pool::get_blocking().size() >= thread_pool::blocking_pool_size_minimum);
+    }
+}
+
+TEST_CASE("thread_pool tasks are executed", "[notstd][shared][utility]")
+{
+    using notstd::thread_pool;
+
+    static constexpr std::size_t NumThreads = 4;
+    static constexpr std::size_t NumTasks = 1000;
+
+    SECTION("all posted tasks are run")
+    {
+        std::atomic<std::size_t> tasksRun{ 0 };
+        std::promise<void> tasksDone{};
+        thread_pool pool{ NumThreads };
+        for (std::size_t i = 0; i < NumTasks; i++) {
+            pool.post([&] {
+                if (tasksRun.fetch_add(1) + 1 == NumTasks) {
+                    tasksDone.set_value();
+                }
+            });
+        }
+
+        REQUIRE(tasksDone.get_future().wait_for(std::chrono::seconds(10)) == std::future_status::ready);
+        REQUIRE(tasksRun == NumTasks);
+    }
+
+    SECTION("tasks posted from a worker thread are run")
+    {
+        std::atomic<std::size_t> tasksRun{ 0 };
+        std::promise<void> tasksDone{};
+        thread_pool pool{ NumThreads };
+        pool.post([&] {
+            for (std::size_t i = 0; i < NumTasks; i++) {
+                pool.post([&] {
+                    if (tasksRun.fetch_add(1) + 1 == NumTasks) {
+                        tasksDone.set_value();
+                    }
+                });
+            }
+        });
+
+        REQUIRE(tasksDone.get_future().wait_for(std::chrono::seconds(10)) == std::future_status::ready);
+        REQUIRE(tasksRun == NumTasks);
+    }
+
+    SECTION("pending tasks are run before destruction completes")
+    {
+        std::atomic<std::size_t> tasksRun{ 0 };
+        {
+            thread_pool pool{ NumThreads };
+            for (std::size_t i = 0; i < NumTasks; i++) {
+                pool.post([&] {
+                    tasksRun++;
+                });
+            }
+        }
+
+        REQUIRE(tasksRun == NumTasks);
+    }
+
+    SECTION("tasks throwing exceptions don't stop the pool")
+    {
+        std::atomic<std::size_t> tasksRun{ 0 };
+        {
+            thread_pool pool{ 1 };
+            pool.post([] {
+                throw std::exception();
+            });
+            pool.post([&] {
+                tasksRun++;
+            });
+        }
+
+        REQUIRE(tasksRun == 1);
+    }
+}
+
+TEST_CASE("thread_pool reports the executing thread", "[notstd][shared][utility]")
+{
+    using notstd::thread_pool;
+
+    thread_pool pool{ 2 };
+    thread_pool poolOther{ 1 };
+    REQUIRE(!pool.running_in_this_thread());
+
+    std::promise<std::vector<bool>> result{};
+    pool.post([&] {
+        result.set_value({ pool.running_in_this_thread(), poolOther.running_in_this_thread() });
+    });
+
+    const auto running = result.get_future().get();
+    REQUIRE(running[0]);
+    REQUIRE(!running[1]);
+}
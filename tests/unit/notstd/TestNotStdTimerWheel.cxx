@@ -0,0 +1,251 @@
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <notstd/timer_wheel.hxx>
+
+using namespace std::chrono_literals;
+
+namespace notstd::test
+{
+/**
+ * @brief Advances the wheel and runs all expired tasks.
+ *
+ * @param timers The wheel to advance.
+ * @param now The time to advance to.
+ * @return std::size_t The number of tasks that were run.
+ */
+std::size_t
+AdvanceAndRun(notstd::timer_wheel& timers, notstd::timer_wheel::clock::time_point now)
+{
+    std::vector<notstd::inline_task> expired{};
+    timers.advance(now, expired);
+    for (auto& task : expired) {
+        task();
+    }
+
+    return expired.size();
+}
+} // namespace notstd::test
+
+TEST_CASE("timer_wheel runs tasks once they expire", "[notstd][shared][utility]")
+{
+    using notstd::timer_wheel;
+
+    const auto start = timer_wheel::clock::now();
+    timer_wheel timers{ start };
+
+    SECTION("empty wheel has no expiry")
+    {
+        REQUIRE(timers.empty());
+        REQUIRE(!timers.next_expiry().has_value());
+        REQUIRE(notstd::test::AdvanceAndRun(timers, start + 1h) == 0);
+    }
+
+    SECTION("task runs at its expiry and not before")
+    {
+        bool hasRun = false;
+        timers.schedule(start + 10ms, [&] {
+            hasRun = true;
+        });
+        REQUIRE(timers.size() == 1);
+        REQUIRE(timers.next_expiry() == start + 10ms);
+
+        notstd::test::AdvanceAndRun(timers, start + 9ms);
+        REQUIRE(!hasRun);
+        notstd::test::AdvanceAndRun(timers, start + 10ms);
+        REQUIRE(hasRun);
+        REQUIRE(timers.empty());
+    }
+
+    SECTION("tasks run in order of expiry")
+    {
+        std::vector<int> order{};
+        timers.schedule(start + 300ms, [&] {
+            order.push_back(3);
+        });
+        timers.schedule(start + 100ms, [&] {
+            order.push_back(1);
+        });
+        timers.schedule(start + 200ms, [&] {
+            order.push_back(2);
+        });
+
+        REQUIRE(notstd::test::AdvanceAndRun(timers, start + 1s) == 3);
+        REQUIRE(order == std::vector<int>{ 1, 2, 3 });
+    }
+
+    SECTION("tasks expiring in the past run on the next advance")
+    {
+        notstd::test::AdvanceAndRun(timers, start + 1s);
+        timers.schedule(start, [] {});
+        REQUIRE(notstd::test::AdvanceAndRun(timers, start + 1s) == 0);
+        REQUIRE(notstd::test::AdvanceAndRun(timers, start + 1s + 1ms) == 1);
+    }
+
+    SECTION("tasks expiring beyond the range of the wheel run at their expiry")
+    {
+        static constexpr auto expiry = std::chrono::hours(24 * 365);
+        timers.schedule(start + expiry, [] {});
+
+        REQUIRE(timers.next_expiry() <= start + expiry);
+        REQUIRE(notstd::test::AdvanceAndRun(timers, start + expiry - 1ms) == 0);
+        REQUIRE(notstd::test::AdvanceAndRun(timers, start + expiry) == 1);
+    }
+}
+
+TEST_CASE("timer_wheel timers can be canceled", "[notstd][shared][utility]")
+{
+    using notstd::timer_wheel;
+
+    const auto start = timer_wheel::clock::now();
+    timer_wheel timers{ start };
+
+    SECTION("canceled task doesn't run")
+    {
+        bool hasRun = false;
+        const auto id = timers.schedule(start + 10ms, [&] {
+            hasRun = true;
+        });
+        REQUIRE(id != timer_wheel::invalid_timer_id);
+        REQUIRE(timers.cancel(id));
+        REQUIRE(timers.empty());
+        REQUIRE(!timers.next_expiry().has_value());
+
+        notstd::test::AdvanceAndRun(timers, start + 1s);
+        REQUIRE(!hasRun);
+    }
+
+    SECTION("canceling other timers in a slot doesn't affect the remaining ones")
+    {
+        std::vector<int> order{};
+        std::vector<timer_wheel::timer_id> ids{};
+        for (int i = 0; i < 5; i++) {
+            ids.push_back(timers.schedule(start + 10ms, [&order, i] {
+                order.push_back(i);
+            }));
+        }
+        REQUIRE(timers.cancel(ids[0]));
+        REQUIRE(timers.cancel(ids[2]));
+        REQUIRE(timers.cancel(ids[4]));
+
+        notstd::test::AdvanceAndRun(timers, start + 10ms);
+        REQUIRE(order == std::vector<int>{ 1, 3 });
+    }
+
+    SECTION("canceling an expired or canceled timer fails")
+    {
+        const auto id = timers.schedule(start + 10ms, [] {});
+        notstd::test::AdvanceAndRun(timers, start + 10ms);
+        REQUIRE(!timers.cancel(id));
+
+        const auto idCanceled = timers.schedule(start + 20ms, [] {});
+        REQUIRE(timers.cancel(idCanceled));
+        REQUIRE(!timers.cancel(idCanceled));
+        REQUIRE(!timers.cancel(timer_wheel::invalid_timer_id));
+    }
+
+    SECTION("stale identifiers don't cancel newer timers")
+    {
+        const auto idStale = timers.schedule(start + 10ms, [] {});
+        REQUIRE(timers.cancel(idStale));
+
+        const auto id = timers.schedule(start + 10ms, [] {});
+        REQUIRE(id != idStale);
+        REQUIRE(!timers.cancel(idStale));
+        REQUIRE(timers.size() == 1);
+    }
+}
+
+TEST_CASE("timer_wheel periodic timers run repeatedly", "[notstd][shared][utility]")
+{
+    using notstd::timer_wheel;
+
+    const auto start = timer_wheel::clock::now();
+    timer_wheel timers{ start };
+
+    std::size_t runs = 0;
+    const auto id = timers.schedule_periodic(start + 10ms, 10ms, [&] {
+        runs++;
+    });
+
+    SECTION("task runs once per period")
+    {
+        for (auto now = start + 1ms; now <= start + 100ms; now += 1ms) {
+            notstd::test::AdvanceAndRun(timers, now);
+        }
+        REQUIRE(runs == 10);
+        REQUIRE(timers.size() == 1);
+    }
+
+    SECTION("missed periods are skipped")
+    {
+        notstd::test::AdvanceAndRun(timers, start + 95ms);
+        REQUIRE(runs == 1);
+        notstd::test::AdvanceAndRun(timers, start + 100ms);
+        REQUIRE(runs == 2);
+    }
+
+    SECTION("canceled task doesn't run again")
+    {
+        notstd::test::AdvanceAndRun(timers, start + 10ms);
+        REQUIRE(runs == 1);
+        REQUIRE(timers.cancel(id));
+        notstd::test::AdvanceAndRun(timers, start + 1s);
+        REQUIRE(runs == 1);
+        REQUIRE(timers.empty());
+    }
+}
+
+TEST_CASE("timer_wheel handles many timers", "[notstd][shared][utility]")
+{
+    using notstd::timer_wheel;
+
+    static constexpr std::size_t NumTimers = 50000;
+    static constexpr std::uint64_t ExpiryMax = std::uint64_t{ 1 } << 34U;
+
+    const auto start = timer_wheel::clock::now();
+    timer_wheel timers{ start };
+
+    // Schedule timers spanning every level of the wheel, and beyond it,
+    // recording the time range of the advance in which each one ran.
+    std::mt19937_64 random{ 0x71AE };
+    std::uniform_int_distribution<std::uint64_t> exponentDistribution(0, 34);
+    std::vector<std::chrono::milliseconds> expiries(NumTimers);
+    std::vector<std::chrono::milliseconds> ranAfter(NumTimers);
+    std::vector<std::chrono::milliseconds> ranAt(NumTimers);
+    std::chrono::milliseconds previous{ 0 };
+    std::chrono::milliseconds now{ 0 };
+    for (std::size_t i = 0; i < NumTimers; i++) {
+        const auto expiryMax = std::min(ExpiryMax, std::uint64_t{ 1 } << exponentDistribution(random));
+        expiries[i] = std::chrono::milliseconds(random() % expiryMax);
+        timers.schedule(start + expiries[i], [&, i] {
+            ranAfter[i] = previous;
+            ranAt[i] = now;
+        });
+    }
+    REQUIRE(timers.size() == NumTimers);
+
+    // Advance by increasing steps, so both short and long timers are covered.
+    std::chrono::milliseconds::rep step = 1;
+    while (!timers.empty()) {
+        REQUIRE(timers.next_expiry().has_value());
+        previous = now;
+        now += std::chrono::milliseconds(step);
+        notstd::test::AdvanceAndRun(timers, start + now);
+        step = (step * 3) / 2 + 1;
+    }
+
+    // Each timer must have run in the first advance at or after its expiry.
+    std::size_t numTimersRanOnTime = 0;
+    for (std::size_t i = 0; i < NumTimers; i++) {
+        if ((expiries[i] == 0ms || ranAfter[i] < expiries[i]) && expiries[i] <= ranAt[i]) {
+            numTimersRanOnTime++;
+        }
+    }
+    REQUIRE(numTimersRanOnTime == NumTimers);
+}
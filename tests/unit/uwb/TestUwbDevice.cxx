@@ -1,12 +1,15 @@
 
 #include <cstdint>
 #include <memory>
+#include <thread>
 
 #include <uwb/UwbDevice.hxx>
 #include <uwb/UwbSession.hxx>
 #include <uwb/UwbSessionEventCallbacks.hxx>
 
 #include <catch2/catch_test_macros.hpp>
+#include <notstd/task.hxx>
+#include <notstd/task_queue.hxx>
 
 // NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers)
 
@@ -84,6 +87,30 @@ struct UwbDeviceTestDerivedTwo : UwbDeviceTestBase
         return (this->Id == rhs.Id);
     }
 };
+
+struct UwbDeviceTestBlocking : UwbDeviceTestDerivedOne
+{
+    UwbDeviceTestBlocking() :
+        UwbDeviceTestDerivedOne(1)
+    {}
+
+    uwb::protocol::fira::UwbCapability
+    GetCapabilitiesImpl() override
+    {
+        CapabilitiesThreadId = std::this_thread::get_id();
+        return {};
+    }
+
+    std::thread::id CapabilitiesThreadId{};
+};
+
+notstd::task<bool>
+GetCapabilitiesOnQueue(UwbDevice& uwbDevice)
+{
+    const auto dispatcher = notstd::task_queue::current_dispatcher();
+    co_await uwbDevice.GetCapabilitiesAsync();
+    co_return notstd::task_queue::current_dispatcher() == dispatcher;
+}
 } // namespace uwb::test
 
 TEST_CASE("uwb devices can be compared for equality", "[basic]")
@@ -149,4 +176,21 @@ TEST_CASE("uwb devices can be compared for equality", "[basic]")
     }
 }
 
+TEST_CASE("uwb device operations can be awaited", "[basic]")
+{
+    using namespace uwb;
+
+    notstd::task_queue taskQueue{};
+    auto dispatcher = taskQueue.get_dispatcher();
+    std::thread::id workerThreadId{};
+    dispatcher->post([&] {
+        workerThreadId = std::this_thread::get_id();
+    }).wait();
+
+    test::UwbDeviceTestBlocking uwbDevice{};
+    REQUIRE(notstd::spawn(*dispatcher, test::GetCapabilitiesOnQueue(uwbDevice)).get());
+    REQUIRE(uwbDevice.CapabilitiesThreadId != std::thread::id{});
+    REQUIRE(uwbDevice.CapabilitiesThreadId != workerThreadId);
+}
+
 // NOLINTEND(cppcoreguidelines-avoid-magic-numbers)
@@ -0,0 +1,169 @@
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <uwb/protocols/fira/uci/ControlMessage.hxx>
+#include <uwb/protocols/fira/uci/ControlPacket.hxx>
+
+TEST_CASE("uci control packet header can be parsed and encoded", "[basic][protocol][uci]")
+{
+    using namespace uwb::protocol::fira::uci;
+
+    SECTION("fields are decoded from the correct bits")
+    {
+        // MT=notification, PBF=1, GID=ranging, OID=0, length 0x19.
+        static constexpr std::array<uint8_t, 4> encoded{ 0x72, 0x00, 0x00, 0x19 };
+        const auto header = ControlPacketHeader::Parse(encoded);
+        REQUIRE(header.has_value());
+        REQUIRE(header->Type == MessageType::Notification);
+        REQUIRE(header->PacketBoundaryFlag);
+        REQUIRE(header->Group == 0x2);
+        REQUIRE(header->Opcode == 0x0);
+        REQUIRE(header->PayloadLength == 0x19);
+        REQUIRE(header->Encode() == encoded);
+    }
+
+    SECTION("reserved bits are ignored")
+    {
+        static constexpr std::array<uint8_t, 4> encoded{ 0x21, 0xC3, 0xFF, 0x00 };
+        const auto header = ControlPacketHeader::Parse(encoded);
+        REQUIRE(header.has_value());
+        REQUIRE(header->Opcode == 0x03);
+        REQUIRE(header->Encode() == std::array<uint8_t, 4>{ 0x21, 0x03, 0x00, 0x00 });
+    }
+
+    SECTION("a short buffer is rejected")
+    {
+        static constexpr std::array<uint8_t, 3> encoded{ 0x21, 0x03, 0x00 };
+        REQUIRE_FALSE(ControlPacketHeader::Parse(encoded).has_value());
+    }
+
+    SECTION("data packets are rejected")
+    {
+        static constexpr std::array<uint8_t, 4> encoded{ 0x01, 0x00, 0x00, 0x00 };
+        REQUIRE_FALSE(ControlPacketHeader::Parse(encoded).has_value());
+    }
+}
+
+TEST_CASE("uci control packet can be parsed", "[basic][protocol][uci]")
+{
+    using namespace uwb::protocol::fira::uci;
+
+    static constexpr std::array<uint8_t, 8> encoded{ 0x41, 0x06, 0x00, 0x02, 0x00, 0x03, 0xAA, 0xBB };
+
+    SECTION("the payload refers to the parsed buffer")
+    {
+        const auto packet = ControlPacket::Parse(encoded);
+        REQUIRE(packet.has_value());
+        REQUIRE(packet->Size() == 6);
+        REQUIRE(std::data(packet->Payload) == std::data(encoded) + ControlPacketHeader::Size);
+        REQUIRE(std::size(packet->Payload) == 2);
+    }
+
+    SECTION("a truncated payload is rejected")
+    {
+        REQUIRE_FALSE(ControlPacket::Parse(std::span(encoded).first(5)).has_value());
+    }
+}
+
+TEST_CASE("uci control messages are segmented and reassembled", "[basic][protocol][uci]")
+{
+    using namespace uwb::protocol::fira::uci;
+
+    std::vector<uint8_t> payload(600);
+    for (std::size_t i = 0; i < std::size(payload); i++) {
+        payload[i] = static_cast<uint8_t>(i);
+    }
+    const auto message = ControlMessage::Create(MessageType::Command, GroupId::Session, SessionOpcodeId::SetAppConfig, payload);
+
+    SECTION("a message with an empty payload is a single packet")
+    {
+        const auto empty = ControlMessage::Create(MessageType::Command, GroupId::Core, CoreOpcodeId::GetDeviceInfo);
+        REQUIRE(empty.Encode() == std::vector<uint8_t>{ 0x20, 0x02, 0x00, 0x00 });
+    }
+
+    SECTION("large payloads are segmented with the packet boundary flag set on all but the last packet")
+    {
+        const auto encoded = message.Encode();
+        REQUIRE(std::size(encoded) == std::size(payload) + (3 * ControlPacketHeader::Size));
+
+        auto data = std::span<const uint8_t>(encoded);
+        std::vector<std::size_t> payloadLengths{};
+        std::vector<bool> packetBoundaryFlags{};
+        while (!std::empty(data)) {
+            const auto packet = ControlPacket::Parse(data);
+            REQUIRE(packet.has_value());
+            payloadLengths.push_back(packet->Header.PayloadLength);
+            packetBoundaryFlags.push_back(packet->Header.PacketBoundaryFlag);
+            data = data.subspan(packet->Size());
+        }
+
+        REQUIRE(payloadLengths == std::vector<std::size_t>{ 255, 255, 90 });
+        REQUIRE(packetBoundaryFlags == std::vector<bool>{ true, true, false });
+    }
+
+    SECTION("an invalid maximum payload length is rejected")
+    {
+        REQUIRE_THROWS(message.Encode(0));
+        REQUIRE_THROWS(message.Encode(256));
+    }
+
+    SECTION("segmented packets are reassembled into the original message")
+    {
+        const auto encoded = message.Encode(100);
+        ControlMessageReassembler reassembler{};
+        std::optional<ControlMessage> reassembled{};
+
+        auto data = std::span<const uint8_t>(encoded);
+        while (!std::empty(data)) {
+            const auto packet = ControlPacket::Parse(data);
+            REQUIRE(packet.has_value());
+            REQUIRE_FALSE(reassembled.has_value());
+            const auto view = reassembler.Push(*packet);
+            if (view.has_value()) {
+                reassembled = ControlMessage::FromView(*view);
+            }
+            data = data.subspan(packet->Size());
+        }
+
+        REQUIRE(reassembled.has_value());
+        REQUIRE(*reassembled == message);
+        REQUIRE(reassembler.GetNumberOfMessagesDiscarded() == 0);
+    }
+
+    SECTION("single packet messages are not copied")
+    {
+        const auto encoded = ControlMessage::Create(MessageType::Response, GroupId::Ranging, RangingOpcodeId::Stop, { 0x00 }).Encode();
+        const auto packet = ControlPacket::Parse(encoded);
+        REQUIRE(packet.has_value());
+
+        ControlMessageReassembler reassembler{};
+        const auto view = reassembler.Push(*packet);
+        REQUIRE(view.has_value());
+        REQUIRE(view->Is(MessageType::Response, GroupId::Ranging, RangingOpcodeId::Stop));
+        REQUIRE(std::data(view->Payload) == std::data(packet->Payload));
+    }
+
+    SECTION("an interrupted segmented message is discarded")
+    {
+        const auto encoded = message.Encode();
+        const auto first = ControlPacket::Parse(encoded);
+        REQUIRE(first.has_value());
+
+        const auto interruptingEncoded = ControlMessage::Create(MessageType::Notification, GroupId::Core, CoreOpcodeId::DeviceStatus, { 0x01 }).Encode();
+        const auto interrupting = ControlPacket::Parse(interruptingEncoded);
+        REQUIRE(interrupting.has_value());
+
+        ControlMessageReassembler reassembler{};
+        REQUIRE_FALSE(reassembler.Push(*first).has_value());
+        const auto view = reassembler.Push(*interrupting);
+        REQUIRE(view.has_value());
+        REQUIRE(view->Is(MessageType::Notification, GroupId::Core, CoreOpcodeId::DeviceStatus));
+        REQUIRE(reassembler.GetNumberOfMessagesDiscarded() == 1);
+    }
+}
@@ -0,0 +1,305 @@
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <span>
+#include <unordered_set>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <uwb/UwbMacAddress.hxx>
+#include <uwb/protocols/fira/FiraDevice.hxx>
+#include <uwb/protocols/fira/uci/ControlMessageCodec.hxx>
+
+TEST_CASE("uci status codes can be encoded and decoded", "[basic][protocol][uci]")
+{
+    using namespace uwb::protocol::fira;
+    using namespace uwb::protocol::fira::uci;
+
+    REQUIRE(EncodeUwbStatus(UwbStatusGeneric::Ok) == 0x00);
+    REQUIRE(EncodeUwbStatus(UwbStatusGeneric::CommandRetry) == 0x0A);
+    REQUIRE(EncodeUwbStatus(UwbStatusSession::NotExist) == 0x11);
+    REQUIRE(EncodeUwbStatus(UwbStatusRanging::RxTimeout) == 0x21);
+
+    REQUIRE(DecodeUwbStatus(0x05) == UwbStatus{ UwbStatusGeneric::InvalidRange });
+    REQUIRE(DecodeUwbStatus(0x19) == UwbStatus{ UwbStatusSession::AddressAlreadyPresent });
+    REQUIRE(DecodeUwbStatus(0x27) == UwbStatus{ UwbStatusRanging::RxMacIeMissing });
+    REQUIRE_FALSE(DecodeUwbStatus(0x0B).has_value());
+    REQUIRE_FALSE(DecodeUwbStatus(0x50).has_value());
+}
+
+TEST_CASE("uci commands are encoded correctly", "[basic][protocol][uci]")
+{
+    using namespace uwb::protocol::fira;
+    using namespace uwb::protocol::fira::uci;
+
+    SECTION("SESSION_INIT_CMD")
+    {
+        const auto command = EncodeSessionInitCommand({ .SessionId = 0x11223344, .SessionType = UwbSessionType::RangingSession });
+        REQUIRE(command.Encode() == std::vector<uint8_t>{ 0x21, 0x00, 0x00, 0x05, 0x44, 0x33, 0x22, 0x11, 0x00 });
+
+        const auto decoded = DecodeSessionInitCommand(command.Payload);
+        REQUIRE(decoded.has_value());
+        REQUIRE(decoded->SessionId == 0x11223344);
+        REQUIRE(decoded->SessionType == UwbSessionType::RangingSession);
+    }
+
+    SECTION("RANGE_START_CMD")
+    {
+        const auto command = EncodeRangeStartCommand(0x01020304);
+        REQUIRE(command.Encode() == std::vector<uint8_t>{ 0x22, 0x00, 0x00, 0x04, 0x04, 0x03, 0x02, 0x01 });
+        REQUIRE(DecodeSessionIdCommand(command.Payload) == 0x01020304U);
+        REQUIRE_FALSE(DecodeSessionIdCommand(std::span(command.Payload).first(3)).has_value());
+    }
+
+    SECTION("SESSION_UPDATE_CONTROLLER_MULTICAST_LIST_CMD")
+    {
+        const UwbSessionUpdateMulicastList multicastList{
+            .SessionId = 1,
+            .Action = UwbMulticastAction::DeleteShortAddress,
+            .Controlees = { { .ControleeMacAddress = uwb::UwbMacAddress(std::array<uint8_t, 2>{ 0xAA, 0xBB }), .SubSessionId = 7 } },
+        };
+        const auto command = EncodeSessionUpdateControllerMulticastListCommand(multicastList);
+        REQUIRE(command.Payload == std::vector<uint8_t>{ 0x01, 0x00, 0x00, 0x00, 0x01, 0x01, 0xAA, 0xBB, 0x07, 0x00, 0x00, 0x00 });
+        REQUIRE(DecodeSessionUpdateControllerMulticastListCommand(command.Payload) == multicastList);
+    }
+
+    SECTION("SESSION_GET_APP_CONFIG_CMD")
+    {
+        const SessionGetAppConfigCommand getAppConfig{
+            .SessionId = 2,
+            .ParameterTypes = { UwbApplicationConfigurationParameterType::DeviceRole, UwbApplicationConfigurationParameterType::RangingInterval },
+        };
+        const auto command = EncodeSessionGetAppConfigCommand(getAppConfig);
+        REQUIRE(command.Payload == std::vector<uint8_t>{ 0x02, 0x00, 0x00, 0x00, 0x02, 0x11, 0x09 });
+        REQUIRE(DecodeSessionGetAppConfigCommand(command.Payload) == getAppConfig);
+    }
+}
+
+TEST_CASE("uci application configuration parameters round-trip", "[basic][protocol][uci]")
+{
+    using namespace uwb::protocol::fira;
+    using namespace uwb::protocol::fira::uci;
+
+    const uwb::UwbMacAddress controlee1{ std::array<uint8_t, 8>{ 1, 2, 3, 4, 5, 6, 7, 8 } };
+    const uwb::UwbMacAddress controlee2{ std::array<uint8_t, 8>{ 8, 7, 6, 5, 4, 3, 2, 1 } };
+
+    // The destination mac addresses precede the mac address mode to verify
+    // that the mode is applied irrespective of ordering.
+    const SessionSetAppConfigCommand setAppConfig{
+        .SessionId = 0x42,
+        .Parameters = {
+            { UwbApplicationConfigurationParameterType::DestinationMacAddresses, std::unordered_set<uwb::UwbMacAddress>{ controlee1, controlee2 } },
+            { UwbApplicationConfigurationParameterType::MacAddressMode, uwb::UwbMacAddressType::Extended },
+            { UwbApplicationConfigurationParameterType::DeviceRole, DeviceRole::Initiator },
+            { UwbApplicationConfigurationParameterType::ChannelNumber, Channel::C9 },
+            { UwbApplicationConfigurationParameterType::HoppingMode, true },
+            { UwbApplicationConfigurationParameterType::SlotDuration, uint16_t{ 2400 } },
+            { UwbApplicationConfigurationParameterType::RangingInterval, uint32_t{ 200 } },
+            { UwbApplicationConfigurationParameterType::DeviceMacAddress, uwb::UwbMacAddress{ std::array<uint8_t, 8>{ 9, 9, 9, 9, 9, 9, 9, 9 } } },
+            { UwbApplicationConfigurationParameterType::StaticStsIv, std::array<uint8_t, StaticStsInitializationVectorLength>{ 1, 2, 3, 4, 5, 6 } },
+            { UwbApplicationConfigurationParameterType::ResultReportConfig, std::unordered_set<ResultReportConfiguration>{ ResultReportConfiguration::TofReport, ResultReportConfiguration::AoAFoMReport } },
+        },
+    };
+
+    const auto command = EncodeSessionSetAppConfigCommand(setAppConfig);
+    const auto decoded = DecodeSessionSetAppConfigCommand(command.Payload);
+    REQUIRE(decoded.has_value());
+    REQUIRE(decoded->SessionId == setAppConfig.SessionId);
+    REQUIRE(std::size(decoded->Parameters) == std::size(setAppConfig.Parameters));
+    for (const auto& parameter : setAppConfig.Parameters) {
+        REQUIRE(std::ranges::find(decoded->Parameters, parameter) != std::cend(decoded->Parameters));
+    }
+
+    SECTION("enumerated values are encoded in a single octet")
+    {
+        const auto channel = std::ranges::search(command.Payload, std::array<uint8_t, 3>{ 0x04, 0x01, 0x09 });
+        REQUIRE_FALSE(std::empty(channel));
+    }
+
+    SECTION("a truncated parameter list is rejected")
+    {
+        REQUIRE_FALSE(DecodeSessionSetAppConfigCommand(std::span(command.Payload).first(std::size(command.Payload) - 1)).has_value());
+    }
+
+    SECTION("SESSION_GET_APP_CONFIG_RSP")
+    {
+        const SessionGetAppConfigResponse response{ .Status = UwbStatusOk, .Parameters = setAppConfig.Parameters };
+        const auto decodedResponse = DecodeSessionGetAppConfigResponse(EncodeSessionGetAppConfigResponse(response).Payload);
+        REQUIRE(decodedResponse.has_value());
+        REQUIRE(std::size(decodedResponse->Parameters) == std::size(response.Parameters));
+    }
+}
+
+TEST_CASE("uci responses round-trip", "[basic][protocol][uci]")
+{
+    using namespace uwb::protocol::fira;
+    using namespace uwb::protocol::fira::uci;
+
+    SECTION("status response replies to the command")
+    {
+        const auto command = EncodeSessionDeinitCommand(5);
+        const auto response = EncodeStatusResponse(command.View(), UwbStatusSession::NotExist);
+        REQUIRE(response.View().Is(MessageType::Response, GroupId::Session, SessionOpcodeId::Deinit));
+        REQUIRE(DecodeStatusResponse(response.Payload) == UwbStatus{ UwbStatusSession::NotExist });
+    }
+
+    SECTION("CORE_GET_DEVICE_INFO_RSP")
+    {
+        const std::vector<uint8_t> encoded{ 0x00, 0x01, 0x10, 0x01, 0x30, 0x01, 0x25, 0x01, 0x00, 0x02, 0xCA, 0xFE };
+        const auto deviceInformation = DecodeGetDeviceInfoResponse(encoded);
+        REQUIRE(deviceInformation.has_value());
+        REQUIRE(deviceInformation->VersionUci == uwb::UwbVersion{ 1, 1, 0 });
+        REQUIRE(deviceInformation->VersionMac == uwb::UwbVersion{ 1, 3, 0 });
+        REQUIRE(deviceInformation->VersionPhy == uwb::UwbVersion{ 1, 2, 5 });
+        REQUIRE(deviceInformation->VersionUciTest == uwb::UwbVersion{ 1, 0, 0 });
+        REQUIRE(deviceInformation->VendorSpecificInfo != nullptr);
+        REQUIRE(std::ranges::equal(deviceInformation->VendorSpecificInfo->GetData(), std::array<uint8_t, 2>{ 0xCA, 0xFE }));
+        REQUIRE(EncodeGetDeviceInfoResponse(*deviceInformation).Payload == encoded);
+        REQUIRE_FALSE(DecodeGetDeviceInfoResponse(std::span(encoded).first(11)).has_value());
+    }
+
+    SECTION("SESSION_SET_APP_CONFIG_RSP")
+    {
+        const SessionSetAppConfigResponse response{
+            .Status = UwbStatusGeneric::InvalidParameter,
+            .ParameterStatuses = { { .Status = UwbStatusGeneric::InvalidRange, .ParameterType = UwbApplicationConfigurationParameterType::SlotDuration } },
+        };
+        REQUIRE(DecodeSessionSetAppConfigResponse(EncodeSessionSetAppConfigResponse(response).Payload) == response);
+    }
+
+    SECTION("count and state responses")
+    {
+        const CountResponse sessionCount{ .Status = UwbStatusOk, .Count = 3 };
+        REQUIRE(EncodeSessionGetCountResponse(sessionCount).Payload == std::vector<uint8_t>{ 0x00, 0x03 });
+        REQUIRE(DecodeSessionGetCountResponse(EncodeSessionGetCountResponse(sessionCount).Payload) == sessionCount);
+
+        const CountResponse rangingCount{ .Status = UwbStatusOk, .Count = 0x01020304 };
+        REQUIRE(DecodeRangeGetRangingCountResponse(EncodeRangeGetRangingCountResponse(rangingCount).Payload) == rangingCount);
+
+        const SessionGetStateResponse state{ .Status = UwbStatusOk, .State = UwbSessionState::Idle };
+        REQUIRE(EncodeSessionGetStateResponse(state).Payload == std::vector<uint8_t>{ 0x00, 0x03 });
+        REQUIRE(DecodeSessionGetStateResponse(EncodeSessionGetStateResponse(state).Payload) == state);
+    }
+}
+
+TEST_CASE("uci notifications round-trip", "[basic][protocol][uci]")
+{
+    using namespace uwb::protocol::fira;
+    using namespace uwb::protocol::fira::uci;
+
+    SECTION("CORE_DEVICE_STATUS_NTF")
+    {
+        const auto notification = EncodeDeviceStatusNotification({ .State = UwbDeviceState::Error });
+        REQUIRE(notification.Payload == std::vector<uint8_t>{ 0xFF });
+        REQUIRE(DecodeNotification(notification.View()) == UwbNotificationData{ UwbStatusDevice{ .State = UwbDeviceState::Error } });
+    }
+
+    SECTION("SESSION_STATUS_NTF")
+    {
+        const UwbSessionStatus sessionStatus{ .SessionId = 9, .State = UwbSessionState::Deinitialized, .ReasonCode = UwbSessionReasonCode::ErrorInvalidRangingInterval };
+        const auto notification = EncodeSessionStatusNotification(sessionStatus);
+        REQUIRE(notification.Payload == std::vector<uint8_t>{ 0x09, 0x00, 0x00, 0x00, 0x01, 0x23 });
+        REQUIRE(DecodeNotification(notification.View()) == UwbNotificationData{ sessionStatus });
+    }
+
+    SECTION("SESSION_UPDATE_CONTROLLER_MULTICAST_LIST_NTF")
+    {
+        const UwbSessionUpdateMulticastListStatus multicastListStatus{
+            .SessionId = 4,
+            .Status = { { .ControleeMacAddress = uwb::UwbMacAddress(std::array<uint8_t, 2>{ 0x01, 0x02 }), .SubSessionId = 3, .Status = UwbStatusMulticast::ErrorListFull } },
+        };
+        const auto notification = EncodeSessionUpdateControllerMulticastListNotification(multicastListStatus);
+        REQUIRE(DecodeNotification(notification.View()) == UwbNotificationData{ multicastListStatus });
+    }
+
+    SECTION("unsupported notifications are not decoded")
+    {
+        const auto notification = ControlMessage::Create(MessageType::Notification, GroupId::Test, CoreOpcodeId::DeviceReset);
+        REQUIRE_FALSE(DecodeNotification(notification.View()).has_value());
+    }
+}
+
+TEST_CASE("uci range data notification is decoded", "[basic][protocol][uci]")
+{
+    using namespace uwb::protocol::fira;
+    using namespace uwb::protocol::fira::uci;
+
+    // clang-format off
+    static constexpr std::array<uint8_t, RangeDataNotificationHeaderLength + RangingMeasurementLength> encoded{
+        0x01, 0x00, 0x00, 0x00,                         // sequence number
+        0x02, 0x00, 0x00, 0x00,                         // session id
+        0x00,                                           // RCR indicator
+        0xC8, 0x00, 0x00, 0x00,                         // current ranging interval
+        0x01,                                           // ranging measurement type
+        0x00,                                           // RFU
+        0x00,                                           // mac address mode indicator
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // RFU
+        0x01,                                           // number of measurements
+        0xAB, 0xCD,                                     // mac address
+        0x00,                                           // status
+        0x01,                                           // NLoS
+        0x64, 0x00,                                     // distance
+        0x00, 0x0A, 0x50,                               // AoA azimuth, figure of merit
+        0x00, 0xF6, 0x00,                               // AoA elevation, figure of merit
+        0x00, 0x00, 0x00,                               // AoA destination azimuth, figure of merit
+        0x00, 0x00, 0x00,                               // AoA destination elevation, figure of merit
+        0x03,                                           // slot index
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // RFU
+    };
+    // clang-format on
+
+    const auto rangingData = DecodeRangeDataNotification(encoded);
+    REQUIRE(rangingData.has_value());
+    REQUIRE(rangingData->SequenceNumber == 1);
+    REQUIRE(rangingData->SessionId == 2);
+    REQUIRE(rangingData->CurrentRangingInterval == 200);
+    REQUIRE(std::size(rangingData->RangingMeasurements) == 1);
+
+    const auto& measurement = rangingData->RangingMeasurements.front();
+    REQUIRE(measurement.PeerMacAddress == uwb::UwbMacAddress(std::array<uint8_t, 2>{ 0xAB, 0xCD }));
+    REQUIRE(measurement.Status == UwbStatus{ UwbStatusOk });
+    REQUIRE(measurement.LineOfSightIndicator == UwbLineOfSightIndicator::NonLineOfSight);
+    REQUIRE(measurement.Distance == 100);
+    REQUIRE(measurement.AoAAzimuth.Result == 0x0A00);
+    REQUIRE(measurement.AoAAzimuth.FigureOfMerit == uint8_t{ 0x50 });
+    REQUIRE(measurement.AoAElevation.Result == 0xF600);
+    REQUIRE_FALSE(measurement.AoAElevation.FigureOfMerit.has_value());
+    REQUIRE(measurement.SlotIndex == 3);
+
+    SECTION("encoding produces the original notification")
+    {
+        const auto notification = EncodeRangeDataNotification(*rangingData);
+        REQUIRE(std::ranges::equal(notification.Payload, encoded));
+    }
+
+    SECTION("extended mac addresses round-trip")
+    {
+        auto rangingDataExtended = *rangingData;
+        rangingDataExtended.RangingMeasurements.push_back(measurement);
+        for (auto& rangingMeasurement : rangingDataExtended.RangingMeasurements) {
+            rangingMeasurement.PeerMacAddress = uwb::UwbMacAddress(std::array<uint8_t, 8>{ 1, 2, 3, 4, 5, 6, 7, 8 });
+        }
+
+        const auto notification = EncodeRangeDataNotification(rangingDataExtended);
+        REQUIRE(std::size(notification.Payload) == RangeDataNotificationHeaderLength + (2 * RangingMeasurementLength));
+        REQUIRE(DecodeRangeDataNotification(notification.Payload) == rangingDataExtended);
+    }
+
+    SECTION("decoding reuses existing ranging data")
+    {
+        UwbRangingData reused{};
+        reused.RangingMeasurements.reserve(8);
+        const auto* storage = std::data(reused.RangingMeasurements);
+        REQUIRE(DecodeRangeDataNotification(encoded, reused));
+        REQUIRE(reused == *rangingData);
+        REQUIRE(std::data(reused.RangingMeasurements) == storage);
+    }
+
+    SECTION("a truncated notification is rejected")
+    {
+        REQUIRE_FALSE(DecodeRangeDataNotification(std::span(encoded).first(std::size(encoded) - 1)).has_value());
+        REQUIRE_FALSE(DecodeRangeDataNotification(std::span(encoded).first(10)).has_value());
+    }
+}
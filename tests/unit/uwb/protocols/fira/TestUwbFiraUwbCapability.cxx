@@ -14,6 +14,7 @@
 #include <unordered_set>
 
 #include <tlv/TlvBer.hxx>
+#include <tlv/TlvBerView.hxx>
 #include <uwb/protocols/fira/UwbCapability.hxx>
 
 namespace uwb::protocol::fira::TestUwbCapability
@@ -194,6 +195,20 @@ TEST_CASE("UwbCapability OOB encoding is stable", "[basic][oob][encoding]")
         const auto uwbCapabilityDecoded = UwbCapability::FromOobDataObject(*uwbCapabilityTlv);
         REQUIRE(uwbCapabilityOriginal == uwbCapabilityDecoded);
     }
+
+    SECTION("complex value can be round-tripped through encoded bytes")
+    {
+        UwbCapability uwbCapabilityOriginal = TestUwbCapability::testUwbCapability;
+        const auto uwbCapabilityEncoded = uwbCapabilityOriginal.ToOobDataObject()->ToBytes();
+
+        encoding::TlvBerView uwbCapabilityTlv{};
+        std::size_t bytesParsed = 0;
+        REQUIRE(encoding::TlvBerView::Parse(uwbCapabilityTlv, uwbCapabilityEncoded, bytesParsed) == encoding::Tlv::ParseResult::Succeeded);
+        REQUIRE(bytesParsed == uwbCapabilityEncoded.size());
+
+        const auto uwbCapabilityDecoded = UwbCapability::FromOobDataObject(uwbCapabilityTlv);
+        REQUIRE(uwbCapabilityOriginal == uwbCapabilityDecoded);
+    }
 }
 
 // TODO find better place for this
@@ -1,10 +1,13 @@
 
 #include <catch2/catch_test_macros.hpp>
 
+#include <array>
+#include <cstdint>
 #include <initializer_list>
 #include <unordered_set>
 #include <unordered_map>
 
+#include <tlv/TlvBerView.hxx>
 #include <uwb/protocols/fira/UwbConfiguration.hxx>
 #include <uwb/protocols/fira/UwbConfigurationBuilder.hxx>
 
@@ -76,3 +79,77 @@ TEST_CASE("UwbConfiguration can be used in unordered_containers", "[basic][conta
         }
     }
 }
+
+TEST_CASE("UwbConfiguration can be converted to and from a data object", "[basic][protocol]")
+{
+    using namespace uwb::protocol::fira;
+
+    const UwbConfiguration uwbConfiguration = UwbConfiguration::Create()
+        .SetFiraVersionPhy(0x0102)
+        .SetFiraVersionMac(0x0304)
+        .SetDeviceRole(DeviceRole::Initiator)
+        .SetRangingMethod(RangingMethod{ RangingDirection::SingleSidedTwoWay, MeasurementReportMode::NonDeferred })
+        .SetStsConfiguration(StsConfiguration::Dynamic)
+        .SetMultiNodeMode(MultiNodeMode::OneToMany)
+        .SetHoppingMode(true)
+        .SetUwbInitiationTime(0x11223344)
+        .SetChannel(Channel::C9)
+        .SetPrfMode(PrfMode::Hprf)
+        .AddResultReportConfiguration(ResultReportConfiguration::TofReport)
+        .AddResultReportConfiguration(ResultReportConfiguration::AoAFoMReport)
+        .SetMacAddressController(uwb::UwbMacAddress{ std::array<uint8_t, 8>{ 1, 2, 3, 4, 5, 6, 7, 8 } })
+        .SetSlotDuration(0x0960)
+        .SetMaxRangingRoundRetry(3);
+
+    SECTION("only parameters which are set are encoded")
+    {
+        const auto tlv = uwbConfiguration.ToDataObject();
+        REQUIRE(tlv);
+        REQUIRE(tlv->GetTagValue() == UwbConfiguration::Tag);
+        REQUIRE(tlv->GetValues().size() == uwbConfiguration.GetValueMap().size());
+
+        const auto* uwbInitiationTime = tlv->Find(0x8A);
+        REQUIRE(uwbInitiationTime != nullptr);
+        REQUIRE(std::ranges::equal(uwbInitiationTime->GetValue(), std::array<uint8_t, 4>{ 0x11, 0x22, 0x33, 0x44 }));
+        const auto* resultReportConfig = tlv->Find(0x93);
+        REQUIRE(resultReportConfig != nullptr);
+        REQUIRE(std::ranges::equal(resultReportConfig->GetValue(), std::array<uint8_t, 1>{ 0x09 }));
+        REQUIRE(tlv->Find(0x8C) == nullptr);
+    }
+
+    SECTION("a round-trip through a TlvBer preserves all parameters")
+    {
+        const auto tlv = uwbConfiguration.ToDataObject();
+        REQUIRE(UwbConfiguration::FromDataObject(*tlv) == uwbConfiguration);
+    }
+
+    SECTION("a round-trip through a TlvBerView preserves all parameters")
+    {
+        const auto encoded = uwbConfiguration.ToDataObject()->ToBytes();
+        encoding::TlvBerView tlv{};
+        std::size_t bytesParsed = 0;
+        REQUIRE(encoding::TlvBerView::Parse(tlv, encoded, bytesParsed) == encoding::Tlv::ParseResult::Succeeded);
+        REQUIRE(UwbConfiguration::FromDataObject(tlv) == uwbConfiguration);
+    }
+
+    SECTION("an incorrect tag is rejected")
+    {
+        static constexpr std::array<uint8_t, 5> encoded{ 0xA4, 0x03, 0x82, 0x01, 0x01 };
+        encoding::TlvBerView tlv{};
+        std::size_t bytesParsed = 0;
+        REQUIRE(encoding::TlvBerView::Parse(tlv, encoded, bytesParsed) == encoding::Tlv::ParseResult::Succeeded);
+        REQUIRE_THROWS_AS(UwbConfiguration::FromDataObject(tlv), UwbConfiguration::IncorrectTlvTag);
+    }
+
+    SECTION("a value with an incorrect size is rejected")
+    {
+        static constexpr std::array<uint8_t, 6> encoded{ 0xA3, 0x04, 0x80, 0x02, 0x01, 0x02 };
+        static constexpr std::array<uint8_t, 6> encodedInvalid{ 0xA3, 0x04, 0x82, 0x02, 0x01, 0x02 };
+        encoding::TlvBerView tlv{};
+        std::size_t bytesParsed = 0;
+        REQUIRE(encoding::TlvBerView::Parse(tlv, encoded, bytesParsed) == encoding::Tlv::ParseResult::Succeeded);
+        REQUIRE(UwbConfiguration::FromDataObject(tlv).GetFiraPhyVersion() == 0x0102);
+        REQUIRE(encoding::TlvBerView::Parse(tlv, encodedInvalid, bytesParsed) == encoding::Tlv::ParseResult::Succeeded);
+        REQUIRE_THROWS_AS(UwbConfiguration::FromDataObject(tlv), UwbConfiguration::IncorrectNumberOfBytesInValueError);
+    }
+}
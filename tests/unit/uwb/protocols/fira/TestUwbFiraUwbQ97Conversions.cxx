@@ -0,0 +1,184 @@
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <uwb/UwbPeer.hxx>
+#include <uwb/protocols/fira/FiraDevice.hxx>
+#include <uwb/protocols/fira/UwbQ97Conversions.hxx>
+#include <uwb/protocols/fira/UwbRangingBatch.hxx>
+
+namespace uwb::protocol::fira::test
+{
+/**
+ * @brief Creates every possible Q9.7 value.
+ *
+ * @return std::vector<uint16_t>
+ */
+std::vector<uint16_t>
+AllQ97Values()
+{
+    std::vector<uint16_t> values(std::numeric_limits<uint16_t>::max() + 1);
+    for (std::size_t i = 0; i < std::size(values); i++) {
+        values[i] = static_cast<uint16_t>(i);
+    }
+    return values;
+}
+
+/**
+ * @brief Determines if two values are identical, including the sign of zero.
+ *
+ * @tparam ValueT The floating point type.
+ * @param lhs
+ * @param rhs
+ * @return true
+ * @return false
+ */
+template <typename ValueT>
+bool
+IsIdentical(ValueT lhs, ValueT rhs)
+{
+    return (lhs == rhs) && (std::signbit(lhs) == std::signbit(rhs));
+}
+
+/**
+ * @brief Converts subranges of every Q9.7 value in bulk, and compares the
+ * results to the scalar conversion. The subranges start at every alignment
+ * and have lengths that exercise each SIMD kernel and the scalar remainder.
+ *
+ * @tparam ValueT The floating point type to convert to.
+ * @return true If all converted values match the scalar conversion.
+ * @return false Otherwise.
+ */
+template <typename ValueT>
+bool
+BulkConversionMatchesScalar()
+{
+    const auto q97 = AllQ97Values();
+    std::vector<ValueT> values(std::size(q97));
+
+    ConvertQ97(q97, std::span<ValueT>(values));
+    for (std::size_t i = 0; i < std::size(q97); i++) {
+        if (!IsIdentical(values[i], static_cast<ValueT>(ConvertQ97(q97[i])))) {
+            return false;
+        }
+    }
+
+    for (std::size_t offset = 0; offset < 16; offset++) {
+        for (std::size_t length = 0; length < 64; length++) {
+            const auto source = std::span<const uint16_t>(q97).subspan(0x7FE0 + offset, length);
+            auto destination = std::span<ValueT>(values).subspan(offset, length);
+            ConvertQ97(source, destination);
+            for (std::size_t i = 0; i < length; i++) {
+                if (!IsIdentical(destination[i], static_cast<ValueT>(ConvertQ97(source[i])))) {
+                    return false;
+                }
+            }
+        }
+    }
+
+    return true;
+}
+} // namespace uwb::protocol::fira::test
+
+TEST_CASE("Q9.7 values are converted to floating point", "[basic][protocol]")
+{
+    using namespace uwb::protocol::fira;
+
+    SECTION("the scalar conversion handles sign, integer and fraction parts")
+    {
+        REQUIRE(ConvertQ97(0x0000) == 0.0);
+        REQUIRE(ConvertQ97(0x0080) == 1.0);
+        REQUIRE(ConvertQ97(0x8080) == -1.0);
+        REQUIRE(ConvertQ97(0x0001) == 1.0 / 128.0);
+        REQUIRE(ConvertQ97(0x0040) == 0.5);
+        REQUIRE(ConvertQ97(0x1680) == 45.0);
+        REQUIRE(ConvertQ97(0x96C0) == -45.5);
+        REQUIRE(ConvertQ97(0x5A00) == 180.0);
+        REQUIRE(ConvertQ97(0x7FFF) == 255.0 + (127.0 / 128.0));
+        REQUIRE(ConvertQ97(0xFFFF) == -(255.0 + (127.0 / 128.0)));
+        REQUIRE(std::signbit(ConvertQ97(0x8000)));
+    }
+
+    SECTION("encoding is the inverse of the scalar conversion")
+    {
+        for (const auto q97 : test::AllQ97Values()) {
+            const auto q97Expected = (q97 == 0x8000) ? uint16_t{ 0x0000 } : q97;
+            REQUIRE(EncodeQ97(ConvertQ97(q97)) == q97Expected);
+        }
+    }
+
+    SECTION("encoding rounds to the nearest value and clamps the magnitude")
+    {
+        REQUIRE(EncodeQ97(45.0 + (0.4 / 128.0)) == 0x1680);
+        REQUIRE(EncodeQ97(-45.5 - (0.6 / 128.0)) == 0x96C1);
+        REQUIRE(EncodeQ97(1000.0) == 0x7FFF);
+        REQUIRE(EncodeQ97(-1000.0) == 0xFFFF);
+    }
+
+    SECTION("bulk conversion to float matches the scalar conversion")
+    {
+        REQUIRE(test::BulkConversionMatchesScalar<float>());
+    }
+
+    SECTION("bulk conversion to double matches the scalar conversion")
+    {
+        REQUIRE(test::BulkConversionMatchesScalar<double>());
+    }
+
+    SECTION("bulk conversion rejects an output that is too small")
+    {
+        const std::vector<uint16_t> q97(17);
+        std::vector<double> values(16);
+        REQUIRE_THROWS_AS(ConvertQ97(q97, std::span<double>(values)), std::invalid_argument);
+    }
+}
+
+TEST_CASE("Q9.7 angles of ranging measurements are converted to degrees", "[basic][protocol]")
+{
+    using namespace uwb::protocol::fira;
+
+    std::vector<UwbRangingData> rangingData(3);
+    for (uint16_t i = 0; i < std::size(rangingData); i++) {
+        for (uint16_t j = 0; j < 10; j++) {
+            const auto value = static_cast<uint16_t>((i * 0x1234) + (j * 0x0F0F));
+            auto& measurement = rangingData[i].RangingMeasurements.emplace_back();
+            measurement.AoAAzimuth.Result = value;
+            measurement.AoAElevation.Result = static_cast<uint16_t>(value ^ 0x8000U);
+            measurement.AoaDestinationAzimuth.Result = static_cast<uint16_t>(~value);
+            measurement.AoaDestinationElevation.Result = static_cast<uint16_t>(value >> 1U);
+        }
+    }
+
+    SECTION("peers created from measurements report angles in degrees")
+    {
+        for (const auto& measurement : rangingData.front().RangingMeasurements) {
+            const auto spatialProperties = uwb::UwbPeer{ measurement }.GetSpatialProperties();
+            REQUIRE(spatialProperties.AngleAzimuth == ConvertQ97(measurement.AoAAzimuth.Result));
+            REQUIRE(spatialProperties.AngleElevation == ConvertQ97(measurement.AoAElevation.Result));
+        }
+    }
+
+    SECTION("ranging batches convert each angle column to degrees")
+    {
+        const UwbRangingBatch batch{ rangingData };
+        std::vector<float> degreesFloat(batch.GetNumberOfMeasurements());
+        std::vector<double> degreesDouble(batch.GetNumberOfMeasurements());
+
+        for (std::size_t i = 0; i < UwbRangingBatch::NumberOfAngles; i++) {
+            const auto angle = static_cast<UwbRangingAngle>(i);
+            const auto q97 = batch.GetAngles(angle);
+            batch.GetAngles(angle, std::span<float>(degreesFloat));
+            batch.GetAngles(angle, std::span<double>(degreesDouble));
+            for (std::size_t m = 0; m < std::size(q97); m++) {
+                REQUIRE(degreesFloat[m] == static_cast<float>(ConvertQ97(q97[m])));
+                REQUIRE(degreesDouble[m] == ConvertQ97(q97[m]));
+            }
+        }
+    }
+}
@@ -0,0 +1,167 @@
+
+#include <array>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <uwb/UwbMacAddress.hxx>
+#include <uwb/protocols/fira/FiraDevice.hxx>
+#include <uwb/protocols/fira/UwbRangingBatch.hxx>
+
+namespace uwb::protocol::fira::test
+{
+const UwbMacAddress PeerShort{ std::array<uint8_t, 2>{ 0x12, 0x34 } };
+const UwbMacAddress PeerExtended{ std::array<uint8_t, 8>{ 1, 2, 3, 4, 5, 6, 7, 8 } };
+
+const std::vector<UwbRangingData> RangingData{
+    UwbRangingData{
+        .SequenceNumber = 7,
+        .SessionId = 0x11223344,
+        .CurrentRangingInterval = 200,
+        .RangingMeasurementType = UwbRangingMeasurementType::TwoWay,
+        .RangingMeasurements = {
+            UwbRangingMeasurement{
+                .SlotIndex = 0,
+                .Distance = 123,
+                .Status = UwbStatusGeneric::Ok,
+                .PeerMacAddress = PeerShort,
+                .LineOfSightIndicator = UwbLineOfSightIndicator::LineOfSight,
+                .AoAAzimuth = { 0x1680, 100 },
+                .AoAElevation = { 0x8640, std::nullopt },
+                .AoaDestinationAzimuth = { 0x0000, 0 },
+                .AoaDestinationElevation = { 0xFFFF, 255 },
+            },
+            UwbRangingMeasurement{
+                .SlotIndex = 1,
+                .Distance = 0xFFFF,
+                .Status = UwbStatusRanging::RxTimeout,
+                .PeerMacAddress = PeerExtended,
+                .LineOfSightIndicator = UwbLineOfSightIndicator::Indeterminant,
+                .AoAAzimuth = { 0x0001, std::nullopt },
+                .AoAElevation = { 0x0002, std::nullopt },
+                .AoaDestinationAzimuth = { 0x0003, std::nullopt },
+                .AoaDestinationElevation = { 0x0004, std::nullopt },
+            },
+        },
+    },
+    UwbRangingData{
+        .SequenceNumber = 8,
+        .SessionId = 0x11223344,
+        .CurrentRangingInterval = 200,
+        .RangingMeasurementType = UwbRangingMeasurementType::TwoWay,
+        .RangingMeasurements = {},
+    },
+    UwbRangingData{
+        .SequenceNumber = 1,
+        .SessionId = 0x55,
+        .CurrentRangingInterval = 96,
+        .RangingMeasurementType = UwbRangingMeasurementType::TwoWay,
+        .RangingMeasurements = {
+            UwbRangingMeasurement{
+                .SlotIndex = 3,
+                .Distance = 500,
+                .Status = UwbStatusSession::AddressNotFound,
+                .PeerMacAddress = PeerShort,
+                .LineOfSightIndicator = UwbLineOfSightIndicator::NonLineOfSight,
+                .AoAAzimuth = { 0x7FFF, 1 },
+                .AoAElevation = { 0x8000, 2 },
+                .AoaDestinationAzimuth = { 0x1234, 3 },
+                .AoaDestinationElevation = { 0x4321, 4 },
+            },
+        },
+    },
+};
+} // namespace uwb::protocol::fira::test
+
+TEST_CASE("UwbRangingBatch converts losslessly to and from UwbRangingData", "[basic][protocol]")
+{
+    using namespace uwb::protocol::fira;
+
+    SECTION("an empty batch has no ranging data")
+    {
+        UwbRangingBatch batch{};
+        REQUIRE(batch.GetNumberOfRangingData() == 0);
+        REQUIRE(batch.GetNumberOfMeasurements() == 0);
+        REQUIRE(batch.GetMeasurementOffsets().size() == 1);
+        REQUIRE(batch.ToRangingData().empty());
+        REQUIRE_THROWS_AS(batch.GetRangingData(0), std::out_of_range);
+    }
+
+    SECTION("ranging data round-trips")
+    {
+        UwbRangingBatch batch{ test::RangingData };
+        REQUIRE(batch.GetNumberOfRangingData() == std::size(test::RangingData));
+        REQUIRE(batch.GetNumberOfMeasurements() == 3);
+        REQUIRE(batch.ToRangingData() == test::RangingData);
+        for (std::size_t i = 0; i < std::size(test::RangingData); i++) {
+            REQUIRE(batch.GetRangingData(i) == test::RangingData[i]);
+        }
+    }
+
+    SECTION("appending ranging data is equivalent to constructing from it")
+    {
+        UwbRangingBatch batch{};
+        for (const auto& rangingData : test::RangingData) {
+            batch.Append(rangingData);
+        }
+        REQUIRE(batch == UwbRangingBatch{ test::RangingData });
+    }
+
+    SECTION("clearing allows the batch to be reused")
+    {
+        UwbRangingBatch batch{ test::RangingData };
+        batch.Clear();
+        REQUIRE(batch == UwbRangingBatch{});
+
+        batch.Append(test::RangingData.back());
+        REQUIRE(batch.GetNumberOfRangingData() == 1);
+        REQUIRE(batch.GetRangingData(0) == test::RangingData.back());
+    }
+}
+
+TEST_CASE("UwbRangingBatch stores ranging data column-wise", "[basic][protocol]")
+{
+    using namespace uwb::protocol::fira;
+
+    const UwbRangingBatch batch{ test::RangingData };
+
+    SECTION("ranging data columns are correct")
+    {
+        REQUIRE(std::vector<uint32_t>(std::cbegin(batch.GetSequenceNumbers()), std::cend(batch.GetSequenceNumbers())) == std::vector<uint32_t>{ 7, 8, 1 });
+        REQUIRE(std::vector<uint32_t>(std::cbegin(batch.GetSessionIds()), std::cend(batch.GetSessionIds())) == std::vector<uint32_t>{ 0x11223344, 0x11223344, 0x55 });
+        REQUIRE(std::vector<uint32_t>(std::cbegin(batch.GetCurrentRangingIntervals()), std::cend(batch.GetCurrentRangingIntervals())) == std::vector<uint32_t>{ 200, 200, 96 });
+        REQUIRE(std::vector<std::size_t>(std::cbegin(batch.GetMeasurementOffsets()), std::cend(batch.GetMeasurementOffsets())) == std::vector<std::size_t>{ 0, 2, 2, 3 });
+    }
+
+    SECTION("measurement columns are correct")
+    {
+        REQUIRE(std::vector<uint16_t>(std::cbegin(batch.GetDistances()), std::cend(batch.GetDistances())) == std::vector<uint16_t>{ 123, 0xFFFF, 500 });
+        REQUIRE(std::vector<uint8_t>(std::cbegin(batch.GetSlotIndexes()), std::cend(batch.GetSlotIndexes())) == std::vector<uint8_t>{ 0, 1, 3 });
+        REQUIRE(std::vector<uint8_t>(std::cbegin(batch.GetStatusCodes()), std::cend(batch.GetStatusCodes())) == std::vector<uint8_t>{ 0x00, 0x21, 0x18 });
+        REQUIRE(std::vector<uint16_t>(std::cbegin(batch.GetAngles(UwbRangingAngle::AoAAzimuth)), std::cend(batch.GetAngles(UwbRangingAngle::AoAAzimuth))) == std::vector<uint16_t>{ 0x1680, 0x0001, 0x7FFF });
+        REQUIRE(std::vector<uint16_t>(std::cbegin(batch.GetAngles(UwbRangingAngle::AoaDestinationElevation)), std::cend(batch.GetAngles(UwbRangingAngle::AoaDestinationElevation))) == std::vector<uint16_t>{ 0xFFFF, 0x0004, 0x4321 });
+        REQUIRE(std::vector<uint8_t>(std::cbegin(batch.GetFiguresOfMerit(UwbRangingAngle::AoAAzimuth)), std::cend(batch.GetFiguresOfMerit(UwbRangingAngle::AoAAzimuth))) == std::vector<uint8_t>{ 100, 0, 1 });
+    }
+
+    SECTION("figure of merit presence is tracked per angle")
+    {
+        const auto presence = batch.GetFigureOfMeritPresence();
+        REQUIRE(std::size(presence) == 3);
+        REQUIRE((presence[0] & UwbRangingBatch::FigureOfMeritPresentMask(UwbRangingAngle::AoAAzimuth)) != 0);
+        REQUIRE((presence[0] & UwbRangingBatch::FigureOfMeritPresentMask(UwbRangingAngle::AoAElevation)) == 0);
+        REQUIRE((presence[0] & UwbRangingBatch::FigureOfMeritPresentMask(UwbRangingAngle::AoaDestinationAzimuth)) != 0);
+        REQUIRE(presence[1] == 0);
+        REQUIRE(presence[2] == 0b1111);
+    }
+
+    SECTION("peers are stored once and referred to by index")
+    {
+        const auto peers = batch.GetPeers();
+        REQUIRE(std::size(peers) == 2);
+        REQUIRE(peers[0] == test::PeerShort);
+        REQUIRE(peers[1] == test::PeerExtended);
+        REQUIRE(std::vector<uint32_t>(std::cbegin(batch.GetPeerIndexes()), std::cend(batch.GetPeerIndexes())) == std::vector<uint32_t>{ 0, 1, 0 });
+    }
+}
@@ -0,0 +1,115 @@
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <tlv/TlvBerView.hxx>
+#include <uwb/protocols/fira/UwbConfigurationBuilder.hxx>
+#include <uwb/protocols/fira/UwbSessionData.hxx>
+
+TEST_CASE("UwbSessionData can be decoded from a TlvBerView", "[basic][protocol]")
+{
+    using namespace uwb::protocol::fira;
+
+    SECTION("scalar and ranging info parameters are decoded")
+    {
+        static constexpr std::array<uint8_t, 43> encoded{
+            0xBF, 0x78, 0x28,
+            0x80, 0x02, 0x01, 0x02,                                           // SessionDataVersion
+            0x81, 0x04, 0x11, 0x22, 0x33, 0x44,                               // SessionId
+            0x82, 0x04, 0x55, 0x66, 0x77, 0x88,                               // SubSessionId
+            0xA4, 0x0C, 0x80, 0x02, 0xAB, 0xCD, 0x81, 0x06, 1, 2, 3, 4, 5, 6, // StaticRangingInfo
+            0xA5, 0x08, 0x80, 0x02, 0xEE, 0xFF, 0x82, 0x02, 0x01, 0x02,       // SecureRangingInfo
+        };
+
+        encoding::TlvBerView tlv{};
+        std::size_t bytesParsed = 0;
+        REQUIRE(encoding::TlvBerView::Parse(tlv, encoded, bytesParsed) == encoding::Tlv::ParseResult::Succeeded);
+
+        const auto uwbSessionData = UwbSessionData::FromDataObject(tlv);
+        REQUIRE(uwbSessionData.sessionDataVersion == 0x0102);
+        REQUIRE(uwbSessionData.sessionId == 0x11223344);
+        REQUIRE(uwbSessionData.subSessionId == 0x55667788);
+        REQUIRE(uwbSessionData.staticRangingInfo.has_value());
+        REQUIRE(uwbSessionData.staticRangingInfo->VendorId == 0xABCD);
+        REQUIRE(uwbSessionData.staticRangingInfo->InitializationVector == std::array<uint8_t, StaticRangingInfo::InitializationVectorLength>{ 1, 2, 3, 4, 5, 6 });
+        REQUIRE(uwbSessionData.secureRangingInfo.has_value());
+        REQUIRE(uwbSessionData.secureRangingInfo->UwbSessionKeyInfo == std::vector<uint8_t>{ 0xEE, 0xFF });
+        REQUIRE(uwbSessionData.secureRangingInfo->ResponderSpecificSubSessionKeyInfo.empty());
+        REQUIRE(uwbSessionData.secureRangingInfo->SusAdditionalParameters == std::vector<uint8_t>{ 0x01, 0x02 });
+    }
+
+    SECTION("an incorrect tag is rejected")
+    {
+        static constexpr std::array<uint8_t, 6> encoded{ 0xA3, 0x04, 0x80, 0x02, 0x01, 0x02 };
+        encoding::TlvBerView tlv{};
+        std::size_t bytesParsed = 0;
+        REQUIRE(encoding::TlvBerView::Parse(tlv, encoded, bytesParsed) == encoding::Tlv::ParseResult::Succeeded);
+        REQUIRE_THROWS_AS(UwbSessionData::FromDataObject(tlv), UwbSessionData::IncorrectTlvTag);
+    }
+
+    SECTION("a value with an incorrect size is rejected")
+    {
+        static constexpr std::array<uint8_t, 8> encoded{ 0xBF, 0x78, 0x05, 0x81, 0x03, 0x11, 0x22, 0x33 };
+        encoding::TlvBerView tlv{};
+        std::size_t bytesParsed = 0;
+        REQUIRE(encoding::TlvBerView::Parse(tlv, encoded, bytesParsed) == encoding::Tlv::ParseResult::Succeeded);
+        REQUIRE_THROWS_AS(UwbSessionData::FromDataObject(tlv), UwbSessionData::IncorrectNumberOfBytesInValueError);
+    }
+}
+
+TEST_CASE("UwbSessionData can be converted to and from a data object", "[basic][protocol]")
+{
+    using namespace uwb::protocol::fira;
+
+    UwbSessionData uwbSessionData{};
+    uwbSessionData.sessionDataVersion = 0x0102;
+    uwbSessionData.sessionId = 0x11223344;
+    uwbSessionData.subSessionId = 0x55667788;
+    uwbSessionData.uwbConfiguration = UwbConfiguration::Create()
+        .SetDeviceRole(DeviceRole::Responder)
+        .SetChannel(Channel::C5)
+        .SetRangingInterval(200);
+
+    const auto requireEqual = [&](const UwbSessionData& decoded) {
+        REQUIRE(decoded.sessionDataVersion == uwbSessionData.sessionDataVersion);
+        REQUIRE(decoded.sessionId == uwbSessionData.sessionId);
+        REQUIRE(decoded.subSessionId == uwbSessionData.subSessionId);
+        REQUIRE(decoded.uwbConfiguration == uwbSessionData.uwbConfiguration);
+        REQUIRE(decoded.staticRangingInfo == uwbSessionData.staticRangingInfo);
+        REQUIRE(decoded.secureRangingInfo.has_value() == uwbSessionData.secureRangingInfo.has_value());
+        if (uwbSessionData.secureRangingInfo.has_value()) {
+            REQUIRE(decoded.secureRangingInfo->UwbSessionKeyInfo == uwbSessionData.secureRangingInfo->UwbSessionKeyInfo);
+            REQUIRE(decoded.secureRangingInfo->ResponderSpecificSubSessionKeyInfo == uwbSessionData.secureRangingInfo->ResponderSpecificSubSessionKeyInfo);
+            REQUIRE(decoded.secureRangingInfo->SusAdditionalParameters == uwbSessionData.secureRangingInfo->SusAdditionalParameters);
+        }
+    };
+
+    SECTION("optional ranging info is omitted when not present")
+    {
+        const auto tlv = uwbSessionData.ToDataObject();
+        REQUIRE(tlv);
+        REQUIRE(tlv->GetTagValue() == UwbSessionData::Tag);
+        REQUIRE(tlv->GetValues().size() == 4);
+        REQUIRE(tlv->Find({ UwbConfiguration::Tag, 0x8B }) != nullptr);
+        requireEqual(UwbSessionData::FromDataObject(*tlv));
+    }
+
+    SECTION("a round-trip preserves all parameters")
+    {
+        uwbSessionData.staticRangingInfo = StaticRangingInfo{ 0xABCD, { 1, 2, 3, 4, 5, 6 } };
+        uwbSessionData.secureRangingInfo = SecureRangingInfo{ { 0xEE, 0xFF }, {}, { 0x01 } };
+
+        const auto tlv = uwbSessionData.ToDataObject();
+        REQUIRE(tlv->GetValues().size() == 6);
+        requireEqual(UwbSessionData::FromDataObject(*tlv));
+
+        const auto encoded = tlv->ToBytes();
+        encoding::TlvBerView tlvView{};
+        std::size_t bytesParsed = 0;
+        REQUIRE(encoding::TlvBerView::Parse(tlvView, encoded, bytesParsed) == encoding::Tlv::ParseResult::Succeeded);
+        requireEqual(UwbSessionData::FromDataObject(tlvView));
+    }
+}
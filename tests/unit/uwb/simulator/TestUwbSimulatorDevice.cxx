@@ -0,0 +1,301 @@
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <uwb/UwbPeer.hxx>
+#include <uwb/UwbSession.hxx>
+#include <uwb/UwbSessionEventCallbacks.hxx>
+#include <uwb/simulator/UwbSimulatorDevice.hxx>
+#include <uwb/simulator/UwbSimulatorMotionModel.hxx>
+#include <uwb/simulator/UwbSimulatorSession.hxx>
+
+namespace uwb::test
+{
+struct UwbSimulatorSessionEventCallbacksTest :
+    public uwb::UwbSessionEventCallbacks
+{
+    void
+    OnSessionEnded(uwb::UwbSession* /* session */, uwb::UwbSessionEndReason /* reason */) override
+    {
+    }
+
+    void
+    OnRangingStarted(uwb::UwbSession* /* session */) override
+    {
+    }
+
+    void
+    OnRangingStopped(uwb::UwbSession* /* session */) override
+    {
+    }
+
+    void
+    OnPeerPropertiesChanged(uwb::UwbSession* session, std::vector<uwb::UwbPeer> peersChanged) override
+    {
+        {
+            std::scoped_lock roundsLock{ RoundsGate };
+            RoundsPerSession[session->GetId()]++;
+            PeersChangedLast = std::move(peersChanged);
+        }
+        RoundsChanged.notify_all();
+    }
+
+    void
+    OnSessionMembershipChanged(uwb::UwbSession* /* session */, std::vector<uwb::UwbPeer> /* peersAdded */, std::vector<uwb::UwbPeer> /* peersRemoved */) override
+    {
+    }
+
+    /**
+     * @brief Wait for each session to complete a number of ranging rounds.
+     *
+     * @param sessionIds The sessions to wait for.
+     * @param numberOfRounds The number of rounds each session must complete.
+     * @return true If all sessions completed the rounds before the timeout.
+     * @return false Otherwise.
+     */
+    bool
+    WaitForRounds(const std::vector<uint32_t>& sessionIds, uint32_t numberOfRounds)
+    {
+        std::unique_lock roundsLock{ RoundsGate };
+        return RoundsChanged.wait_for(roundsLock, std::chrono::seconds(10), [&] {
+            for (const auto sessionId : sessionIds) {
+                if (RoundsPerSession[sessionId] < numberOfRounds) {
+                    return false;
+                }
+            }
+            return true;
+        });
+    }
+
+    /**
+     * @brief Get the number of ranging rounds a session has completed.
+     *
+     * @param sessionId The session.
+     * @return uint32_t
+     */
+    uint32_t
+    GetRounds(uint32_t sessionId)
+    {
+        std::scoped_lock roundsLock{ RoundsGate };
+        return RoundsPerSession[sessionId];
+    }
+
+    std::mutex RoundsGate;
+    std::condition_variable RoundsChanged;
+    std::unordered_map<uint32_t, uint32_t> RoundsPerSession;
+    std::vector<uwb::UwbPeer> PeersChangedLast;
+};
+} // namespace uwb::test
+
+TEST_CASE("uwb simulator generates deterministic ranging data", "[basic][simulator]")
+{
+    using namespace uwb::simulator;
+
+    UwbSimulatorConfiguration configuration{};
+    configuration.Seed = 0x1234;
+    configuration.Peers = {
+        UwbSimulatorPeerMotion{ .Model = UwbSimulatorMotionModelType::RandomWalk, .DistanceNoise = 5.0, .AngleNoise = 2.0 },
+        UwbSimulatorPeerMotion{ .Model = UwbSimulatorMotionModelType::Orbit, .AngleNoise = 1.0 },
+    };
+
+    auto generate = [](const UwbSimulatorConfiguration& configurationSession, uint32_t sessionId) {
+        UwbSimulatorSession session{ sessionId, {}, {}, configurationSession };
+        std::vector<uwb::protocol::fira::UwbRangingData> rangingData;
+        for (auto i = 0; i < 50; i++) {
+            rangingData.push_back(session.GenerateNextRangingData());
+        }
+        return rangingData;
+    };
+
+    SECTION("the same seed produces the same ranging data")
+    {
+        REQUIRE(generate(configuration, 1) == generate(configuration, 1));
+    }
+
+    SECTION("different seeds produce different ranging data")
+    {
+        auto configurationOther = configuration;
+        configurationOther.Seed++;
+        REQUIRE(generate(configuration, 1) != generate(configurationOther, 1));
+    }
+
+    SECTION("different sessions produce different ranging data")
+    {
+        REQUIRE(generate(configuration, 1) != generate(configuration, 2));
+    }
+
+    SECTION("ranging data describes each peer")
+    {
+        const auto rangingData = generate(configuration, 7);
+        for (uint32_t i = 0; i < std::size(rangingData); i++) {
+            REQUIRE(rangingData[i].SessionId == 7);
+            REQUIRE(rangingData[i].SequenceNumber == i);
+            REQUIRE(std::size(rangingData[i].RangingMeasurements) == std::size(configuration.Peers));
+            REQUIRE(rangingData[i].RangingMeasurements[0].PeerMacAddress != rangingData[i].RangingMeasurements[1].PeerMacAddress);
+        }
+    }
+}
+
+TEST_CASE("uwb simulator motion models move peers as described", "[basic][simulator]")
+{
+    using namespace uwb::simulator;
+
+    UwbSimulatorRandom random{ 42 };
+    const std::chrono::duration<double> elapsed{ 0.25 };
+
+    SECTION("stationary peers don't move")
+    {
+        const UwbSimulatorPeerMotion motion{ .Initial = { .Distance = 250.0, .Azimuth = 30.0, .Elevation = -10.0 } };
+        UwbSimulatorMotionModel model{ motion };
+        for (auto i = 0; i < 100; i++) {
+            model.Advance(elapsed, random);
+        }
+        REQUIRE(model.GetPosition() == motion.Initial);
+    }
+
+    SECTION("random walks stay within the distance limits")
+    {
+        UwbSimulatorMotionModel model{ UwbSimulatorPeerMotion{ .Model = UwbSimulatorMotionModelType::RandomWalk, .DistanceMinimum = 50.0, .DistanceMaximum = 150.0, .Speed = 500.0, .AngularSpeed = 500.0 } };
+        for (auto i = 0; i < 1000; i++) {
+            model.Advance(elapsed, random);
+            const auto& position = model.GetPosition();
+            REQUIRE(position.Distance >= 50.0);
+            REQUIRE(position.Distance <= 150.0);
+            REQUIRE(position.Azimuth >= -180.0);
+            REQUIRE(position.Azimuth < 180.0);
+            REQUIRE(position.Elevation >= -90.0);
+            REQUIRE(position.Elevation <= 90.0);
+        }
+    }
+
+    SECTION("orbiting peers keep their distance and wrap their azimuth")
+    {
+        UwbSimulatorMotionModel model{ UwbSimulatorPeerMotion{ .Model = UwbSimulatorMotionModelType::Orbit, .Initial = { .Distance = 300.0, .Azimuth = 170.0 }, .AngularSpeed = 40.0 } };
+        model.Advance(elapsed, random);
+        REQUIRE(model.GetPosition().Distance == 300.0);
+        REQUIRE(model.GetPosition().Azimuth == -180.0);
+    }
+
+    SECTION("oscillating peers turn around at the distance limits")
+    {
+        UwbSimulatorMotionModel model{ UwbSimulatorPeerMotion{ .Model = UwbSimulatorMotionModelType::Oscillate, .Initial = { .Distance = 90.0 }, .DistanceMinimum = 10.0, .DistanceMaximum = 100.0, .Speed = 100.0 } };
+        model.Advance(elapsed, random);
+        REQUIRE(model.GetPosition().Distance == 85.0);
+        model.Advance(elapsed, random);
+        REQUIRE(model.GetPosition().Distance == 60.0);
+    }
+}
+
+TEST_CASE("uwb simulator ranging data converts to peer spatial properties", "[basic][simulator]")
+{
+    using namespace uwb::simulator;
+
+    UwbSimulatorConfiguration configuration{};
+    configuration.Peers = {
+        UwbSimulatorPeerMotion{ .Initial = { .Distance = 123.0, .Azimuth = -45.5, .Elevation = 12.25 } },
+    };
+
+    UwbSimulatorSession session{ 1, {}, {}, configuration };
+    const auto rangingData = session.GenerateNextRangingData();
+    REQUIRE(std::size(rangingData.RangingMeasurements) == 1);
+
+    const uwb::UwbPeer peer{ rangingData.RangingMeasurements.front() };
+    const auto spatialProperties = peer.GetSpatialProperties();
+    REQUIRE(spatialProperties.Distance == 123.0);
+    REQUIRE(spatialProperties.AngleAzimuth == -45.5);
+    REQUIRE(spatialProperties.AngleElevation == 12.25);
+}
+
+TEST_CASE("uwb simulator device drives ranging sessions", "[basic][simulator]")
+{
+    using namespace uwb::simulator;
+
+    UwbSimulatorConfiguration configuration{};
+    configuration.RangingInterval = std::chrono::milliseconds(5);
+    configuration.Peers = {
+        UwbSimulatorPeerMotion{ .Model = UwbSimulatorMotionModelType::RandomWalk },
+        UwbSimulatorPeerMotion{ .Model = UwbSimulatorMotionModelType::Orbit },
+        UwbSimulatorPeerMotion{ .Model = UwbSimulatorMotionModelType::Oscillate },
+    };
+
+    auto device = UwbSimulatorDevice::Create(configuration);
+    auto callbacks = std::make_shared<uwb::test::UwbSimulatorSessionEventCallbacksTest>();
+
+    SECTION("multiple sessions range concurrently")
+    {
+        const std::vector<uint32_t> sessionIds{ 1, 2, 3, 4 };
+        std::vector<std::shared_ptr<uwb::UwbSession>> sessions;
+        for (const auto sessionId : sessionIds) {
+            auto session = device->CreateSession(sessionId, callbacks);
+            session->Configure({});
+            session->StartRanging();
+            REQUIRE(session->GetSessionState() == uwb::protocol::fira::UwbSessionState::Active);
+            sessions.push_back(std::move(session));
+        }
+
+        REQUIRE(device->GetSessionCount() == std::size(sessionIds));
+        REQUIRE(callbacks->WaitForRounds(sessionIds, 5));
+        // The most recent round is only counted once its callbacks complete.
+        REQUIRE(device->GetNumberOfMeasurementsGenerated() >= std::size(sessionIds) * 4 * std::size(configuration.Peers));
+
+        for (auto& session : sessions) {
+            session->Destroy();
+            REQUIRE(session->GetSessionState() == uwb::protocol::fira::UwbSessionState::Deinitialized);
+        }
+        REQUIRE(device->GetSessionCount() == 0);
+    }
+
+    SECTION("stopped sessions no longer range")
+    {
+        auto session = device->CreateSession(1, callbacks);
+        session->Configure({});
+        session->StartRanging();
+        REQUIRE(callbacks->WaitForRounds({ 1 }, 2));
+        session->StopRanging();
+        REQUIRE(session->GetSessionState() == uwb::protocol::fira::UwbSessionState::Idle);
+
+        // Stopping waits for a round in progress, so none complete afterwards.
+        const auto numberOfRounds = callbacks->GetRounds(1);
+        const auto numberOfMeasurements = device->GetNumberOfMeasurementsGenerated();
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        REQUIRE(callbacks->GetRounds(1) == numberOfRounds);
+        REQUIRE(device->GetNumberOfMeasurementsGenerated() == numberOfMeasurements);
+
+        session->StartRanging();
+        REQUIRE(callbacks->WaitForRounds({ 1 }, 4));
+    }
+
+    SECTION("the ranging interval can be configured per session")
+    {
+        auto session = device->CreateSession(1, callbacks);
+        session->Configure({ { .Type = uwb::protocol::fira::UwbApplicationConfigurationParameterType::RangingInterval, .Value = uint32_t{ 10 } } });
+        auto simulatorSession = std::dynamic_pointer_cast<UwbSimulatorSession>(session);
+        REQUIRE(simulatorSession != nullptr);
+        REQUIRE(simulatorSession->GetRangingInterval() == std::chrono::milliseconds(10));
+    }
+
+    SECTION("changing the ranging interval of a ranging session reschedules it")
+    {
+        auto session = device->CreateSession(1, callbacks);
+        session->Configure({});
+        session->StartRanging();
+        REQUIRE(callbacks->WaitForRounds({ 1 }, 2));
+
+        session->SetApplicationConfigurationParameters({ { .Type = uwb::protocol::fira::UwbApplicationConfigurationParameterType::RangingInterval, .Value = uint32_t{ 10000 } } });
+
+        // Allow a round that was in progress when the interval changed to complete.
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        const auto numberOfRounds = callbacks->GetRounds(1);
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        REQUIRE(callbacks->GetRounds(1) == numberOfRounds);
+        session->Destroy();
+    }
+}